@@ -0,0 +1,113 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFBoundsTrack.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace SVFBoundsTrack
+{
+    const uint32 Magic = 0x42465653; // "SVFB"
+    const int32 Version = 1;
+}
+
+const TCHAR* FSVFBoundsTrack::FileExtension = TEXT("svfbounds");
+
+FSVFBoundsTrack::FSVFBoundsTrack(int32 InNumFrames)
+{
+    Frames.Init(FBox(ForceInit), FMath::Max(InNumFrames, 0));
+}
+
+bool FSVFBoundsTrack::Record(int32 FrameId, const FBox& Bounds)
+{
+    const int32 Index = FrameId - 1;
+    if (!Frames.IsValidIndex(Index) || !Bounds.IsValid || Frames[Index].IsValid)
+    {
+        return false;
+    }
+    Frames[Index] = Bounds;
+    ++NumRecorded;
+    return true;
+}
+
+FBox FSVFBoundsTrack::GetWindowBounds(int32 FrameId, int32 WindowFrames) const
+{
+    FBox Bounds(ForceInit);
+    const int32 Index = FrameId - 1;
+    if (!Frames.IsValidIndex(Index))
+    {
+        return Bounds;
+    }
+
+    const int32 WindowSize = FMath::Max(WindowFrames, 1);
+    const int32 First = Index / WindowSize * WindowSize;
+    const int32 End = FMath::Min(First + WindowSize, Frames.Num());
+    for (int32 Frame = First; Frame < End; ++Frame)
+    {
+        if (Frames[Frame].IsValid)
+        {
+            Bounds += Frames[Frame];
+        }
+    }
+    return Bounds;
+}
+
+void FSVFBoundsTrack::Save(TArray<uint8>& OutData) const
+{
+    OutData.Reset();
+    FMemoryWriter Writer(OutData);
+    uint32 Magic = SVFBoundsTrack::Magic;
+    int32 Version = SVFBoundsTrack::Version;
+    int32 NumFrames = Frames.Num();
+    Writer << Magic << Version << NumFrames;
+    for (const FBox& Bounds : Frames)
+    {
+        FVector Min = Bounds.Min;
+        FVector Max = Bounds.Max;
+        Writer << Min << Max;
+    }
+}
+
+bool FSVFBoundsTrack::Load(const TArray<uint8>& Data)
+{
+    FMemoryReader Reader(Data);
+    uint32 Magic = 0;
+    int32 Version = 0;
+    int32 NumFrames = 0;
+    Reader << Magic << Version << NumFrames;
+    if (Reader.IsError() || Magic != SVFBoundsTrack::Magic || Version != SVFBoundsTrack::Version || NumFrames != Frames.Num() ||
+        Data.Num() - Reader.Tell() != NumFrames * 2 * static_cast<int64>(sizeof(FVector)))
+    {
+        return false;
+    }
+
+    TArray<FBox> Loaded;
+    Loaded.Reserve(NumFrames);
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        FVector Min;
+        FVector Max;
+        Reader << Min << Max;
+        Loaded.Add(FBox(Min, Max));
+    }
+    if (Reader.IsError())
+    {
+        return false;
+    }
+    Frames = MoveTemp(Loaded);
+    NumRecorded = NumFrames;
+    return true;
+}
+
+bool FSVFBoundsTrack::SaveToFile(const FString& Path) const
+{
+    TArray<uint8> Data;
+    Save(Data);
+    return FFileHelper::SaveArrayToFile(Data, *Path);
+}
+
+bool FSVFBoundsTrack::LoadFromFile(const FString& Path)
+{
+    TArray<uint8> Data;
+    return FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent) && Load(Data);
+}
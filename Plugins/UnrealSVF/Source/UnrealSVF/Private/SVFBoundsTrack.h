@@ -0,0 +1,47 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Local bounds of every frame of a clip, so a component can use bounds that cover a whole window of
+ * frames and only change between windows. Filled frame by frame as the clip plays and kept in a
+ * sidecar file once complete, so later openings have every frame's bounds from the start.
+ */
+class FSVFBoundsTrack
+{
+public:
+    // Sidecar files: FileExtension next to the clip, or under Saved/SVF once written by playback
+    static const TCHAR* FileExtension;
+
+    explicit FSVFBoundsTrack(int32 InNumFrames);
+
+    int32 GetNumFrames() const
+    {
+        return Frames.Num();
+    }
+
+    // Frame ids start at 1. Returns true if the frame was not known before.
+    bool Record(int32 FrameId, const FBox& Bounds);
+
+    bool IsComplete() const
+    {
+        return NumRecorded == Frames.Num() && NumRecorded > 0;
+    }
+
+    // Union of the known frames in FrameId's window; windows of WindowFrames frames start at frame 1.
+    // Invalid while no frame of the window is known.
+    FBox GetWindowBounds(int32 FrameId, int32 WindowFrames) const;
+
+    void Save(TArray<uint8>& OutData) const;
+    // Fails on data that is not a track, or a track of a clip with another frame count
+    bool Load(const TArray<uint8>& Data);
+
+    bool SaveToFile(const FString& Path) const;
+    bool LoadFromFile(const FString& Path);
+
+private:
+    TArray<FBox> Frames;
+    int32 NumRecorded = 0;
+};
@@ -0,0 +1,73 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFBufferBudget.h"
+
+namespace SVFBufferBudget
+{
+    // Priorities are clamped so a zero or negative one still grows, just slowly
+    const float MinPriority = 0.01f;
+    const float MaxPriority = 100.f;
+    // Bisection steps on the fill level, enough to resolve a single frame of any sane headroom
+    const int32 SearchIterations = 40;
+}
+
+FSVFBufferAllocation FSVFBufferBudgetSolver::Allocate(const FSVFBufferRequest& Request, double Level)
+{
+    const double Priority = FMath::Clamp(Request.Priority, SVFBufferBudget::MinPriority, SVFBufferBudget::MaxPriority);
+    const double Fraction = FMath::Clamp(Level * Priority, 0.0, 1.0);
+
+    const uint32 MaxFrames = FMath::Max(Request.MinFrames, Request.MaxFrames);
+    const int32 MinSeconds = FMath::Max(0, Request.MinDownloadSeconds);
+    const int32 MaxSeconds = FMath::Max(MinSeconds, Request.MaxDownloadSeconds);
+
+    FSVFBufferAllocation Allocation;
+    Allocation.Frames = Request.MinFrames + static_cast<uint32>(FMath::FloorToDouble(Fraction * (MaxFrames - Request.MinFrames)));
+    Allocation.DownloadSeconds = MinSeconds + static_cast<int32>(FMath::FloorToDouble(Fraction * (MaxSeconds - MinSeconds)));
+    return Allocation;
+}
+
+uint64 FSVFBufferBudgetSolver::GetBytes(const FSVFBufferRequest& Request, const FSVFBufferAllocation& Allocation)
+{
+    return Request.FrameBytes * Allocation.Frames + Request.StreamBytesPerSecond * static_cast<uint64>(FMath::Max(0, Allocation.DownloadSeconds));
+}
+
+uint64 FSVFBufferBudgetSolver::Solve(const TArray<FSVFBufferRequest>& Requests, uint64 BudgetBytes, TArray<FSVFBufferAllocation>& OutAllocations)
+{
+    auto AllocateAll = [&Requests, &OutAllocations](double Level)
+    {
+        uint64 Bytes = 0;
+        OutAllocations.SetNum(Requests.Num());
+        for (int32 Index = 0; Index < Requests.Num(); ++Index)
+        {
+            OutAllocations[Index] = Allocate(Requests[Index], Level);
+            Bytes += GetBytes(Requests[Index], OutAllocations[Index]);
+        }
+        return Bytes;
+    };
+
+    // At this level the lowest priority reader reaches its maximum, and so does everyone else
+    const double FullLevel = 1.0 / SVFBufferBudget::MinPriority;
+    const uint64 FullBytes = AllocateAll(FullLevel);
+    if (BudgetBytes == 0 || FullBytes <= BudgetBytes)
+    {
+        return FullBytes;
+    }
+
+    // Usage only grows with the level, find the highest level that still fits
+    double Low = 0.0;
+    double High = FullLevel;
+    for (int32 Step = 0; Step < SVFBufferBudget::SearchIterations; ++Step)
+    {
+        const double Mid = (Low + High) * 0.5;
+        if (AllocateAll(Mid) <= BudgetBytes)
+        {
+            Low = Mid;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+    // Minimums over budget still come back as minimums, the caller decides what to do about that
+    return AllocateAll(Low);
+}
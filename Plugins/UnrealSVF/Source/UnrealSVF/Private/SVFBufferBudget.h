@@ -0,0 +1,48 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Buffering one reader asks for. Frames and seconds are granted between their min and max.
+struct FSVFBufferRequest
+{
+    // Memory of one decoded frame
+    uint64 FrameBytes = 0;
+    // Compressed stream rate, what one second of download buffer costs
+    uint64 StreamBytesPerSecond = 0;
+    uint32 MinFrames = 0;
+    uint32 MaxFrames = 0;
+    int32 MinDownloadSeconds = 0;
+    int32 MaxDownloadSeconds = 0;
+    // Relative share of the memory above the minimums, 1 is normal
+    float Priority = 1.f;
+};
+
+struct FSVFBufferAllocation
+{
+    uint32 Frames = 0;
+    int32 DownloadSeconds = 0;
+
+    bool operator==(const FSVFBufferAllocation& Other) const
+    {
+        return Frames == Other.Frames && DownloadSeconds == Other.DownloadSeconds;
+    }
+    bool operator!=(const FSVFBufferAllocation& Other) const { return !(*this == Other); }
+};
+
+// Splits a memory budget between readers. Minimums are always granted; the memory left is filled
+// up evenly, each reader getting the same fraction of its headroom scaled by its priority, until
+// the budget is used or every reader is at its maximum.
+class FSVFBufferBudgetSolver
+{
+public:
+    // Fills OutAllocations in request order and returns the bytes they use. A budget of 0 grants every maximum.
+    static uint64 Solve(const TArray<FSVFBufferRequest>& Requests, uint64 BudgetBytes, TArray<FSVFBufferAllocation>& OutAllocations);
+
+    static uint64 GetBytes(const FSVFBufferRequest& Request, const FSVFBufferAllocation& Allocation);
+
+private:
+    // Allocation at fill level Level, the headroom fraction is Level * Priority
+    static FSVFBufferAllocation Allocate(const FSVFBufferRequest& Request, double Level);
+};
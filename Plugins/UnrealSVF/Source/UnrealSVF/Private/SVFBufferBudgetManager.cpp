@@ -0,0 +1,206 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFBufferBudgetManager.h"
+#include "SVFReaderPoolBudget.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSVFBufferBudget, Log, All);
+
+#define LogSVF(pmt, ...) UE_LOG(LogSVFBufferBudget, Log, TEXT(pmt), ##__VA_ARGS__)
+#define WarnSVF(pmt, ...) UE_LOG(LogSVFBufferBudget, Warning, TEXT(pmt), ##__VA_ARGS__)
+#define FatalSVF(pmt, ...) UE_LOG(LogSVFBufferBudget, Fatal, TEXT(pmt), ##__VA_ARGS__)
+
+namespace SVFBufferBudgetManager
+{
+    // Assumed for files that have not been opened yet: 2k texture, 64k vertices with normals, 12 Mbps
+    const int32 DefaultTextureSize = 2048;
+    const int32 DefaultVertexCount = 64 * 1024;
+    const int32 DefaultIndexCount = 192 * 1024;
+    const uint64 DefaultStreamBytesPerSecond = 12 * 1000 * 1000 / 8;
+    // Download buffer an open reader keeps however tight the budget is
+    const int32 MinDownloadSeconds = 2;
+}
+
+FSVFBufferBudgetManager& FSVFBufferBudgetManager::Get()
+{
+    static FSVFBufferBudgetManager Instance;
+    return Instance;
+}
+
+FSVFBufferBudgetManager::FSVFBufferBudgetManager()
+    : BudgetBytes(0)
+    , bOverBudget(false)
+{
+    // 0 (the default) leaves every reader at its configured buffering
+    int32 BudgetMB = 0;
+    FString SectionBlock = GIsEditor ? TEXT("SVFSettings_Editor") : TEXT("SVFSettings");
+    GConfig->GetInt(*SectionBlock, TEXT("BufferBudgetMB"), BudgetMB, GEngineIni);
+    BudgetBytes = static_cast<uint64>(FMath::Max(0, BudgetMB)) * 1024 * 1024;
+}
+
+FSVFBufferBudgetManager::FCost FSVFBufferBudgetManager::GetCost(const FString& FilePath) const
+{
+    if (const FCost* Known = KnownCosts.Find(FilePath))
+    {
+        return *Known;
+    }
+    FCost Estimate;
+    Estimate.FrameBytes = FSVFReaderPoolBudget::EstimateReaderBytes(SVFBufferBudgetManager::DefaultTextureSize, SVFBufferBudgetManager::DefaultTextureSize,
+        SVFBufferBudgetManager::DefaultVertexCount, SVFBufferBudgetManager::DefaultIndexCount, 1, true);
+    Estimate.StreamBytesPerSecond = SVFBufferBudgetManager::DefaultStreamBytesPerSecond;
+    return Estimate;
+}
+
+uint32 FSVFBufferBudgetManager::ReserveFrames(uint32 ReaderId, const FString& FilePath, uint32 MinFrames, uint32 MaxFrames,
+    int32 DownloadSeconds, float Priority)
+{
+    if (!IsEnabled())
+    {
+        return MaxFrames;
+    }
+
+    uint32 Frames = MaxFrames;
+    TArray<TPair<FApplyDownloadSeconds, int32>> Apply;
+    {
+        FScopeLock Lock(&BudgetCS);
+        const FCost Cost = GetCost(FilePath);
+        FEntry& Entry = Entries.FindOrAdd(ReaderId);
+        Entry.FilePath = FilePath;
+        Entry.Request.FrameBytes = Cost.FrameBytes;
+        Entry.Request.StreamBytesPerSecond = Cost.StreamBytesPerSecond;
+        Entry.Request.MinFrames = MinFrames;
+        Entry.Request.MaxFrames = MaxFrames;
+        Entry.Request.MaxDownloadSeconds = DownloadSeconds;
+        Entry.Request.MinDownloadSeconds = FMath::Min(DownloadSeconds, SVFBufferBudgetManager::MinDownloadSeconds);
+        Entry.Request.Priority = Priority;
+        Entry.Apply = nullptr;
+        Entry.bOpened = false;
+        Rebalance(Apply);
+        Frames = Entries[ReaderId].Allocation.Frames;
+    }
+    ApplyAll(Apply);
+    return Frames;
+}
+
+void FSVFBufferBudgetManager::OnReaderOpened(uint32 ReaderId, uint64 FrameBytes, uint64 StreamBytesPerSecond, uint32 Frames, FApplyDownloadSeconds Apply)
+{
+    TArray<TPair<FApplyDownloadSeconds, int32>> Changes;
+    {
+        FScopeLock Lock(&BudgetCS);
+        FEntry* Entry = Entries.Find(ReaderId);
+        if (!Entry)
+        {
+            return;
+        }
+        FCost& Cost = KnownCosts.FindOrAdd(Entry->FilePath);
+        Cost.FrameBytes = FrameBytes;
+        Cost.StreamBytesPerSecond = StreamBytesPerSecond;
+
+        // From now on only the download buffer can move
+        Entry->Request.FrameBytes = FrameBytes;
+        Entry->Request.StreamBytesPerSecond = StreamBytesPerSecond;
+        Entry->Request.MinFrames = Frames;
+        Entry->Request.MaxFrames = Frames;
+        Entry->Apply = MoveTemp(Apply);
+        Entry->bOpened = true;
+        // Nothing has been applied to the reader yet
+        Entry->Allocation.DownloadSeconds = INDEX_NONE;
+        Rebalance(Changes);
+    }
+    ApplyAll(Changes);
+}
+
+bool FSVFBufferBudgetManager::SetMaxDownloadSeconds(uint32 ReaderId, int32 Seconds)
+{
+    TArray<TPair<FApplyDownloadSeconds, int32>> Apply;
+    {
+        FScopeLock Lock(&BudgetCS);
+        FEntry* Entry = Entries.Find(ReaderId);
+        if (!Entry || !Entry->bOpened)
+        {
+            return false;
+        }
+        Entry->Request.MaxDownloadSeconds = Seconds;
+        Entry->Request.MinDownloadSeconds = FMath::Min(Seconds, SVFBufferBudgetManager::MinDownloadSeconds);
+        Rebalance(Apply);
+    }
+    ApplyAll(Apply);
+    return true;
+}
+
+void FSVFBufferBudgetManager::SetPriority(uint32 ReaderId, float Priority)
+{
+    TArray<TPair<FApplyDownloadSeconds, int32>> Apply;
+    {
+        FScopeLock Lock(&BudgetCS);
+        FEntry* Entry = Entries.Find(ReaderId);
+        if (!Entry || Entry->Request.Priority == Priority)
+        {
+            return;
+        }
+        Entry->Request.Priority = Priority;
+        Rebalance(Apply);
+    }
+    ApplyAll(Apply);
+}
+
+void FSVFBufferBudgetManager::Unregister(uint32 ReaderId)
+{
+    TArray<TPair<FApplyDownloadSeconds, int32>> Apply;
+    {
+        FScopeLock Lock(&BudgetCS);
+        if (Entries.Remove(ReaderId) == 0)
+        {
+            return;
+        }
+        Rebalance(Apply);
+    }
+    ApplyAll(Apply);
+}
+
+void FSVFBufferBudgetManager::Rebalance(TArray<TPair<FApplyDownloadSeconds, int32>>& OutApply)
+{
+    TArray<uint32> Ids;
+    TArray<FSVFBufferRequest> Requests;
+    Ids.Reserve(Entries.Num());
+    Requests.Reserve(Entries.Num());
+    for (const TPair<uint32, FEntry>& Pair : Entries)
+    {
+        Ids.Add(Pair.Key);
+        Requests.Add(Pair.Value.Request);
+    }
+
+    TArray<FSVFBufferAllocation> Allocations;
+    const uint64 UsedBytes = FSVFBufferBudgetSolver::Solve(Requests, BudgetBytes, Allocations);
+    const bool bOver = UsedBytes > BudgetBytes;
+    if (bOver && !bOverBudget)
+    {
+        WarnSVF("%d readers need %llu MB at their minimum buffering, over the %llu MB budget",
+            Entries.Num(), UsedBytes / (1024 * 1024), BudgetBytes / (1024 * 1024));
+    }
+    bOverBudget = bOver;
+
+    for (int32 Index = 0; Index < Ids.Num(); ++Index)
+    {
+        FEntry& Entry = Entries[Ids[Index]];
+        const bool bDownloadChanged = Entry.Allocation.DownloadSeconds != Allocations[Index].DownloadSeconds;
+        Entry.Allocation = Allocations[Index];
+        if (Entry.bOpened && bDownloadChanged && Entry.Apply)
+        {
+            OutApply.Emplace(Entry.Apply, Entry.Allocation.DownloadSeconds);
+        }
+    }
+}
+
+void FSVFBufferBudgetManager::ApplyAll(const TArray<TPair<FApplyDownloadSeconds, int32>>& Apply)
+{
+    for (const TPair<FApplyDownloadSeconds, int32>& Change : Apply)
+    {
+        Change.Key(Change.Value);
+    }
+}
+
+#undef LogSVF
+#undef WarnSVF
+#undef FatalSVF
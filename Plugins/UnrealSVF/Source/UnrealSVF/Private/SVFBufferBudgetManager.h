@@ -0,0 +1,69 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "SVFBufferBudget.h"
+
+/**
+ * Keeps the buffering of every open reader under [SVFSettings] BufferBudgetMB.
+ * Decoded frame buffers are sized when a reader opens and cannot change afterwards, so readers about
+ * to open get the decoded depth left over by the others; open readers are rebalanced through their
+ * download buffers whenever a reader opens, closes, changes priority or play rate.
+ * Frame sizes and bitrates are remembered per file, unknown files are estimated until they are opened.
+ */
+class FSVFBufferBudgetManager
+{
+public:
+    // Called with the download buffer seconds a reader is allowed, possibly from another thread
+    typedef TFunction<void(int32 DownloadSeconds)> FApplyDownloadSeconds;
+
+    static FSVFBufferBudgetManager& Get();
+
+    bool IsEnabled() const { return BudgetBytes > 0; }
+
+    // Decoded frames a reader about to open may buffer, between MinFrames and MaxFrames
+    uint32 ReserveFrames(uint32 ReaderId, const FString& FilePath, uint32 MinFrames, uint32 MaxFrames, int32 DownloadSeconds, float Priority);
+
+    // The reader opened with Frames decoded frames; its measured costs replace the estimates
+    void OnReaderOpened(uint32 ReaderId, uint64 FrameBytes, uint64 StreamBytesPerSecond, uint32 Frames, FApplyDownloadSeconds Apply);
+
+    // Download buffer the reader's play rate asks for. Returns false if the reader is not budgeted.
+    bool SetMaxDownloadSeconds(uint32 ReaderId, int32 Seconds);
+
+    void SetPriority(uint32 ReaderId, float Priority);
+
+    void Unregister(uint32 ReaderId);
+
+private:
+    FSVFBufferBudgetManager();
+
+    struct FCost
+    {
+        uint64 FrameBytes;
+        uint64 StreamBytesPerSecond;
+    };
+
+    struct FEntry
+    {
+        FString FilePath;
+        FSVFBufferRequest Request;
+        FSVFBufferAllocation Allocation;
+        FApplyDownloadSeconds Apply;
+        bool bOpened = false;
+    };
+
+    // Solves for every entry; download changes of open readers are returned to be applied outside the lock
+    void Rebalance(TArray<TPair<FApplyDownloadSeconds, int32>>& OutApply);
+
+    void ApplyAll(const TArray<TPair<FApplyDownloadSeconds, int32>>& Apply);
+
+    FCost GetCost(const FString& FilePath) const;
+
+    TMap<uint32, FEntry> Entries;
+    TMap<FString, FCost> KnownCosts;
+    uint64 BudgetBytes;
+    bool bOverBudget;
+    FCriticalSection BudgetCS;
+};
@@ -1,13 +1,23 @@
 // Copyright (C) Microsoft Corporation. All rights reserved.
 
 #include "SVFComponent.h"
+#include "SVFBoundsTrack.h"
+#include "SVFMeshBVH.h"
 #include "SVFMeshComponents.h"
+#include "SVFMeshDecimator.h"
+#include "SVFSharedStreamRegistry.h"
+#include "SVFSignificanceManager.h"
 #include "UnrealSVF.h"
 #include "Misc/Paths.h"
 #include "SVFSimpleInterface.h"
 #include "DynamicMeshBuilder.h"
 #include "Engine/Engine.h"
 #include "LocalVertexFactory.h"
+#include "RenderCore.h"
+#include "DynamicRHI.h"
+#include "Misc/App.h"
+#include "Misc/Crc.h"
+#include "Async/Async.h"
 
 #include "Runtime/Launch/Resources/Version.h"
 #include "Runtime/Engine/Classes/PhysicsEngine/BodySetup.h"
@@ -21,10 +31,21 @@ DEFINE_LOG_CATEGORY_STATIC(LogSVFComponent, Log, All);
 DECLARE_CYCLE_STAT(TEXT("Get Mesh Elements"), STAT_SVF_GetMeshElements, STATGROUP_UnrealSVF);
 DECLARE_CYCLE_STAT(TEXT("Create Scene Proxy"), STAT_SVF_CreateSceneProxy, STATGROUP_UnrealSVF);
 DECLARE_CYCLE_STAT(TEXT("Update Collision"), STAT_SVF_UpdateCollision, STATGROUP_UnrealSVF);
+DECLARE_CYCLE_STAT(TEXT("Update Triangle BVH"), STAT_SVF_UpdateTriangleBVH, STATGROUP_UnrealSVF);
+DECLARE_CYCLE_STAT(TEXT("Build Triangle BVH"), STAT_SVF_BuildTriangleBVH, STATGROUP_UnrealSVF);
+DECLARE_CYCLE_STAT(TEXT("Trace Frame"), STAT_SVF_TraceFrame, STATGROUP_UnrealSVF);
+DECLARE_CYCLE_STAT(TEXT("Build Surface Sampler"), STAT_SVF_BuildSurfaceSampler, STATGROUP_UnrealSVF);
+DECLARE_CYCLE_STAT(TEXT("Sample Surface"), STAT_SVF_SampleSurface, STATGROUP_UnrealSVF);
+DECLARE_CYCLE_STAT(TEXT("Decimate Collision"), STAT_SVF_DecimateCollision, STATGROUP_UnrealSVF);
+DECLARE_CYCLE_STAT(TEXT("Update Frame Bounds"), STAT_SVF_UpdateFrameBounds, STATGROUP_UnrealSVF);
 DECLARE_CYCLE_STAT(TEXT("Update Mesh Elements"), STAT_SVF_UpdateMeshElements, STATGROUP_UnrealSVF);
 
+// Components playing one reader, keyed by MakeSharedStreamKey
+static TSVFSharedStreamRegistry<USVFComponent*> GSVFSharedStreams;
+
 #if PLATFORM_WINDOWS
 #include "SVFReaderPassThrough.h"
+#include "SVFReaderPool.h"
 THIRD_PARTY_INCLUDES_START
 #include <setupapi.h>
 #if ENGINE_MINOR_VERSION > 19
@@ -48,11 +69,28 @@ bool USVFComponent::OpenFilePath()
     // Use preset settings
     if (bOverride_PresetMode)
     {
+        // Presets describe buffering, not how this hologram ranks against others
+        const float BufferPriority = OpenInfo.BufferPriority;
         OpenInfo = FSVFOpenInfo(PresetMode);
+        OpenInfo.BufferPriority = BufferPriority;
+    }
+
+    OpenInfo.LockStepDecode = IsLockStepActive();
+    LockStepController.Reset();
+    UpdateThrottle.Reset();
+
+    // Another component already plays this clip, present its frames instead of opening a reader
+    if (bShareStream && JoinSharedStream())
+    {
+        return true;
     }
 
+    // A warm reader skips Open and preroll
+    SVFReaderObject = bUseReaderPool ?
+        USVFReaderPool::Get()->Acquire(RelativeFilePathFromContent.FilePath, OpenInfo, this, m_ClockScale) : nullptr;
+
     // Can we do 
-    if (FAILED(ISVFSimpleInterface::CreateInstance(this, RelativeFilePathFromContent.FilePath,
+    if (!SVFReaderObject && FAILED(ISVFSimpleInterface::CreateInstance(this, RelativeFilePathFromContent.FilePath,
         OpenInfo, &SVFReaderObject, this)))
     {
         WarnSVF("SVFReader instance not created!");
@@ -67,8 +105,25 @@ bool USVFComponent::OpenFilePath()
     }
 
     SVFReader = Cast<ISVFSimpleInterface>(SVFReaderObject);
+    // A pooled reader was budgeted with the priority of whoever opened it
+    SVFReader->SetBufferPriority(OpenInfo.BufferPriority);
     OpenedFilePath = RelativeFilePathFromContent.FilePath;
     FileInfo = SVFReader->GetFileInfo();
+    FitRenderDataToClip();
+    OpenBoundsTrack();
+
+    if (bShareStream)
+    {
+        SharedStreamKey = MakeSharedStreamKey();
+        if (!GSVFSharedStreams.Join(SharedStreamKey, this))
+        {
+            // Lost a race against another component opening the same clip, keep playing on our own
+            WarnSVF("%s opened concurrently by another component, not shared", *OpenedFilePath);
+            USVFComponent* Leader = nullptr;
+            GSVFSharedStreams.Leave(SharedStreamKey, this, Leader);
+            SharedStreamKey.Empty();
+        }
+    }
 
 #if WITH_EDITOR
     FEditorDelegates::PausePIE.AddUObject(this, &USVFComponent::HandlePausePIE);
@@ -80,10 +135,36 @@ bool USVFComponent::OpenFilePath()
 
 void USVFComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+    // Take the frame fetched last tick, whichever path below fetched it
+    UpdateTriangleBVH();
+    UpdateSurfaceSampler();
+    TickTriangleCollision();
+
+    if (IsSharedStreamFollower())
+    {
+        TickSharedStreamFollower();
+        Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+        return;
+    }
+
+    if (IsLockStepActive())
+    {
+        TickLockStep(DeltaTime);
+        Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+        return;
+    }
+    bWasLockStepActive = false;
+
     if (ClockState == EUSVFClockState::Running)
     {
         ClockCurrentTime += DeltaTime * m_ClockScale;
     }
+    if (bPredictDisplayTime)
+    {
+        // Timings of the last completed frame, real time regardless of time dilation
+        PresentationPredictor.AddFrameTiming(FApp::GetDeltaTime(),
+            FPlatformTime::ToSeconds(GRenderThreadTime), FPlatformTime::ToSeconds(RHIGetGPUFrameCycles()));
+    }
     bool bDoUpdate = GFrameNumber % UpdateFrameInterval == 0;
     if (!bDoUpdate)
     {
@@ -98,26 +179,93 @@ void USVFComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorCo
         {
             bool bIsNewFrame = false;
             bool isEndOfStream = false;
+            UpdatePresentationPrediction(DeltaTime);
             SVFReader->GetNextFrameViaClock(bIsNewFrame, &isEndOfStream);
 
             SVFReader->GetFrameData(LastFrameData);
 
-            if (bIsNewFrame && !DisableUpdateMesh)
+            if (bIsNewFrame && !DisableUpdateMesh && ThrottleFrameUpdate())
             {
                 GenerateMesh();
             }
         }
     }
 
-    UpdateBounds();
-    MarkRenderTransformDirty();
+    UpdateFrameBounds();
 
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
 
+void USVFComponent::TickLockStep(float DeltaTime)
+{
+    if (!SVFReader || DisableAll || FileInfo.FrameCount < 1)
+    {
+        return;
+    }
+
+    SVFReader->GetSVFStatus(m_status);
+    LastState = (EUSVFReaderState)m_status.lastKnownState;
+    if (DisableGetNextFrame || !bIsPlaying)
+    {
+        return;
+    }
+
+    if (!bWasLockStepActive)
+    {
+        // Entering lock-step mid playback: continue from the frame on screen
+        FSVFFrameInfo FrameInfo;
+        SVFReader->GetFrameInfo(FrameInfo);
+        LockStepController.Reset(FrameInfo.frameTimestamp.GetTotalSeconds());
+        bWasLockStepActive = true;
+    }
+
+    const double FrameDuration = FileInfo.Duration.GetTotalSeconds() / FileInfo.FrameCount;
+    const double Step = DeltaTime * FMath::Abs(m_ClockScale);
+    ClockCurrentTime += Step;
+    LockStepController.SetFrameDuration(FrameDuration);
+    LockStepController.SetTimeout(LockStepTimeout);
+    LockStepController.Advance(Step);
+
+    const int32 PreviousFrame = LockStepController.GetCurrentFrame();
+    auto FetchFrame = [this, FrameDuration](int32& OutFrameIndex, bool& bOutEndOfStream)
+    {
+        if (!SVFReader->GetNextFrame(&bOutEndOfStream))
+        {
+            return false;
+        }
+        FSVFFrameInfo FrameInfo;
+        SVFReader->GetFrameInfo(FrameInfo);
+        OutFrameIndex = FMath::RoundToInt(FrameInfo.frameTimestamp.GetTotalSeconds() / FrameDuration);
+        return true;
+    };
+    auto RestartStream = [this]()
+    {
+        return SVFReader->StartSource(0);
+    };
+    // Looping restarts within the step that hits the end, so the seam doesn't repeat the last frame
+    const ESVFLockStepResult Result = OpenInfo.AutoLooping ?
+        LockStepController.WaitForTargetFrame(FetchFrame, RestartStream) :
+        LockStepController.WaitForTargetFrame(FetchFrame);
+
+    if (Result == ESVFLockStepResult::TimedOut)
+    {
+        WarnSVF("Lock-step frame %d not decoded within %.1f s", LockStepController.GetTargetFrame(), LockStepTimeout);
+    }
+    const int32 CurrentFrame = LockStepController.GetCurrentFrame();
+    if (CurrentFrame != PreviousFrame && CurrentFrame != INDEX_NONE && !DisableUpdateMesh)
+    {
+        SVFReader->GetFrameData(LastFrameData);
+        ThrottleFrameUpdate();
+        GenerateMesh();
+        UpdateFrameBounds();
+    }
+}
+
 void USVFComponent::GenerateMesh()
 {
-    if (!LastFrameData.IsValid() || !SceneProxy)
+    // Followers draw the leader's buffers, so the leader uploads even while it has no proxy itself
+    if (!LastFrameData.IsValid() || !RenderData.IsValid() ||
+        (!SceneProxy && GSVFSharedStreams.Num(SharedStreamKey) < 2))
     {
         return;
     }
@@ -126,30 +274,14 @@ void USVFComponent::GenerateMesh()
     LastFrameData->GetFrameInfo(FrameInfo);
     if (FrameInfo.frameId > 0)
     {
-        FSVFMeshSceneProxy* LocalSceneProxy = (FSVFMeshSceneProxy*)SceneProxy;
-        TSharedPtr<FFrameData> LocalLastFrameData = LastFrameData;
-        // Enqueue command to send to render thread
-        ENQUEUE_RENDER_COMMAND(FSVFMeshUpdate)(
-            [=](FRHICommandListImmediate& RHICmdList)
-            {
-                if (LocalSceneProxy)
-                {
-                    LocalSceneProxy->Update_RenderThread(LocalLastFrameData);
-                }
-                else
-                {
-                    LogSVF("Lost SVFSceneProxy. Skipping Update_RenderThread for this frame.");
-                }
-                
-            }
-        );
+        RenderData->Update(LastFrameData);
 
-        bUpdateTexture = FrameInfo.isKeyFrame;
+        bUpdateTexture = FrameUpdate.bNewKeyFrameGroup;
         LastVerticesNum = FrameInfo.vertexCount;
         LastIndicesNum = FrameInfo.indexCount;
     }
 
-    if ((bUpdateTexture && bUpdateTextureLessOften) || !bUpdateTextureLessOften)
+    if (FrameUpdate.bUpdateTexture && ((bUpdateTexture && bUpdateTextureLessOften) || !bUpdateTextureLessOften))
     {
         UpdateMaterial();
     }
@@ -201,6 +333,8 @@ bool USVFComponent::OpenFilePath()
 
     OpenedFilePath = RelativeFilePathFromContent.FilePath;
     FileInfo = SVFReader->GetFileInfo();
+    FitRenderDataToClip();
+    OpenBoundsTrack();
 
     if (FileInfo.FileWidth > 0 && FileInfo.FileHeight > 0)
     {
@@ -235,20 +369,23 @@ bool USVFComponent::OpenFilePath()
 
 void USVFComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
-    if (bIsPlaying && SVFReader && SVFReader->GetFrameData(LastFrameData))
+    UpdateTriangleBVH();
+    UpdateSurfaceSampler();
+    TickTriangleCollision();
+
+    if (bIsPlaying && SVFReader && SVFReader->GetFrameData(LastFrameData) && ThrottleFrameUpdate())
     {
         GenerateMesh();
     }
 
-    UpdateBounds();
-    MarkRenderTransformDirty();
+    UpdateFrameBounds();
 
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
 
 void USVFComponent::GenerateMesh()
 {
-    if (!LastFrameData.IsValid() || !SceneProxy)
+    if (!LastFrameData.IsValid() || !SceneProxy || !RenderData.IsValid())
     {
         return;
     }
@@ -263,20 +400,12 @@ void USVFComponent::GenerateMesh()
             int MaxVertexCount = FileInfo.MaxVertexCount == 0 ? DefaultVertexCount : FileInfo.MaxVertexCount;
             int MaxIndexCount = FileInfo.MaxIndexCount == 0 ? DefaultIndexCount : FileInfo.MaxIndexCount;
 
-            FSVFMeshSceneProxy* LocalSceneProxy = (FSVFMeshSceneProxy*)SceneProxy;
-            TSharedPtr<FFrameData> LocalLastFrameData = LastFrameData;
-            // Enqueue command to send to render thread
-            ENQUEUE_RENDER_COMMAND(FSVFMeshUpdate)(
-				[=](FRHICommandListImmediate& RHICmdList)
-                {
-                    LocalSceneProxy->Update_RenderThread(LocalLastFrameData, MaxVertexCount, MaxIndexCount);
-                }
-            );
+            RenderData->Update(LastFrameData, MaxVertexCount, MaxIndexCount);
         }
-        bUpdateTexture = FrameInfo.isKeyFrame;
+        bUpdateTexture = FrameUpdate.bNewKeyFrameGroup;
     }
 
-    if ((bUpdateTexture && bUpdateTextureLessOften) || !bUpdateTextureLessOften)
+    if (FrameUpdate.bUpdateTexture && ((bUpdateTexture && bUpdateTextureLessOften) || !bUpdateTextureLessOften))
     {
         UpdateMaterial();
     }
@@ -338,6 +467,9 @@ bool USVFComponent::GeneratePreview()
     }
 
     CloseCurrent(false);
+    // Outside of play CloseCurrent keeps the previous clip's bounds
+    BoundsTrack.Reset();
+    FrameBoundsFrameId = INDEX_NONE;
     // For editor - need try open file for validating and generate preview first frame
     if (FAILED(ISVFSimpleInterface::CreateInstance(this, RelativeFilePath_EditorPreview,
         OpenInfo, &SVFReaderObject, this)))
@@ -376,7 +508,9 @@ bool USVFComponent::GeneratePreview()
                 if (SVFReader->GetNextFrame(&bIsEndFrame))
                 {
                     SVFReader->GetFrameData(LastFrameData);
+                    FrameUpdate = FSVFUpdateDecision();
                     GenerateMesh();
+                    UpdateFrameBounds();
                     UpdateMaterialEditor();
                     bResult = true;
                     OpenedFilePath = RelativeFilePath_EditorPreview;
@@ -443,32 +577,103 @@ FPrimitiveSceneProxy* USVFComponent::CreateSceneProxy()
     return new FSVFMeshSceneProxy(this);
 }
 
+TSharedPtr<FSVFMeshRenderData, ESPMode::ThreadSafe> USVFComponent::GetRenderData(ERHIFeatureLevel::Type InFeatureLevel)
+{
+    if (!RenderData.IsValid())
+    {
+        RenderData = FSVFMeshRenderData::Create(InFeatureLevel, GetMaxVertexCount(), GetMaxIndexCount(), GetRenderSettings());
+    }
+    return RenderData;
+}
+
+void USVFComponent::FitRenderDataToClip()
+{
+    // The texture coordinate format follows the clip, so a new clip can need other buffers of the same size
+    if (RenderData.IsValid() && (RenderData->NeedsResize(GetMaxVertexCount(), GetMaxIndexCount()) ||
+        !(RenderData->GetSettings() == GetRenderSettings())))
+    {
+        // Followers pick the new buffers up from the leader on their next tick
+        const ERHIFeatureLevel::Type FeatureLevel = GetWorld() ? GetWorld()->FeatureLevel : GMaxRHIFeatureLevel;
+        RenderData = FSVFMeshRenderData::Create(FeatureLevel, GetMaxVertexCount(), GetMaxIndexCount(), GetRenderSettings());
+        MarkRenderStateDirty();
+    }
+}
+
+FSVFMeshRenderSettings USVFComponent::GetRenderSettings() const
+{
+    FSVFMeshRenderSettings Settings;
+    Settings.bBuildClusters = bCullClustersPerView;
+    Settings.bOptimizeVertexCache = bOptimizeVertexCache;
+    Settings.bGenerateNormals = bGenerateMissingNormals;
+    Settings.bHalfPrecisionPositions = bHalfPrecisionPositions && FSVFMeshVertexBuffer::SupportsHalfPositions();
+    static bool bWarnedFullPrecisionPositions = false;
+    if (bHalfPrecisionPositions && !Settings.bHalfPrecisionPositions && !bWarnedFullPrecisionPositions)
+    {
+        bWarnedFullPrecisionPositions = true;
+        WarnSVF("Half Precision Positions is not supported with manual vertex fetch, positions are uploaded as floats");
+    }
+    // Coordinates outside 0..1 would be clamped, so only clips that declare unsigned UVs get the normalized format
+    Settings.bNormalizedTexCoords = bNormalizedTexCoords && FileInfo.hasUnsignedUVs;
+    if (bGenerateLODs)
+    {
+        // Each level has to be smaller on screen than the one before it
+        float PreviousScreenSize = 1.f;
+        for (float ScreenSize : LODScreenSizes)
+        {
+            if (ScreenSize <= 0.f || ScreenSize >= PreviousScreenSize)
+            {
+                break;
+            }
+            Settings.LODScreenSizes.Add(ScreenSize);
+            PreviousScreenSize = ScreenSize;
+        }
+    }
+    return Settings;
+}
+
 void USVFComponent::CloseCurrent(bool InAsync)
 {
-    if (!IsWorldPlaying())
+    // Other components still present a shared reader, it is only let go of here
+    const bool bReaderStillShared = LeaveSharedStream();
+    if (!IsWorldPlaying() && !bReaderStillShared)
     {
         return;
     }
 
     if (SVFReader)
     {
-        if (InAsync)
-        {
-            SVFReader->Close_BackgroundThread();
-        }
-        else
-        {
-            SVFReader->Close();
-        }
-        if (SVFReaderObject)
+        // A recycled reader stays open in the pool for the next SVF_Open of the same file
+        bool bRecycled = bReaderStillShared;
+#if PLATFORM_WINDOWS
+        bRecycled = bRecycled || (bUseReaderPool && SVFReaderObject && USVFReaderPool::Get()->Recycle(SVFReaderObject));
+#endif
+        if (!bRecycled)
         {
-            SVFReaderObject->MarkPendingKill();
+            if (InAsync)
+            {
+                SVFReader->Close_BackgroundThread();
+            }
+            else
+            {
+                SVFReader->Close();
+            }
+            if (SVFReaderObject)
+            {
+                SVFReaderObject->MarkPendingKill();
+            }
         }
         SVFReaderObject = nullptr;
         SVFReader = nullptr;
         OpenedFilePath.Empty();
     }
 
+    ResetTriangleBVH();
+    ResetSurfaceSampler();
+    ResetTriangleCollision();
+    BoundsTrack.Reset();
+    FrameBounds.Init();
+    FrameBoundsFrameId = INDEX_NONE;
+
     if (PauseHandle.IsValid())
     {
         FCoreDelegates::ApplicationWillEnterBackgroundDelegate.Remove(PauseHandle);
@@ -493,42 +698,122 @@ int32 USVFComponent::GetNumMaterials() const
     return 1;
 }
 
-FBoxSphereBounds USVFComponent::CalcBounds(const FTransform & LocalToWorld) const
+void USVFComponent::OpenBoundsTrack()
+{
+    BoundsTrack = MakeShared<FSVFBoundsTrack>(FileInfo.FrameCount);
+    FrameBounds.Init();
+    FrameBoundsFrameId = INDEX_NONE;
+
+    // A track shipped next to the clip wins over one written by an earlier playback
+    const FString ShippedPath = FPaths::ChangeExtension(FPaths::ProjectContentDir() / OpenedFilePath, FSVFBoundsTrack::FileExtension);
+    bSaveBoundsTrack = !BoundsTrack->LoadFromFile(ShippedPath) && !BoundsTrack->LoadFromFile(GetSavedBoundsTrackPath());
+}
+
+FString USVFComponent::GetSavedBoundsTrackPath() const
+{
+    return FPaths::ChangeExtension(FPaths::ProjectSavedDir() / TEXT("SVF") / OpenedFilePath, FSVFBoundsTrack::FileExtension);
+}
+
+void USVFComponent::UpdateFrameBounds()
 {
-    if (SVFReader && LastFrameData.IsValid())
+    SCOPE_CYCLE_COUNTER(STAT_SVF_UpdateFrameBounds);
+    if (!LastFrameData.IsValid())
     {
-        FSVFFrameInfo FrameInfo;
-        LastFrameData->GetFrameInfo(FrameInfo);
-        if (FrameInfo.frameId > 0)
+        return;
+    }
+
+    FSVFFrameInfo FrameInfo;
+    LastFrameData->GetFrameInfo(FrameInfo);
+    if (FrameInfo.frameId <= 0 || FrameInfo.frameId == FrameBoundsFrameId)
+    {
+        return;
+    }
+    FrameBoundsFrameId = FrameInfo.frameId;
+
+    // Followers read the leader's track, the leader ticks first and has recorded this frame already
+    USVFComponent* Leader = GetSharedStreamLeader();
+    FSVFBoundsTrack* Track = Leader ? Leader->BoundsTrack.Get() : BoundsTrack.Get();
+    if (Track && !Leader && Track->Record(FrameInfo.frameId, FrameInfo.Bounds) && bSaveBoundsTrack && Track->IsComplete())
+    {
+        bSaveBoundsTrack = false;
+        if (!Track->SaveToFile(GetSavedBoundsTrackPath()))
         {
-            return FBoxSphereBounds(FrameInfo.Bounds).TransformBy(LocalToWorld);
+            WarnSVF("Bounds track of %s not saved!", *OpenedFilePath);
         }
     }
+
+    FBox Bounds = FrameInfo.Bounds;
+    if (Track && BoundsWindowFrames > 1)
+    {
+        Bounds += Track->GetWindowBounds(FrameInfo.frameId, BoundsWindowFrames);
+    }
+    if (FrameBounds.IsValid && Bounds == FrameBounds)
+    {
+        return;
+    }
+
+    FrameBounds = Bounds;
+    UpdateBounds();
+    MarkRenderTransformDirty();
+}
+
+FBoxSphereBounds USVFComponent::CalcBounds(const FTransform & LocalToWorld) const
+{
+    if (FrameBounds.IsValid)
+    {
+        return FBoxSphereBounds(FrameBounds).TransformBy(LocalToWorld);
+    }
     return FBoxSphereBounds(FVector::ZeroVector, FVector::ZeroVector, 1).TransformBy(LocalToWorld);
 }
 
 bool USVFComponent::GetPhysicsTriMeshData(struct FTriMeshCollisionData* CollisionData, bool InUseAllTriData)
 {
+    if (!ContainsPhysicsTriMeshData(InUseAllTriData))
+    {
+        return false;
+    }
+
+    CollisionData->Vertices = CollisionMesh->Positions;
+    const int32 NumTriangles = CollisionMesh->Indices.Num() / 3;
+    CollisionData->Indices.SetNumUninitialized(NumTriangles);
+    CollisionData->MaterialIndices.Init(0, NumTriangles);
+    for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+    {
+        FTriIndices& Tri = CollisionData->Indices[Triangle];
+        Tri.v0 = CollisionMesh->Indices[Triangle * 3 + 0];
+        Tri.v1 = CollisionMesh->Indices[Triangle * 3 + 1];
+        Tri.v2 = CollisionMesh->Indices[Triangle * 3 + 2];
+    }
+    CollisionData->bFlipNormals = true;
+    // Replaced every few frames, cook speed matters more than query speed
+    CollisionData->bDeformableMesh = true;
+    CollisionData->bFastCook = true;
     return true;
 }
 
 bool USVFComponent::ContainsPhysicsTriMeshData(bool InUseAllTriData) const
 {
-    return false;
+    return CollisionMesh.IsValid() && CollisionMesh->Indices.Num() >= 3;
+}
+
+UBodySetup* USVFComponent::CreateBodySetup()
+{
+    // The body setup in a template needs to be public since the property is Tnstanced and thus
+    // is the archetype of the instance meaning there is a direct reference
+    UBodySetup* NewBodySetup = NewObject<UBodySetup>(this, NAME_None, (IsTemplate() ? RF_Public : RF_NoFlags));
+    NewBodySetup->BodySetupGuid = FGuid::NewGuid();
+
+    NewBodySetup->bGenerateMirroredCollision = false;
+    NewBodySetup->bDoubleSidedGeometry = true;
+    NewBodySetup->CollisionTraceFlag = CTF_UseDefault;
+    return NewBodySetup;
 }
 
 void USVFComponent::UpdateBodySetup()
 {
     if (MeshBodySetup == NULL)
     {
-        // The body setup in a template needs to be public since the property is Tnstanced and thus
-        // is the archetype of the instance meaning there is a direct reference
-        MeshBodySetup = NewObject<UBodySetup>(this, NAME_None, (IsTemplate() ? RF_Public : RF_NoFlags));
-        MeshBodySetup->BodySetupGuid = FGuid::NewGuid();
-
-        MeshBodySetup->bGenerateMirroredCollision = false;
-        MeshBodySetup->bDoubleSidedGeometry = true;
-        MeshBodySetup->CollisionTraceFlag = CTF_UseDefault;
+        MeshBodySetup = CreateBodySetup();
     }
 }
 
@@ -536,6 +821,12 @@ void USVFComponent::UpdateCollision()
 {
     SCOPE_CYCLE_COUNTER(STAT_SVF_UpdateCollision);
 
+    // The triangle collision cooks off the game thread, a synchronous cook here would stall it
+    if (bCookTriangleCollision)
+    {
+        return;
+    }
+
     bool bCreatePhysState = false;// Should we create physics state at the end of this function?
                                     // If its created, shut it down now
     if (bPhysicsStateCreated)
@@ -589,6 +880,336 @@ UBodySetup* USVFComponent::GetBodySetup()
     return MeshBodySetup;
 }
 
+void USVFComponent::TickTriangleCollision()
+{
+    typedef TSharedPtr<FSVFCompactMesh, ESPMode::ThreadSafe> FMeshPtr;
+    if (!bCookTriangleCollision)
+    {
+        if (CollisionMesh.IsValid() || PendingCollisionMesh.IsValid() || AsyncBodySetupQueue.Num() > 0)
+        {
+            ResetTriangleCollision();
+        }
+        return;
+    }
+
+    // One update at a time, decimation then cook
+    if (AsyncBodySetupQueue.Num() > 0)
+    {
+        return;
+    }
+    if (PendingCollisionMesh.IsValid())
+    {
+        if (!PendingCollisionMesh.IsReady())
+        {
+            return;
+        }
+        FMeshPtr Mesh = PendingCollisionMesh.Get();
+        PendingCollisionMesh = TFuture<FMeshPtr>();
+        if (Mesh.IsValid() && Mesh->Indices.Num() >= 3)
+        {
+            // The cook takes its input from GetPhysicsTriMeshData right away, on this thread; only
+            // the cooking itself runs in the background
+            CollisionMesh = Mesh;
+            UBodySetup* NewBodySetup = CreateBodySetup();
+            NewBodySetup->CollisionTraceFlag = CTF_UseComplexAsSimple;
+            AsyncBodySetupQueue.Add(NewBodySetup);
+            NewBodySetup->CreatePhysicsMeshesAsync(
+                FOnAsyncPhysicsCookFinished::CreateUObject(this, &USVFComponent::FinishCollisionCook, NewBodySetup));
+        }
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    FSVFFrameInfo FrameInfo;
+    if (!World || World->GetRealTimeSeconds() - LastCollisionCookTime < CollisionCookInterval ||
+        !LastFrameData.IsValid() || !LastFrameData->GetFrameInfo(FrameInfo) || FrameInfo.frameId <= 0)
+    {
+        return;
+    }
+
+    TArray<FVector> Positions;
+    TArray<int32> Indices;
+    if (!LastFrameData->GetFramePositions(Positions) || !LastFrameData->GetFrameIndices(Indices))
+    {
+        return;
+    }
+    LastCollisionCookTime = World->GetRealTimeSeconds();
+
+    const int32 TriangleBudget = CollisionTriangleBudget;
+    PendingCollisionMesh = Async(EAsyncExecution::ThreadPool,
+        [Positions = MoveTemp(Positions), Indices = MoveTemp(Indices), TriangleBudget]() -> FMeshPtr
+    {
+        SCOPE_CYCLE_COUNTER(STAT_SVF_DecimateCollision);
+        FMeshPtr Mesh = MakeShared<FSVFCompactMesh, ESPMode::ThreadSafe>();
+        FSVFMeshDecimator::DecimateToBudget(Indices, Positions, TriangleBudget, *Mesh);
+        return Mesh;
+    });
+}
+
+void USVFComponent::FinishCollisionCook(bool bSuccess, UBodySetup* FinishedBodySetup)
+{
+    // Cooks dropped by a reset are no longer queued and are ignored
+    const int32 QueueIndex = AsyncBodySetupQueue.Find(FinishedBodySetup);
+    if (QueueIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (bSuccess)
+    {
+        // The new body replaces the old one in one step, cooks started before it are outdated
+        MeshBodySetup = FinishedBodySetup;
+        RecreatePhysicsState();
+        AsyncBodySetupQueue.RemoveAt(0, QueueIndex + 1);
+    }
+    else
+    {
+        AsyncBodySetupQueue.RemoveAt(QueueIndex);
+    }
+}
+
+void USVFComponent::ResetTriangleCollision()
+{
+    PendingCollisionMesh = TFuture<TSharedPtr<FSVFCompactMesh, ESPMode::ThreadSafe>>();
+    AsyncBodySetupQueue.Reset();
+    CollisionMesh.Reset();
+    LastCollisionCookTime = 0.0;
+
+    // Back to an empty body until the next clip's first cook
+    if (MeshBodySetup && MeshBodySetup->CollisionTraceFlag == CTF_UseComplexAsSimple)
+    {
+        MeshBodySetup = nullptr;
+        if (bPhysicsStateCreated)
+        {
+            RecreatePhysicsState();
+        }
+    }
+}
+
+void USVFComponent::UpdateTriangleBVH()
+{
+    typedef TSharedPtr<FSVFMeshBVH, ESPMode::ThreadSafe> FBVHPtr;
+    if (!bBuildTriangleBVH)
+    {
+        if (TriangleBVH.IsValid() || PendingTriangleBVH.IsValid())
+        {
+            ResetTriangleBVH();
+        }
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_SVF_UpdateTriangleBVH);
+
+    // One tree in flight; frames arriving meanwhile are skipped
+    if (PendingTriangleBVH.IsValid())
+    {
+        if (!PendingTriangleBVH.IsReady())
+        {
+            return;
+        }
+        FBVHPtr Finished = PendingTriangleBVH.Get();
+        PendingTriangleBVH = TFuture<FBVHPtr>();
+        if (Finished.IsValid())
+        {
+            TriangleBVH = Finished;
+        }
+        else
+        {
+            // The refit did not fit the frame, the next one is built from scratch
+            TriangleBVHFrameId = INDEX_NONE;
+            TriangleBVHIndicesCrc = 0;
+        }
+    }
+
+    FSVFFrameInfo FrameInfo;
+    if (!LastFrameData.IsValid() || !LastFrameData->GetFrameInfo(FrameInfo) || FrameInfo.frameId <= 0 ||
+        FrameInfo.frameId == TriangleBVHFrameId)
+    {
+        return;
+    }
+
+    TArray<FVector> Positions;
+    if (!LastFrameData->GetFramePositions(Positions))
+    {
+        return;
+    }
+
+    // Indices only change with a keyframe. After skipped frames a keyframe may have been missed,
+    // so those compare the indices themselves.
+    TArray<int32> Indices;
+    bool bNewTopology = !TriangleBVH.IsValid() || FrameInfo.isKeyFrame || FrameInfo.indexCount != TriangleBVHIndexCount;
+    if (bNewTopology || FrameInfo.frameId != TriangleBVHFrameId + 1)
+    {
+        if (!LastFrameData->GetFrameIndices(Indices))
+        {
+            return;
+        }
+        const uint32 IndicesCrc = FCrc::MemCrc32(Indices.GetData(), Indices.Num() * sizeof(int32));
+        bNewTopology = bNewTopology || IndicesCrc != TriangleBVHIndicesCrc;
+        TriangleBVHIndicesCrc = IndicesCrc;
+    }
+    TriangleBVHFrameId = FrameInfo.frameId;
+    TriangleBVHIndexCount = FrameInfo.indexCount;
+
+    // The published tree keeps answering queries while the refit works on a copy of it
+    FBVHPtr Source = bNewTopology ? FBVHPtr() : TriangleBVH;
+    PendingTriangleBVH = Async(EAsyncExecution::ThreadPool,
+        [Source, Positions = MoveTemp(Positions), Indices = MoveTemp(Indices)]() mutable -> FBVHPtr
+    {
+        SCOPE_CYCLE_COUNTER(STAT_SVF_BuildTriangleBVH);
+        FBVHPtr BVH = MakeShared<FSVFMeshBVH, ESPMode::ThreadSafe>();
+        if (!Source.IsValid())
+        {
+            BVH->Build(MoveTemp(Positions), Indices);
+        }
+        else if (!BVH->RefitFrom(*Source, MoveTemp(Positions)))
+        {
+            return FBVHPtr();
+        }
+        return BVH;
+    });
+}
+
+void USVFComponent::ResetTriangleBVH()
+{
+    // A pending build is let finish on its own, its result is dropped with the future
+    PendingTriangleBVH = TFuture<TSharedPtr<FSVFMeshBVH, ESPMode::ThreadSafe>>();
+    TriangleBVH.Reset();
+    TriangleBVHFrameId = INDEX_NONE;
+    TriangleBVHIndexCount = 0;
+    TriangleBVHIndicesCrc = 0;
+}
+
+bool USVFComponent::SVF_LineTraceFrame(const FVector& Start, const FVector& End, FVector& OutLocation, FVector& OutNormal, float& OutDistance) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SVF_TraceFrame);
+
+    FSVFMeshRayHit Hit;
+    const FTransform& LocalToWorld = GetComponentTransform();
+    if (!TriangleBVH.IsValid() ||
+        !TriangleBVH->Raycast(LocalToWorld.InverseTransformPosition(Start), LocalToWorld.InverseTransformPosition(End), Hit))
+    {
+        return false;
+    }
+
+    // Hit and normal from the triangle in world space, so scale and mirroring need no special case
+    FVector A, B, C;
+    TriangleBVH->GetTriangle(Hit.Triangle, A, B, C);
+    A = LocalToWorld.TransformPosition(A);
+    B = LocalToWorld.TransformPosition(B);
+    C = LocalToWorld.TransformPosition(C);
+    OutLocation = A + (B - A) * Hit.U + (C - A) * Hit.V;
+    OutNormal = ((B - A) ^ (C - A)).GetSafeNormal();
+    // Both faces are hit, the normal faces the ray
+    if ((OutNormal | (End - Start)) > 0.f)
+    {
+        OutNormal = -OutNormal;
+    }
+    OutDistance = FVector::Dist(Start, OutLocation);
+    return true;
+}
+
+bool USVFComponent::SVF_SphereOverlapFrame(const FVector& Center, float Radius, FVector& OutClosestPoint) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SVF_TraceFrame);
+
+    const FTransform& LocalToWorld = GetComponentTransform();
+    const float MinScale = LocalToWorld.GetScale3D().GetAbsMin();
+    if (!TriangleBVH.IsValid() || MinScale <= SMALL_NUMBER)
+    {
+        return false;
+    }
+
+    // Searched in local space with a radius covering the world sphere; exact for uniform scale
+    FVector LocalPoint;
+    int32 Triangle;
+    if (!TriangleBVH->ClosestPoint(LocalToWorld.InverseTransformPosition(Center), Radius / MinScale, LocalPoint, Triangle))
+    {
+        return false;
+    }
+    OutClosestPoint = LocalToWorld.TransformPosition(LocalPoint);
+    return FVector::DistSquared(OutClosestPoint, Center) <= FMath::Square(Radius);
+}
+
+void USVFComponent::UpdateSurfaceSampler()
+{
+    typedef TSharedPtr<FSVFSurfaceSampler, ESPMode::ThreadSafe> FSamplerPtr;
+    if (!bBuildSurfaceSampler)
+    {
+        if (SurfaceSampler.IsValid() || PendingSurfaceSampler.IsValid())
+        {
+            ResetSurfaceSampler();
+        }
+        return;
+    }
+
+    // One build in flight; frames presented meanwhile are skipped
+    if (PendingSurfaceSampler.IsValid())
+    {
+        if (!PendingSurfaceSampler.IsReady())
+        {
+            return;
+        }
+        SurfaceSampler = PendingSurfaceSampler.Get();
+        PendingSurfaceSampler = TFuture<FSamplerPtr>();
+    }
+
+    FSVFFrameSnapshotPtr Snapshot = GetFrameSnapshot();
+    if (!Snapshot.IsValid() || Snapshot->FrameId == SurfaceSamplerFrameId)
+    {
+        return;
+    }
+    SurfaceSamplerFrameId = Snapshot->FrameId;
+
+    // The sampler reads the snapshot in place, it stays alive for as long as the sampler does
+    PendingSurfaceSampler = Async(EAsyncExecution::ThreadPool, [Snapshot]() -> FSamplerPtr
+    {
+        SCOPE_CYCLE_COUNTER(STAT_SVF_BuildSurfaceSampler);
+        FSamplerPtr Sampler = MakeShared<FSVFSurfaceSampler, ESPMode::ThreadSafe>();
+        Sampler->Build(Snapshot);
+        return Sampler;
+    });
+}
+
+void USVFComponent::ResetSurfaceSampler()
+{
+    PendingSurfaceSampler = TFuture<TSharedPtr<FSVFSurfaceSampler, ESPMode::ThreadSafe>>();
+    SurfaceSampler.Reset();
+    SurfaceSamplerFrameId = INDEX_NONE;
+}
+
+bool USVFComponent::SVF_SampleSurface(int32 Count, int32 Seed, TArray<FVector>& OutPositions, TArray<FVector>& OutNormals,
+    TArray<FVector2D>& OutTexCoords) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SVF_SampleSurface);
+
+    OutPositions.Reset();
+    OutNormals.Reset();
+    OutTexCoords.Reset();
+    FSVFSurfaceSamplerPtr Sampler = SurfaceSampler;
+    if (!Sampler.IsValid() || Sampler->IsEmpty() || Count <= 0)
+    {
+        return false;
+    }
+
+    // Normals take the inverse scale, so they stay perpendicular under non-uniform scale
+    const FTransform& LocalToWorld = GetComponentTransform();
+    const FVector InverseScale = FTransform::GetSafeScaleReciprocal(LocalToWorld.GetScale3D());
+    FRandomStream Random(Seed);
+    OutPositions.SetNumUninitialized(Count);
+    OutNormals.SetNumUninitialized(Count);
+    OutTexCoords.SetNumUninitialized(Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        FSVFSurfaceSample Sample;
+        Sampler->Sample(Random, Sample);
+        OutPositions[Index] = LocalToWorld.TransformPosition(Sample.Position);
+        OutNormals[Index] = LocalToWorld.TransformVectorNoScale(Sample.Normal * InverseScale).GetSafeNormal();
+        OutTexCoords[Index] = Sample.TexCoord;
+    }
+    return true;
+}
+
 USVFComponent::USVFComponent()
     : bAutoPlay(true)
     , DisableUpdateMesh(false)
@@ -650,6 +1271,15 @@ bool USVFComponent::IsWorldPlaying() const
     return HasBegunPlay();
 }
 
+bool USVFComponent::IsLockStepActive() const
+{
+#if PLATFORM_WINDOWS
+    return bLockStepPlayback || (bLockStepWithFixedTimeStep && FApp::UseFixedTimeStep());
+#else
+    return false;
+#endif
+}
+
 bool USVFComponent::IsFileOpened() const
 {
     return !OpenedFilePath.IsEmpty() && SVFReader != nullptr;
@@ -722,6 +1352,11 @@ void USVFComponent::UpdateMaterial()
         }
     }
 
+    UpdateMaterialInstance();
+}
+
+void USVFComponent::UpdateMaterialInstance()
+{
     // Dynamic material not assigned or the material has changed and new instance must be created
     if (DynInstance && DynInstance->Parent != BaseMaterial)
     {
@@ -737,6 +1372,150 @@ void USVFComponent::UpdateMaterial()
     DynInstance->SetTextureParameterValue(TEXT("Texture"), DynTexture);
 }
 
+FString USVFComponent::MakeSharedStreamKey() const
+{
+    // Only readers opened the same way can be shared
+    return FString::Printf(TEXT("%s|%d%d%d%d"), *RelativeFilePathFromContent.FilePath, OpenInfo.AudioDisabled ? 1 : 0,
+        OpenInfo.OutputNormals ? 1 : 0, OpenInfo.AutoLooping ? 1 : 0, OpenInfo.LockStepDecode ? 1 : 0);
+}
+
+bool USVFComponent::JoinSharedStream()
+{
+    const FString Key = MakeSharedStreamKey();
+    USVFComponent* Leader = GSVFSharedStreams.GetLeader(Key);
+    if (!Leader || Leader == this || !Leader->SVFReader)
+    {
+        return false;
+    }
+    if (GSVFSharedStreams.Join(Key, this))
+    {
+        // The leader left in the meantime, there is nothing to follow
+        GSVFSharedStreams.Leave(Key, this, Leader);
+        return false;
+    }
+
+    SharedStreamKey = Key;
+    SVFReaderObject = Leader->SVFReaderObject;
+    SVFReader = Leader->SVFReader;
+    OpenedFilePath = Leader->OpenedFilePath;
+    FileInfo = Leader->FileInfo;
+    LastFrameData = Leader->LastFrameData;
+    bIsBeginPlayback = Leader->bIsBeginPlayback;
+    bIsPlaying = Leader->bIsPlaying;
+    LogSVF("Sharing the reader of %s", *OpenedFilePath);
+    // Buffers, texture and tick order are picked up by the next tick, on the game thread
+    return true;
+}
+
+bool USVFComponent::LeaveSharedStream()
+{
+    if (SharedStreamKey.IsEmpty())
+    {
+        return false;
+    }
+
+    const bool bWasLeader = GSVFSharedStreams.IsLeader(SharedStreamKey, this);
+    USVFComponent* NewLeader = nullptr;
+    const int32 NumRemaining = GSVFSharedStreams.Leave(SharedStreamKey, this, NewLeader);
+    SharedStreamKey.Empty();
+    if (USVFComponent* Leader = SharedStreamLeader.Get())
+    {
+        RemoveTickPrerequisiteComponent(Leader);
+    }
+    SharedStreamLeader.Reset();
+    if (NumRemaining == 0)
+    {
+        return false;
+    }
+
+    if (bWasLeader && NewLeader)
+    {
+        NewLeader->TakeStreamLeadership(this);
+    }
+    // Let go of the shared buffers and texture, the stream keeps changing them. The component shows nothing
+    // until it opens a file of its own
+    RenderData.Reset();
+    DynTexture = nullptr;
+    MarkRenderStateDirty();
+    return true;
+}
+
+bool USVFComponent::IsSharedStreamFollower() const
+{
+    return !SharedStreamKey.IsEmpty() && !GSVFSharedStreams.IsLeader(SharedStreamKey, this);
+}
+
+void USVFComponent::TickSharedStreamFollower()
+{
+    USVFComponent* Leader = GSVFSharedStreams.GetLeader(SharedStreamKey);
+    if (!Leader)
+    {
+        return;
+    }
+    if (Leader != SharedStreamLeader.Get())
+    {
+        // Tick after the leader so its newest frame is presented in the same frame
+        if (USVFComponent* PreviousLeader = SharedStreamLeader.Get())
+        {
+            RemoveTickPrerequisiteComponent(PreviousLeader);
+        }
+        AddTickPrerequisiteComponent(Leader);
+        SharedStreamLeader = Leader;
+    }
+
+    m_status = Leader->m_status;
+    LastState = Leader->LastState;
+    bIsPlaying = Leader->bIsPlaying;
+    bIsBeginPlayback = Leader->bIsBeginPlayback;
+    LastFrameData = Leader->LastFrameData;
+
+    if (RenderData != Leader->RenderData && Leader->RenderData.IsValid())
+    {
+        RenderData = Leader->RenderData;
+        MarkRenderStateDirty();
+    }
+    if (DynTexture != Leader->DynTexture && !DisableUpdateTexture)
+    {
+        DynTexture = Leader->DynTexture;
+        UpdateMaterialInstance();
+    }
+
+    UpdateFrameBounds();
+}
+
+void USVFComponent::TakeStreamLeadership(USVFComponent* PreviousLeader)
+{
+    // Continue the previous leader's timeline, the reader is presenting against it
+    ClockCurrentTime = PreviousLeader->ClockCurrentTime;
+    PresentationOffset = PreviousLeader->PresentationOffset;
+    ClockState = PreviousLeader->ClockState;
+    m_ClockScale = PreviousLeader->m_ClockScale;
+    bIsBeginPlayback = PreviousLeader->bIsBeginPlayback;
+    bIsPlaying = PreviousLeader->bIsPlaying;
+    PredictedPresentationClock.Invalidate();
+    CadencePolicy.Reset();
+    PresentationPredictor.Reset();
+
+    RemoveTickPrerequisiteComponent(PreviousLeader);
+    SharedStreamLeader.Reset();
+
+#if PLATFORM_WINDOWS
+    if (USVFReaderPassThrough* Reader = Cast<USVFReaderPassThrough>(SVFReaderObject))
+    {
+        Reader->Rename(nullptr, this, REN_DontCreateRedirectors | REN_NonTransactional);
+        Reader->RebindClock(this);
+    }
+#endif
+    BoundsTrack = PreviousLeader->BoundsTrack;
+    bSaveBoundsTrack = PreviousLeader->bSaveBoundsTrack;
+    LogSVF("Took over the shared reader of %s", *OpenedFilePath);
+}
+
+USVFComponent* USVFComponent::GetSharedStreamLeader() const
+{
+    return IsSharedStreamFollower() ? GSVFSharedStreams.GetLeader(SharedStreamKey) : nullptr;
+}
+
 bool USVFComponent::SVF_IsPlaying()
 {
     return SVFReader && bIsPlaying;
@@ -744,6 +1523,12 @@ bool USVFComponent::SVF_IsPlaying()
 
 void USVFComponent::SVF_Play()
 {
+    if (USVFComponent* Leader = GetSharedStreamLeader())
+    {
+        Leader->SVF_Play();
+        bIsPlaying = Leader->bIsPlaying;
+        return;
+    }
 #if PLATFORM_ANDROID
     SVFReader->Start();
     bIsPlaying = true;
@@ -790,6 +1575,12 @@ void USVFComponent::SVF_Play()
 
 void USVFComponent::SVF_Pause()
 {
+    if (USVFComponent* Leader = GetSharedStreamLeader())
+    {
+        Leader->SVF_Pause();
+        bIsPlaying = Leader->bIsPlaying;
+        return;
+    }
     if (SVF_IsPlaying())
     {
         SVFReader->Stop();
@@ -800,6 +1591,12 @@ void USVFComponent::SVF_Pause()
 
 void USVFComponent::SVF_Stop()
 {
+    if (USVFComponent* Leader = GetSharedStreamLeader())
+    {
+        Leader->SVF_Stop();
+        bIsPlaying = Leader->bIsPlaying;
+        return;
+    }
     if (SVF_IsPlaying())
     {
         SVFReader->Stop();
@@ -917,8 +1714,33 @@ bool USVFComponent::SVF_Open(const FString& FileName, bool InStartPlayingImmedia
     return bResult;
 }
 
+bool USVFComponent::SVF_PrewarmCue()
+{
+#if PLATFORM_WINDOWS
+    if (!bUseReaderPool || !ValidateFilePath(FPaths::ProjectContentDir() / RelativeFilePathFromContent.FilePath))
+    {
+        return false;
+    }
+
+    // Same settings OpenFilePath will use, otherwise the warm reader would not match
+    FSVFOpenInfo CueOpenInfo = bOverride_PresetMode ? FSVFOpenInfo(PresetMode) : OpenInfo;
+    CueOpenInfo.LockStepDecode = IsLockStepActive();
+    CueOpenInfo.playbackRate = m_ClockScale;
+    return USVFReaderPool::Get()->Prewarm(RelativeFilePathFromContent.FilePath, CueOpenInfo);
+#else
+    return false;
+#endif
+}
+
 void USVFComponent::SVF_SetPlayRate(float InPlayRate)
 {
+    // The leader's clock drives a shared reader
+    if (USVFComponent* Leader = GetSharedStreamLeader())
+    {
+        Leader->SVF_SetPlayRate(InPlayRate);
+        m_ClockScale = Leader->m_ClockScale;
+        return;
+    }
     if (!SVFReader)
     {
         return;
@@ -928,17 +1750,48 @@ void USVFComponent::SVF_SetPlayRate(float InPlayRate)
     {
         InPlayRate = FMath::Abs(InPlayRate);
     }
-    if (FMath::Abs(InPlayRate) < 0.1f)
+    const float Rate = FMath::Min(FMath::Abs(InPlayRate), 10.f);
+    if (Rate < KINDA_SMALL_NUMBER)
     {
         SVF_Pause();
+        return;
     }
-    else
+
+    // Our clock drives SVF, so scaling it is enough and keeps the reader's buffers intact.
+    // The reader clock is only touched when it drives playback itself or paces the audio.
+    m_ClockScale = Rate;
+    if (NeedsReaderClockScale())
+    {
+        SVFReader->SetReaderClockScale(Rate);
+    }
+    SVFReader->UpdateBufferingForRate(Rate);
+    SVFReader->SetPlayFlow(InPlayRate >= 0.f);
+}
+
+void USVFComponent::SVF_SetBufferPriority(float InPriority)
+{
+    OpenInfo.BufferPriority = FMath::Max(0.f, InPriority);
+    // Followers have no reader of their own
+    if (USVFComponent* Leader = GetSharedStreamLeader())
+    {
+        Leader->SVF_SetBufferPriority(InPriority);
+        return;
+    }
+    if (SVFReader)
     {
-        SVFClock_SetScale(FMath::Clamp(FMath::RoundToInt(FMath::Abs(InPlayRate) / 0.1f) * 0.1f, -10.f, 10.f));
-        SVFReader->SetPlayFlow(InPlayRate >= 0.f);
+        SVFReader->SetBufferPriority(OpenInfo.BufferPriority);
     }
 }
 
+bool USVFComponent::NeedsReaderClockScale() const
+{
+#if PLATFORM_WINDOWS
+    return !OpenInfo.forceSoftwareClock || (FileInfo.hasAudio && !OpenInfo.AudioDisabled);
+#else
+    return true;
+#endif
+}
+
 float USVFComponent::SVF_GetPlayRate()
 {
     return m_ClockScale;
@@ -949,8 +1802,78 @@ bool USVFComponent::SVF_CanSeek()
     return SVFReader && SVFReader->CanSeek();
 }
 
+bool USVFComponent::ThrottleFrameUpdate()
+{
+    FrameUpdate = FSVFUpdateDecision();
+    if (!LastFrameData.IsValid())
+    {
+        return true;
+    }
+
+    FSVFFrameInfo FrameInfo;
+    LastFrameData->GetFrameInfo(FrameInfo);
+
+    // Offline renders and streams presented by other components as well get every frame
+    FSVFUpdateRate Rate;
+    if (!bScaleUpdateRateWithScreenSize || IsLockStepActive() || GSVFSharedStreams.Num(SharedStreamKey) > 1)
+    {
+        UpdateTier = ESVFUpdateTier::Full;
+    }
+    else
+    {
+        FSVFSignificanceSettings Settings;
+        Settings.FullRateScreenSize = FullRateScreenSize;
+        Settings.HalfRateScreenSize = FMath::Min(HalfRateScreenSize, FullRateScreenSize);
+        // Same bounds as CalcBounds, from the last update; worlds without player views play at full rate
+        const float ScreenSize = FSVFSignificanceManager::Get().GetScreenSize(GetWorld(), Bounds);
+        UpdateTier = ScreenSize < 0.f ? ESVFUpdateTier::Full : FSVFSignificance::SelectTier(ScreenSize, UpdateTier, Settings);
+        const double Duration = FileInfo.Duration.GetTotalSeconds();
+        Rate = FSVFSignificance::GetUpdateRate(UpdateTier, Duration > 0.0 ? FileInfo.FrameCount / Duration : 0.f, Settings);
+    }
+
+    FrameUpdate = UpdateThrottle.OnNewFrame(FrameInfo.frameId, FrameInfo.isKeyFrame, Rate);
+    return FrameUpdate.bUpdateMesh;
+}
+
+void USVFComponent::UpdatePresentationPrediction(float DeltaTime)
+{
+    PredictedPresentationClock.Invalidate();
+    if (!bPredictDisplayTime || ClockState != EUSVFClockState::Running || FileInfo.FrameCount < 1)
+    {
+        CadencePolicy.Reset();
+        return;
+    }
+
+    int64 ClockTime = 0;
+    SVFClock_GetTime(&ClockTime);
+    PresentationPredictor.SetExtraLatency(DisplayLatencyMs * 0.001);
+    CadencePolicy.SetHysteresis(CadenceHysteresis);
+    CadencePolicy.SetFrameDuration(FileInfo.Duration.GetTotalSeconds() / FileInfo.FrameCount);
+
+    // Latency and refresh interval are real time, the presentation time is content time
+    const double ClockScale = FMath::Abs(m_ClockScale);
+    const double PredictedTime = static_cast<double>(ClockTime - PresentationOffset) / ETimespan::TicksPerSecond +
+        PresentationPredictor.GetPredictedLatency() * ClockScale;
+    if (CadencePolicy.SelectFrame(PredictedTime, PresentationPredictor.GetFrameInterval() * ClockScale) == INDEX_NONE)
+    {
+        return;
+    }
+
+    // Content time per real second, including time dilation, so the reader's clock keeps pace with
+    // ClockCurrentTime until the next update re-anchors it
+    const double RealDelta = FApp::GetDeltaTime();
+    const double Rate = RealDelta > 0.0 ? DeltaTime / RealDelta * m_ClockScale : m_ClockScale;
+    PredictedPresentationClock.Set(CadencePolicy.GetSelectedFrameTime(), FPlatformTime::Seconds(), Rate);
+}
+
 bool USVFComponent::SVFClock_GetPresentationTime(int64* OutTime)
 {
+    double PredictedTime = 0.0;
+    if (PredictedPresentationClock.Get(FPlatformTime::Seconds(), PredictedTime))
+    {
+        *OutTime = static_cast<int64>(PredictedTime * ETimespan::TicksPerSecond);
+        return true;
+    }
     if (!SVFClock_GetTime(OutTime))
     {
         return false;
@@ -975,6 +1898,7 @@ bool USVFComponent::SVFClock_Start()
 bool USVFComponent::SVFClock_Stop()
 {
     ClockState = EUSVFClockState::Stopped;
+    PredictedPresentationClock.Invalidate();
     return true;
 }
 
@@ -988,17 +1912,24 @@ bool USVFComponent::SVFClock_Shutdown()
 {
     ClockState = EUSVFClockState::Stopped;
     ClockCurrentTime = 0.f;
+    PredictedPresentationClock.Invalidate();
+    CadencePolicy.Reset();
+    PresentationPredictor.Reset();
     return true;
 }
 
 bool USVFComponent::SVFClock_SetPresentationOffset(int64 InT)
 {
     PresentationOffset = InT;
+    PredictedPresentationClock.Invalidate();
+    CadencePolicy.Reset();
     return true;
 }
 
 bool USVFComponent::SVFClock_SnapPresentationOffset()
 {
+    PredictedPresentationClock.Invalidate();
+    CadencePolicy.Reset();
     return SVFClock_GetTime(&PresentationOffset);
 }
 
@@ -1126,17 +2057,22 @@ void USVFComponent::EnumAudioDevices(TArray<FAudioDeviceInfo>& deviceInfos)
 
 bool USVFComponent::GetVertices(TArray<FVector>& Vertices)
 {
-    if (!SceneProxy)
+    FSVFFrameSnapshotPtr Snapshot = GetFrameSnapshot();
+    if (!Snapshot.IsValid())
     {
         return false;
     }
-    
-    FSVFMeshSceneProxy* LocalSceneProxy = (FSVFMeshSceneProxy*)SceneProxy;
-    LocalSceneProxy->GetPositionalVertices(Vertices, SVF_GetFrameInfo().vertexCount);
+
+    Vertices.Append(Snapshot->Positions);
 
     return true;
 }
 
+FSVFFrameSnapshotPtr USVFComponent::GetFrameSnapshot() const
+{
+    return RenderData.IsValid() ? RenderData->GetSnapshot() : FSVFFrameSnapshotPtr();
+}
+
 #undef LogSVF
 #undef WarnSVF
 #undef FatalSVF
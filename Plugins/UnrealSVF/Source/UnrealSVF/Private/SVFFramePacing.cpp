@@ -0,0 +1,168 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFFramePacing.h"
+#include "Misc/ScopeLock.h"
+
+namespace SVFFramePacing
+{
+    // Weight of the newest sample in the running averages
+    const double SmoothingFactor = 0.1;
+    // Samples further than this ratio from the average (hitches, loading) are clamped
+    const double MaxSampleRatio = 4.0;
+    // Used until the first frame has been measured
+    const double DefaultFrameInterval = 1.0 / 60.0;
+}
+
+FSVFPresentationTimePredictor::FSVFPresentationTimePredictor()
+    : ExtraLatency(0.0)
+{
+    Reset();
+}
+
+void FSVFPresentationTimePredictor::Reset()
+{
+    FrameInterval = SVFFramePacing::DefaultFrameInterval;
+    RenderThreadTime = 0.0;
+    GPUTime = 0.0;
+    NumSamples = 0;
+}
+
+double FSVFPresentationTimePredictor::SmoothSample(double Average, double Sample) const
+{
+    if (NumSamples == 0)
+    {
+        return Sample;
+    }
+    if (Average > 0.0)
+    {
+        Sample = FMath::Clamp(Sample, Average / SVFFramePacing::MaxSampleRatio, Average * SVFFramePacing::MaxSampleRatio);
+    }
+    return Average + (Sample - Average) * SVFFramePacing::SmoothingFactor;
+}
+
+void FSVFPresentationTimePredictor::AddFrameTiming(double GameDeltaSeconds, double RenderThreadSeconds, double GPUSeconds)
+{
+    if (GameDeltaSeconds <= 0.0)
+    {
+        return;
+    }
+    FrameInterval = SmoothSample(FrameInterval, GameDeltaSeconds);
+    RenderThreadTime = SmoothSample(RenderThreadTime, FMath::Max(0.0, RenderThreadSeconds));
+    GPUTime = SmoothSample(GPUTime, FMath::Max(0.0, GPUSeconds));
+    ++NumSamples;
+}
+
+double FSVFPresentationTimePredictor::GetPredictedLatency() const
+{
+    // The game thread finishes this frame one interval from now, then the render thread and GPU
+    // process it in turn before it is flipped to the display
+    return FrameInterval + RenderThreadTime + GPUTime + ExtraLatency;
+}
+
+FSVFCadencePolicy::FSVFCadencePolicy()
+    : FrameDuration(0.0)
+    , Hysteresis(0.25f)
+{
+    Reset();
+}
+
+void FSVFCadencePolicy::Reset()
+{
+    SelectedFrame = INDEX_NONE;
+    SelectedAtTime = 0.0;
+}
+
+int64 FSVFCadencePolicy::SelectFrame(double PredictedContentTime, double DisplayInterval)
+{
+    if (FrameDuration <= 0.0)
+    {
+        return INDEX_NONE;
+    }
+
+    const double Position = FMath::Max(0.0, PredictedContentTime) / FrameDuration;
+    const int64 Candidate = static_cast<int64>(FMath::FloorToDouble(Position));
+
+    // Seeks, loops and hitches: nothing to stabilise, take the frame as is
+    if (SelectedFrame == INDEX_NONE || Candidate > SelectedFrame + 1 || Candidate < SelectedFrame - 1)
+    {
+        SelectedFrame = Candidate;
+        SelectedAtTime = PredictedContentTime;
+        return SelectedFrame;
+    }
+
+    // Display refreshes each content frame should stay on screen for, e.g. 2 for 30 fps on 60 Hz
+    const double RefreshInterval = DisplayInterval > 0.0 ? DisplayInterval : FrameDuration;
+    const double RefreshesPerFrame = FrameDuration / RefreshInterval;
+    // Refreshes since the frame was selected, however many calls were skipped in between
+    const int32 HeldRefreshes = FMath::Max(0, FMath::RoundToInt(static_cast<float>((PredictedContentTime - SelectedAtTime) / RefreshInterval)));
+
+    bool bAdvance = false;
+    if (Candidate == SelectedFrame + 1)
+    {
+        // Crossed the boundary: hold back only while the frame hasn't had its minimum cadence
+        // and the overshoot is still inside the hysteresis window
+        const bool bMinCadenceReached = HeldRefreshes >= FMath::FloorToInt(RefreshesPerFrame);
+        const bool bTooLate = (Position - Candidate) > Hysteresis;
+        bAdvance = bMinCadenceReached || bTooLate;
+    }
+    else if (Candidate == SelectedFrame)
+    {
+        // Just short of the boundary: advance early if the frame has had its full cadence already,
+        // so timing jitter around the boundary doesn't stretch it by one refresh
+        const bool bFullCadenceReached = HeldRefreshes >= FMath::CeilToInt(RefreshesPerFrame);
+        const bool bNearBoundary = (static_cast<double>(SelectedFrame + 1) - Position) < Hysteresis;
+        bAdvance = bFullCadenceReached && bNearBoundary;
+    }
+    // Candidate == SelectedFrame - 1 is jitter pulling the prediction back over a boundary that was
+    // already crossed; never step backwards for that
+
+    if (bAdvance)
+    {
+        ++SelectedFrame;
+        SelectedAtTime = PredictedContentTime;
+    }
+    return SelectedFrame;
+}
+
+double FSVFCadencePolicy::GetSelectedFrameTime() const
+{
+    if (SelectedFrame == INDEX_NONE)
+    {
+        return 0.0;
+    }
+    return (static_cast<double>(SelectedFrame) + 0.5) * FrameDuration;
+}
+
+FSVFPresentationClock::FSVFPresentationClock()
+    : BaseContentTime(0.0)
+    , AnchorTime(0.0)
+    , Rate(0.0)
+    , bValid(false)
+{
+}
+
+void FSVFPresentationClock::Set(double ContentSeconds, double NowSeconds, double InRate)
+{
+    FScopeLock ScopeLock(&Lock);
+    BaseContentTime = ContentSeconds;
+    AnchorTime = NowSeconds;
+    Rate = InRate;
+    bValid = true;
+}
+
+void FSVFPresentationClock::Invalidate()
+{
+    FScopeLock ScopeLock(&Lock);
+    bValid = false;
+}
+
+bool FSVFPresentationClock::Get(double NowSeconds, double& OutContentSeconds) const
+{
+    FScopeLock ScopeLock(&Lock);
+    if (!bValid)
+    {
+        return false;
+    }
+    OutContentSeconds = FMath::Max(0.0, BaseContentTime + (NowSeconds - AnchorTime) * Rate);
+    return true;
+}
@@ -0,0 +1,110 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFFrameSnapshotSlot.h"
+#include "DynamicMeshBuilder.h"
+#include "Misc/ScopeLock.h"
+
+FSVFFrameSnapshotSlot::FWritablePtr FSVFFrameSnapshotSlot::Allocate()
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        // A retired snapshot cannot gain readers again, so once unique it stays unique
+        for (int32 Index = 0; Index < Retired.Num(); ++Index)
+        {
+            if (Retired[Index].IsUnique())
+            {
+                FWritablePtr Snapshot = MoveTemp(Retired[Index]);
+                Retired.RemoveAtSwap(Index, 1, false);
+                return Snapshot;
+            }
+        }
+    }
+    return MakeShared<FSVFFrameSnapshot, ESPMode::ThreadSafe>();
+}
+
+bool FSVFFrameSnapshotSlot::Publish(FWritablePtr&& Snapshot, uint32 Sequence)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (!Snapshot.IsValid())
+    {
+        return false;
+    }
+    if (Sequence <= CurrentSequence)
+    {
+        Retire(MoveTemp(Snapshot));
+        return false;
+    }
+    if (Current.IsValid())
+    {
+        Retire(MoveTemp(Current));
+    }
+    Current = MoveTemp(Snapshot);
+    CurrentSequence = Sequence;
+    return true;
+}
+
+FSVFFrameSnapshotPtr FSVFFrameSnapshotSlot::Get() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Current;
+}
+
+void FSVFFrameSnapshotSlot::Reset()
+{
+    FScopeLock ScopeLock(&Lock);
+    Current.Reset();
+    CurrentSequence = 0;
+    Retired.Reset();
+}
+
+void FSVFFrameSnapshotSlot::Retire(FWritablePtr&& Snapshot)
+{
+    if (Retired.Num() < MaxRetired)
+    {
+        Retired.Add(MoveTemp(Snapshot));
+    }
+    Snapshot.Reset();
+}
+
+void FSVFFrameSnapshotSlot::Fill(FSVFFrameSnapshot& Snapshot, int32 FrameId, TArrayView<const FDynamicMeshVertex> Vertices,
+    TArrayView<const int32> Indices, bool bHasNormals)
+{
+    const int32 NumVertices = Vertices.Num();
+    Snapshot.FrameId = FrameId;
+    Snapshot.Positions.SetNumUninitialized(NumVertices, false);
+    Snapshot.Normals.SetNumUninitialized(bHasNormals ? NumVertices : 0, false);
+    Snapshot.TexCoords.SetNumUninitialized(NumVertices, false);
+    for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+    {
+        Snapshot.Positions[Vertex] = Vertices[Vertex].Position;
+        Snapshot.TexCoords[Vertex] = Vertices[Vertex].TextureCoordinate[0];
+        if (bHasNormals)
+        {
+            Snapshot.Normals[Vertex] = Vertices[Vertex].TangentZ.ToFVector();
+        }
+    }
+    Snapshot.Indices.Reset(Indices.Num());
+    Snapshot.Indices.Append(Indices.GetData(), Indices.Num());
+}
+
+void FSVFFrameSnapshotSlot::Fill(FSVFFrameSnapshot& Snapshot, int32 FrameId, TArrayView<const FVector> Positions,
+    TArrayView<const FPackedNormal> Tangents, const FVector2D* TexCoords, int32 TexCoordStride, TArrayView<const int32> Indices)
+{
+    const int32 NumVertices = Positions.Num();
+    const bool bHasNormals = Tangents.Num() == 2 * NumVertices;
+    Snapshot.FrameId = FrameId;
+    Snapshot.Positions.Reset(NumVertices);
+    Snapshot.Positions.Append(Positions.GetData(), NumVertices);
+    Snapshot.Normals.SetNumUninitialized(bHasNormals ? NumVertices : 0, false);
+    Snapshot.TexCoords.SetNumUninitialized(NumVertices, false);
+    for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+    {
+        Snapshot.TexCoords[Vertex] = TexCoords ? TexCoords[Vertex * TexCoordStride] : FVector2D::ZeroVector;
+        if (bHasNormals)
+        {
+            Snapshot.Normals[Vertex] = Tangents[2 * Vertex + 1].ToFVector();
+        }
+    }
+    Snapshot.Indices.Reset(Indices.Num());
+    Snapshot.Indices.Append(Indices.GetData(), Indices.Num());
+}
@@ -0,0 +1,51 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "SVFFrameSnapshot.h"
+
+struct FDynamicMeshVertex;
+struct FPackedNormal;
+
+/**
+ * Latest frame snapshot of one stream. Publishers and readers may be on any thread. Snapshots that no
+ * reader holds anymore are refilled for later frames instead of being reallocated.
+ */
+class FSVFFrameSnapshotSlot
+{
+public:
+    typedef TSharedPtr<FSVFFrameSnapshot, ESPMode::ThreadSafe> FWritablePtr;
+
+    // Replaced snapshots kept for reuse, enough for readers that hold on to one for a frame or two
+    static const int32 MaxRetired = 3;
+
+    // Snapshot to fill for the next publish: a retired one nobody reads anymore, or a new one
+    FWritablePtr Allocate();
+
+    // Makes Snapshot the current one unless a later sequence was published already; false if it was dropped
+    bool Publish(FWritablePtr&& Snapshot, uint32 Sequence);
+
+    FSVFFrameSnapshotPtr Get() const;
+
+    // Forgets every snapshot, before the owner is reused for another clip
+    void Reset();
+
+    // Copies decoded vertices, their first texture coordinate and indices into Snapshot
+    static void Fill(FSVFFrameSnapshot& Snapshot, int32 FrameId, TArrayView<const FDynamicMeshVertex> Vertices,
+        TArrayView<const int32> Indices, bool bHasNormals);
+    // Same from the separate vertex streams of a staging block; Tangents holds TangentX and TangentZ
+    // interleaved and is empty for clips without normals
+    static void Fill(FSVFFrameSnapshot& Snapshot, int32 FrameId, TArrayView<const FVector> Positions,
+        TArrayView<const FPackedNormal> Tangents, const FVector2D* TexCoords, int32 TexCoordStride, TArrayView<const int32> Indices);
+
+private:
+    // Puts a snapshot aside for Allocate, called with Lock held
+    void Retire(FWritablePtr&& Snapshot);
+
+    mutable FCriticalSection Lock;
+    FWritablePtr Current;
+    uint32 CurrentSequence = 0;
+    TArray<FWritablePtr> Retired;
+};
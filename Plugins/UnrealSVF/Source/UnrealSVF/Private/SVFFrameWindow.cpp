@@ -0,0 +1,76 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFFrameWindow.h"
+
+FSVFFrameWindow::FSVFFrameWindow()
+{
+    Configure(1);
+}
+
+void FSVFFrameWindow::Configure(int32 InNumSlots)
+{
+    Slots.SetNum(FMath::Max(1, InNumSlots));
+    Reset();
+}
+
+void FSVFFrameWindow::Reset()
+{
+    for (FSlot& Slot : Slots)
+    {
+        Slot = FSlot();
+    }
+    Head = INDEX_NONE;
+    NumFrames = 0;
+}
+
+int32 FSVFFrameWindow::Push(int32 FrameIndex)
+{
+    int64 Position = 0;
+    if (Head != INDEX_NONE)
+    {
+        const FSlot& Newest = Slots[Head];
+        // Skipped frames count, a loop or seek back just continues after the newest frame
+        Position = Newest.Position + (FrameIndex > Newest.FrameIndex ? FrameIndex - Newest.FrameIndex : 1);
+    }
+
+    Head = (Head + 1) % Slots.Num();
+    Slots[Head].FrameIndex = FrameIndex;
+    Slots[Head].Position = Position;
+    NumFrames = FMath::Min(NumFrames + 1, Slots.Num());
+    return Head;
+}
+
+int32 FSVFFrameWindow::FindSlot(int32 FrameOffset) const
+{
+    if (Head == INDEX_NONE)
+    {
+        return INDEX_NONE;
+    }
+
+    const int64 Target = Slots[Head].Position - FMath::Max(0, FrameOffset);
+    // Walk from newest to oldest, positions only decrease along the way
+    int32 Slot = Head;
+    for (int32 Index = 1; Index < NumFrames; ++Index)
+    {
+        if (Slots[Slot].Position <= Target)
+        {
+            break;
+        }
+        Slot = (Slot - 1 + Slots.Num()) % Slots.Num();
+    }
+    return Slot;
+}
+
+void FSVFFrameWindow::AssignInstances(const TArray<int32>& FrameOffsets, TArray<int32>& OutSlots) const
+{
+    OutSlots.SetNum(FrameOffsets.Num());
+    for (int32 Index = 0; Index < FrameOffsets.Num(); ++Index)
+    {
+        OutSlots[Index] = FindSlot(FrameOffsets[Index]);
+    }
+}
+
+int32 FSVFFrameWindow::GetSlotFrame(int32 Slot) const
+{
+    return Slots.IsValidIndex(Slot) ? Slots[Slot].FrameIndex : INDEX_NONE;
+}
@@ -0,0 +1,31 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SVFTexCoordPacker.h"
+
+// Vertex of the half precision position stream; the vertex factory reads it as VET_Half4, W is one.
+// Components round to the nearest half, where FFloat16's own conversion truncates and doubles the error.
+struct FSVFHalfPosition
+{
+    FFloat16 X;
+    FFloat16 Y;
+    FFloat16 Z;
+    FFloat16 W;
+
+    FSVFHalfPosition() {}
+
+    explicit FSVFHalfPosition(const FVector& Position)
+        : W(1.f)
+    {
+        X.Encoded = FSVFTexCoordPacker::FloatToHalf(Position.X);
+        Y.Encoded = FSVFTexCoordPacker::FloatToHalf(Position.Y);
+        Z.Encoded = FSVFTexCoordPacker::FloatToHalf(Position.Z);
+    }
+
+    FVector ToFVector() const
+    {
+        return FVector(X.GetFloat(), Y.GetFloat(), Z.GetFloat());
+    }
+};
@@ -0,0 +1,267 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFInstancedComponent.h"
+#include "SVFMeshComponents.h"
+#include "UnrealSVF.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+#include "Runtime/Launch/Resources/Version.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSVFInstancedComponent, Log, All);
+
+#define LogSVF(pmt, ...) UE_LOG(LogSVFInstancedComponent, Log, TEXT(pmt), ##__VA_ARGS__)
+#define WarnSVF(pmt, ...) UE_LOG(LogSVFInstancedComponent, Warning, TEXT(pmt), ##__VA_ARGS__)
+#define FatalSVF(pmt, ...) UE_LOG(LogSVFInstancedComponent, Fatal, TEXT(pmt), ##__VA_ARGS__)
+
+#if PLATFORM_ANDROID
+#include "SVFReaderAndroid.h"
+#endif
+
+namespace SVFInstancedComponent
+{
+    int32 GetWindowSize(int32 FrameWindowSize)
+    {
+#if PLATFORM_ANDROID
+        // The Android reader renders into a single texture, every instance shows the newest frame
+        return 1;
+#else
+        return FMath::Clamp(FrameWindowSize, 1, 64);
+#endif
+    }
+}
+
+void USVFInstancedComponent::OnRegister()
+{
+    // Instances already share this component's reader
+    bShareStream = false;
+    // Materials are created here on the game thread, before the first proxy
+    InitSlots();
+    Super::OnRegister();
+}
+
+int32 USVFInstancedComponent::SVF_AddInstance(const FTransform& InstanceTransform, int32 FrameOffset)
+{
+    FSVFInstance Instance;
+    Instance.Transform = InstanceTransform;
+    Instance.FrameOffset = FMath::Max(0, FrameOffset);
+    const int32 Index = Instances.Add(Instance);
+    UpdateInstanceSlots();
+    MarkRenderStateDirty();
+    return Index;
+}
+
+bool USVFInstancedComponent::SVF_SetInstanceFrameOffset(int32 InstanceIndex, int32 FrameOffset)
+{
+    if (!Instances.IsValidIndex(InstanceIndex))
+    {
+        return false;
+    }
+    Instances[InstanceIndex].FrameOffset = FMath::Max(0, FrameOffset);
+    // Only the slot assignment changes, the proxy is kept
+    UpdateInstanceSlots();
+    UpdateBounds();
+    MarkRenderTransformDirty();
+    return true;
+}
+
+void USVFInstancedComponent::SVF_ClearInstances()
+{
+    Instances.Empty();
+    UpdateInstanceSlots();
+    MarkRenderStateDirty();
+}
+
+#if WITH_EDITOR
+void USVFInstancedComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    InitSlots();
+    UpdateInstanceSlots();
+    MarkRenderStateDirty();
+}
+#endif
+
+FPrimitiveSceneProxy* USVFInstancedComponent::CreateSceneProxy()
+{
+    InitSlots();
+    return new FSVFInstancedMeshSceneProxy(this);
+}
+
+bool USVFInstancedComponent::InitSlots()
+{
+    const int32 WindowSize = SVFInstancedComponent::GetWindowSize(FrameWindowSize);
+    // Slots are recreated, from pooled buffers where they fit, when the window or the clip's maxima change
+    if (SlotRenderData.Num() == WindowSize && SlotMaterials.Num() == WindowSize &&
+        (WindowSize == 0 || !SlotRenderData[0]->NeedsResize(GetMaxVertexCount(), GetMaxIndexCount())))
+    {
+        return false;
+    }
+
+    const ERHIFeatureLevel::Type FeatureLevel = GetWorld() ? GetWorld()->FeatureLevel : GMaxRHIFeatureLevel;
+    SlotRenderData.Reset(WindowSize);
+    SlotMaterials.Reset(WindowSize);
+    SlotTextures.Reset(WindowSize);
+    SlotBounds.Reset(WindowSize);
+    for (int32 Slot = 0; Slot < WindowSize; Slot++)
+    {
+        SlotRenderData.Add(FSVFMeshRenderData::Create(FeatureLevel, GetMaxVertexCount(), GetMaxIndexCount(), GetRenderSettings()));
+        SlotMaterials.Add(BaseMaterial ? UMaterialInstanceDynamic::Create(BaseMaterial, this) : nullptr);
+        SlotTextures.Add(nullptr);
+        SlotBounds.Add(FBox(ForceInit));
+    }
+    FrameWindow.Configure(WindowSize);
+
+    TArray<int32> Offsets;
+    GetInstanceOffsets(Offsets);
+    FrameWindow.AssignInstances(Offsets, InstanceSlots);
+    return true;
+}
+
+void USVFInstancedComponent::GenerateMesh()
+{
+    if (!LastFrameData.IsValid())
+    {
+        return;
+    }
+
+    FSVFFrameInfo FrameInfo;
+    LastFrameData->GetFrameInfo(FrameInfo);
+    if (FrameInfo.frameId <= 0)
+    {
+        return;
+    }
+
+    if (InitSlots())
+    {
+        // The proxy holds the previous slots
+        MarkRenderStateDirty();
+    }
+    const int32 Slot = FrameWindow.Push(FrameInfo.frameId);
+    SlotBounds[Slot] = FrameInfo.Bounds;
+    LastVerticesNum = FrameInfo.vertexCount;
+    LastIndicesNum = FrameInfo.indexCount;
+
+    SlotRenderData[Slot]->Update(LastFrameData);
+
+    // Every slot needs the texture of its own frame, so it is copied on every frame
+    UpdateSlotTexture(Slot);
+    UpdateInstanceSlots();
+}
+
+void USVFInstancedComponent::UpdateSlotTexture(int32 Slot)
+{
+    if (DisableUpdateTexture || !SlotTextures.IsValidIndex(Slot))
+    {
+        return;
+    }
+
+    EPixelFormat TextureFormat;
+    int32 Width = 0;
+    int32 Height = 0;
+    if (!LastFrameData->GetTextureInfo(TextureFormat, Width, Height))
+    {
+        return;
+    }
+
+    UTexture2D*& Texture = SlotTextures[Slot];
+    if (!Texture || Width != Texture->GetSizeX() || Height != Texture->GetSizeY())
+    {
+        Texture = UTexture2D::CreateTransient(Width, Height, TextureFormat);
+        Texture->UpdateResource();
+#if PLATFORM_ANDROID
+        Cast<USVFReaderAndroid>(SVFReader)->EnqueueSetUnrealTexture(Texture);
+#endif
+        if (SlotMaterials[Slot])
+        {
+            SlotMaterials[Slot]->SetTextureParameterValue(TEXT("Texture"), Texture);
+        }
+    }
+    if (!LastFrameData->CopyTextureBuffer(Texture, bUseHardwareTextureCopy))
+    {
+        WarnSVF("Unexpected texture copy failure.");
+    }
+}
+
+void USVFInstancedComponent::UpdateInstanceSlots()
+{
+    TArray<int32> Offsets;
+    GetInstanceOffsets(Offsets);
+    FrameWindow.AssignInstances(Offsets, InstanceSlots);
+
+    if (SceneProxy)
+    {
+        FSVFInstancedMeshSceneProxy* LocalSceneProxy = (FSVFInstancedMeshSceneProxy*)SceneProxy;
+        TArray<int32> LocalInstanceSlots = InstanceSlots;
+        TArray<FBox> LocalSlotBounds = SlotBounds;
+        ENQUEUE_RENDER_COMMAND(FSVFInstancedMeshSetSlots)(
+            [LocalSceneProxy, LocalInstanceSlots, LocalSlotBounds](FRHICommandListImmediate& RHICmdList)
+            {
+                LocalSceneProxy->SetInstanceSlots_RenderThread(LocalInstanceSlots, LocalSlotBounds);
+            }
+        );
+    }
+}
+
+void USVFInstancedComponent::GetInstanceOffsets(TArray<int32>& OutOffsets) const
+{
+    OutOffsets.Reset(FMath::Max(1, Instances.Num()));
+    for (const FSVFInstance& Instance : Instances)
+    {
+        OutOffsets.Add(Instance.FrameOffset);
+    }
+    if (Instances.Num() == 0)
+    {
+        OutOffsets.Add(0);
+    }
+}
+
+void USVFInstancedComponent::GetInstanceTransforms(TArray<FMatrix>& OutTransforms) const
+{
+    OutTransforms.Reset(FMath::Max(1, Instances.Num()));
+    for (const FSVFInstance& Instance : Instances)
+    {
+        OutTransforms.Add(Instance.Transform.ToMatrixWithScale());
+    }
+    if (Instances.Num() == 0)
+    {
+        OutTransforms.Add(FMatrix::Identity);
+    }
+}
+
+FBoxSphereBounds USVFInstancedComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+    TArray<FMatrix> Transforms;
+    GetInstanceTransforms(Transforms);
+
+    FBox Bounds(ForceInit);
+    for (int32 Instance = 0; Instance < Transforms.Num(); Instance++)
+    {
+        const int32 Slot = InstanceSlots.IsValidIndex(Instance) ? InstanceSlots[Instance] : INDEX_NONE;
+        if (SlotBounds.IsValidIndex(Slot) && SlotBounds[Slot].IsValid)
+        {
+            Bounds += SlotBounds[Slot].TransformBy(Transforms[Instance]);
+        }
+    }
+    if (!Bounds.IsValid)
+    {
+        return FBoxSphereBounds(FVector::ZeroVector, FVector::ZeroVector, 1).TransformBy(LocalToWorld);
+    }
+    return FBoxSphereBounds(Bounds).TransformBy(LocalToWorld);
+}
+
+void USVFInstancedComponent::GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials) const
+{
+    Super::GetUsedMaterials(OutMaterials, bGetDebugMaterials);
+    for (UMaterialInstanceDynamic* SlotMaterial : SlotMaterials)
+    {
+        if (SlotMaterial)
+        {
+            OutMaterials.AddUnique(SlotMaterial);
+        }
+    }
+}
+
+#undef LogSVF
+#undef WarnSVF
+#undef FatalSVF
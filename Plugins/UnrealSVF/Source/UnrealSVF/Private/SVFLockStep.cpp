@@ -0,0 +1,109 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFLockStep.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+
+namespace SVFLockStep
+{
+    // Polling interval while waiting for the decoder
+    const float PollInterval = 0.001f;
+    // Output times this close below a frame boundary belong to the next frame (accumulated step error)
+    const double BoundaryTolerance = 1e-4;
+}
+
+FSVFLockStepController::FSVFLockStepController()
+    : FrameDuration(0.0)
+    , TimeoutSeconds(DefaultTimeoutSeconds)
+{
+    SetTimeSource(nullptr, nullptr);
+    Reset();
+}
+
+void FSVFLockStepController::SetTimeSource(TFunction<double()> InNow, TFunction<void(float)> InSleep)
+{
+    Now = InNow ? MoveTemp(InNow) : TFunction<double()>([]() { return FPlatformTime::Seconds(); });
+    SleepFor = InSleep ? MoveTemp(InSleep) : TFunction<void(float)>([](float Seconds) { FPlatformProcess::Sleep(Seconds); });
+}
+
+void FSVFLockStepController::Reset(double InOutputTime)
+{
+    OutputTime = FMath::Max(0.0, InOutputTime);
+    CurrentFrame = INDEX_NONE;
+    bStarted = false;
+}
+
+void FSVFLockStepController::Advance(double StepSeconds)
+{
+    // The first step shows the frame at the reset time
+    if (bStarted)
+    {
+        OutputTime += FMath::Max(0.0, StepSeconds);
+    }
+    bStarted = true;
+}
+
+int32 FSVFLockStepController::GetTargetFrame() const
+{
+    if (FrameDuration <= 0.0)
+    {
+        return INDEX_NONE;
+    }
+    return FMath::FloorToInt(OutputTime / FrameDuration + SVFLockStep::BoundaryTolerance);
+}
+
+ESVFLockStepResult FSVFLockStepController::WaitForTargetFrame(FFetchFrame FetchFrame)
+{
+    return FetchUntilTarget(FetchFrame, nullptr);
+}
+
+ESVFLockStepResult FSVFLockStepController::WaitForTargetFrame(FFetchFrame FetchFrame, FRestartStream RestartStream)
+{
+    return FetchUntilTarget(FetchFrame, &RestartStream);
+}
+
+ESVFLockStepResult FSVFLockStepController::FetchUntilTarget(FFetchFrame FetchFrame, const FRestartStream* RestartStream)
+{
+    int32 TargetFrame = GetTargetFrame();
+    if (TargetFrame == INDEX_NONE || CurrentFrame >= TargetFrame)
+    {
+        return ESVFLockStepResult::CurrentFrame;
+    }
+
+    const double Deadline = Now() + TimeoutSeconds;
+    bool bFetchedAny = false;
+    while (true)
+    {
+        int32 FrameIndex = INDEX_NONE;
+        bool bEndOfStream = false;
+        if (FetchFrame(FrameIndex, bEndOfStream))
+        {
+            // Frames before the target are decoded and passed over, never dropped by timing
+            bFetchedAny = true;
+            CurrentFrame = FrameIndex;
+            if (CurrentFrame >= TargetFrame)
+            {
+                return ESVFLockStepResult::NewFrame;
+            }
+        }
+        if (bEndOfStream)
+        {
+            // The last frame seen tells the clip's length; without one since the last restart the
+            // clip is empty and looping would never get anywhere
+            if (!RestartStream || CurrentFrame == INDEX_NONE || !(*RestartStream)())
+            {
+                return bFetchedAny ? ESVFLockStepResult::NewFrame : ESVFLockStepResult::EndOfStream;
+            }
+            OutputTime = FMath::Max(0.0, OutputTime - (CurrentFrame + 1) * FrameDuration);
+            CurrentFrame = INDEX_NONE;
+            TargetFrame = GetTargetFrame();
+            continue;
+        }
+        if (Now() >= Deadline)
+        {
+            // Frames fetched so far are still valid, GetCurrentFrame tells how far decode got
+            return ESVFLockStepResult::TimedOut;
+        }
+        SleepFor(SVFLockStep::PollInterval);
+    }
+}
@@ -0,0 +1,82 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFLoopSeam.h"
+
+FSVFLoopSeamScheduler::FSVFLoopSeamScheduler()
+    : LoopDuration(0)
+    , FrameDuration(0)
+    , LeadTime(0)
+{
+    Reset();
+}
+
+void FSVFLoopSeamScheduler::Configure(int32 InFrameCount, int64 InLoopDuration, int64 InLeadTime)
+{
+    LoopDuration = FMath::Max<int64>(0, InLoopDuration);
+    FrameDuration = InFrameCount > 0 ? LoopDuration / InFrameCount : 0;
+    LeadTime = FMath::Max<int64>(0, InLeadTime);
+    Reset();
+}
+
+void FSVFLoopSeamScheduler::Reset()
+{
+    bTailReached = false;
+    bStandbyRequested = false;
+}
+
+ESVFLoopSeamAction FSVFLoopSeamScheduler::Update(int64 PresentationTime, ESVFLoopStandbyState StandbyState)
+{
+    if (LoopDuration <= 0 || FrameDuration <= 0)
+    {
+        // Unknown clip length, nothing to schedule ahead
+        if (bTailReached)
+        {
+            Reset();
+            return ESVFLoopSeamAction::RestartSource;
+        }
+        return ESVFLoopSeamAction::None;
+    }
+
+    if (!bStandbyRequested && StandbyState == ESVFLoopStandbyState::None &&
+        PresentationTime >= LoopDuration - LeadTime)
+    {
+        bStandbyRequested = true;
+        return ESVFLoopSeamAction::PrepareStandby;
+    }
+
+    if (!bTailReached)
+    {
+        return ESVFLoopSeamAction::None;
+    }
+
+    switch (StandbyState)
+    {
+    case ESVFLoopStandbyState::Ready:
+        // Keep the last frame up for its full duration
+        if (PresentationTime >= LoopDuration)
+        {
+            Reset();
+            return ESVFLoopSeamAction::SwitchToStandby;
+        }
+        return ESVFLoopSeamAction::None;
+    case ESVFLoopStandbyState::Preparing:
+        // Still faster than a restart unless the standby is hopelessly late
+        if (PresentationTime < LoopDuration + LeadTime)
+        {
+            return ESVFLoopSeamAction::None;
+        }
+        // fallthrough
+    default:
+        Reset();
+        return ESVFLoopSeamAction::RestartSource;
+    }
+}
+
+void FSVFLoopSeamScheduler::OnFramePresented(int64 FrameTimestamp, bool bEndOfStream)
+{
+    // Half a frame of slack, FrameDuration is truncated and timestamps are rounded by the encoder
+    if (bEndOfStream || (FrameDuration > 0 && FrameTimestamp + FrameDuration / 2 >= LoopDuration - FrameDuration))
+    {
+        bTailReached = true;
+    }
+}
@@ -0,0 +1,399 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFMeshBVH.h"
+
+namespace SVFMeshBVH
+{
+    float HalfArea(const FVector& Size)
+    {
+        return Size.X * Size.Y + Size.Y * Size.Z + Size.Z * Size.X;
+    }
+
+    float HalfArea(const FBox& Box)
+    {
+        return Box.IsValid ? HalfArea(Box.GetSize()) : 0.f;
+    }
+
+    // Entry time of the ray into the box, or a negative value if it misses within [0, MaxTime]
+    float IntersectBox(const FVector& Min, const FVector& Max, const FVector& Start, const FVector& InvDir, float MaxTime)
+    {
+        const FVector T0 = (Min - Start) * InvDir;
+        const FVector T1 = (Max - Start) * InvDir;
+        const float Near = FMath::Max3(FMath::Min(T0.X, T1.X), FMath::Min(T0.Y, T1.Y), FMath::Min(T0.Z, T1.Z));
+        const float Far = FMath::Min3(FMath::Max(T0.X, T1.X), FMath::Max(T0.Y, T1.Y), FMath::Max(T0.Z, T1.Z));
+        return (Near <= Far && Far >= 0.f && Near <= MaxTime) ? FMath::Max(Near, 0.f) : -1.f;
+    }
+
+    float SquaredDistanceToBox(const FVector& Min, const FVector& Max, const FVector& Point)
+    {
+        const FVector Outside = (Min - Point).ComponentMax(Point - Max).ComponentMax(FVector::ZeroVector);
+        return Outside.SizeSquared();
+    }
+}
+
+void FSVFMeshBVH::Build(TArray<FVector>&& InPositions, const TArray<int32>& Indices)
+{
+    Positions = MoveTemp(InPositions);
+    Triangles.Reset(Indices.Num());
+    Nodes.Reset();
+
+    // Compact the valid triangles, the tree then sorts them through Order
+    const int32 NumVertices = Positions.Num();
+    for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+    {
+        const int32 A = Indices[Index + 0];
+        const int32 B = Indices[Index + 1];
+        const int32 C = Indices[Index + 2];
+        if (A >= 0 && A < NumVertices && B >= 0 && B < NumVertices && C >= 0 && C < NumVertices)
+        {
+            Triangles.Add(A);
+            Triangles.Add(B);
+            Triangles.Add(C);
+        }
+    }
+
+    const int32 NumTriangles = Triangles.Num() / 3;
+    if (NumTriangles == 0)
+    {
+        return;
+    }
+
+    Centroids.SetNumUninitialized(NumTriangles, false);
+    Order.SetNumUninitialized(NumTriangles, false);
+    for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+    {
+        Centroids[Triangle] = (Positions[Triangles[Triangle * 3 + 0]] + Positions[Triangles[Triangle * 3 + 1]] +
+            Positions[Triangles[Triangle * 3 + 2]]) / 3.f;
+        Order[Triangle] = Triangle;
+    }
+
+    // A binary tree with leaves of at least one triangle never has more nodes than this
+    Nodes.Reserve(2 * NumTriangles);
+    Nodes.AddUninitialized();
+    Subdivide(0, 0, NumTriangles);
+
+    // Store the triangles in leaf order so leaves address them directly
+    TArray<int32> SortedTriangles;
+    SortedTriangles.SetNumUninitialized(Triangles.Num(), false);
+    for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+    {
+        SortedTriangles[Triangle * 3 + 0] = Triangles[Order[Triangle] * 3 + 0];
+        SortedTriangles[Triangle * 3 + 1] = Triangles[Order[Triangle] * 3 + 1];
+        SortedTriangles[Triangle * 3 + 2] = Triangles[Order[Triangle] * 3 + 2];
+    }
+    Exchange(Triangles, SortedTriangles);
+}
+
+void FSVFMeshBVH::Subdivide(int32 NodeIndex, int32 First, int32 Count)
+{
+    FBox Bounds(ForceInit);
+    FBox CentroidBounds(ForceInit);
+    for (int32 Index = First; Index < First + Count; ++Index)
+    {
+        const int32 Triangle = Order[Index];
+        Bounds += Positions[Triangles[Triangle * 3 + 0]];
+        Bounds += Positions[Triangles[Triangle * 3 + 1]];
+        Bounds += Positions[Triangles[Triangle * 3 + 2]];
+        CentroidBounds += Centroids[Triangle];
+    }
+    Nodes[NodeIndex].Min = Bounds.Min;
+    Nodes[NodeIndex].Max = Bounds.Max;
+
+    const FVector CentroidSize = CentroidBounds.GetSize();
+    const int32 Axis = CentroidSize.X >= CentroidSize.Y ? (CentroidSize.X >= CentroidSize.Z ? 0 : 2) : (CentroidSize.Y >= CentroidSize.Z ? 1 : 2);
+    const float AxisMin = CentroidBounds.Min[Axis];
+    const float AxisSize = CentroidSize[Axis];
+    if (Count <= MaxTrianglesPerLeaf || AxisSize <= KINDA_SMALL_NUMBER)
+    {
+        // Small enough, or all centroids in one spot so no plane separates them
+        Nodes[NodeIndex].Offset = First;
+        Nodes[NodeIndex].Count = Count;
+        return;
+    }
+
+    // Bin the centroids along the longest axis and take the split with the lowest surface area cost
+    const float BinScale = NumBins / AxisSize;
+    auto GetBin = [this, Axis, AxisMin, BinScale](int32 Triangle)
+    {
+        return FMath::Min(static_cast<int32>((Centroids[Triangle][Axis] - AxisMin) * BinScale), NumBins - 1);
+    };
+
+    int32 BinCounts[NumBins] = {};
+    FBox BinBounds[NumBins];
+    for (FBox& BinBox : BinBounds)
+    {
+        BinBox.Init();
+    }
+    for (int32 Index = First; Index < First + Count; ++Index)
+    {
+        const int32 Triangle = Order[Index];
+        const int32 Bin = GetBin(Triangle);
+        ++BinCounts[Bin];
+        BinBounds[Bin] += Positions[Triangles[Triangle * 3 + 0]];
+        BinBounds[Bin] += Positions[Triangles[Triangle * 3 + 1]];
+        BinBounds[Bin] += Positions[Triangles[Triangle * 3 + 2]];
+    }
+
+    // Cost of the planes after bin 0 .. NumBins - 2, swept from the right then from the left
+    float RightCosts[NumBins];
+    FBox Sweep(ForceInit);
+    int32 SweepCount = 0;
+    for (int32 Bin = NumBins - 1; Bin > 0; --Bin)
+    {
+        Sweep += BinBounds[Bin];
+        SweepCount += BinCounts[Bin];
+        RightCosts[Bin - 1] = SweepCount * SVFMeshBVH::HalfArea(Sweep);
+    }
+    int32 SplitBin = INDEX_NONE;
+    float BestCost = MAX_flt;
+    Sweep.Init();
+    SweepCount = 0;
+    for (int32 Bin = 0; Bin < NumBins - 1; ++Bin)
+    {
+        Sweep += BinBounds[Bin];
+        SweepCount += BinCounts[Bin];
+        const float Cost = SweepCount * SVFMeshBVH::HalfArea(Sweep) + RightCosts[Bin];
+        if (SweepCount > 0 && SweepCount < Count && Cost < BestCost)
+        {
+            BestCost = Cost;
+            SplitBin = Bin;
+        }
+    }
+
+    int32 Middle = First;
+    if (SplitBin != INDEX_NONE)
+    {
+        int32 Last = First + Count - 1;
+        while (Middle <= Last)
+        {
+            if (GetBin(Order[Middle]) <= SplitBin)
+            {
+                ++Middle;
+            }
+            else
+            {
+                Swap(Order[Middle], Order[Last--]);
+            }
+        }
+    }
+    else
+    {
+        // Every centroid fell in one bin, fall back to halving the range by centroid
+        Sort(Order.GetData() + First, Count, [this, Axis](int32 A, int32 B) { return Centroids[A][Axis] < Centroids[B][Axis]; });
+        Middle = First + Count / 2;
+    }
+
+    const int32 LeftIndex = Nodes.AddUninitialized();
+    Subdivide(LeftIndex, First, Middle - First);
+    const int32 RightIndex = Nodes.AddUninitialized();
+    Subdivide(RightIndex, Middle, First + Count - Middle);
+    Nodes[NodeIndex].Offset = RightIndex;
+    Nodes[NodeIndex].Count = 0;
+}
+
+FBox FSVFMeshBVH::GetTriangleBounds(int32 First, int32 Count) const
+{
+    FBox Bounds(ForceInit);
+    for (int32 Index = First * 3; Index < (First + Count) * 3; ++Index)
+    {
+        Bounds += Positions[Triangles[Index]];
+    }
+    return Bounds;
+}
+
+bool FSVFMeshBVH::Refit(TArray<FVector>&& InPositions)
+{
+    if (InPositions.Num() != Positions.Num())
+    {
+        return false;
+    }
+    Positions = MoveTemp(InPositions);
+    RefitNodes();
+    return true;
+}
+
+bool FSVFMeshBVH::RefitFrom(const FSVFMeshBVH& Source, TArray<FVector>&& InPositions)
+{
+    if (InPositions.Num() != Source.Positions.Num())
+    {
+        return false;
+    }
+    Positions = MoveTemp(InPositions);
+    Triangles = Source.Triangles;
+    Nodes = Source.Nodes;
+    RefitNodes();
+    return true;
+}
+
+void FSVFMeshBVH::RefitNodes()
+{
+    // Children come after their parent, so walking backwards visits them first
+    for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; --NodeIndex)
+    {
+        FNode& Node = Nodes[NodeIndex];
+        if (Node.Count > 0)
+        {
+            const FBox Bounds = GetTriangleBounds(Node.Offset, Node.Count);
+            Node.Min = Bounds.Min;
+            Node.Max = Bounds.Max;
+        }
+        else
+        {
+            const FNode& Left = Nodes[NodeIndex + 1];
+            const FNode& Right = Nodes[Node.Offset];
+            Node.Min = Left.Min.ComponentMin(Right.Min);
+            Node.Max = Left.Max.ComponentMax(Right.Max);
+        }
+    }
+}
+
+FBox FSVFMeshBVH::GetBounds() const
+{
+    return Nodes.Num() > 0 ? FBox(Nodes[0].Min, Nodes[0].Max) : FBox(ForceInit);
+}
+
+bool FSVFMeshBVH::Raycast(const FVector& Start, const FVector& End, FSVFMeshRayHit& OutHit) const
+{
+    OutHit = FSVFMeshRayHit();
+    if (Nodes.Num() == 0)
+    {
+        return false;
+    }
+
+    const FVector Dir = End - Start;
+    // Axis parallel rays get a huge inverse so the slab test still orders correctly
+    const FVector InvDir(
+        FMath::Abs(Dir.X) > SMALL_NUMBER ? 1.f / Dir.X : BIG_NUMBER,
+        FMath::Abs(Dir.Y) > SMALL_NUMBER ? 1.f / Dir.Y : BIG_NUMBER,
+        FMath::Abs(Dir.Z) > SMALL_NUMBER ? 1.f / Dir.Z : BIG_NUMBER);
+
+    TArray<int32, TInlineAllocator<64>> Stack;
+    if (SVFMeshBVH::IntersectBox(Nodes[0].Min, Nodes[0].Max, Start, InvDir, OutHit.Time) >= 0.f)
+    {
+        Stack.Add(0);
+    }
+    while (Stack.Num() > 0)
+    {
+        const int32 NodeIndex = Stack.Pop(false);
+        const FNode& Node = Nodes[NodeIndex];
+        if (Node.Count > 0)
+        {
+            for (int32 Triangle = Node.Offset; Triangle < Node.Offset + Node.Count; ++Triangle)
+            {
+                // Moller-Trumbore, either winding
+                FVector A, B, C;
+                GetTriangle(Triangle, A, B, C);
+                const FVector Edge1 = B - A;
+                const FVector Edge2 = C - A;
+                const FVector P = Dir ^ Edge2;
+                const float Det = Edge1 | P;
+                if (FMath::Abs(Det) < SMALL_NUMBER)
+                {
+                    continue;
+                }
+                const float InvDet = 1.f / Det;
+                const FVector ToStart = Start - A;
+                const float U = (ToStart | P) * InvDet;
+                if (U < 0.f || U > 1.f)
+                {
+                    continue;
+                }
+                const FVector Q = ToStart ^ Edge1;
+                const float V = (Dir | Q) * InvDet;
+                if (V < 0.f || U + V > 1.f)
+                {
+                    continue;
+                }
+                const float Time = (Edge2 | Q) * InvDet;
+                if (Time >= 0.f && Time < OutHit.Time)
+                {
+                    OutHit.Time = Time;
+                    OutHit.Triangle = Triangle;
+                    OutHit.U = U;
+                    OutHit.V = V;
+                }
+            }
+            continue;
+        }
+
+        // Nearer child on top of the stack; boxes entered after the current hit are skipped
+        const int32 LeftIndex = NodeIndex + 1;
+        const int32 RightIndex = Node.Offset;
+        const float LeftTime = SVFMeshBVH::IntersectBox(Nodes[LeftIndex].Min, Nodes[LeftIndex].Max, Start, InvDir, OutHit.Time);
+        const float RightTime = SVFMeshBVH::IntersectBox(Nodes[RightIndex].Min, Nodes[RightIndex].Max, Start, InvDir, OutHit.Time);
+        const bool bLeftFirst = LeftTime >= 0.f && (RightTime < 0.f || LeftTime <= RightTime);
+        if (bLeftFirst)
+        {
+            if (RightTime >= 0.f)
+            {
+                Stack.Add(RightIndex);
+            }
+            Stack.Add(LeftIndex);
+        }
+        else if (RightTime >= 0.f)
+        {
+            if (LeftTime >= 0.f)
+            {
+                Stack.Add(LeftIndex);
+            }
+            Stack.Add(RightIndex);
+        }
+    }
+    return OutHit.Triangle != INDEX_NONE;
+}
+
+bool FSVFMeshBVH::ClosestPoint(const FVector& Center, float Radius, FVector& OutPoint, int32& OutTriangle) const
+{
+    OutTriangle = INDEX_NONE;
+    if (Nodes.Num() == 0 || Radius < 0.f)
+    {
+        return false;
+    }
+
+    // The search radius shrinks to the best distance found so far
+    float BestDistanceSquared = FMath::Square(Radius);
+    TArray<int32, TInlineAllocator<64>> Stack;
+    Stack.Add(0);
+    while (Stack.Num() > 0)
+    {
+        const int32 NodeIndex = Stack.Pop(false);
+        const FNode& Node = Nodes[NodeIndex];
+        if (SVFMeshBVH::SquaredDistanceToBox(Node.Min, Node.Max, Center) > BestDistanceSquared)
+        {
+            continue;
+        }
+        if (Node.Count > 0)
+        {
+            for (int32 Triangle = Node.Offset; Triangle < Node.Offset + Node.Count; ++Triangle)
+            {
+                FVector A, B, C;
+                GetTriangle(Triangle, A, B, C);
+                const FVector Point = FMath::ClosestPointOnTriangleToPoint(Center, A, B, C);
+                const float DistanceSquared = FVector::DistSquared(Point, Center);
+                if (DistanceSquared <= BestDistanceSquared)
+                {
+                    BestDistanceSquared = DistanceSquared;
+                    OutPoint = Point;
+                    OutTriangle = Triangle;
+                }
+            }
+            continue;
+        }
+
+        const int32 LeftIndex = NodeIndex + 1;
+        const int32 RightIndex = Node.Offset;
+        const float LeftDistance = SVFMeshBVH::SquaredDistanceToBox(Nodes[LeftIndex].Min, Nodes[LeftIndex].Max, Center);
+        const float RightDistance = SVFMeshBVH::SquaredDistanceToBox(Nodes[RightIndex].Min, Nodes[RightIndex].Max, Center);
+        if (LeftDistance <= RightDistance)
+        {
+            Stack.Add(RightIndex);
+            Stack.Add(LeftIndex);
+        }
+        else
+        {
+            Stack.Add(LeftIndex);
+            Stack.Add(RightIndex);
+        }
+    }
+    return OutTriangle != INDEX_NONE;
+}
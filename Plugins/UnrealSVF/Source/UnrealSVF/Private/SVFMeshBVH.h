@@ -0,0 +1,92 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Closest ray hit on a frame's triangles, in the local space the BVH was built in
+struct FSVFMeshRayHit
+{
+    // Fraction along the ray, 0 at the start and 1 at the end
+    float Time = 1.f;
+    int32 Triangle = INDEX_NONE;
+    // Barycentric weights of the triangle's second and third corner
+    float U = 0.f;
+    float V = 0.f;
+};
+
+// Bounding volume hierarchy over the triangles of one frame, for ray and sphere queries in local space.
+// Built top down with a binned surface area heuristic; frames of the same keyframe group only move
+// their vertices, so those refit the boxes bottom up and keep the tree. Not thread safe, a tree is
+// built or refit by one thread and only read afterwards.
+class FSVFMeshBVH
+{
+public:
+    static const int32 MaxTrianglesPerLeaf = 4;
+    static const int32 NumBins = 12;
+
+    // Takes the frame's vertex positions and triangle list; triangles with out of range indices are dropped
+    void Build(TArray<FVector>&& InPositions, const TArray<int32>& Indices);
+
+    // Moves the vertices of the same topology, false if the vertex count does not match the build
+    bool Refit(TArray<FVector>&& InPositions);
+    // Same as Refit, starting from another tree's topology so that tree can stay in use meanwhile
+    bool RefitFrom(const FSVFMeshBVH& Source, TArray<FVector>&& InPositions);
+
+    bool IsEmpty() const
+    {
+        return Nodes.Num() == 0;
+    }
+
+    int32 GetNumTriangles() const
+    {
+        return Triangles.Num() / 3;
+    }
+
+    int32 GetNumVertices() const
+    {
+        return Positions.Num();
+    }
+
+    FBox GetBounds() const;
+
+    // Closest hit of the segment Start to End, both faces of a triangle count
+    bool Raycast(const FVector& Start, const FVector& End, FSVFMeshRayHit& OutHit) const;
+
+    // Point on the triangles closest to Center, if any lies within Radius
+    bool ClosestPoint(const FVector& Center, float Radius, FVector& OutPoint, int32& OutTriangle) const;
+
+    // Corners of a triangle as stored, triangles are numbered in tree order
+    void GetTriangle(int32 Triangle, FVector& OutA, FVector& OutB, FVector& OutC) const
+    {
+        OutA = Positions[Triangles[Triangle * 3 + 0]];
+        OutB = Positions[Triangles[Triangle * 3 + 1]];
+        OutC = Positions[Triangles[Triangle * 3 + 2]];
+    }
+
+private:
+    struct FNode
+    {
+        FVector Min;
+        // Leaves: first triangle. Inner nodes: the second child, the first one directly follows the node.
+        int32 Offset;
+        FVector Max;
+        // Triangles in a leaf, 0 for inner nodes
+        int32 Count;
+    };
+
+    // Splits the triangles [First, First + Count) of the node and appends its children
+    void Subdivide(int32 NodeIndex, int32 First, int32 Count);
+    FBox GetTriangleBounds(int32 First, int32 Count) const;
+    void RefitNodes();
+
+    TArray<FVector> Positions;
+    // Vertex indices, three per triangle, sorted so every leaf is one range
+    TArray<int32> Triangles;
+    // Depth first, a child always comes after its parent
+    TArray<FNode> Nodes;
+
+    // Build scratch
+    TArray<FVector> Centroids;
+    TArray<int32> Order;
+};
@@ -0,0 +1,16 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFMeshBufferPool.h"
+
+namespace SVFMeshBufferPool
+{
+    // FSVFMeshVertexBuffer: float3 position, two packed normals and room for four half float UV pairs
+    const uint64 VertexBytes = 12 + 2 * 4 + 4 * 4;
+    const uint64 IndexBytes = 4;
+}
+
+uint64 FSVFMeshBufferSize::GetBytes() const
+{
+    return static_cast<uint64>(FMath::Max(0, NumVertices)) * SVFMeshBufferPool::VertexBytes +
+        static_cast<uint64>(FMath::Max(0, NumIndices)) * SVFMeshBufferPool::IndexBytes;
+}
@@ -0,0 +1,118 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Capacity of one set of mesh buffers
+struct FSVFMeshBufferSize
+{
+    int32 NumVertices = 0;
+    int32 NumIndices = 0;
+
+    FSVFMeshBufferSize() {}
+    FSVFMeshBufferSize(int32 InNumVertices, int32 InNumIndices)
+        : NumVertices(InNumVertices), NumIndices(InNumIndices) {}
+
+    bool Holds(const FSVFMeshBufferSize& Other) const
+    {
+        return NumVertices >= Other.NumVertices && NumIndices >= Other.NumIndices;
+    }
+
+    // GPU memory of the position, tangent, UV and index buffers
+    uint64 GetBytes() const;
+};
+
+// Free mesh buffer sets kept for reuse when components switch clips or are recreated. Acquire takes the
+// smallest matching set that holds the request and is at most MaxOversize times its size, so a small clip
+// does not pin a large set; Release evicts the oldest sets past the byte budget. Not thread safe.
+template <typename ItemType>
+class TSVFMeshBufferPool
+{
+public:
+    static constexpr float MaxOversize = 2.f;
+
+    void SetBudget(uint64 InBudgetBytes)
+    {
+        BudgetBytes = InBudgetBytes;
+    }
+
+    bool IsEnabled() const
+    {
+        return BudgetBytes > 0;
+    }
+
+    uint64 GetUsedBytes() const
+    {
+        return UsedBytes;
+    }
+
+    // Matches(Item) filters out sets made for other settings
+    template <typename MatchType>
+    bool Acquire(const FSVFMeshBufferSize& Needed, MatchType Matches, ItemType& OutItem)
+    {
+        const uint64 MaxBytes = static_cast<uint64>(Needed.GetBytes() * MaxOversize);
+        int32 Best = INDEX_NONE;
+        for (int32 Index = 0; Index < Entries.Num(); ++Index)
+        {
+            const FEntry& Entry = Entries[Index];
+            const uint64 Bytes = Entry.Size.GetBytes();
+            if (Entry.Size.Holds(Needed) && Bytes <= MaxBytes && Matches(Entry.Item) &&
+                (Best == INDEX_NONE || Bytes < Entries[Best].Size.GetBytes()))
+            {
+                Best = Index;
+            }
+        }
+        if (Best == INDEX_NONE)
+        {
+            return false;
+        }
+        OutItem = MoveTemp(Entries[Best].Item);
+        UsedBytes -= Entries[Best].Size.GetBytes();
+        Entries.RemoveAt(Best);
+        return true;
+    }
+
+    void Empty(TArray<ItemType>& OutItems)
+    {
+        for (FEntry& Entry : Entries)
+        {
+            OutItems.Add(MoveTemp(Entry.Item));
+        }
+        Entries.Empty();
+        UsedBytes = 0;
+    }
+
+    // False if the pool is off or the set alone is over budget, the caller frees Item then
+    bool Release(ItemType Item, const FSVFMeshBufferSize& Size, TArray<ItemType>& OutEvicted)
+    {
+        const uint64 Bytes = Size.GetBytes();
+        if (Bytes > BudgetBytes)
+        {
+            return false;
+        }
+        while (UsedBytes + Bytes > BudgetBytes && Entries.Num() > 0)
+        {
+            UsedBytes -= Entries[0].Size.GetBytes();
+            OutEvicted.Add(MoveTemp(Entries[0].Item));
+            Entries.RemoveAt(0);
+        }
+        FEntry& Entry = Entries.AddDefaulted_GetRef();
+        Entry.Item = MoveTemp(Item);
+        Entry.Size = Size;
+        UsedBytes += Bytes;
+        return true;
+    }
+
+private:
+    struct FEntry
+    {
+        ItemType Item;
+        FSVFMeshBufferSize Size;
+    };
+
+    // Oldest first
+    TArray<FEntry> Entries;
+    uint64 BudgetBytes = 0;
+    uint64 UsedBytes = 0;
+};
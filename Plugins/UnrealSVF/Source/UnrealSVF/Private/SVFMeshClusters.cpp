@@ -0,0 +1,72 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFMeshClusters.h"
+
+FIntVector FSVFMeshClusterBuilder::GetGridSize(const FBox& Bounds, int32 NumTriangles)
+{
+    const int32 TargetCells = NumTriangles / TargetTrianglesPerCluster;
+    if (TargetCells < 2)
+    {
+        return FIntVector(1, 1, 1);
+    }
+
+    // Edge of a cubic cell so that the bounds hold about TargetCells of them; flat meshes get a
+    // minimum thickness so the volume does not collapse to zero
+    const FVector Size = Bounds.GetSize();
+    const float MinExtent = FMath::Max(Size.GetMax() * 0.01f, KINDA_SMALL_NUMBER);
+    const FVector Extents = Size.ComponentMax(FVector(MinExtent));
+    const float CellEdge = FMath::Pow(Extents.X * Extents.Y * Extents.Z / TargetCells, 1.f / 3.f);
+
+    auto CellsAlong = [CellEdge](float Extent)
+    {
+        return FMath::Clamp(FMath::RoundToInt(Extent / CellEdge), 1, MaxCellsPerAxis);
+    };
+    return FIntVector(CellsAlong(Extents.X), CellsAlong(Extents.Y), CellsAlong(Extents.Z));
+}
+
+bool FSVFMeshClusterBuilder::IntersectsFrustum(const FBox& LocalBounds, const FMatrix& LocalToWorld, TArrayView<const FPlane> Planes)
+{
+    if (!LocalBounds.IsValid)
+    {
+        return false;
+    }
+
+    FVector Origin;
+    FVector Extent;
+    LocalBounds.TransformBy(LocalToWorld).GetCenterAndExtents(Origin, Extent);
+    for (const FPlane& Plane : Planes)
+    {
+        // Distance of the box's closest point in front of the plane
+        const float PushOut = FMath::Abs(Plane.X * Extent.X) + FMath::Abs(Plane.Y * Extent.Y) + FMath::Abs(Plane.Z * Extent.Z);
+        if (Plane.PlaneDot(Origin) > PushOut)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FSVFMeshClusterBuilder::GatherVisibleRanges(const TArray<FSVFMeshCluster>& Clusters, const FMatrix& LocalToWorld,
+    TArrayView<const FPlane> Planes, TArray<FSVFIndexRange>& OutRanges)
+{
+    OutRanges.Reset();
+    for (const FSVFMeshCluster& Cluster : Clusters)
+    {
+        if (!IntersectsFrustum(Cluster.Bounds, LocalToWorld, Planes))
+        {
+            continue;
+        }
+        if (OutRanges.Num() > 0)
+        {
+            FSVFIndexRange& Last = OutRanges.Last();
+            if (Last.FirstIndex + Last.NumTriangles * 3 == Cluster.FirstIndex)
+            {
+                Last.NumTriangles += Cluster.NumTriangles;
+                continue;
+            }
+        }
+        FSVFIndexRange& Range = OutRanges.AddDefaulted_GetRef();
+        Range.FirstIndex = Cluster.FirstIndex;
+        Range.NumTriangles = Cluster.NumTriangles;
+    }
+}
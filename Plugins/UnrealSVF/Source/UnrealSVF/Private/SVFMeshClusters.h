@@ -0,0 +1,173 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Contiguous triangles of an index buffer and the local space box around them
+struct FSVFMeshCluster
+{
+    FBox Bounds;
+    uint32 FirstIndex;
+    uint32 NumTriangles;
+};
+
+// Index range to draw, clusters next to each other in the index buffer are merged into one
+struct FSVFIndexRange
+{
+    uint32 FirstIndex;
+    uint32 NumTriangles;
+};
+
+// Splits a frame's triangles into spatial clusters so each view draws only the parts inside its frustum.
+// Triangles are bucketed by the grid cell holding their centroid, the grid sized to the mesh bounds so
+// cells are roughly cubic; the index buffer is reordered so every non-empty cell is one cluster.
+// Linear in the triangle count, scratch memory is kept between frames.
+class FSVFMeshClusterBuilder
+{
+public:
+    // Triangles aimed for per cluster; meshes below twice this stay a single cluster
+    static const int32 TargetTrianglesPerCluster = 2048;
+    static const int32 MaxCellsPerAxis = 8;
+
+    // Reorders Indices in place. GetPosition(VertexIndex) returns the local position of a vertex.
+    template <typename GetPositionType>
+    void Build(TArray<int32>& Indices, int32 NumVertices, GetPositionType GetPosition, TArray<FSVFMeshCluster>& OutClusters);
+
+    // Recomputes the bounds of clusters built earlier for the same indices, e.g. for later frames of a keyframe group
+    template <typename GetPositionType>
+    static void UpdateBounds(const TArray<int32>& Indices, int32 NumVertices, GetPositionType GetPosition, TArray<FSVFMeshCluster>& Clusters);
+
+    // Box against view frustum planes (normals pointing out), the box transformed by LocalToWorld first
+    static bool IntersectsFrustum(const FBox& LocalBounds, const FMatrix& LocalToWorld, TArrayView<const FPlane> Planes);
+
+    // Clusters intersecting the frustum, adjacent ones merged into a single range
+    static void GatherVisibleRanges(const TArray<FSVFMeshCluster>& Clusters, const FMatrix& LocalToWorld,
+        TArrayView<const FPlane> Planes, TArray<FSVFIndexRange>& OutRanges);
+
+private:
+    // Cells along each axis for a mesh of NumTriangles within Bounds
+    static FIntVector GetGridSize(const FBox& Bounds, int32 NumTriangles);
+
+    TArray<int32> TriangleCells;
+    TArray<int32> CellStarts;
+    TArray<FBox> CellBounds;
+    TArray<int32> SortedIndices;
+};
+
+template <typename GetPositionType>
+void FSVFMeshClusterBuilder::Build(TArray<int32>& Indices, int32 NumVertices, GetPositionType GetPosition, TArray<FSVFMeshCluster>& OutClusters)
+{
+    OutClusters.Reset();
+    const int32 NumTriangles = Indices.Num() / 3;
+    if (NumTriangles == 0)
+    {
+        return;
+    }
+
+    // Bounds of the referenced vertices, out of range indices are left to the draw as they are
+    FBox MeshBounds(ForceInit);
+    for (int32 Index = 0; Index < NumTriangles * 3; ++Index)
+    {
+        if (Indices[Index] >= 0 && Indices[Index] < NumVertices)
+        {
+            MeshBounds += GetPosition(Indices[Index]);
+        }
+    }
+
+    const FIntVector GridSize = MeshBounds.IsValid ? GetGridSize(MeshBounds, NumTriangles) : FIntVector(1, 1, 1);
+    const int32 NumCells = GridSize.X * GridSize.Y * GridSize.Z;
+    if (NumCells <= 1)
+    {
+        FSVFMeshCluster& Cluster = OutClusters.AddDefaulted_GetRef();
+        Cluster.Bounds = MeshBounds;
+        Cluster.FirstIndex = 0;
+        Cluster.NumTriangles = NumTriangles;
+        return;
+    }
+
+    const FVector CellScale = FVector(GridSize) / MeshBounds.GetSize().ComponentMax(FVector(KINDA_SMALL_NUMBER));
+    TriangleCells.SetNumUninitialized(NumTriangles, false);
+    CellStarts.Reset();
+    CellStarts.SetNumZeroed(NumCells + 1, false);
+    CellBounds.Reset();
+    CellBounds.SetNum(NumCells, false);
+    for (FBox& Bounds : CellBounds)
+    {
+        Bounds.Init();
+    }
+
+    // Cell of every triangle and the cell sizes
+    for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+    {
+        FVector Corners[3];
+        FVector Centroid = FVector::ZeroVector;
+        for (int32 Corner = 0; Corner < 3; ++Corner)
+        {
+            const int32 VertexIndex = Indices[Triangle * 3 + Corner];
+            Corners[Corner] = (VertexIndex >= 0 && VertexIndex < NumVertices) ? GetPosition(VertexIndex) : MeshBounds.Min;
+            Centroid += Corners[Corner];
+        }
+        const FVector Cell = (Centroid / 3.f - MeshBounds.Min) * CellScale;
+        const int32 X = FMath::Clamp(FMath::FloorToInt(Cell.X), 0, GridSize.X - 1);
+        const int32 Y = FMath::Clamp(FMath::FloorToInt(Cell.Y), 0, GridSize.Y - 1);
+        const int32 Z = FMath::Clamp(FMath::FloorToInt(Cell.Z), 0, GridSize.Z - 1);
+        const int32 CellIndex = (Z * GridSize.Y + Y) * GridSize.X + X;
+
+        TriangleCells[Triangle] = CellIndex;
+        ++CellStarts[CellIndex + 1];
+        CellBounds[CellIndex] += Corners[0];
+        CellBounds[CellIndex] += Corners[1];
+        CellBounds[CellIndex] += Corners[2];
+    }
+    for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+    {
+        CellStarts[CellIndex + 1] += CellStarts[CellIndex];
+    }
+
+    // Every cell becomes a cluster, empty cells are skipped
+    for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+    {
+        const int32 CellTriangles = CellStarts[CellIndex + 1] - CellStarts[CellIndex];
+        if (CellTriangles > 0)
+        {
+            FSVFMeshCluster& Cluster = OutClusters.AddDefaulted_GetRef();
+            Cluster.Bounds = CellBounds[CellIndex];
+            Cluster.FirstIndex = CellStarts[CellIndex] * 3;
+            Cluster.NumTriangles = CellTriangles;
+        }
+    }
+
+    // Counting sort of the triangles by cell, stable so the order inside a cell is kept
+    SortedIndices.SetNumUninitialized(Indices.Num(), false);
+    for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+    {
+        const int32 Destination = CellStarts[TriangleCells[Triangle]]++ * 3;
+        SortedIndices[Destination + 0] = Indices[Triangle * 3 + 0];
+        SortedIndices[Destination + 1] = Indices[Triangle * 3 + 1];
+        SortedIndices[Destination + 2] = Indices[Triangle * 3 + 2];
+    }
+    // A trailing partial triangle is not drawn either way, keep it where it was
+    for (int32 Index = NumTriangles * 3; Index < Indices.Num(); ++Index)
+    {
+        SortedIndices[Index] = Indices[Index];
+    }
+    Exchange(Indices, SortedIndices);
+}
+
+template <typename GetPositionType>
+void FSVFMeshClusterBuilder::UpdateBounds(const TArray<int32>& Indices, int32 NumVertices, GetPositionType GetPosition, TArray<FSVFMeshCluster>& Clusters)
+{
+    for (FSVFMeshCluster& Cluster : Clusters)
+    {
+        Cluster.Bounds.Init();
+        const int32 LastIndex = FMath::Min<int32>(Indices.Num(), Cluster.FirstIndex + Cluster.NumTriangles * 3);
+        for (int32 Index = Cluster.FirstIndex; Index < LastIndex; ++Index)
+        {
+            if (Indices[Index] >= 0 && Indices[Index] < NumVertices)
+            {
+                Cluster.Bounds += GetPosition(Indices[Index]);
+            }
+        }
+    }
+}
@@ -2,12 +2,18 @@
 
 #include "SVFMeshComponents.h"
 #include "SVFComponent.h"
+#include "SVFInstancedComponent.h"
 #include "UnrealSVF.h"
 #include "Misc/Paths.h"
 #include "SVFSimpleInterface.h"
+#include "SVFVertexStreamLayout.h"
 #include "DynamicMeshBuilder.h"
 #include "Engine/Engine.h"
 #include "LocalVertexFactory.h"
+#include "Rendering/ColorVertexBuffer.h"
+#include "Async/Async.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/ScopeLock.h"
 
 #include "Runtime/Launch/Resources/Version.h"
 #include "Runtime/Engine/Classes/PhysicsEngine/BodySetup.h"
@@ -22,11 +28,50 @@ DEFINE_LOG_CATEGORY_STATIC(LogSVFMeshComponents, Log, All);
 #include "SVFReaderAndroid.h"
 #endif // PLATFORM_ANDROID
 
-FSVFMeshVertexBuffer::FSVFMeshVertexBuffer(uint32 InNumTexCoords, uint32 InLightmapCoordinateIndex, bool InUse16bitTexCoord, uint32 InNumVertices) :
-    NumTexCoords(InNumTexCoords), LightmapCoordinateIndex(InLightmapCoordinateIndex), Use16bitTexCoord(InUse16bitTexCoord)
+namespace SVFMeshComponents
+{
+    // Tangent basis of every decoded vertex; only the normal (TangentZ) varies, and only in clips that carry normals
+    const FPackedNormal DefaultTangentX(FVector(1, 0, 0));
+    const FPackedNormal DefaultTangentZ(FVector4(0, 0, 1, 1));
+    // From 4.20 the local vertex factory can point every vertex at one colour, before it colours are per vertex
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 20
+    const bool bSharedColor = true;
+#else
+    const bool bSharedColor = false;
+#endif
+    // Memory kept in released mesh buffers for reuse, unless MeshBufferPoolMB says otherwise
+    const int32 DefaultMeshBufferPoolMB = 64;
+
+    // Render data of released streams, taken on the game thread and returned on the render thread
+    struct FRenderDataPool
+    {
+        FCriticalSection Lock;
+        TSVFMeshBufferPool<FSVFMeshRenderData*> Pool;
+
+        FRenderDataPool()
+        {
+            int32 PoolMB = DefaultMeshBufferPoolMB;
+            FString SectionBlock = GIsEditor ? TEXT("SVFSettings_Editor") : TEXT("SVFSettings");
+            GConfig->GetInt(*SectionBlock, TEXT("MeshBufferPoolMB"), PoolMB, GEngineIni);
+            Pool.SetBudget(static_cast<uint64>(FMath::Max(0, PoolMB)) * 1024 * 1024);
+        }
+    };
+
+    FRenderDataPool& GetRenderDataPool()
+    {
+        static FRenderDataPool Instance;
+        return Instance;
+    }
+}
+
+FSVFMeshVertexBuffer::FSVFMeshVertexBuffer(uint32 InNumTexCoords, uint32 InLightmapCoordinateIndex, bool InUse16bitTexCoord, uint32 InNumVertices,
+    bool InUseHalfPositions, bool InUseNormalizedTexCoords) :
+    NumTexCoords(InNumTexCoords), LightmapCoordinateIndex(InLightmapCoordinateIndex), Use16bitTexCoord(InUse16bitTexCoord),
+    UseHalfPositions(InUseHalfPositions), UseNormalizedTexCoords(InUseNormalizedTexCoords)
 {
     check(NumTexCoords > 0 && NumTexCoords <= MAX_STATIC_TEXCOORDS);
     check(LightmapCoordinateIndex < NumTexCoords);
+    check(!UseHalfPositions || SupportsHalfPositions());
     Vertices.SetNumUninitialized(InNumVertices);
 }
 
@@ -39,17 +84,19 @@ void FSVFMeshVertexBuffer::Reset(uint32 InNumVertices)
 
 void FSVFMeshVertexBuffer::InitRHI()
 {
-    uint32 TextureStride = sizeof(FVector2D);
+    const uint32 TextureStride = GetTexCoordStride();
     EPixelFormat TextureFormat = PF_G32R32F;
-
-    if (Use16bitTexCoord)
+    if (GetTexCoordFormat() == ESVFTexCoordFormat::UNorm16)
+    {
+        TextureFormat = PF_G16R16;
+    }
+    else if (GetTexCoordFormat() == ESVFTexCoordFormat::Half)
     {
-        TextureStride = sizeof(FVector2DHalf);
         TextureFormat = PF_G16R16F;
     }
 
     FRHIResourceCreateInfo PositionCreateInfo;
-    PositionBuffer.VertexBufferRHI = RHICreateVertexBuffer(sizeof(FVector) * Vertices.Num(),
+    PositionBuffer.VertexBufferRHI = RHICreateVertexBuffer(GetPositionStride() * Vertices.Num(),
         BUF_Static | BUF_ShaderResource, PositionCreateInfo);
     FRHIResourceCreateInfo TangentCreateInfo;
     TangentBuffer.VertexBufferRHI = RHICreateVertexBuffer(sizeof(FPackedNormal) * 2 * Vertices.Num(),
@@ -57,7 +104,7 @@ void FSVFMeshVertexBuffer::InitRHI()
     FRHIResourceCreateInfo TexCoordCreateInfo;
     TexCoordBuffer.VertexBufferRHI = RHICreateVertexBuffer(TextureStride * 4 * Vertices.Num(),
         BUF_Static | BUF_ShaderResource, TexCoordCreateInfo);
-#if PLATFORM_WINDOWS
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION <= 19
     FRHIResourceCreateInfo ColorCreateInfo;
     ColorBuffer.VertexBufferRHI = RHICreateVertexBuffer(sizeof(FColor) * Vertices.Num(),
         BUF_Static | BUF_ShaderResource, ColorCreateInfo);
@@ -67,66 +114,80 @@ void FSVFMeshVertexBuffer::InitRHI()
     {
 #if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION <= 19
         TangentBufferSRV = RHICreateShaderResourceView(TangentBuffer.VertexBufferRHI, 4, PF_R8G8B8A8);
+        ColorBufferSRV = RHICreateShaderResourceView(ColorBuffer.VertexBufferRHI, 4, PF_R8G8B8A8);
 #elif ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 20
         TangentBufferSRV = RHICreateShaderResourceView(TangentBuffer.VertexBufferRHI, 4, PF_R8G8B8A8_SNORM);
 #endif
         TexCoordBufferSRV = RHICreateShaderResourceView(TexCoordBuffer.VertexBufferRHI, TextureStride, TextureFormat);
         PositionBufferSRV = RHICreateShaderResourceView(PositionBuffer.VertexBufferRHI, sizeof(float), PF_R32_FLOAT);
-#if PLATFORM_WINDOWS
-        ColorBufferSRV = RHICreateShaderResourceView(ColorBuffer.VertexBufferRHI, 4, PF_R8G8B8A8);
-#endif
     }
 
+    // Clips without normals never touch the tangents again
+    WriteDefaultTangents();
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION <= 19
+    FColor* ColorBufferData = static_cast<FColor*>(
+        RHILockVertexBuffer(ColorBuffer.VertexBufferRHI, 0, sizeof(FColor) * Vertices.Num(), RLM_WriteOnly));
+    for (int32 i = 0; i < Vertices.Num(); i++)
+    {
+        ColorBufferData[i] = FColor::White;
+    }
+    RHIUnlockVertexBuffer(ColorBuffer.VertexBufferRHI);
+#endif
+
 #if PLATFORM_WINDOWS
     void* TexCoordBufferData = RHILockVertexBuffer(TexCoordBuffer.VertexBufferRHI,
         0, NumTexCoords * TextureStride * Vertices.Num(), RLM_WriteOnly);
-    FVector2D* TexCoordBufferData32 = !Use16bitTexCoord ? static_cast<FVector2D*>(TexCoordBufferData) : nullptr;
-    FVector2DHalf* TexCoordBufferData16 = Use16bitTexCoord ? static_cast<FVector2DHalf*>(TexCoordBufferData) : nullptr;
+    TArray<FVector2D> TexCoords;
+    TexCoords.SetNumUninitialized(NumTexCoords * Vertices.Num());
 
     // Copy the vertex data into the vertex buffers.
-    FVector* PositionBufferData = static_cast<FVector*>(
-        RHILockVertexBuffer(PositionBuffer.VertexBufferRHI,
-            0, sizeof(FVector) * Vertices.Num(), RLM_WriteOnly));
-    FPackedNormal* TangentBufferData = static_cast<FPackedNormal*>(
-        RHILockVertexBuffer(TangentBuffer.VertexBufferRHI,
-            0, 2 * sizeof(FPackedNormal) * Vertices.Num(), RLM_WriteOnly));
-    FColor* ColorBufferData = static_cast<FColor*>(
-        RHILockVertexBuffer(ColorBuffer.VertexBufferRHI,
-            0, sizeof(FColor) * Vertices.Num(), RLM_WriteOnly));
+    void* PositionBufferData = RHILockVertexBuffer(PositionBuffer.VertexBufferRHI,
+        0, GetPositionStride() * Vertices.Num(), RLM_WriteOnly);
+    FVector* PositionBufferData32 = !UseHalfPositions ? static_cast<FVector*>(PositionBufferData) : nullptr;
+    FSVFHalfPosition* PositionBufferData16 = UseHalfPositions ? static_cast<FSVFHalfPosition*>(PositionBufferData) : nullptr;
 
     for (int32 i = 0; i < Vertices.Num(); i++)
     {
-        PositionBufferData[i] = Vertices[i].Position;
-        TangentBufferData[2 * i + 0] = Vertices[i].TangentX;
-        TangentBufferData[2 * i + 1] = Vertices[i].TangentZ;
-        ColorBufferData[i] = Vertices[i].Color;
+        if (UseHalfPositions)
+        {
+            PositionBufferData16[i] = FSVFHalfPosition(Vertices[i].Position);
+        }
+        else
+        {
+            PositionBufferData32[i] = Vertices[i].Position;
+        }
 
         for (uint32 j = 0; j < NumTexCoords; j++)
         {
-            if (Use16bitTexCoord)
-            {
-                TexCoordBufferData16[NumTexCoords * i + j] = FVector2DHalf(Vertices[i].TextureCoordinate[j]);
-            }
-            else
-            {
-                TexCoordBufferData32[NumTexCoords * i + j] = Vertices[i].TextureCoordinate[j];
-            }
+            TexCoords[NumTexCoords * i + j] = Vertices[i].TextureCoordinate[j];
         }
     }
+    FSVFTexCoordPacker::Pack(TexCoords.GetData(), TexCoords.Num(), GetTexCoordFormat(), TexCoordBufferData);
 
     RHIUnlockVertexBuffer(PositionBuffer.VertexBufferRHI);
-    RHIUnlockVertexBuffer(TangentBuffer.VertexBufferRHI);
     RHIUnlockVertexBuffer(TexCoordBuffer.VertexBufferRHI);
-    RHIUnlockVertexBuffer(ColorBuffer.VertexBufferRHI);
 #endif
 }
 
+void FSVFMeshVertexBuffer::WriteDefaultTangents()
+{
+    FPackedNormal* TangentBufferData = static_cast<FPackedNormal*>(
+        RHILockVertexBuffer(TangentBuffer.VertexBufferRHI,
+            0, 2 * sizeof(FPackedNormal) * Vertices.Num(), RLM_WriteOnly));
+    for (int32 i = 0; i < Vertices.Num(); i++)
+    {
+        TangentBufferData[2 * i + 0] = SVFMeshComponents::DefaultTangentX;
+        TangentBufferData[2 * i + 1] = SVFMeshComponents::DefaultTangentZ;
+    }
+    RHIUnlockVertexBuffer(TangentBuffer.VertexBufferRHI);
+}
+
 void FSVFMeshVertexBuffer::ReleaseRHI()
 {
     PositionBufferSRV.SafeRelease();
     TexCoordBufferSRV.SafeRelease();
     TangentBufferSRV.SafeRelease();
-#if PLATFORM_WINDOWS
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION <= 19
     ColorBufferSRV.SafeRelease();
 #endif
 }
@@ -137,7 +198,7 @@ void FSVFMeshVertexBuffer::InitResource()
     PositionBuffer.InitResource();
     TangentBuffer.InitResource();
     TexCoordBuffer.InitResource();
-#if PLATFORM_WINDOWS
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION <= 19
     ColorBuffer.InitResource();
 #endif
 }
@@ -148,7 +209,7 @@ void FSVFMeshVertexBuffer::ReleaseResource()
     PositionBuffer.ReleaseResource();
     TangentBuffer.ReleaseResource();
     TexCoordBuffer.ReleaseResource();
-#if PLATFORM_WINDOWS
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION <= 19
     ColorBuffer.ReleaseResource();
 #endif
 }
@@ -160,76 +221,50 @@ void FSVFMeshVertexFactory::InitResource()
     ENQUEUE_RENDER_COMMAND(InitDynamicMeshVertexFactory)(
         [VertexFactory, SVFVertexBuffer](FRHICommandListImmediate& RHICmdList)
         {
+            // The factory outlives clips, so it is laid out for normals; without them the tangents hold the default basis
+            const FSVFVertexStreamLayout Layout = FSVFVertexStreamLayout::Build(SVFVertexBuffer->GetUseHalfPositions(),
+                SVFVertexBuffer->GetTexCoordFormat(), SVFVertexBuffer->GetNumTexCoords(), true, SVFMeshComponents::bSharedColor);
+            auto MakeComponent = [SVFVertexBuffer](const FSVFVertexStreamDesc& Desc, EVertexStreamUsage Usage)
+            {
+                const FVertexBuffer* Buffer = &GNullColorVertexBuffer;
+                switch (Desc.Buffer)
+                {
+                case ESVFVertexStreamBuffer::Position: Buffer = &SVFVertexBuffer->PositionBuffer; break;
+                case ESVFVertexStreamBuffer::Tangent: Buffer = &SVFVertexBuffer->TangentBuffer; break;
+                case ESVFVertexStreamBuffer::TexCoord: Buffer = &SVFVertexBuffer->TexCoordBuffer; break;
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION <= 19
+                case ESVFVertexStreamBuffer::Color: Buffer = &SVFVertexBuffer->ColorBuffer; break;
+#endif
+                default: break;
+                }
+                return FVertexStreamComponent(Buffer, Desc.Offset, Desc.Stride, Desc.Type, Usage);
+            };
+
             FDataType Data;
-            Data.PositionComponent = FVertexStreamComponent(
-                &SVFVertexBuffer->PositionBuffer,
-                0,
-                sizeof(FVector),
-                VET_Float3
-            );
+            Data.PositionComponent = MakeComponent(Layout.Position, EVertexStreamUsage::Default);
 
             Data.NumTexCoords = SVFVertexBuffer->GetNumTexCoords();
             {
                 Data.LightMapCoordinateIndex = SVFVertexBuffer->GetLightmapCoordinateIndex();
                 Data.TangentsSRV = SVFVertexBuffer->TangentBufferSRV;
                 Data.TextureCoordinatesSRV = SVFVertexBuffer->TexCoordBufferSRV;
-#if PLATFORM_WINDOWS
-                Data.ColorComponentsSRV = SVFVertexBuffer->ColorBufferSRV;
-#endif
                 Data.PositionComponentSRV = SVFVertexBuffer->PositionBufferSRV;
             }
             {
-                EVertexElementType UVDoubleWideVertexElementType = VET_None;
-                EVertexElementType UVVertexElementType = VET_None;
-                uint32 UVSizeInBytes = 0;
-                if (SVFVertexBuffer->GetUse16bitTexCoords())
+                for (const FSVFVertexStreamDesc& TexCoord : Layout.TexCoords)
                 {
-                    UVSizeInBytes = sizeof(FVector2DHalf);
-                    UVDoubleWideVertexElementType = VET_Half4;
-                    UVVertexElementType = VET_Half2;
-                }
-                else
-                {
-                    UVSizeInBytes = sizeof(FVector2D);
-                    UVDoubleWideVertexElementType = VET_Float4;
-                    UVVertexElementType = VET_Float2;
+                    Data.TextureCoordinates.Add(MakeComponent(TexCoord, EVertexStreamUsage::ManualFetch));
                 }
 
-                int32 UVIndex;
-                uint32 UvStride = UVSizeInBytes * SVFVertexBuffer->GetNumTexCoords();
-                for (UVIndex = 0; UVIndex < (int32)SVFVertexBuffer->GetNumTexCoords() - 1; UVIndex += 2)
-                {
-                    Data.TextureCoordinates.Add
-                    (
-                        FVertexStreamComponent(
-                            &SVFVertexBuffer->TexCoordBuffer,
-                            UVSizeInBytes * UVIndex,
-                            UvStride,
-                            UVDoubleWideVertexElementType,
-                            EVertexStreamUsage::ManualFetch
-                        )
-                    );
-                }
+                Data.TangentBasisComponents[0] = MakeComponent(Layout.TangentBasis[0], EVertexStreamUsage::ManualFetch);
+                Data.TangentBasisComponents[1] = MakeComponent(Layout.TangentBasis[1], EVertexStreamUsage::ManualFetch);
 
-                // possible last UV channel if we have an odd number
-                if (UVIndex < (int32)SVFVertexBuffer->GetNumTexCoords())
-                {
-                    Data.TextureCoordinates.Add(FVertexStreamComponent(
-                        &SVFVertexBuffer->TexCoordBuffer,
-                        UVSizeInBytes * UVIndex,
-                        UvStride,
-                        UVVertexElementType,
-                        EVertexStreamUsage::ManualFetch
-                    ));
-                }
-
-                Data.TangentBasisComponents[0] = FVertexStreamComponent(&SVFVertexBuffer->TangentBuffer,
-                    0, 2 * sizeof(FPackedNormal), VET_PackedNormal, EVertexStreamUsage::ManualFetch);
-                Data.TangentBasisComponents[1] = FVertexStreamComponent(&SVFVertexBuffer->TangentBuffer,
-                    sizeof(FPackedNormal), 2 * sizeof(FPackedNormal), VET_PackedNormal, EVertexStreamUsage::ManualFetch);
-#if PLATFORM_WINDOWS
-                Data.ColorComponent = FVertexStreamComponent(&SVFVertexBuffer->ColorBuffer,
-                    0, sizeof(FColor), VET_Color, EVertexStreamUsage::ManualFetch);
+                Data.ColorComponent = MakeComponent(Layout.Color, EVertexStreamUsage::ManualFetch);
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 20
+                Data.ColorComponentsSRV = GNullColorVertexBuffer.VertexBufferSRV;
+                Data.ColorIndexMask = 0;
+#else
+                Data.ColorComponentsSRV = SVFVertexBuffer->ColorBufferSRV;
 #endif
             }
             VertexFactory->SetData(Data);
@@ -238,53 +273,247 @@ void FSVFMeshVertexFactory::InitResource()
     FLocalVertexFactory::InitResource();
 }
 
-FSVFMeshSceneProxy::FSVFMeshSceneProxy(USVFComponent* Component)
-    : FPrimitiveSceneProxy(Component)
-    , VertexBuffer(1, 0, true, Component->GetMaxVertexCount())
-    , IndexBuffer(Component->GetMaxIndexCount())
-    , VertexFactory(GetScene().GetFeatureLevel(), &VertexBuffer)
-    , MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
-    , BodySetup(Component->GetBodySetup())
+FSVFMeshRenderData::FSVFMeshRenderData(ERHIFeatureLevel::Type InFeatureLevel, int32 InNumVertices, int32 InNumIndices,
+    const FSVFMeshRenderSettings& InSettings)
+    : VertexBuffer(1, 0, true, InNumVertices, InSettings.bHalfPrecisionPositions, InSettings.bNormalizedTexCoords)
+    , IndexBuffer(InNumIndices)
+    , VertexFactory(InFeatureLevel, &VertexBuffer)
+    , FeatureLevel(InFeatureLevel)
+    , Capacity(InNumVertices, InNumIndices)
+    , Stager(InSettings, VertexBuffer.GetNumTexCoords(), VertexBuffer.GetTexCoordFormat())
 {
-    TSharedPtr<FFrameData> FrameData = Component->GetLastFrameData();
-    if (FrameData.IsValid())
+}
+
+FSVFMeshRenderData::~FSVFMeshRenderData()
+{
+    check(IsInRenderingThread());
+    VertexBuffer.ReleaseResource();
+    IndexBuffer.ReleaseResource();
+    VertexFactory.ReleaseResource();
+    for (TUniquePtr<FSVFMeshIndexBuffer>& LODIndexBuffer : LODIndexBuffers)
     {
-        FSVFFrameInfo FrameInfo;
-        if (FrameData->GetFrameInfo(FrameInfo))
-        {
-            if (FrameInfo.frameId > 0)
+        LODIndexBuffer->ReleaseResource();
+    }
+}
+
+FSVFMeshRenderData::FPtr FSVFMeshRenderData::Create(ERHIFeatureLevel::Type InFeatureLevel, int32 InNumVertices, int32 InNumIndices,
+    const FSVFMeshRenderSettings& InSettings)
+{
+    FSVFMeshRenderData* Pooled = nullptr;
+    {
+        SVFMeshComponents::FRenderDataPool& RenderDataPool = SVFMeshComponents::GetRenderDataPool();
+        FScopeLock Lock(&RenderDataPool.Lock);
+        RenderDataPool.Pool.Acquire(FSVFMeshBufferSize(InNumVertices, InNumIndices),
+            [InFeatureLevel, &InSettings](const FSVFMeshRenderData* RenderData)
             {
-                // Copy verts
-                FrameData->GetFrameVertices(VertexBuffer.Vertices);
-                // Copy index buffer
-                FrameData->GetFrameIndices(IndexBuffer.Indices);
-                // Enqueue initialization of render resource
-                BeginInitResource(&VertexBuffer);
-                BeginInitResource(&IndexBuffer);
-                BeginInitResource(&VertexFactory);
-            }
+                return RenderData->FeatureLevel == InFeatureLevel && RenderData->Stager.GetSettings() == InSettings;
+            }, Pooled);
+    }
+    return Wrap(Pooled ? Pooled : new FSVFMeshRenderData(InFeatureLevel, InNumVertices, InNumIndices, InSettings));
+}
+
+FSVFMeshRenderData::FPtr FSVFMeshRenderData::Wrap(FSVFMeshRenderData* RenderData)
+{
+    // The last reference can be dropped by a component on the game thread or by a proxy on the render thread
+    return FPtr(RenderData, [](FSVFMeshRenderData* Released)
+    {
+        if (IsInRenderingThread())
+        {
+            Release_RenderThread(Released);
+        }
+        else
+        {
+            ENQUEUE_RENDER_COMMAND(FSVFMeshRenderDataRelease)(
+                [Released](FRHICommandListImmediate& RHICmdList)
+                {
+                    Release_RenderThread(Released);
+                });
         }
+    });
+}
+
+void FSVFMeshRenderData::Release_RenderThread(FSVFMeshRenderData* RenderData)
+{
+    check(IsInRenderingThread());
+    if (RenderData->bResourcesInitialized)
+    {
+        // Nothing is drawn from reused buffers until their next stream uploads a frame
+        RenderData->IndexBuffer.Indices.Reset();
+        RenderData->Clusters.Reset();
+        RenderData->LODClusters.Reset();
+        RenderData->NumReadyLODs = 0;
+        RenderData->VertexBuffer.WriteDefaultTangents();
     }
+    RenderData->Stager.Reset();
+    RenderData->Snapshots.Reset();
 
-    // Grab material
-    Material = Component->GetMaterial(0);
-    if (Material == NULL)
+    TArray<FSVFMeshRenderData*> Freed;
+    bool bPooled = false;
     {
-        Material = UMaterial::GetDefaultMaterial(MD_Surface);
+        SVFMeshComponents::FRenderDataPool& RenderDataPool = SVFMeshComponents::GetRenderDataPool();
+        FScopeLock Lock(&RenderDataPool.Lock);
+        bPooled = RenderDataPool.Pool.Release(RenderData, RenderData->Capacity, Freed);
+    }
+    if (!bPooled)
+    {
+        Freed.Add(RenderData);
+    }
+    for (FSVFMeshRenderData* FreedRenderData : Freed)
+    {
+        delete FreedRenderData;
+    }
+}
+
+void FSVFMeshRenderData::EmptyPool()
+{
+    TArray<FSVFMeshRenderData*> Pooled;
+    {
+        SVFMeshComponents::FRenderDataPool& RenderDataPool = SVFMeshComponents::GetRenderDataPool();
+        FScopeLock Lock(&RenderDataPool.Lock);
+        RenderDataPool.Pool.Empty(Pooled);
+    }
+    if (Pooled.Num() > 0)
+    {
+        ENQUEUE_RENDER_COMMAND(FSVFMeshRenderDataPoolEmpty)(
+            [Pooled](FRHICommandListImmediate& RHICmdList)
+            {
+                for (FSVFMeshRenderData* RenderData : Pooled)
+                {
+                    delete RenderData;
+                }
+            });
+        FlushRenderingCommands();
+    }
+}
+
+bool FSVFMeshRenderData::NeedsResize(int32 InNumVertices, int32 InNumIndices) const
+{
+    const FSVFMeshBufferSize Needed(InNumVertices, InNumIndices);
+    return !Capacity.Holds(Needed) ||
+        Capacity.GetBytes() > Needed.GetBytes() * TSVFMeshBufferPool<FSVFMeshRenderData*>::MaxOversize;
+}
+
+void FSVFMeshRenderData::EnsureCapacity_RenderThread(int32 InNumVertices, int32 InNumIndices)
+{
+    // Recreating the buffers stalls playback; the clip's maxima normally make this unnecessary
+    if (InNumVertices > Capacity.NumVertices)
+    {
+        WarnSVF("Resizing vertexBuffer from %d to %d", Capacity.NumVertices, InNumVertices);
+        VertexBuffer.Reset(InNumVertices);
+        Capacity.NumVertices = InNumVertices;
+    }
+    if (InNumIndices > Capacity.NumIndices)
+    {
+        WarnSVF("Resizing indexBuffer from %d to %d", Capacity.NumIndices, InNumIndices);
+        IndexBuffer.Reset(InNumIndices);
+        Capacity.NumIndices = InNumIndices;
+    }
+}
+
+bool FSVFMeshRenderData::GetVisibleRanges(const FSceneView* View, const FMatrix& LocalToWorld, int32 LOD, TArray<FSVFIndexRange>& OutRanges) const
+{
+    const TArray<FSVFMeshCluster>* ViewClusters = &Clusters;
+    if (LOD > 0)
+    {
+        ViewClusters = LODClusters.IsValidIndex(LOD - 1) ? &LODClusters[LOD - 1] : nullptr;
+    }
+    // Instanced stereo draws both eyes from one view, its frustum only covers the first
+    if (!ViewClusters || ViewClusters->Num() < 2 || View->IsInstancedStereoPass())
+    {
+        return false;
+    }
+#if ENGINE_MINOR_VERSION >= 26
+    // Shadow depth passes cull casters against the shadow frustum, which lives in pre-shadow translated space
+    if (const FConvexVolume* ShadowFrustum = View->GetDynamicMeshElementsShadowCullFrustum())
+    {
+        FSVFMeshClusterBuilder::GatherVisibleRanges(*ViewClusters, LocalToWorld.ConcatTranslation(View->GetPreShadowTranslation()),
+            ShadowFrustum->Planes, OutRanges);
+        return true;
+    }
+    FSVFMeshClusterBuilder::GatherVisibleRanges(*ViewClusters, LocalToWorld, View->ViewFrustum.Planes, OutRanges);
+    return true;
+#else
+    // Shadow passes cannot be told from regular views here, their casters may be outside the view frustum
+    return false;
+#endif
+}
+
+int32 FSVFMeshRenderData::GetLOD(const FSceneView* View, const FBoxSphereBounds& WorldBounds) const
+{
+    if (NumReadyLODs == 0)
+    {
+        return 0;
+    }
+    const float ScreenSize = ComputeBoundsScreenSize(WorldBounds.Origin, WorldBounds.SphereRadius, *View);
+    int32 LOD = 0;
+    while (LOD < NumReadyLODs && ScreenSize < Stager.GetSettings().LODScreenSizes[LOD])
+    {
+        ++LOD;
+    }
+    return LOD;
+}
+
+void FSVFMeshRenderData::Update(TSharedPtr<FFrameData> FrameData, int VertexCount, int IndexCount)
+{
+    if (!FrameData.IsValid())
+    {
+        return;
+    }
+
+    FPtr LocalRenderData = AsShared();
+#if PLATFORM_WINDOWS
+    // Decoding, conversion and reordering run on a worker, the render thread only copies the staged block
+    const uint32 Sequence = Stager.NextSequence();
+    Async(EAsyncExecution::TaskGraph, [LocalRenderData, FrameData, Sequence, VertexCount, IndexCount]()
+    {
+        FSVFMeshStagingBlockPtr Block = LocalRenderData->Stager.Stage(*FrameData, Sequence, VertexCount, IndexCount,
+            &LocalRenderData->Snapshots);
+        if (Block.IsValid())
+        {
+            ENQUEUE_RENDER_COMMAND(FSVFMeshUpload)(
+                [LocalRenderData, Block](FRHICommandListImmediate& RHICmdList)
+                {
+                    LocalRenderData->Upload_RenderThread(Block);
+                });
+        }
+    });
+#else
+    ENQUEUE_RENDER_COMMAND(FSVFMeshUpdate)(
+        [LocalRenderData, FrameData, VertexCount, IndexCount](FRHICommandListImmediate& RHICmdList)
+        {
+            LocalRenderData->Update_RenderThread(FrameData, VertexCount, IndexCount);
+        });
+#endif
+}
+
+void FSVFMeshRenderData::InitResources_RenderThread()
+{
+    if (!bResourcesInitialized)
+    {
+        VertexBuffer.InitResource();
+        IndexBuffer.InitResource();
+        VertexFactory.InitResource();
+        bResourcesInitialized = true;
     }
 }
 
-FSVFMeshSceneProxy::FSVFMeshSceneProxy(USVFComponent* Component, int InitialVertexCount, int InitialIndexCount)
+FSVFMeshSceneProxy::FSVFMeshSceneProxy(USVFComponent* Component)
     : FPrimitiveSceneProxy(Component)
-    , VertexBuffer(1, 0, false, InitialVertexCount)
-    , IndexBuffer(InitialIndexCount)
-    , VertexFactory(GetScene().GetFeatureLevel(), &VertexBuffer)
+    , RenderData(Component->GetRenderData(GetScene().GetFeatureLevel()))
     , MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
     , BodySetup(Component->GetBodySetup())
 {
-    BeginInitResource(&VertexBuffer);
-    BeginInitResource(&IndexBuffer);
-    BeginInitResource(&VertexFactory);
+    // Buffers are shared and may hold the current frame already; otherwise upload the last frame so a
+    // recreated proxy does not show an empty mesh until the next frame
+    TSharedPtr<FFrameData> FrameData = Component->GetLastFrameData();
+    if (FrameData.IsValid())
+    {
+        FSVFFrameInfo FrameInfo;
+        if (FrameData->GetFrameInfo(FrameInfo) && FrameInfo.frameId > 0)
+        {
+            RenderData->Update(FrameData);
+        }
+    }
 
     // Grab material
     Material = Component->GetMaterial(0);
@@ -296,9 +525,6 @@ FSVFMeshSceneProxy::FSVFMeshSceneProxy(USVFComponent* Component, int InitialVert
 
 FSVFMeshSceneProxy::~FSVFMeshSceneProxy()
 {
-    VertexBuffer.ReleaseResource();
-    IndexBuffer.ReleaseResource();
-    VertexFactory.ReleaseResource();
 }
 
 void FSVFMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
@@ -324,6 +550,7 @@ void FSVFMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>&
         Collector.RegisterOneFrameMaterialProxy(WireframeMaterialInstance);
     }
 
+    const FSVFMeshIndexBuffer& IndexBuffer = RenderData->IndexBuffer;
     if (IndexBuffer.Indices.Num() > 0 && IndexBuffer.IndexBufferRHI)
     {
 #if ENGINE_MINOR_VERSION < 22
@@ -332,33 +559,53 @@ void FSVFMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>&
         FMaterialRenderProxy* MaterialProxy = bWireframe ? WireframeMaterialInstance : Material->GetRenderProxy();
 #endif
 
+        TArray<FSVFIndexRange> VisibleRanges;
+
         // For each view..
         for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
         {
             if (VisibilityMap & (1 << ViewIndex))
             {
                 const FSceneView* View = Views[ViewIndex];
-                // Draw the mesh.
-                FMeshBatch& Mesh = Collector.AllocateMesh();
-                FMeshBatchElement& BatchElement = Mesh.Elements[0];
-                BatchElement.IndexBuffer = &IndexBuffer;
-                Mesh.bWireframe = bWireframe;
-                Mesh.VertexFactory = &VertexFactory;
-                Mesh.MaterialRenderProxy = MaterialProxy;
+                // Distant holograms draw a reduced index set
+                const int32 LOD = RenderData->GetLOD(View, GetBounds());
+                // Only the clusters inside this view's frustum, e.g. one viewport of several on an nDisplay node
+                const bool bClustered = RenderData->GetVisibleRanges(View, GetLocalToWorld(), LOD, VisibleRanges);
+                if (bClustered && VisibleRanges.Num() == 0)
+                {
+                    continue;
+                }
+                const FSVFMeshIndexBuffer& ViewIndexBuffer = RenderData->GetIndexBuffer(LOD);
+                if (!bClustered)
+                {
+                    VisibleRanges.Reset();
+                    VisibleRanges.Add({ 0, static_cast<uint32>(ViewIndexBuffer.Indices.Num() / 3) });
+                }
+
+                for (const FSVFIndexRange& Range : VisibleRanges)
+                {
+                    // Draw the mesh.
+                    FMeshBatch& Mesh = Collector.AllocateMesh();
+                    FMeshBatchElement& BatchElement = Mesh.Elements[0];
+                    BatchElement.IndexBuffer = &ViewIndexBuffer;
+                    Mesh.bWireframe = bWireframe;
+                    Mesh.VertexFactory = &RenderData->VertexFactory;
+                    Mesh.MaterialRenderProxy = MaterialProxy;
 #if ENGINE_MINOR_VERSION < 22
-                BatchElement.PrimitiveUniformBuffer = CreatePrimitiveUniformBufferImmediate(
-                    GetLocalToWorld(), GetBounds(), GetLocalBounds(), true, true);
+                    BatchElement.PrimitiveUniformBuffer = CreatePrimitiveUniformBufferImmediate(
+                        GetLocalToWorld(), GetBounds(), GetLocalBounds(), true, true);
 #endif
-                BatchElement.FirstIndex = 0;
-                BatchElement.NumPrimitives = IndexBuffer.Indices.Num() / 3;
-                BatchElement.MinVertexIndex = 0;
-                BatchElement.MaxVertexIndex = VertexBuffer.Vertices.Num() - 1;
-                //Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
-                Mesh.ReverseCulling = true;
-                Mesh.Type = PT_TriangleList;
-                Mesh.DepthPriorityGroup = SDPG_World;
-                Mesh.bCanApplyViewModeOverrides = false;
-                Collector.AddMesh(ViewIndex, Mesh);
+                    BatchElement.FirstIndex = Range.FirstIndex;
+                    BatchElement.NumPrimitives = Range.NumTriangles;
+                    BatchElement.MinVertexIndex = 0;
+                    BatchElement.MaxVertexIndex = RenderData->VertexBuffer.Vertices.Num() - 1;
+                    //Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+                    Mesh.ReverseCulling = true;
+                    Mesh.Type = PT_TriangleList;
+                    Mesh.DepthPriorityGroup = SDPG_World;
+                    Mesh.bCanApplyViewModeOverrides = false;
+                    Collector.AddMesh(ViewIndex, Mesh);
+                }
             }
         }
     }
@@ -407,37 +654,174 @@ SIZE_T FSVFMeshSceneProxy::GetTypeHash() const
     return reinterpret_cast<size_t>(&UniquePointer);
 }
 
+FSVFInstancedMeshSceneProxy::FSVFInstancedMeshSceneProxy(USVFInstancedComponent* Component)
+    : FPrimitiveSceneProxy(Component)
+    , Slots(Component->SlotRenderData)
+    , SlotBounds(Component->SlotBounds)
+    , InstanceSlots(Component->InstanceSlots)
+    , MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+{
+    Component->GetInstanceTransforms(InstanceTransforms);
+    for (UMaterialInstanceDynamic* SlotMaterial : Component->SlotMaterials)
+    {
+        SlotMaterials.Add(SlotMaterial ? SlotMaterial : UMaterial::GetDefaultMaterial(MD_Surface));
+    }
+}
+
+void FSVFInstancedMeshSceneProxy::SetInstanceSlots_RenderThread(const TArray<int32>& InInstanceSlots, const TArray<FBox>& InSlotBounds)
+{
+    check(IsInRenderingThread());
+    InstanceSlots = InInstanceSlots;
+    SlotBounds = InSlotBounds;
+}
+
+void FSVFInstancedMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
+    const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SVF_GetMeshElements);
+
+    const bool bWireframe = AllowDebugViewmodes() && ViewFamily.EngineShowFlags.Wireframe;
+
+    FColoredMaterialRenderProxy* WireframeMaterialInstance = NULL;
+    if (bWireframe)
+    {
+        WireframeMaterialInstance = new FColoredMaterialRenderProxy(
+#if ENGINE_MINOR_VERSION < 22
+            GEngine->WireframeMaterial ? GEngine->WireframeMaterial->GetRenderProxy(IsSelected()) : NULL,
+#else
+            GEngine->WireframeMaterial ? GEngine->WireframeMaterial->GetRenderProxy() : NULL,
+#endif
+            FLinearColor(0, 0.5f, 1.f)
+        );
+
+        Collector.RegisterOneFrameMaterialProxy(WireframeMaterialInstance);
+    }
+
+    TArray<FSVFIndexRange> VisibleRanges;
+    for (int32 Instance = 0; Instance < InstanceTransforms.Num(); Instance++)
+    {
+        const int32 Slot = InstanceSlots.IsValidIndex(Instance) ? InstanceSlots[Instance] : INDEX_NONE;
+        if (!Slots.IsValidIndex(Slot) || !Slots[Slot].IsValid() || !SlotBounds.IsValidIndex(Slot))
+        {
+            continue;
+        }
+        const FSVFMeshRenderData& SlotData = *Slots[Slot];
+        if (SlotData.IndexBuffer.Indices.Num() == 0 || !SlotData.IndexBuffer.IndexBufferRHI)
+        {
+            continue;
+        }
+
+#if ENGINE_MINOR_VERSION < 22
+        FMaterialRenderProxy* MaterialProxy = bWireframe ? WireframeMaterialInstance : SlotMaterials[Slot]->GetRenderProxy(IsSelected());
+#else
+        FMaterialRenderProxy* MaterialProxy = bWireframe ? WireframeMaterialInstance : SlotMaterials[Slot]->GetRenderProxy();
+#endif
+        const FMatrix InstanceToWorld = InstanceTransforms[Instance] * GetLocalToWorld();
+        const FBoxSphereBounds InstanceLocalBounds = SlotBounds[Slot].IsValid ?
+            FBoxSphereBounds(SlotBounds[Slot]) : GetLocalBounds();
+        const FBoxSphereBounds InstanceBounds = InstanceLocalBounds.TransformBy(InstanceToWorld);
+
+        for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+        {
+            if (VisibilityMap & (1 << ViewIndex))
+            {
+                const int32 LOD = SlotData.GetLOD(Views[ViewIndex], InstanceBounds);
+                const bool bClustered = SlotData.GetVisibleRanges(Views[ViewIndex], InstanceToWorld, LOD, VisibleRanges);
+                if (bClustered && VisibleRanges.Num() == 0)
+                {
+                    continue;
+                }
+                const FSVFMeshIndexBuffer& ViewIndexBuffer = SlotData.GetIndexBuffer(LOD);
+                if (!bClustered)
+                {
+                    VisibleRanges.Reset();
+                    VisibleRanges.Add({ 0, static_cast<uint32>(ViewIndexBuffer.Indices.Num() / 3) });
+                }
+
+                // Every instance gets its own transform through a primitive uniform buffer of its own
+#if ENGINE_MINOR_VERSION >= 22
+                FDynamicPrimitiveUniformBuffer& InstanceUniformBuffer =
+                    Collector.AllocateOneFrameResource<FDynamicPrimitiveUniformBuffer>();
+                InstanceUniformBuffer.Set(InstanceToWorld, InstanceToWorld, InstanceBounds, InstanceLocalBounds,
+                    true, false, false, false);
+#endif
+                for (const FSVFIndexRange& Range : VisibleRanges)
+                {
+                    FMeshBatch& Mesh = Collector.AllocateMesh();
+                    FMeshBatchElement& BatchElement = Mesh.Elements[0];
+                    BatchElement.IndexBuffer = &ViewIndexBuffer;
+                    Mesh.bWireframe = bWireframe;
+                    Mesh.VertexFactory = &SlotData.VertexFactory;
+                    Mesh.MaterialRenderProxy = MaterialProxy;
+#if ENGINE_MINOR_VERSION < 22
+                    BatchElement.PrimitiveUniformBuffer = CreatePrimitiveUniformBufferImmediate(
+                        InstanceToWorld, InstanceBounds, InstanceLocalBounds, true, true);
+#else
+                    BatchElement.PrimitiveUniformBufferResource = &InstanceUniformBuffer.UniformBuffer;
+#endif
+                    BatchElement.FirstIndex = Range.FirstIndex;
+                    BatchElement.NumPrimitives = Range.NumTriangles;
+                    BatchElement.MinVertexIndex = 0;
+                    BatchElement.MaxVertexIndex = SlotData.VertexBuffer.Vertices.Num() - 1;
+                    Mesh.ReverseCulling = true;
+                    Mesh.Type = PT_TriangleList;
+                    Mesh.DepthPriorityGroup = SDPG_World;
+                    Mesh.bCanApplyViewModeOverrides = false;
+                    Collector.AddMesh(ViewIndex, Mesh);
+                }
+            }
+        }
+    }
+
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+    for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+    {
+        if (VisibilityMap & (1 << ViewIndex))
+        {
+            RenderBounds(Collector.GetPDI(ViewIndex), ViewFamily.EngineShowFlags, GetBounds(), IsSelected());
+        }
+    }
+#endif
+}
+
+FPrimitiveViewRelevance FSVFInstancedMeshSceneProxy::GetViewRelevance(const FSceneView* View) const
+{
+    FPrimitiveViewRelevance Result;
+    Result.bDrawRelevance = IsShown(View);
+    Result.bShadowRelevance = IsShadowCast(View);
+    Result.bDynamicRelevance = true;
+    Result.bRenderInMainPass = ShouldRenderInMainPass();
+    Result.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
+    Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+    MaterialRelevance.SetPrimitiveViewRelevance(Result);
+    return Result;
+}
+
+SIZE_T FSVFInstancedMeshSceneProxy::GetTypeHash() const
+{
+    static size_t UniquePointer;
+    return reinterpret_cast<size_t>(&UniquePointer);
+}
+
 /**
  * Called on render thread to assign new dynamic data
  * Here we assume that this is not a new keyframe, and only update position/normals
  */
-void FSVFMeshSceneProxy::Update_RenderThread(TSharedPtr<FFrameData> FrameData, int VertexCount, int IndexCount)
+void FSVFMeshRenderData::Update_RenderThread(TSharedPtr<FFrameData> FrameData, int VertexCount, int IndexCount)
 {
     SCOPE_CYCLE_COUNTER(STAT_SVF_UpdateMeshElements);
 
     check(IsInRenderingThread());
     if (FrameData.IsValid())
     {
+        InitResources_RenderThread();
 #if PLATFORM_ANDROID
         FrameData->UnrealRenderEvent_RenderThread();
 #endif
         FSVFFrameInfo FrameInfo;
         if (FrameData->GetFrameInfo(FrameInfo) && FrameInfo.frameId > 0)
         {
-            if ((VertexCount > 0 && VertexCount > VertexBuffer.Vertices.Num()) ||
-                FrameInfo.vertexCount > VertexBuffer.Vertices.Num())
-            {
-                WarnSVF("Resizing vertexBuffer from %d to max of (%d, %d)",
-                    VertexBuffer.Vertices.Num(), VertexCount, FrameInfo.vertexCount);
-                VertexBuffer.Reset(FMath::Max(VertexCount, FrameInfo.vertexCount));
-            }
-            if ((IndexCount > 0 && IndexCount > IndexBuffer.Indices.Num()) ||
-                FrameInfo.indexCount > IndexBuffer.Indices.Num())
-            {
-                WarnSVF("Resizing indexBuffer from %d to max of (%d, %d)",
-                    IndexBuffer.Indices.Num(), IndexCount, FrameInfo.indexCount);
-                IndexBuffer.Reset(FMath::Max(IndexCount, FrameInfo.indexCount));
-            }
+            EnsureCapacity_RenderThread(FMath::Max(VertexCount, FrameInfo.vertexCount), FMath::Max(IndexCount, FrameInfo.indexCount));
 
             uint32 NumVertices = FrameInfo.vertexCount;
             uint32 NumIndicies = FrameInfo.indexCount;
@@ -448,6 +832,17 @@ void FSVFMeshSceneProxy::Update_RenderThread(TSharedPtr<FFrameData> FrameData, i
             {
                 FrameData->GetFrameIndices(IndexBuffer.Indices);
                 FrameData->GetFrameVertices(VertexBuffer.Vertices);
+                const bool bGenerateNormals = Stager.GetSettings().bGenerateNormals && !FrameData->HasNormals();
+                if (bGenerateNormals)
+                {
+                    Stager.GenerateNormals(FrameInfo, IndexBuffer.Indices, MakeArrayView(VertexBuffer.Vertices.GetData(), NumVertices));
+                }
+                const bool bHasNormals = FrameData->HasNormals() || bGenerateNormals;
+
+                FSVFFrameSnapshotSlot::FWritablePtr Snapshot = Snapshots.Allocate();
+                FSVFFrameSnapshotSlot::Fill(*Snapshot, FrameInfo.frameId, MakeArrayView(VertexBuffer.Vertices.GetData(), NumVertices),
+                    MakeArrayView(IndexBuffer.Indices.GetData(), NumIndicies), bHasNormals);
+                Snapshots.Publish(MoveTemp(Snapshot), ++SnapshotSequence);
 
                 // Update Index buffer
                 void* IndexBufferData = RHILockIndexBuffer(IndexBuffer.IndexBufferRHI,
@@ -457,58 +852,140 @@ void FSVFMeshSceneProxy::Update_RenderThread(TSharedPtr<FFrameData> FrameData, i
                 RHIUnlockIndexBuffer(IndexBuffer.IndexBufferRHI);
 
                 // Update Vertex, Tangent, TexCoord buffer
-                FVector* PositionBufferData = static_cast<FVector*>(
-                    RHILockVertexBuffer(VertexBuffer.PositionBuffer.VertexBufferRHI,
-                        0, sizeof(FVector) * NumVertices, RLM_WriteOnly));
-                FPackedNormal* TangentBufferData = static_cast<FPackedNormal*>(
+                const bool bHalfPositions = VertexBuffer.GetUseHalfPositions();
+                void* PositionBufferData = RHILockVertexBuffer(VertexBuffer.PositionBuffer.VertexBufferRHI,
+                    0, VertexBuffer.GetPositionStride() * NumVertices, RLM_WriteOnly);
+                FVector* PositionBufferData32 = !bHalfPositions ? static_cast<FVector*>(PositionBufferData) : nullptr;
+                FSVFHalfPosition* PositionBufferData16 = bHalfPositions ? static_cast<FSVFHalfPosition*>(PositionBufferData) : nullptr;
+                // Tangents stay as written at init unless the frame has normals. A write-only lock replaces the
+                // whole range, so the constant TangentX is written along with the normals.
+                FPackedNormal* TangentBufferData = bHasNormals ? static_cast<FPackedNormal*>(
                     RHILockVertexBuffer(VertexBuffer.TangentBuffer.VertexBufferRHI,
-                        0, 2 * sizeof(FPackedNormal) * NumVertices, RLM_WriteOnly));
+                        0, 2 * sizeof(FPackedNormal) * NumVertices, RLM_WriteOnly)) : nullptr;
 
+                // Coordinates are gathered here and converted to the buffer's format in one batch below
                 uint32 NumTexCoords = VertexBuffer.GetNumTexCoords();
-                bool Use16bitTexCoord = VertexBuffer.GetUse16bitTexCoords();
-
-                void* TexCoordBufferData = RHILockVertexBuffer(VertexBuffer.TexCoordBuffer.VertexBufferRHI,
-                    0, NumTexCoords * sizeof(FVector2D) * FrameInfo.vertexCount, RLM_WriteOnly);
-                FVector2D* TexCoordBufferData32 = !Use16bitTexCoord ?
-                    static_cast<FVector2D*>(TexCoordBufferData) : nullptr;
-                FVector2DHalf* TexCoordBufferData16 = Use16bitTexCoord ?
-                    static_cast<FVector2DHalf*>(TexCoordBufferData) : nullptr;
+                TexCoordScratch.SetNumUninitialized(NumTexCoords * NumVertices, false);
 
                 for (uint32 i = 0; i < NumVertices; i++)
                 {
-                    PositionBufferData[i] = VertexBuffer.Vertices[i].Position;
-                    TangentBufferData[2 * i + 0] = VertexBuffer.Vertices[i].TangentX;
-                    TangentBufferData[2 * i + 1] = VertexBuffer.Vertices[i].TangentZ;
+                    if (bHalfPositions)
+                    {
+                        PositionBufferData16[i] = FSVFHalfPosition(VertexBuffer.Vertices[i].Position);
+                    }
+                    else
+                    {
+                        PositionBufferData32[i] = VertexBuffer.Vertices[i].Position;
+                    }
+                    if (TangentBufferData)
+                    {
+                        TangentBufferData[2 * i + 0] = SVFMeshComponents::DefaultTangentX;
+                        TangentBufferData[2 * i + 1] = VertexBuffer.Vertices[i].TangentZ;
+                    }
 
                     for (uint32 j = 0; j < NumTexCoords; j++)
                     {
-                        if (Use16bitTexCoord)
-                        {
-                            TexCoordBufferData16[NumTexCoords * i + j] =
-                                FVector2DHalf(VertexBuffer.Vertices[i].TextureCoordinate[j]);
-                        }
-                        else
-                        {
-                            TexCoordBufferData32[NumTexCoords * i + j] =
-                                VertexBuffer.Vertices[i].TextureCoordinate[j];
-                        }
+                        TexCoordScratch[NumTexCoords * i + j] = VertexBuffer.Vertices[i].TextureCoordinate[j];
                     }
                 }
 
                 RHIUnlockVertexBuffer(VertexBuffer.PositionBuffer.VertexBufferRHI);
-                RHIUnlockVertexBuffer(VertexBuffer.TangentBuffer.VertexBufferRHI);
+                if (TangentBufferData)
+                {
+                    RHIUnlockVertexBuffer(VertexBuffer.TangentBuffer.VertexBufferRHI);
+                }
+
+                // Locks exactly the bytes written, the buffer's element size rather than a float pair's
+                void* TexCoordBufferData = RHILockVertexBuffer(VertexBuffer.TexCoordBuffer.VertexBufferRHI,
+                    0, TexCoordScratch.Num() * VertexBuffer.GetTexCoordStride(), RLM_WriteOnly);
+                FSVFTexCoordPacker::Pack(TexCoordScratch.GetData(), TexCoordScratch.Num(), VertexBuffer.GetTexCoordFormat(), TexCoordBufferData);
                 RHIUnlockVertexBuffer(VertexBuffer.TexCoordBuffer.VertexBufferRHI);
             }
         }
     }
 }
 
-void FSVFMeshVertexBuffer::GetPositionalVertices(TArray<FVector>& OutVertices, int32 VerticesCount) const
+void FSVFMeshRenderData::Upload_RenderThread(FSVFMeshStagingBlockPtr Block)
 {
-    for (int32 VertexIndex = 0; VertexIndex < VerticesCount; VertexIndex++)
+    SCOPE_CYCLE_COUNTER(STAT_SVF_UpdateMeshElements);
+
+    check(IsInRenderingThread());
+    InitResources_RenderThread();
+    // Workers can finish out of order
+    if (Block->Sequence <= LastUploadedSequence)
+    {
+        Stager.Recycle(MoveTemp(Block));
+        return;
+    }
+    LastUploadedSequence = Block->Sequence;
+
+    EnsureCapacity_RenderThread(Block->RequiredVertices, Block->RequiredIndices);
+
+    if (VertexBuffer.PositionBuffer.VertexBufferRHI &&
+        VertexBuffer.TangentBuffer.VertexBufferRHI &&
+        IndexBuffer.IndexBufferRHI)
     {
-        OutVertices.Push(Vertices[VertexIndex].Position);
+        auto CopyToVertexBuffer = [](FVertexBuffer& Buffer, const void* Data, uint32 Size)
+        {
+            void* BufferData = RHILockVertexBuffer(Buffer.VertexBufferRHI, 0, Size, RLM_WriteOnly);
+            FMemory::Memcpy(BufferData, Data, Size);
+            RHIUnlockVertexBuffer(Buffer.VertexBufferRHI);
+        };
+
+        const uint32 IndicesSize = Block->Indices.Num() * sizeof(int32);
+        void* IndexBufferData = RHILockIndexBuffer(IndexBuffer.IndexBufferRHI, 0, IndicesSize, RLM_WriteOnly);
+        FMemory::Memcpy(IndexBufferData, Block->Indices.GetData(), IndicesSize);
+        RHIUnlockIndexBuffer(IndexBuffer.IndexBufferRHI);
+
+        if (Block->HalfPositions.Num() > 0)
+        {
+            CopyToVertexBuffer(VertexBuffer.PositionBuffer, Block->HalfPositions.GetData(), Block->HalfPositions.Num() * sizeof(FSVFHalfPosition));
+        }
+        else
+        {
+            CopyToVertexBuffer(VertexBuffer.PositionBuffer, Block->Positions.GetData(), Block->Positions.Num() * sizeof(FVector));
+        }
+        // Tangents stay as written at init unless the clip carries normals
+        if (Block->Tangents.Num() > 0)
+        {
+            CopyToVertexBuffer(VertexBuffer.TangentBuffer, Block->Tangents.GetData(), Block->Tangents.Num() * sizeof(FPackedNormal));
+        }
+        CopyToVertexBuffer(VertexBuffer.TexCoordBuffer, Block->TexCoords.GetData(), Block->TexCoords.Num());
+
+        // The CPU side copies describe what is drawn; the block takes the previous arrays back for reuse
+        Exchange(IndexBuffer.Indices, Block->Indices);
+        Exchange(Clusters, Block->Clusters);
+
+        if (Block->TopologyGeneration != TopologyGeneration)
+        {
+            TopologyGeneration = Block->TopologyGeneration;
+            NumReadyLODs = 0;
+        }
+        const FSVFTopologyBuild* Build = Block->TopologyBuild.Get();
+        if (NumReadyLODs == 0 && Build && Build->Generation == TopologyGeneration && Build->LODIndices.Num() > 0)
+        {
+            for (int32 LOD = 0; LOD < Build->LODIndices.Num(); ++LOD)
+            {
+                if (!LODIndexBuffers.IsValidIndex(LOD))
+                {
+                    LODIndexBuffers.Add(MakeUnique<FSVFMeshIndexBuffer>(0));
+                }
+                FSVFMeshIndexBuffer& LODIndexBuffer = *LODIndexBuffers[LOD];
+                LODIndexBuffer.Indices = Build->LODIndices[LOD];
+                // InitRHI uploads the indices into a new static buffer
+                LODIndexBuffer.ReleaseResource();
+                LODIndexBuffer.InitResource();
+            }
+            NumReadyLODs = Build->LODIndices.Num();
+        }
+        // Cluster ranges refer to the LOD buffers of the block's build, which are the ones uploaded
+        Exchange(LODClusters, Block->LODClusters);
+        if (LODClusters.Num() != NumReadyLODs)
+        {
+            LODClusters.Reset();
+        }
     }
+    Stager.Recycle(MoveTemp(Block));
 }
 
 #undef LogSVF
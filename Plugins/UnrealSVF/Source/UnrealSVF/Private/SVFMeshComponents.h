@@ -4,6 +4,10 @@
 #include "Components/MeshComponent.h"
 #include "SVFClockInterface.h"
 #include "Interfaces/Interface_CollisionDataProvider.h"
+#include "SVFMeshClusters.h"
+#include "SVFMeshStaging.h"
+#include "SVFMeshBufferPool.h"
+#include "Async/Future.h"
 
 #if PLATFORM_WINDOWS
 #include "SVFReaderPassThrough.h"
@@ -20,6 +24,7 @@ THIRD_PARTY_INCLUDES_END
 #endif
 
 class USVFComponent;
+class USVFInstancedComponent;
 
 class FSVFMeshIndexBuffer : public FIndexBuffer
 {
@@ -75,20 +80,23 @@ public:
     FShaderResourceViewRHIRef PositionBufferSRV;
     FShaderResourceViewRHIRef TangentBufferSRV;
     FShaderResourceViewRHIRef TexCoordBufferSRV;
-
-#if PLATFORM_WINDOWS 
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION <= 19
+    // White for every vertex, written once; later engines share the null colour buffer's single entry
     FVertexBuffer ColorBuffer;
     FShaderResourceViewRHIRef ColorBufferSRV;
 #endif
 
-    FSVFMeshVertexBuffer(uint32 InNumTexCoords, uint32 InLightmapCoordinateIndex, bool InUse16bitTexCoord, uint32 InNumVertices);
+    FSVFMeshVertexBuffer(uint32 InNumTexCoords, uint32 InLightmapCoordinateIndex, bool InUse16bitTexCoord, uint32 InNumVertices,
+        bool InUseHalfPositions = false, bool InUseNormalizedTexCoords = false);
 
     void Reset(uint32 InNumVertices);
     virtual void InitRHI() override;
     virtual void ReleaseRHI() override;
     void InitResource() override;
     void ReleaseResource() override;
-    void GetPositionalVertices(TArray<FVector>& OutVertices, int32 VerticesCount) const;
+
+    // Every vertex facing the default way, until frames with normals are uploaded
+    void WriteDefaultTangents();
 
     const uint32 GetNumTexCoords() const
     {
@@ -104,10 +112,42 @@ public:
     {
         return Use16bitTexCoord;
     }
+
+    // Normalized coordinates are 16 bit as well, they replace the half floats
+    ESVFTexCoordFormat GetTexCoordFormat() const
+    {
+        return UseNormalizedTexCoords ? ESVFTexCoordFormat::UNorm16 :
+            Use16bitTexCoord ? ESVFTexCoordFormat::Half : ESVFTexCoordFormat::Float;
+    }
+
+    uint32 GetTexCoordStride() const
+    {
+        return FSVFTexCoordPacker::GetStride(GetTexCoordFormat());
+    }
+
+    // Positions are FSVFHalfPosition instead of FVector
+    const bool GetUseHalfPositions() const
+    {
+        return UseHalfPositions;
+    }
+
+    // Manual vertex fetch reads positions as three floats per vertex from the buffer view, which a half
+    // float stream cannot serve; there positions stay floats
+    static bool SupportsHalfPositions()
+    {
+        return !RHISupportsManualVertexFetch(GMaxRHIShaderPlatform);
+    }
+
+    uint32 GetPositionStride() const
+    {
+        return UseHalfPositions ? sizeof(FSVFHalfPosition) : sizeof(FVector);
+    }
 private:
     const uint32 NumTexCoords;
     const uint32 LightmapCoordinateIndex;
     const bool Use16bitTexCoord = true;
+    const bool UseHalfPositions = false;
+    const bool UseNormalizedTexCoords = false;
 };
 
 class FSVFMeshVertexFactory : public FLocalVertexFactory
@@ -124,18 +164,115 @@ private:
     FSVFMeshVertexBuffer* VertexBuffer;
 };
 
+/**
+ * GPU buffers and vertex factory of one SVF stream. Owned through a thread safe shared pointer so that every
+ * scene proxy drawing the stream (components sharing a stream, recreated proxies) uses the same buffers;
+ * once the last reference is dropped, the render thread keeps the buffers in a pool for the next stream
+ * they fit or releases them.
+ */
+class FSVFMeshRenderData : public TSharedFromThis<FSVFMeshRenderData, ESPMode::ThreadSafe>
+{
+public:
+
+    typedef TSharedPtr<FSVFMeshRenderData, ESPMode::ThreadSafe> FPtr;
+
+    // Reuses pooled buffers of a released stream when they fit, see MeshBufferPoolMB
+    static FPtr Create(ERHIFeatureLevel::Type InFeatureLevel, int32 InNumVertices, int32 InNumIndices,
+        const FSVFMeshRenderSettings& InSettings = FSVFMeshRenderSettings());
+
+    // Frees the pooled buffers, at module shutdown
+    static void EmptyPool();
+
+    // Vertices and indices the buffers hold without being recreated
+    const FSVFMeshBufferSize& GetCapacity() const
+    {
+        return Capacity;
+    }
+
+    // Whether a clip with these maxima should get buffers of its own: they do not fit, or waste too much
+    bool NeedsResize(int32 InNumVertices, int32 InNumIndices) const;
+
+    const FSVFMeshRenderSettings& GetSettings() const
+    {
+        return Stager.GetSettings();
+    }
+
+    // Game thread. Converts the frame on a worker and has the render thread copy the result into the buffers.
+    void Update(TSharedPtr<FFrameData> FrameData, int VertexCount = 0, int IndexCount = 0);
+
+    // Converts and uploads the frame on the render thread, for platforms whose frames can only be read there
+    void Update_RenderThread(TSharedPtr<FFrameData> FrameData, int VertexCount = 0, int IndexCount = 0);
+
+    // Copies a staged frame into the GPU buffers, older frames than the one drawn are dropped
+    void Upload_RenderThread(FSVFMeshStagingBlockPtr Block);
+
+    // Geometry of the latest frame, from any thread; null until the first frame is converted
+    FSVFFrameSnapshotPtr GetSnapshot() const
+    {
+        return Snapshots.Get();
+    }
+
+    // LOD to draw for the bounds' screen size in View, 0 is the full mesh
+    int32 GetLOD(const FSceneView* View, const FBoxSphereBounds& WorldBounds) const;
+
+    // Index buffer of a LOD from GetLOD
+    const FSVFMeshIndexBuffer& GetIndexBuffer(int32 LOD) const
+    {
+        return LOD > 0 ? *LODIndexBuffers[LOD - 1] : IndexBuffer;
+    }
+
+    // Index ranges of the LOD's clusters View can see. Returns false if the whole LOD has to be drawn.
+    bool GetVisibleRanges(const FSceneView* View, const FMatrix& LocalToWorld, int32 LOD, TArray<FSVFIndexRange>& OutRanges) const;
+
+    FSVFMeshVertexBuffer VertexBuffer;
+    FSVFMeshIndexBuffer IndexBuffer;
+    FSVFMeshVertexFactory VertexFactory;
+
+    // Clusters of the frame in IndexBuffer, empty when clustering is off
+    TArray<FSVFMeshCluster> Clusters;
+    // Clusters of the frame in each LOD index buffer, empty when clustering is off or the LODs aren't ready
+    TArray<TArray<FSVFMeshCluster>> LODClusters;
+
+private:
+
+    FSVFMeshRenderData(ERHIFeatureLevel::Type InFeatureLevel, int32 InNumVertices, int32 InNumIndices, const FSVFMeshRenderSettings& InSettings);
+    ~FSVFMeshRenderData();
+
+    void InitResources_RenderThread();
+
+    // Wraps a new or pooled instance; the last reference hands it to the pool or deletes it on the render thread
+    static FPtr Wrap(FSVFMeshRenderData* RenderData);
+    static void Release_RenderThread(FSVFMeshRenderData* RenderData);
+    // Grows the buffers when a frame is larger than the clip said
+    void EnsureCapacity_RenderThread(int32 InNumVertices, int32 InNumIndices);
+
+    const ERHIFeatureLevel::Type FeatureLevel;
+    FSVFMeshBufferSize Capacity;
+    FSVFMeshStager Stager;
+    bool bResourcesInitialized = false;
+    uint32 LastUploadedSequence = 0;
+
+    FSVFFrameSnapshotSlot Snapshots;
+    // Publish order of frames converted on the render thread
+    uint32 SnapshotSequence = 0;
+    // Texture coordinates of a frame converted on the render thread, gathered for one batch conversion
+    TArray<FVector2D> TexCoordScratch;
+
+    // LODs of the current keyframe group
+    TArray<TUniquePtr<FSVFMeshIndexBuffer>> LODIndexBuffers;
+    int32 NumReadyLODs = 0;
+    uint32 TopologyGeneration = 0;
+};
+
 class FSVFMeshSceneProxy : public FPrimitiveSceneProxy
 {
 public:
 
     FSVFMeshSceneProxy(USVFComponent* Component);
-    FSVFMeshSceneProxy(USVFComponent* Component, int InitialVertexCount, int InitialIndexCount);
     virtual ~FSVFMeshSceneProxy();
     SIZE_T GetTypeHash() const;
     virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
         const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override;
-    //void Update_RenderThread(TSharedPtr<FFrameData> FrameData);
-    void Update_RenderThread(TSharedPtr<FFrameData> FrameData, int VertexCount = 0, int IndexCount = 0);
     virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const;
 
     virtual bool CanBeOccluded() const override
@@ -153,17 +290,53 @@ public:
         return(FPrimitiveSceneProxy::GetAllocatedSize());
     }
 
-    void GetPositionalVertices(TArray<FVector>& OutVertices, int32 VerticesCount) const
+private:
+
+    UMaterialInterface* Material;
+    FSVFMeshRenderData::FPtr RenderData;
+    FMaterialRelevance MaterialRelevance;
+    UBodySetup* BodySetup;
+};
+
+/**
+ * Draws the instances of a USVFInstancedComponent, one mesh batch per instance and view from the slot
+ * buffers of the frame the instance shows.
+ */
+class FSVFInstancedMeshSceneProxy : public FPrimitiveSceneProxy
+{
+public:
+
+    FSVFInstancedMeshSceneProxy(USVFInstancedComponent* Component);
+    SIZE_T GetTypeHash() const;
+    virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
+        const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override;
+    virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const;
+
+    virtual bool CanBeOccluded() const override
+    {
+        return !MaterialRelevance.bDisableDepthTest;
+    }
+
+    virtual uint32 GetMemoryFootprint(void) const
+    {
+        return(sizeof(*this) + GetAllocatedSize());
+    }
+
+    uint32 GetAllocatedSize(void) const
     {
-        VertexBuffer.GetPositionalVertices(OutVertices, VerticesCount);
+        return(FPrimitiveSceneProxy::GetAllocatedSize() + InstanceTransforms.GetAllocatedSize() +
+            InstanceSlots.GetAllocatedSize() + SlotBounds.GetAllocatedSize());
     }
 
+    // Slot shown by every instance and the bounds of the frame in every slot
+    void SetInstanceSlots_RenderThread(const TArray<int32>& InInstanceSlots, const TArray<FBox>& InSlotBounds);
+
 private:
 
-    UMaterialInterface* Material;
-    FSVFMeshVertexBuffer VertexBuffer;
-    FSVFMeshIndexBuffer IndexBuffer;
-    FSVFMeshVertexFactory VertexFactory;
+    TArray<FSVFMeshRenderData::FPtr> Slots;
+    TArray<UMaterialInterface*> SlotMaterials;
+    TArray<FBox> SlotBounds;
+    TArray<FMatrix> InstanceTransforms;
+    TArray<int32> InstanceSlots;
     FMaterialRelevance MaterialRelevance;
-    UBodySetup* BodySetup;
-};
\ No newline at end of file
+};
@@ -0,0 +1,204 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFMeshDecimator.h"
+
+namespace SVFMeshDecimator
+{
+    // A level keeping more than this share of the previous level's triangles is not worth its memory
+    const float MaxKeptTriangleRatio = 0.8f;
+    // Cell growth per step when searching for a triangle budget; clustering keeps about half the triangles per step
+    const float BudgetCellGrowth = 1.41421356f;
+    const int32 MaxBudgetSteps = 32;
+    // Cell coordinates are packed 21 bits per axis
+    const int64 CellCoordinateMask = (1 << 21) - 1;
+
+    uint64 PackCell(const FVector& Position, const FVector& Origin, float InvCellSize)
+    {
+        const int64 X = FMath::FloorToInt((Position.X - Origin.X) * InvCellSize) & CellCoordinateMask;
+        const int64 Y = FMath::FloorToInt((Position.Y - Origin.Y) * InvCellSize) & CellCoordinateMask;
+        const int64 Z = FMath::FloorToInt((Position.Z - Origin.Z) * InvCellSize) & CellCoordinateMask;
+        return static_cast<uint64>(X | (Y << 21) | (Z << 42));
+    }
+}
+
+const float FSVFMeshDecimator::BaseCellFraction = 1.f / 128.f;
+
+void FSVFMeshDecimator::Decimate(TArrayView<const int32> Indices, TArrayView<const FVector> Positions, float CellSize, TArray<int32>& OutIndices)
+{
+    OutIndices.Reset();
+    const int32 NumVertices = Positions.Num();
+    const int32 NumTriangles = Indices.Num() / 3;
+    if (NumTriangles == 0 || NumVertices == 0 || CellSize <= 0.f)
+    {
+        return;
+    }
+
+    FBox Bounds(ForceInit);
+    for (const FVector& Position : Positions)
+    {
+        Bounds += Position;
+    }
+    const float InvCellSize = 1.f / CellSize;
+
+    // Cell of every vertex and the mean position of every cell
+    TMap<uint64, int32> CellIds;
+    CellIds.Reserve(NumVertices / 4);
+    TArray<int32> VertexCells;
+    VertexCells.SetNumUninitialized(NumVertices);
+    TArray<FVector> CellSums;
+    TArray<int32> CellCounts;
+    for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+    {
+        const uint64 Key = SVFMeshDecimator::PackCell(Positions[Vertex], Bounds.Min, InvCellSize);
+        int32* Found = CellIds.Find(Key);
+        const int32 Cell = Found ? *Found : CellIds.Add(Key, CellSums.Num());
+        if (!Found)
+        {
+            CellSums.Add(FVector::ZeroVector);
+            CellCounts.Add(0);
+        }
+        VertexCells[Vertex] = Cell;
+        CellSums[Cell] += Positions[Vertex];
+        ++CellCounts[Cell];
+    }
+
+    // The vertex closest to its cell's mean stands in for the whole cell, keeping the surface in place
+    TArray<int32> Representatives;
+    TArray<float> BestDistances;
+    Representatives.Init(INDEX_NONE, CellSums.Num());
+    BestDistances.Init(MAX_flt, CellSums.Num());
+    for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+    {
+        const int32 Cell = VertexCells[Vertex];
+        const float Distance = FVector::DistSquared(Positions[Vertex], CellSums[Cell] / CellCounts[Cell]);
+        if (Distance < BestDistances[Cell])
+        {
+            BestDistances[Cell] = Distance;
+            Representatives[Cell] = Vertex;
+        }
+    }
+
+    TSet<FIntVector> Emitted;
+    Emitted.Reserve(NumTriangles / 2);
+    OutIndices.Reserve(Indices.Num() / 2);
+    for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+    {
+        int32 Corners[3];
+        bool bValid = true;
+        for (int32 Corner = 0; Corner < 3; ++Corner)
+        {
+            const int32 Vertex = Indices[Triangle * 3 + Corner];
+            bValid &= Vertex >= 0 && Vertex < NumVertices;
+            Corners[Corner] = bValid ? Representatives[VertexCells[Vertex]] : INDEX_NONE;
+        }
+        // Collapsed to a line or a point
+        if (!bValid || Corners[0] == Corners[1] || Corners[1] == Corners[2] || Corners[0] == Corners[2])
+        {
+            continue;
+        }
+
+        // Rotate the smallest index first so the same triangle with the same winding is found again
+        const int32 First = Corners[0] < Corners[1] ? (Corners[0] < Corners[2] ? 0 : 2) : (Corners[1] < Corners[2] ? 1 : 2);
+        const FIntVector Key(Corners[First], Corners[(First + 1) % 3], Corners[(First + 2) % 3]);
+        bool bAlreadyEmitted = false;
+        Emitted.Add(Key, &bAlreadyEmitted);
+        if (!bAlreadyEmitted)
+        {
+            OutIndices.Add(Corners[0]);
+            OutIndices.Add(Corners[1]);
+            OutIndices.Add(Corners[2]);
+        }
+    }
+}
+
+void FSVFMeshDecimator::BuildLODs(TArrayView<const int32> Indices, TArrayView<const FVector> Positions, int32 NumLODs, TArray<TArray<int32>>& OutLODs)
+{
+    OutLODs.Reset();
+    FBox Bounds(ForceInit);
+    for (const FVector& Position : Positions)
+    {
+        Bounds += Position;
+    }
+    if (!Bounds.IsValid)
+    {
+        return;
+    }
+
+    const float Diagonal = Bounds.GetSize().Size();
+    int32 PreviousTriangles = Indices.Num() / 3;
+    for (int32 LOD = 1; LOD <= NumLODs; ++LOD)
+    {
+        TArray<int32> LODIndices;
+        Decimate(Indices, Positions, Diagonal * BaseCellFraction * (1 << (LOD - 1)), LODIndices);
+        const int32 Triangles = LODIndices.Num() / 3;
+        if (Triangles == 0 || Triangles > PreviousTriangles * SVFMeshDecimator::MaxKeptTriangleRatio)
+        {
+            break;
+        }
+        PreviousTriangles = Triangles;
+        OutLODs.Add(MoveTemp(LODIndices));
+    }
+}
+
+void FSVFMeshDecimator::DecimateToBudget(TArrayView<const int32> Indices, TArrayView<const FVector> Positions, int32 MaxTriangles, FSVFCompactMesh& OutMesh)
+{
+    OutMesh.Positions.Reset();
+    OutMesh.Indices.Reset();
+    const int32 NumVertices = Positions.Num();
+    FBox Bounds(ForceInit);
+    for (const FVector& Position : Positions)
+    {
+        Bounds += Position;
+    }
+    if (!Bounds.IsValid || MaxTriangles <= 0)
+    {
+        return;
+    }
+
+    // Grow the cells until the triangles fit, a mesh already within budget is only compacted
+    TArray<int32> Reduced;
+    if (Indices.Num() / 3 <= MaxTriangles)
+    {
+        Reduced.Append(Indices.GetData(), Indices.Num() / 3 * 3);
+    }
+    else
+    {
+        float CellSize = Bounds.GetSize().Size() * BaseCellFraction;
+        for (int32 Step = 0; Step < SVFMeshDecimator::MaxBudgetSteps; ++Step)
+        {
+            Decimate(Indices, Positions, CellSize, Reduced);
+            if (Reduced.Num() / 3 <= MaxTriangles)
+            {
+                break;
+            }
+            CellSize *= SVFMeshDecimator::BudgetCellGrowth;
+        }
+        if (Reduced.Num() / 3 > MaxTriangles)
+        {
+            Reduced.Reset();
+        }
+    }
+
+    // Keep only the referenced vertices, renumbered in first use order
+    TArray<int32> Remap;
+    Remap.Init(INDEX_NONE, NumVertices);
+    OutMesh.Indices.Reserve(Reduced.Num());
+    for (int32 Index = 0; Index + 2 < Reduced.Num(); Index += 3)
+    {
+        const int32 A = Reduced[Index + 0];
+        const int32 B = Reduced[Index + 1];
+        const int32 C = Reduced[Index + 2];
+        if (A < 0 || A >= NumVertices || B < 0 || B >= NumVertices || C < 0 || C >= NumVertices)
+        {
+            continue;
+        }
+        for (const int32 Vertex : { A, B, C })
+        {
+            if (Remap[Vertex] == INDEX_NONE)
+            {
+                Remap[Vertex] = OutMesh.Positions.Add(Positions[Vertex]);
+            }
+            OutMesh.Indices.Add(Remap[Vertex]);
+        }
+    }
+}
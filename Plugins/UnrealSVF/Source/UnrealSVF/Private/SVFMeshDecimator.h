@@ -0,0 +1,32 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Self-contained vertices and triangles, e.g. a decimated frame handed to collision cooking
+struct FSVFCompactMesh
+{
+    TArray<FVector> Positions;
+    TArray<int32> Indices;
+};
+
+// Reduced index sets of a captured mesh for distant holograms, built by vertex clustering.
+// Vertices inside one grid cell collapse onto the cell's most central vertex; triangles that
+// lose an edge or repeat another are dropped. The output indexes the original vertex buffer,
+// so a LOD stays valid for every frame of a keyframe group while the positions animate.
+class FSVFMeshDecimator
+{
+public:
+    // LOD n (from 1) uses cells of BaseCellFraction * 2^(n-1) times the bounds diagonal
+    static const float BaseCellFraction;
+
+    static void Decimate(TArrayView<const int32> Indices, TArrayView<const FVector> Positions, float CellSize, TArray<int32>& OutIndices);
+
+    // NumLODs index sets for LOD 1 and up. A level that removes too little is left out along with the
+    // levels after it, so OutLODs may hold fewer sets.
+    static void BuildLODs(TArrayView<const int32> Indices, TArrayView<const FVector> Positions, int32 NumLODs, TArray<TArray<int32>>& OutLODs);
+
+    // At most MaxTriangles triangles, the finest grid that fits; only the vertices they use are kept
+    static void DecimateToBudget(TArrayView<const int32> Indices, TArrayView<const FVector> Positions, int32 MaxTriangles, FSVFCompactMesh& OutMesh);
+};
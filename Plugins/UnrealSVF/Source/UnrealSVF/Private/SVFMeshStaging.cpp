@@ -0,0 +1,296 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFMeshStaging.h"
+#include "SVFMeshDecimator.h"
+#include "SVFVertexCacheOptimizer.h"
+#include "UnrealSVF.h"
+#include "Async/Async.h"
+#include "Misc/Crc.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSVFMeshStaging, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("Generate Normals"), STAT_SVF_GenerateNormals, STATGROUP_UnrealSVF);
+
+namespace SVFMeshStaging
+{
+    // Tangent basis of generated normals, the same constant TangentX the render data writes
+    const FPackedNormal GeneratedTangentX(FVector(1, 0, 0));
+}
+
+FSVFMeshStager::FSVFMeshStager(const FSVFMeshRenderSettings& InSettings, uint32 InNumTexCoords, ESVFTexCoordFormat InTexCoordFormat)
+    : Settings(InSettings)
+    , NumTexCoords(InNumTexCoords)
+    , TexCoordFormat(InTexCoordFormat)
+{
+}
+
+FSVFMeshStagingBlockPtr FSVFMeshStager::Stage(FFrameData& FrameData, uint32 Sequence, int32 VertexCount, int32 IndexCount,
+    FSVFFrameSnapshotSlot* Snapshots)
+{
+    FSVFFrameInfo FrameInfo;
+    if (!FrameData.GetFrameInfo(FrameInfo) || FrameInfo.frameId <= 0)
+    {
+        return nullptr;
+    }
+
+    FScopeLock Lock(&StageLock);
+    if (Sequence <= LastStagedSequence)
+    {
+        return nullptr;
+    }
+
+    FSVFMeshStagingBlockPtr Block;
+    {
+        FScopeLock PoolScope(&PoolLock);
+        Block = FreeBlocks.Num() > 0 ? FreeBlocks.Pop(false) : MakeShared<FSVFMeshStagingBlock, ESPMode::ThreadSafe>();
+    }
+
+    // Vertices go straight from the decoder's buffer into one array per vertex stream
+    const int32 NumVertices = FrameInfo.vertexCount;
+    const bool bGenerateNormals = Settings.bGenerateNormals && !FrameData.HasNormals();
+    const bool bHasNormals = FrameData.HasNormals() || bGenerateNormals;
+    Block->Positions.SetNumUninitialized(NumVertices, false);
+    Block->Tangents.SetNumUninitialized(bHasNormals ? 2 * NumVertices : 0, false);
+    Block->TexCoords.SetNumUninitialized(NumTexCoords * NumVertices * FSVFTexCoordPacker::GetStride(TexCoordFormat), false);
+    // 16 bit formats are packed from floats afterwards, all channels in one batch
+    const bool bPackTexCoords = TexCoordFormat != ESVFTexCoordFormat::Float;
+    if (bPackTexCoords)
+    {
+        FloatTexCoords.SetNumUninitialized(NumTexCoords * NumVertices, false);
+    }
+    FVector2D* TexCoords = bPackTexCoords ? FloatTexCoords.GetData() : reinterpret_cast<FVector2D*>(Block->TexCoords.GetData());
+    if (NumTexCoords > 1)
+    {
+        // Only the first channel comes from the file
+        FMemory::Memzero(TexCoords, NumTexCoords * NumVertices * sizeof(FVector2D));
+    }
+
+    FSVFVertexStreams Streams;
+    Streams.Positions = Block->Positions.GetData();
+    // Generated normals replace the whole basis, so the decoder does not write it first
+    Streams.Tangents = FrameData.HasNormals() ? Block->Tangents.GetData() : nullptr;
+    Streams.TexCoords = NumTexCoords > 0 ? TexCoords : nullptr;
+    Streams.TexCoordStride = FMath::Max<int32>(NumTexCoords, 1);
+    if (!FrameData.GetFrameStreams(Streams) || !FrameData.GetFrameIndices(Block->Indices))
+    {
+        Recycle(MoveTemp(Block));
+        return nullptr;
+    }
+    if (bPackTexCoords)
+    {
+        FSVFTexCoordPacker::Pack(FloatTexCoords.GetData(), FloatTexCoords.Num(), TexCoordFormat, Block->TexCoords.GetData());
+    }
+    LastStagedSequence = Sequence;
+    Block->Sequence = Sequence;
+    Block->FrameInfo = FrameInfo;
+    Block->RequiredVertices = FMath::Max(VertexCount, NumVertices);
+    Block->RequiredIndices = FMath::Max(IndexCount, FrameInfo.indexCount);
+
+    // Topology is tracked on the indices as decoded, before they are reordered
+    if (HasTopologyWork() || bGenerateNormals)
+    {
+        TrackTopology(FrameInfo, Block->Indices);
+    }
+    if (bGenerateNormals)
+    {
+        const FVector* Positions = Block->Positions.GetData();
+        FPackedNormal* Tangents = Block->Tangents.GetData();
+        ComputeNormals(Block->Indices, NumVertices,
+            [Positions](int32 VertexIndex) -> const FVector& { return Positions[VertexIndex]; },
+            [Tangents](int32 VertexIndex, const FVector& Normal)
+            {
+                Tangents[2 * VertexIndex + 0] = SVFMeshStaging::GeneratedTangentX;
+                Tangents[2 * VertexIndex + 1] = FPackedNormal(FVector4(Normal, 1.f));
+            });
+    }
+    Block->HalfPositions.SetNumUninitialized(Settings.bHalfPrecisionPositions ? NumVertices : 0, false);
+    for (int32 i = 0; i < Block->HalfPositions.Num(); i++)
+    {
+        Block->HalfPositions[i] = FSVFHalfPosition(Block->Positions[i]);
+    }
+
+    // Readers get the indices as decoded, before they are reordered; published ahead of the upload
+    if (Snapshots)
+    {
+        FSVFFrameSnapshotSlot::FWritablePtr Snapshot = Snapshots->Allocate();
+        FSVFFrameSnapshotSlot::Fill(*Snapshot, FrameInfo.frameId, Block->Positions, Block->Tangents, Streams.TexCoords,
+            Streams.TexCoordStride, Block->Indices);
+        Snapshots->Publish(MoveTemp(Snapshot), Sequence);
+    }
+
+    if (HasTopologyWork())
+    {
+        UpdateTopology(*Block);
+    }
+    Block->TopologyGeneration = TopologyGeneration;
+    Block->TopologyBuild = ReadyBuild;
+
+    // The group's cache optimised order replaces the decoded one, clustering keeps it within each cluster
+    if (ReadyBuild.IsValid() && ReadyBuild->OptimizedIndices.Num() == Block->Indices.Num())
+    {
+        FMemory::Memcpy(Block->Indices.GetData(), ReadyBuild->OptimizedIndices.GetData(), Block->Indices.Num() * sizeof(int32));
+    }
+    if (Settings.bBuildClusters)
+    {
+        // Triangles are regrouped so every cluster is one index range
+        const TArray<FVector>& Positions = Block->Positions;
+        ClusterBuilder.Build(Block->Indices, NumVertices,
+            [&Positions](int32 VertexIndex) -> const FVector& { return Positions[VertexIndex]; }, Block->Clusters);
+    }
+    else
+    {
+        Block->Clusters.Reset();
+    }
+
+    // The LODs were clustered once for the group, their bounds follow the vertices of every frame
+    const int32 NumLODClusters = Settings.bBuildClusters && ReadyBuild.IsValid() ? ReadyBuild->LODClusters.Num() : 0;
+    Block->LODClusters.SetNum(NumLODClusters);
+    for (int32 LOD = 0; LOD < NumLODClusters; ++LOD)
+    {
+        const TArray<FVector>& Positions = Block->Positions;
+        Block->LODClusters[LOD] = ReadyBuild->LODClusters[LOD];
+        FSVFMeshClusterBuilder::UpdateBounds(ReadyBuild->LODIndices[LOD], NumVertices,
+            [&Positions](int32 VertexIndex) -> const FVector& { return Positions[VertexIndex]; }, Block->LODClusters[LOD]);
+    }
+    return Block;
+}
+
+void FSVFMeshStager::Recycle(FSVFMeshStagingBlockPtr&& Block)
+{
+    if (!Block.IsValid())
+    {
+        return;
+    }
+    // Builds can be large, they stay alive only as long as the stager or the render data need them
+    Block->TopologyBuild.Reset();
+    FScopeLock PoolScope(&PoolLock);
+    if (FreeBlocks.Num() < MaxFreeBlocks)
+    {
+        FreeBlocks.Add(MoveTemp(Block));
+    }
+    Block.Reset();
+}
+
+void FSVFMeshStager::Reset()
+{
+    FScopeLock Lock(&StageLock);
+    ReadyBuild.Reset();
+    LastFrameId = INDEX_NONE;
+    LastIndexCount = 0;
+    LastIndicesCrc = 0;
+    NormalGenerator.Reset();
+}
+
+void FSVFMeshStager::GenerateNormals(const FSVFFrameInfo& FrameInfo, const TArray<int32>& Indices, TArrayView<FDynamicMeshVertex> Vertices)
+{
+    FScopeLock Lock(&StageLock);
+    TrackTopology(FrameInfo, Indices);
+    FDynamicMeshVertex* VertexData = Vertices.GetData();
+    ComputeNormals(Indices, Vertices.Num(),
+        [VertexData](int32 VertexIndex) -> const FVector& { return VertexData[VertexIndex].Position; },
+        [VertexData](int32 VertexIndex, const FVector& Normal)
+        {
+            VertexData[VertexIndex].TangentX = SVFMeshStaging::GeneratedTangentX;
+            VertexData[VertexIndex].TangentZ = FPackedNormal(FVector4(Normal, 1.f));
+        });
+}
+
+void FSVFMeshStager::TrackTopology(const FSVFFrameInfo& FrameInfo, const TArray<int32>& Indices)
+{
+    // Indices only change with a keyframe. Frames skipped by update throttling, seeks and loops can
+    // hide the keyframe, so anything but the next frame compares the indices themselves.
+    const bool bNextFrame = FrameInfo.frameId == LastFrameId + 1 && FrameInfo.indexCount == LastIndexCount;
+    bool bNewTopology = FrameInfo.isKeyFrame || !bNextFrame;
+    if (bNewTopology && !FrameInfo.isKeyFrame && FrameInfo.indexCount == LastIndexCount)
+    {
+        const uint32 IndicesCrc = FCrc::MemCrc32(Indices.GetData(), Indices.Num() * sizeof(int32));
+        bNewTopology = IndicesCrc != LastIndicesCrc;
+        LastIndicesCrc = IndicesCrc;
+    }
+    else if (bNewTopology)
+    {
+        LastIndicesCrc = FCrc::MemCrc32(Indices.GetData(), Indices.Num() * sizeof(int32));
+    }
+    LastFrameId = FrameInfo.frameId;
+    LastIndexCount = FrameInfo.indexCount;
+
+    if (bNewTopology)
+    {
+        // Results of the previous keyframe group no longer match the indices
+        ReadyBuild.Reset();
+        ++TopologyGeneration;
+    }
+}
+
+void FSVFMeshStager::UpdateTopology(FSVFMeshStagingBlock& Block)
+{
+    const TArray<int32>& Indices = Block.Indices;
+    if (PendingBuild.IsValid() && PendingBuild.IsReady())
+    {
+        FSVFTopologyBuildPtr Build = PendingBuild.Get();
+        PendingBuild = TFuture<FSVFTopologyBuildPtr>();
+        if (Build.IsValid() && Build->Generation == TopologyGeneration)
+        {
+            ReadyBuild = Build;
+        }
+    }
+
+    // One build at a time; a stale one is let finish and the current topology is built after it
+    if (!PendingBuild.IsValid() && PendingBuildGeneration != TopologyGeneration)
+    {
+        PendingBuildGeneration = TopologyGeneration;
+        TArray<int32> SourceIndices = Indices;
+        TArray<FVector> SourcePositions = Block.Positions;
+        const uint32 Generation = TopologyGeneration;
+        const int32 NumLODs = Settings.LODScreenSizes.Num();
+        const bool bOptimize = Settings.bOptimizeVertexCache;
+        const bool bClusterLODs = Settings.bBuildClusters;
+        PendingBuild = Async(EAsyncExecution::ThreadPool,
+            [SourceIndices = MoveTemp(SourceIndices), SourcePositions = MoveTemp(SourcePositions), Generation, NumLODs, bOptimize, bClusterLODs]()
+        {
+            TSharedPtr<FSVFTopologyBuild, ESPMode::ThreadSafe> Build = MakeShared<FSVFTopologyBuild, ESPMode::ThreadSafe>();
+            Build->Generation = Generation;
+            FSVFMeshDecimator::BuildLODs(SourceIndices, SourcePositions, NumLODs, Build->LODIndices);
+            if (bOptimize)
+            {
+                FSVFVertexCacheOptimizer::Optimize(SourceIndices, SourcePositions.Num(), Build->OptimizedIndices);
+                UE_LOG(LogSVFMeshStaging, Verbose, TEXT("Vertex cache ACMR %.3f -> %.3f for %d triangles"),
+                    FSVFVertexCacheOptimizer::ComputeACMR(SourceIndices, SourcePositions.Num()),
+                    FSVFVertexCacheOptimizer::ComputeACMR(Build->OptimizedIndices, SourcePositions.Num()), SourceIndices.Num() / 3);
+                TArray<int32> OptimizedLOD;
+                for (TArray<int32>& LODIndices : Build->LODIndices)
+                {
+                    FSVFVertexCacheOptimizer::Optimize(LODIndices, SourcePositions.Num(), OptimizedLOD);
+                    Exchange(LODIndices, OptimizedLOD);
+                }
+            }
+            if (bClusterLODs)
+            {
+                // Regrouped after the cache order like the full mesh, so it is kept within each cluster
+                FSVFMeshClusterBuilder LODClusterBuilder;
+                Build->LODClusters.SetNum(Build->LODIndices.Num());
+                for (int32 LOD = 0; LOD < Build->LODIndices.Num(); ++LOD)
+                {
+                    LODClusterBuilder.Build(Build->LODIndices[LOD], SourcePositions.Num(),
+                        [&SourcePositions](int32 VertexIndex) -> const FVector& { return SourcePositions[VertexIndex]; }, Build->LODClusters[LOD]);
+                }
+            }
+            return FSVFTopologyBuildPtr(Build);
+        });
+    }
+}
+
+template <typename GetPositionType, typename SetNormalType>
+void FSVFMeshStager::ComputeNormals(const TArray<int32>& Indices, int32 NumVertices, GetPositionType GetPosition, SetNormalType SetNormal)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SVF_GenerateNormals);
+
+    // The vertex to triangle table holds for every frame of the keyframe group
+    if (NormalTopologyGeneration != TopologyGeneration || !NormalGenerator.HasTopology(NumVertices, Indices.Num()))
+    {
+        NormalGenerator.SetTopology(Indices, NumVertices);
+        NormalTopologyGeneration = TopologyGeneration;
+    }
+    NormalGenerator.Compute(GetPosition, SetNormal);
+}
@@ -0,0 +1,162 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PackedNormal.h"
+#include "Async/Future.h"
+#include "HAL/CriticalSection.h"
+#include "SVFTypes.h"
+#include "SVFMeshClusters.h"
+#include "SVFNormalGenerator.h"
+#include "SVFFrameSnapshotSlot.h"
+#include "SVFTexCoordPacker.h"
+#include "SVFHalfPosition.h"
+
+// How the render data of a stream prepares its frames for drawing
+struct FSVFMeshRenderSettings
+{
+    // Split every uploaded frame into clusters for per-view culling
+    bool bBuildClusters = false;
+    // Reorder each keyframe group's triangles for the vertex cache and reuse the order for the whole group
+    bool bOptimizeVertexCache = false;
+    // Screen sizes below which LOD 1, 2, ... are drawn; no LODs are built when empty
+    TArray<float> LODScreenSizes;
+    // Compute vertex normals from the triangles for clips that do not carry normals
+    bool bGenerateNormals = false;
+    // Upload positions as half floats instead of floats
+    bool bHalfPrecisionPositions = false;
+    // Upload texture coordinates as unsigned normalized 16 bit instead of half floats, for clips with UVs in 0..1
+    bool bNormalizedTexCoords = false;
+
+    bool operator==(const FSVFMeshRenderSettings& Other) const
+    {
+        return bBuildClusters == Other.bBuildClusters && bOptimizeVertexCache == Other.bOptimizeVertexCache &&
+            LODScreenSizes == Other.LODScreenSizes && bGenerateNormals == Other.bGenerateNormals &&
+            bHalfPrecisionPositions == Other.bHalfPrecisionPositions && bNormalizedTexCoords == Other.bNormalizedTexCoords;
+    }
+};
+
+// Work done once per keyframe group on the thread pool
+struct FSVFTopologyBuild
+{
+    // Topology generation the build was started for
+    uint32 Generation = 0;
+    // The group's indices in vertex cache order, empty when not optimising
+    TArray<int32> OptimizedIndices;
+    TArray<TArray<int32>> LODIndices;
+    // Clusters of every LOD's indices when clustering, bounds as of the frame the build started from
+    TArray<TArray<FSVFMeshCluster>> LODClusters;
+};
+typedef TSharedPtr<const FSVFTopologyBuild, ESPMode::ThreadSafe> FSVFTopologyBuildPtr;
+
+// One frame converted to the layout of the GPU buffers, so the render thread only copies it
+struct FSVFMeshStagingBlock
+{
+    // Order in which frames were handed to the stager, later frames replace earlier ones
+    uint32 Sequence = 0;
+    FSVFFrameInfo FrameInfo;
+    // Buffer sizes the stream asked for, at least the frame's own counts
+    int32 RequiredVertices = 0;
+    int32 RequiredIndices = 0;
+
+    TArray<FVector> Positions;
+    // Positions as uploaded when the settings ask for half precision, empty otherwise
+    TArray<FSVFHalfPosition> HalfPositions;
+    // TangentX and TangentZ interleaved, empty for clips without normals
+    TArray<FPackedNormal> Tangents;
+    // NumTexCoords channels per vertex, in the texture coordinate buffer's format
+    TArray<uint8> TexCoords;
+    // Final draw order: cache optimised and grouped into clusters
+    TArray<int32> Indices;
+    TArray<FSVFMeshCluster> Clusters;
+    // Clusters of TopologyBuild's LODs with this frame's bounds, empty when clustering is off or no LODs are built
+    TArray<TArray<FSVFMeshCluster>> LODClusters;
+
+    // Bumped whenever the indices hold a new topology
+    uint32 TopologyGeneration = 0;
+    // Latest finished build, drawn from only if its generation matches the block's
+    FSVFTopologyBuildPtr TopologyBuild;
+};
+typedef TSharedPtr<FSVFMeshStagingBlock, ESPMode::ThreadSafe> FSVFMeshStagingBlockPtr;
+
+/**
+ * Converts decoded frames into staging blocks on worker threads: vertex scatter, 16 bit UVs, missing
+ * normals, vertex cache order, clusters and the per keyframe group topology builds. Frames of one stream
+ * are staged one at a time; blocks come from a small pool and go back to it once uploaded.
+ */
+class FSVFMeshStager
+{
+public:
+    // Blocks kept for reuse; a stream rarely has more than a couple of frames in flight
+    static const int32 MaxFreeBlocks = 4;
+
+    FSVFMeshStager(const FSVFMeshRenderSettings& InSettings, uint32 InNumTexCoords, ESVFTexCoordFormat InTexCoordFormat);
+
+    // Sequence number for the next frame, taken in the order frames are produced
+    uint32 NextSequence()
+    {
+        return static_cast<uint32>(SequenceCounter.Increment());
+    }
+
+    // Any thread. Returns null if the frame has no geometry or a later frame was staged already.
+    // The frame's geometry is also published to Snapshots when given.
+    FSVFMeshStagingBlockPtr Stage(FFrameData& FrameData, uint32 Sequence, int32 VertexCount = 0, int32 IndexCount = 0,
+        FSVFFrameSnapshotSlot* Snapshots = nullptr);
+
+    // Fills TangentZ of the frame's vertices from its triangles, for frames converted outside of Stage. Any thread.
+    void GenerateNormals(const FSVFFrameInfo& FrameInfo, const TArray<int32>& Indices, TArrayView<FDynamicMeshVertex> Vertices);
+
+    // Hands an uploaded or dropped block back for reuse
+    void Recycle(FSVFMeshStagingBlockPtr&& Block);
+
+    // Forgets the stream's topology, before the buffers are reused for another clip
+    void Reset();
+
+    const FSVFMeshRenderSettings& GetSettings() const
+    {
+        return Settings;
+    }
+
+private:
+    bool HasTopologyWork() const
+    {
+        return Settings.bOptimizeVertexCache || Settings.LODScreenSizes.Num() > 0;
+    }
+
+    // Bumps TopologyGeneration when the decoded indices hold a new topology
+    void TrackTopology(const FSVFFrameInfo& FrameInfo, const TArray<int32>& Indices);
+    // Takes finished builds and starts one for the current topology
+    void UpdateTopology(FSVFMeshStagingBlock& Block);
+    // Normals of the current topology, called with StageLock held
+    template <typename GetPositionType, typename SetNormalType>
+    void ComputeNormals(const TArray<int32>& Indices, int32 NumVertices, GetPositionType GetPosition, SetNormalType SetNormal);
+
+    const FSVFMeshRenderSettings Settings;
+    const uint32 NumTexCoords;
+    const ESVFTexCoordFormat TexCoordFormat;
+
+    FThreadSafeCounter SequenceCounter;
+
+    // Everything below is guarded by StageLock
+    FCriticalSection StageLock;
+    uint32 LastStagedSequence = 0;
+    // Float texture coordinates of frames staged in a 16 bit format, packed in one batch and kept for snapshots
+    TArray<FVector2D> FloatTexCoords;
+    FSVFMeshClusterBuilder ClusterBuilder;
+
+    TFuture<FSVFTopologyBuildPtr> PendingBuild;
+    FSVFTopologyBuildPtr ReadyBuild;
+    uint32 TopologyGeneration = 0;
+    uint32 PendingBuildGeneration = 0;
+    int32 LastFrameId = INDEX_NONE;
+    int32 LastIndexCount = 0;
+    uint32 LastIndicesCrc = 0;
+
+    FSVFNormalGenerator NormalGenerator;
+    // Topology generation the generator's vertex to triangle table was built for
+    uint32 NormalTopologyGeneration = 0;
+
+    FCriticalSection PoolLock;
+    TArray<FSVFMeshStagingBlockPtr> FreeBlocks;
+};
@@ -0,0 +1,49 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFNormalGenerator.h"
+
+void FSVFNormalGenerator::SetTopology(const TArray<int32>& Indices, int32 NumVertices)
+{
+    const int32 NumIndices = Indices.Num() / 3 * 3;
+    NumTopologyIndices = Indices.Num();
+    Triangles.Reset(NumIndices);
+    for (int32 Index = 0; Index < NumIndices; Index += 3)
+    {
+        const int32 I0 = Indices[Index + 0];
+        const int32 I1 = Indices[Index + 1];
+        const int32 I2 = Indices[Index + 2];
+        if ((uint32)I0 < (uint32)NumVertices && (uint32)I1 < (uint32)NumVertices && (uint32)I2 < (uint32)NumVertices)
+        {
+            Triangles.Add(I0);
+            Triangles.Add(I1);
+            Triangles.Add(I2);
+        }
+    }
+
+    // Counting sort of the corners by vertex: counts, then running totals make each entry the end of its
+    // vertex's range, and stepping an end back once per corner leaves it at the range's start
+    VertexTriangleStarts.Reset(NumVertices + 1);
+    VertexTriangleStarts.AddZeroed(NumVertices + 1);
+    for (int32 Vertex : Triangles)
+    {
+        ++VertexTriangleStarts[Vertex];
+    }
+    for (int32 Vertex = 1; Vertex <= NumVertices; ++Vertex)
+    {
+        VertexTriangleStarts[Vertex] += VertexTriangleStarts[Vertex - 1];
+    }
+    VertexTriangles.SetNumUninitialized(Triangles.Num(), false);
+    for (int32 Corner = 0; Corner < Triangles.Num(); ++Corner)
+    {
+        VertexTriangles[--VertexTriangleStarts[Triangles[Corner]]] = Corner / 3;
+    }
+}
+
+void FSVFNormalGenerator::Reset()
+{
+    Triangles.Reset();
+    NumTopologyIndices = 0;
+    VertexTriangleStarts.Reset();
+    VertexTriangles.Reset();
+    FaceNormals.Reset();
+}
@@ -0,0 +1,87 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+
+// Area weighted vertex normals for clips that do not carry normals. The vertex to triangle table is built
+// once per topology, frames of the same keyframe group only recompute the normals. Both passes write
+// disjoint ranges, faces first and then vertices gathering their faces, so batches run in parallel
+// without atomics or locks.
+class FSVFNormalGenerator
+{
+public:
+    // Triangles or vertices per parallel batch
+    static const int32 BatchSize = 4096;
+
+    // Builds the vertex to triangle table; triangles with out of range indices are left out
+    void SetTopology(const TArray<int32>& Indices, int32 NumVertices);
+
+    bool HasTopology(int32 NumVertices, int32 NumIndices) const
+    {
+        return VertexTriangleStarts.Num() == NumVertices + 1 && NumTopologyIndices == NumIndices;
+    }
+
+    void Reset();
+
+    // GetPosition(VertexIndex) returns the local position of a vertex of the topology, SetNormal(VertexIndex,
+    // Normal) receives its unit normal; both are called from worker threads. Faces follow the engine's winding.
+    template <typename GetPositionType, typename SetNormalType>
+    void Compute(GetPositionType GetPosition, SetNormalType SetNormal);
+
+private:
+    static int32 GetNumBatches(int32 Num)
+    {
+        return (Num + BatchSize - 1) / BatchSize;
+    }
+
+    // Valid triangles of the topology, three indices each
+    TArray<int32> Triangles;
+    int32 NumTopologyIndices = 0;
+    // Triangles around vertex V are VertexTriangles[VertexTriangleStarts[V] .. VertexTriangleStarts[V + 1])
+    TArray<int32> VertexTriangleStarts;
+    TArray<int32> VertexTriangles;
+    // Cross products of the last frame, twice the area long
+    TArray<FVector> FaceNormals;
+};
+
+template <typename GetPositionType, typename SetNormalType>
+void FSVFNormalGenerator::Compute(GetPositionType GetPosition, SetNormalType SetNormal)
+{
+    const int32 NumTriangles = Triangles.Num() / 3;
+    const int32 NumVertices = VertexTriangleStarts.Num() - 1;
+    if (NumVertices <= 0)
+    {
+        return;
+    }
+
+    FaceNormals.SetNumUninitialized(NumTriangles, false);
+    ParallelFor(GetNumBatches(NumTriangles), [this, NumTriangles, &GetPosition](int32 Batch)
+    {
+        const int32 End = FMath::Min((Batch + 1) * BatchSize, NumTriangles);
+        for (int32 Triangle = Batch * BatchSize; Triangle < End; ++Triangle)
+        {
+            const FVector A = GetPosition(Triangles[Triangle * 3 + 0]);
+            const FVector B = GetPosition(Triangles[Triangle * 3 + 1]);
+            const FVector C = GetPosition(Triangles[Triangle * 3 + 2]);
+            FaceNormals[Triangle] = (C - A) ^ (B - A);
+        }
+    });
+
+    ParallelFor(GetNumBatches(NumVertices), [this, NumVertices, &SetNormal](int32 Batch)
+    {
+        const int32 End = FMath::Min((Batch + 1) * BatchSize, NumVertices);
+        for (int32 Vertex = Batch * BatchSize; Vertex < End; ++Vertex)
+        {
+            FVector Sum = FVector::ZeroVector;
+            for (int32 Slot = VertexTriangleStarts[Vertex]; Slot < VertexTriangleStarts[Vertex + 1]; ++Slot)
+            {
+                Sum += FaceNormals[VertexTriangles[Slot]];
+            }
+            // Unused vertices and those on degenerate triangles only face up
+            const float SizeSquared = Sum.SizeSquared();
+            SetNormal(Vertex, SizeSquared > SMALL_NUMBER ? Sum * FMath::InvSqrt(SizeSquared) : FVector::UpVector);
+        }
+    });
+}
@@ -0,0 +1,43 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define SVF_NORMAL_SSE 1
+#include <emmintrin.h>
+#else
+#define SVF_NORMAL_SSE 0
+#endif
+
+namespace SVFNormalPacking
+{
+    // One SVF normal (nx, ny, nz) as FPackedNormal packs FVector(-nz, -nx, -ny): Unreal's axes, flipped,
+    // each component rounded to the nearest 1/127 with halves rounded up, saturated, W set to 127
+    FORCEINLINE uint32 PackSVFNormalScalar(float NX, float NY, float NZ)
+    {
+        const uint32 X = static_cast<uint8>(FMath::Clamp<int32>(FMath::RoundToInt(-NZ * 127.f), -128, 127));
+        const uint32 Y = static_cast<uint8>(FMath::Clamp<int32>(FMath::RoundToInt(-NX * 127.f), -128, 127));
+        const uint32 Z = static_cast<uint8>(FMath::Clamp<int32>(FMath::RoundToInt(-NY * 127.f), -128, 127));
+        return X | (Y << 8) | (Z << 16) | (127u << 24);
+    }
+
+    // Same from the decoder's floats (nx, ny, nz, u), which must be readable as four floats. The SSE path
+    // rounds like the engine's RoundToInt on x64, converting 2x + 0.5 to nearest even and halving, so the
+    // bits match FPackedNormal's scalar conversion exactly.
+    FORCEINLINE uint32 PackSVFNormal(const float* NormalAndU)
+    {
+#if SVF_NORMAL_SSE
+        // u is dropped by the zero scale, its lane rounds to W = 127
+        const __m128 Scale = _mm_setr_ps(-254.f, -254.f, -254.f, 0.f);
+        const __m128 Bias = _mm_setr_ps(0.5f, 0.5f, 0.5f, 254.5f);
+        const __m128 Normal = _mm_shuffle_ps(_mm_loadu_ps(NormalAndU), _mm_loadu_ps(NormalAndU), _MM_SHUFFLE(3, 1, 0, 2));
+        const __m128i Rounded = _mm_srai_epi32(_mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(Normal, Scale), Bias)), 1);
+        const __m128i Words = _mm_packs_epi32(Rounded, Rounded);
+        return static_cast<uint32>(_mm_cvtsi128_si32(_mm_packs_epi16(Words, Words)));
+#else
+        return PackSVFNormalScalar(NormalAndU[0], NormalAndU[1], NormalAndU[2]);
+#endif
+    }
+}
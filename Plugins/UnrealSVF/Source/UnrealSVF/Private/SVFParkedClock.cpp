@@ -0,0 +1,51 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFParkedClock.h"
+
+bool USVFParkedClock::SVFClock_GetPresentationTime(int64* OutTime)
+{
+    *OutTime = -PresentationOffset;
+    return true;
+}
+
+bool USVFParkedClock::SVFClock_GetTime(int64* OutTime)
+{
+    *OutTime = 0L;
+    return true;
+}
+
+bool USVFParkedClock::SVFClock_GetState(EUSVFClockState* OutState)
+{
+    *OutState = EUSVFClockState::Stopped;
+    return true;
+}
+
+bool USVFParkedClock::SVFClock_SetPresentationOffset(int64 InT)
+{
+    PresentationOffset = InT;
+    return true;
+}
+
+bool USVFParkedClock::SVFClock_SnapPresentationOffset()
+{
+    PresentationOffset = 0L;
+    return true;
+}
+
+bool USVFParkedClock::SVFClock_GetPresentationOffset(int64* OutTime)
+{
+    *OutTime = PresentationOffset;
+    return true;
+}
+
+bool USVFParkedClock::SVFClock_SetScale(float InScale)
+{
+    ClockScale = InScale;
+    return true;
+}
+
+bool USVFParkedClock::SVFClock_GetScale(float* OutScale)
+{
+    *OutScale = ClockScale;
+    return true;
+}
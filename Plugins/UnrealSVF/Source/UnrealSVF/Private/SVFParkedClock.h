@@ -0,0 +1,41 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "SVFClockInterface.h"
+#include "SVFParkedClock.generated.h"
+
+/**
+ * Clock for readers that are opened and prerolled but not presenting yet (loop standby, warm readers).
+ * It never runs, so the reader buffers up to its first frame and waits; once the reader is handed to a
+ * component its clock binding is switched over to the component.
+ */
+UCLASS(Transient)
+class USVFParkedClock : public UObject, public ISVFClockInterface
+{
+    GENERATED_BODY()
+
+public:
+
+    // ~ ISVFClockInterface
+    virtual bool SVFClock_Initialize() override { return true; }
+    virtual bool SVFClock_GetPresentationTime(int64* OutTime) override;
+    virtual bool SVFClock_GetTime(int64* OutTime) override;
+    virtual bool SVFClock_Start() override { return true; }
+    virtual bool SVFClock_Stop() override { return true; }
+    virtual bool SVFClock_GetState(EUSVFClockState* OutState) override;
+    virtual bool SVFClock_Shutdown() override { return true; }
+    virtual bool SVFClock_SetPresentationOffset(int64 InT) override;
+    virtual bool SVFClock_SnapPresentationOffset() override;
+    virtual bool SVFClock_GetPresentationOffset(int64* OutTime) override;
+    virtual bool SVFClock_SetScale(float InScale) override;
+    virtual bool SVFClock_GetScale(float* OutScale) override;
+    // ~ END: ISVFClockInterface
+
+protected:
+
+    int64 PresentationOffset = 0L;
+    float ClockScale = 1.f;
+};
@@ -0,0 +1,75 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFPlayRatePolicy.h"
+
+namespace SVFPlayRatePolicy
+{
+    // Look-ahead scales are multiples of this step
+    const float ScaleStep = 0.5f;
+    // How far below a step the rate has to fall before the look-ahead shrinks again
+    const float ShrinkMargin = 0.1f;
+}
+
+FSVFPlayRateBufferPolicy::FSVFPlayRateBufferPolicy()
+    : MaxBufferUpperBound(0)
+{
+    Reset();
+}
+
+void FSVFPlayRateBufferPolicy::SetBaseTargets(const FSVFBufferingTargets& InBase, uint32 InMaxBufferUpperBound)
+{
+    Base = InBase;
+    MaxBufferUpperBound = FMath::Max(InMaxBufferUpperBound, InBase.MaxBufferFrames);
+    Reset();
+}
+
+void FSVFPlayRateBufferPolicy::Reset()
+{
+    CurrentScale = 0.f;
+}
+
+float FSVFPlayRateBufferPolicy::GetLookAheadScale(float Rate) const
+{
+    const float Steps = FMath::CeilToFloat(FMath::Abs(Rate) / SVFPlayRatePolicy::ScaleStep);
+    return FMath::Max(1.f, Steps * SVFPlayRatePolicy::ScaleStep);
+}
+
+FSVFBufferingTargets FSVFPlayRateBufferPolicy::GetTargetsForRate(float Rate) const
+{
+    const float Scale = GetLookAheadScale(Rate);
+    auto ScaleFrames = [this, Scale](uint32 Frames)
+    {
+        return FMath::Min(static_cast<uint32>(FMath::CeilToInt(Frames * Scale)), MaxBufferUpperBound);
+    };
+
+    FSVFBufferingTargets Targets;
+    Targets.MinBufferFrames = ScaleFrames(Base.MinBufferFrames);
+    Targets.MaxBufferFrames = FMath::Max(ScaleFrames(Base.MaxBufferFrames), Targets.MinBufferFrames);
+    Targets.BufferHysteresisFrames = FMath::Min(ScaleFrames(Base.BufferHysteresisFrames), Targets.MaxBufferFrames);
+    Targets.MaxDropFramesPerCall = static_cast<uint32>(FMath::CeilToInt(Base.MaxDropFramesPerCall * Scale));
+    Targets.DownloadBufferSeconds = FMath::CeilToInt(Base.DownloadBufferSeconds * Scale);
+    return Targets;
+}
+
+bool FSVFPlayRateBufferPolicy::UpdateRate(float Rate, FSVFBufferingTargets& OutTargets)
+{
+    const float NewScale = GetLookAheadScale(Rate);
+    bool bRetarget = false;
+    if (CurrentScale <= 0.f || NewScale > CurrentScale)
+    {
+        // Grow right away, the reader is about to be drained faster
+        bRetarget = true;
+    }
+    else if (NewScale < CurrentScale)
+    {
+        bRetarget = FMath::Abs(Rate) < CurrentScale - SVFPlayRatePolicy::ScaleStep - SVFPlayRatePolicy::ShrinkMargin;
+    }
+
+    if (!bRetarget)
+    {
+        return false;
+    }
+    CurrentScale = NewScale;
+    OutTargets = GetTargetsForRate(Rate);
+    return true;
+}
@@ -3,6 +3,8 @@
 #if PLATFORM_WINDOWS
 
 #include "SVFPrivateTypes.h"
+#include "SVFNormalPacking.h"
+#include "SVFVertexScatter.h"
 #include "UnrealSVF.h"
 #include "SVFClockInterface.h"
 #include "SVFCallbackInterface.h"
@@ -13,6 +15,7 @@
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "HAL/IPlatformFileModule.h"
 #include "HAL/PlatformFile.h"
+#include "Misc/ScopeLock.h"
 #include "Runtime/Launch/Resources/Version.h"
 
 #if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 26
@@ -152,6 +155,8 @@ USVFClockUseUnrealInterface::~USVFClockUseUnrealInterface() {
 
 // --------------------------------------------------------------------------
 HRESULT USVFClockUseUnrealInterface::Initialize(UObject* InUnrealObject) {
+    // May rebind a clock already in use by a reader, SVF threads must not see a half-updated binding
+    FScopeLock Lock(&BindingCS);
     UnrealClock = InUnrealObject;
     checkSlow(UnrealClock.IsValid());
     if (!UnrealClock.IsValid()) {
@@ -210,6 +215,7 @@ HRESULT STDMETHODCALLTYPE USVFClockUseUnrealInterface::QueryInterface(REFIID rii
 // --------------------------------------------------------------------------
 _Use_decl_annotations_
 HRESULT USVFClockUseUnrealInterface::GetPresentationTime(SVFTIME *pTime) {
+    FScopeLock Lock(&BindingCS);
     checkSlow(pTime);
     if (pTime == nullptr) {
         return E_POINTER;
@@ -227,6 +233,7 @@ HRESULT USVFClockUseUnrealInterface::GetPresentationTime(SVFTIME *pTime) {
 // --------------------------------------------------------------------------
 _Use_decl_annotations_
 HRESULT USVFClockUseUnrealInterface::GetTime(SVFTIME *pTime) {
+    FScopeLock Lock(&BindingCS);
     checkSlow(pTime);
     if (pTime == nullptr) {
         return E_POINTER;
@@ -243,6 +250,7 @@ HRESULT USVFClockUseUnrealInterface::GetTime(SVFTIME *pTime) {
 
 // --------------------------------------------------------------------------
 HRESULT USVFClockUseUnrealInterface::Start() {
+    FScopeLock Lock(&BindingCS);
     if (!UnrealClock.IsValid()) {
         return E_POINTER;
     }
@@ -255,6 +263,7 @@ HRESULT USVFClockUseUnrealInterface::Start() {
 
 // --------------------------------------------------------------------------
 HRESULT USVFClockUseUnrealInterface::Stop() {
+    FScopeLock Lock(&BindingCS);
     if (!UnrealClock.IsValid()) {
         return E_POINTER;
     }
@@ -268,6 +277,7 @@ HRESULT USVFClockUseUnrealInterface::Stop() {
 // --------------------------------------------------------------------------
 _Use_decl_annotations_
 HRESULT USVFClockUseUnrealInterface::GetState(ESVFClockState *pState) {
+    FScopeLock Lock(&BindingCS);
     checkSlow(pState);
     if (pState == nullptr) {
         return E_POINTER;
@@ -286,6 +296,7 @@ HRESULT USVFClockUseUnrealInterface::GetState(ESVFClockState *pState) {
 
 // --------------------------------------------------------------------------
 HRESULT USVFClockUseUnrealInterface::Shutdown() {
+    FScopeLock Lock(&BindingCS);
     if (!UnrealClock.IsValid()) {
         return E_POINTER;
     }
@@ -298,6 +309,7 @@ HRESULT USVFClockUseUnrealInterface::Shutdown() {
 
 // --------------------------------------------------------------------------
 HRESULT USVFClockUseUnrealInterface::SetPresentationOffset(SVFTIME t) {
+    FScopeLock Lock(&BindingCS);
     if (!UnrealClock.IsValid()) {
         return E_POINTER;
     }
@@ -310,6 +322,7 @@ HRESULT USVFClockUseUnrealInterface::SetPresentationOffset(SVFTIME t) {
 
 // --------------------------------------------------------------------------
 HRESULT USVFClockUseUnrealInterface::SnapPresentationOffset() {
+    FScopeLock Lock(&BindingCS);
     if (!UnrealClock.IsValid()) {
         return E_POINTER;
     }
@@ -323,6 +336,7 @@ HRESULT USVFClockUseUnrealInterface::SnapPresentationOffset() {
 // --------------------------------------------------------------------------
 _Use_decl_annotations_
 HRESULT USVFClockUseUnrealInterface::GetPresentationOffset(SVFTIME *pTime) {
+    FScopeLock Lock(&BindingCS);
     checkSlow(pTime);
     if (pTime == nullptr) {
         return E_POINTER;
@@ -339,6 +353,7 @@ HRESULT USVFClockUseUnrealInterface::GetPresentationOffset(SVFTIME *pTime) {
 
 // --------------------------------------------------------------------------
 HRESULT USVFClockUseUnrealInterface::SetScale(float scale) {
+    FScopeLock Lock(&BindingCS);
     if (!UnrealClock.IsValid()) {
         return E_POINTER;
     }
@@ -352,6 +367,7 @@ HRESULT USVFClockUseUnrealInterface::SetScale(float scale) {
 // --------------------------------------------------------------------------
 _Use_decl_annotations_
 HRESULT USVFClockUseUnrealInterface::GetScale(float *pScale) {
+    FScopeLock Lock(&BindingCS);
     checkSlow(pScale);
     if (pScale == nullptr) {
         return E_POINTER;
@@ -840,16 +856,20 @@ HRESULT SVFFrameHelper::CopyVerticesBuffer(ComPtr<ISVFBuffer>& spVertexBuffer, F
         return E_OUTOFMEMORY;
     }
 
+    // Constant parts of the tangent basis are packed once, not per vertex
+    const FPackedNormal TangentX(FVector(1, 0, 0));
+    const FPackedNormal UpTangentZ(FVector4(0, 0, 1, 1));
+    const FColor White(255, 255, 255);
     if (bUseNormal) {
         auto fData = (CSVFVertex_Norm_Full const*)lockedMem.pData;
         for (uint32 i = 0; i < VertexCount; ++i) {
             FDynamicMeshVertex& Vert = OutVertices[i];
             Vert.Position = FVector(fData[i].z, fData[i].x, fData[i].y);
             Vert.TextureCoordinate[0] = FVector2D(fData[i].u, fData[i].v);
-            Vert.TangentX = FVector(1, 0, 0);
-            Vert.TangentZ = FVector(-fData[i].nz, -fData[i].nx, -fData[i].ny);
-            Vert.TangentZ.Vector.W = 127;
-            Vert.Color = FColor(255, 255, 255);
+            Vert.TangentX = TangentX;
+            // nx, ny, nz are followed by u, so the four float load stays inside the vertex
+            Vert.TangentZ.Vector.Packed = SVFNormalPacking::PackSVFNormal(&fData[i].nx);
+            Vert.Color = White;
         }
     }
     else {
@@ -858,10 +878,9 @@ HRESULT SVFFrameHelper::CopyVerticesBuffer(ComPtr<ISVFBuffer>& spVertexBuffer, F
             FDynamicMeshVertex& Vert = OutVertices[i];
             Vert.Position = FVector(fData[i].z, fData[i].x, fData[i].y);
             Vert.TextureCoordinate[0] = FVector2D(fData[i].u, fData[i].v);
-            Vert.TangentX = FVector(1, 0, 0);
-            Vert.TangentZ = FVector(0, 0, 1);
-            Vert.TangentZ.Vector.W = 127;
-            Vert.Color = FColor(255, 255, 255);
+            Vert.TangentX = TangentX;
+            Vert.TangentZ = UpTangentZ;
+            Vert.Color = White;
         }
     }
 
@@ -870,6 +889,85 @@ HRESULT SVFFrameHelper::CopyVerticesBuffer(ComPtr<ISVFBuffer>& spVertexBuffer, F
     return S_OK;
 }
 
+HRESULT SVFFrameHelper::CopyVerticesStreams(ComPtr<ISVFBuffer>& spVertexBuffer, const FSVFVertexStreams& OutStreams, bool bUseNormal, uint32 VertexCount) {
+    if (!spVertexBuffer || !OutStreams.Positions) {
+        return E_POINTER;
+    }
+    if (VertexCount < 3 || OutStreams.TexCoordStride < 1) {
+        return E_INVALIDARG;
+    }
+
+    DWORD ActualSize = 0L;
+    HRESULT hr = S_OK;
+    spVertexBuffer->GetSize(&ActualSize);
+    uint32 NeedSize = VertexCount * (bUseNormal ? sizeof(CSVFVertex_Norm_Full) : sizeof(CSVFVertex_Full));
+    if (ActualSize != NeedSize) {
+        UE_LOG(LogTemp, Error, TEXT("ActualSize (%ld) not equal to NeedSize (%ld)"), ActualSize, NeedSize);
+        return E_UNEXPECTED;
+    }
+
+    SVFLockedMemory lockedMem;
+    ZeroMemory(&lockedMem, sizeof(lockedMem));
+    hr = spVertexBuffer->LockBuffer(&lockedMem);
+    if (FAILED(hr)) {
+        UE_LOG(LogTemp, Error, TEXT("Error in CopyVerticesStreams: failed to lock SVF vertex buffer, hr = 0x%08X"), hr);
+        return hr;
+    }
+    if (ActualSize < lockedMem.Size) {
+        UE_LOG(LogTemp, Error, TEXT("Error in CopyVerticesStreams: vertex buffer size is %ld while current frame vertex buffer size is %ld"), ActualSize, lockedMem.Size);
+        spVertexBuffer->UnlockBuffer();
+        return E_OUTOFMEMORY;
+    }
+
+    if (bUseNormal) {
+        SVFVertexScatter::ScatterSVFNormalVertices((CSVFVertex_Norm_Full const*)lockedMem.pData, VertexCount, OutStreams);
+    }
+    else {
+        SVFVertexScatter::ScatterSVFVertices((CSVFVertex_Full const*)lockedMem.pData, VertexCount, OutStreams);
+    }
+
+    spVertexBuffer->UnlockBuffer();
+
+    return S_OK;
+}
+
+HRESULT SVFFrameHelper::CopyVerticesPositions(ComPtr<ISVFBuffer>& spVertexBuffer, FVector* OutPositions, bool bUseNormal, uint32 VertexCount) {
+    if (!spVertexBuffer || !OutPositions) {
+        return E_POINTER;
+    }
+    if (VertexCount < 3) {
+        return E_INVALIDARG;
+    }
+
+    DWORD ActualSize = 0L;
+    HRESULT hr = S_OK;
+    spVertexBuffer->GetSize(&ActualSize);
+    const uint32 Stride = bUseNormal ? sizeof(CSVFVertex_Norm_Full) : sizeof(CSVFVertex_Full);
+    if (ActualSize != VertexCount * Stride) {
+        UE_LOG(LogTemp, Error, TEXT("ActualSize (%ld) not equal to NeedSize (%ld)"), ActualSize, VertexCount * Stride);
+        return E_UNEXPECTED;
+    }
+
+    SVFLockedMemory lockedMem;
+    ZeroMemory(&lockedMem, sizeof(lockedMem));
+    hr = spVertexBuffer->LockBuffer(&lockedMem);
+    if (FAILED(hr)) {
+        UE_LOG(LogTemp, Error, TEXT("Error in CopyVerticesPositions: failed to lock SVF vertex buffer, hr = 0x%08X"), hr);
+        return hr;
+    }
+
+    // Both layouts start with the position, same axis swap as CopyVerticesBuffer
+    const uint8* pData = static_cast<const uint8*>(lockedMem.pData);
+    for (uint32 i = 0; i < VertexCount; ++i) {
+        auto const& Vert = *reinterpret_cast<CSVFVertex_Full const*>(pData + i * Stride);
+        OutPositions[i] = FVector(Vert.z, Vert.x, Vert.y);
+    }
+
+    spVertexBuffer->UnlockBuffer();
+
+    return S_OK;
+}
+
 HRESULT SVFFrameHelper::CopyIndicesBuffer(ComPtr<ISVFBuffer>& spIndexBuffer, int32* OutIndices, uint32 IndicesCount) {
     if (!spIndexBuffer || !OutIndices) {
         return E_POINTER;
@@ -1326,6 +1424,11 @@ bool SVFHelpers::ObtainFileInfoFromSVF(const FString& InFilePath, ComPtr<ISVFRea
     {
         OutFileInfo.FileHeight = val32;
     }
+    hr = spReaderAttrib->GetUINT32(SVFAttrib_UseUnsignedUVs, &val32);
+    if (S_OK == hr)
+    {
+        OutFileInfo.hasUnsignedUVs = (val32 == 1L);
+    }
     if (OutFileInfo.FrameCount <= 0 && OutFileInfo.Duration.IsZero())
     {
         return false;
@@ -1450,6 +1553,7 @@ bool FFrameDataFromSVFBuffer::GetFrameVerticesWithNormal(TArray<FSVFVertexNorm>&
     }
 
     SCOPE_CYCLE_COUNTER(STAT_SVF_CopyVerticeBuffer);
+    FScopeLock Lock(&VertexBufferLock);
 
     ComPtr<ISVFBuffer> spVB;
     HRESULT hr = S_OK;
@@ -1505,6 +1609,7 @@ bool FFrameDataFromSVFBuffer::GetFrameVerticesWithoutNormal(TArray<FSVFVertex>&
     }
 
     SCOPE_CYCLE_COUNTER(STAT_SVF_CopyVerticeBuffer);
+    FScopeLock Lock(&VertexBufferLock);
 
     ComPtr<ISVFBuffer> spVB;
     HRESULT hr = S_OK;
@@ -1559,6 +1664,7 @@ bool FFrameDataFromSVFBuffer::GetFrameVertices(TArray<FDynamicMeshVertex>& OutVe
     }
 
     SCOPE_CYCLE_COUNTER(STAT_SVF_CopyVerticeBuffer);
+    FScopeLock Lock(&VertexBufferLock);
 
     ComPtr<ISVFBuffer> spVB;
     HRESULT hr = S_OK;
@@ -1583,6 +1689,7 @@ bool FFrameDataFromSVFBuffer::GetFrameVertices(FDynamicMeshVertex* OutVertices)
     }
 
     SCOPE_CYCLE_COUNTER(STAT_SVF_CopyVerticeBuffer);
+    FScopeLock Lock(&VertexBufferLock);
 
     ComPtr<ISVFBuffer> spVB;
     HRESULT hr = S_OK;
@@ -1596,6 +1703,47 @@ bool FFrameDataFromSVFBuffer::GetFrameVertices(FDynamicMeshVertex* OutVertices)
     return SUCCEEDED(SVFFrameHelper::CopyVerticesBuffer(spVB, OutVertices, bUseNormals, m_FrameInfo.vertexCount));
 }
 
+bool FFrameDataFromSVFBuffer::GetFrameStreams(const FSVFVertexStreams& OutStreams)
+{
+    checkSlow(m_Frame);
+    if (!m_Frame || m_FrameInfo.vertexCount < 3)
+    {
+        return false;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_SVF_CopyVerticeBuffer);
+    FScopeLock Lock(&VertexBufferLock);
+
+    ComPtr<ISVFBuffer> spVB;
+    HRESULT hr = SVFFrameHelper::ExtractVerticesBuffer(m_Frame, spVB);
+    if (FAILED(hr))
+    {
+        return false;
+    }
+    return SUCCEEDED(SVFFrameHelper::CopyVerticesStreams(spVB, OutStreams, bUseNormals, m_FrameInfo.vertexCount));
+}
+
+bool FFrameDataFromSVFBuffer::GetFramePositions(TArray<FVector>& OutPositions)
+{
+    checkSlow(m_Frame);
+    if (!m_Frame || m_FrameInfo.vertexCount < 3)
+    {
+        return false;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_SVF_CopyVerticeBuffer);
+    FScopeLock Lock(&VertexBufferLock);
+
+    ComPtr<ISVFBuffer> spVB;
+    HRESULT hr = SVFFrameHelper::ExtractVerticesBuffer(m_Frame, spVB);
+    if (FAILED(hr))
+    {
+        return false;
+    }
+    OutPositions.SetNumUninitialized(m_FrameInfo.vertexCount, false);
+    return SUCCEEDED(SVFFrameHelper::CopyVerticesPositions(spVB, OutPositions.GetData(), bUseNormals, m_FrameInfo.vertexCount));
+}
+
 bool FFrameDataFromSVFBuffer::GetFrameIndices(TArray<int32>& OutIndices)
 {
     checkSlow(m_Frame);
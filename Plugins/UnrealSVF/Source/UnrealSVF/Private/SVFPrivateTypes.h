@@ -91,6 +91,7 @@ public:
     USVFClockUseUnrealInterface();
     virtual ~USVFClockUseUnrealInterface();
 
+    // Binds (or rebinds) the clock to an object implementing ISVFClockInterface
     HRESULT Initialize(UObject* InUnrealObject);
 
     // IUnknown
@@ -121,6 +122,7 @@ protected:
 
     TWeakObjectPtr<UObject> UnrealClock;
     ISVFClockInterface* InterfacePtr = nullptr;
+    FCriticalSection BindingCS;
 
 };
 
@@ -219,13 +221,18 @@ struct FFrameDataFromSVFBuffer : public FFrameData {
     bool bUseNormals;
 
     std::shared_ptr<std::queue<HostageFrameD3D11>> m_hostageFrames;
+    // The staging worker and game thread queries may read the vertex buffer at the same time
+    FCriticalSection VertexBufferLock;
 
     virtual bool GetFrameInfo(FSVFFrameInfo& OutFrameInfo) override;
+    virtual bool HasNormals() const override { return bUseNormals; }
 
     virtual bool GetFrameVerticesWithNormal(TArray<FSVFVertexNorm>& OutVertices) override;
     virtual bool GetFrameVerticesWithoutNormal(TArray<FSVFVertex>& OutVertices) override;
     virtual bool GetFrameVertices(TArray<FDynamicMeshVertex>& OutVertices) override;
     virtual bool GetFrameVertices(FDynamicMeshVertex* OutVertices) override;
+    virtual bool GetFrameStreams(const FSVFVertexStreams& OutStreams) override;
+    virtual bool GetFramePositions(TArray<FVector>& OutPositions) override;
 
     virtual bool GetFrameIndices(TArray<int32>& OutIndices) override;
     virtual bool GetFrameIndices(int32* OutIndices) override;
@@ -250,6 +257,8 @@ namespace SVFFrameHelper {
     void UpdateSVFStatus(_In_ ISVFReader* pReader, _In_ ISVFFrame* pFrame, FSVFStatus& status);
 
     HRESULT CopyVerticesBuffer(ComPtr<ISVFBuffer>& spVertexBuffer, struct FDynamicMeshVertex* OutVertices, bool bUseNormal, uint32 VertexCount);
+    HRESULT CopyVerticesStreams(ComPtr<ISVFBuffer>& spVertexBuffer, const FSVFVertexStreams& OutStreams, bool bUseNormal, uint32 VertexCount);
+    HRESULT CopyVerticesPositions(ComPtr<ISVFBuffer>& spVertexBuffer, FVector* OutPositions, bool bUseNormal, uint32 VertexCount);
     HRESULT CopyIndicesBuffer(ComPtr<ISVFBuffer>& spIndexBuffer, int32* OutIndices, uint32 IndicesCount);
     HRESULT CopyTextureBuffer(ComPtr<ISVFBuffer>& spTextureBuffer, TArray<uint8>& OutData);
     HRESULT CopyTextureBuffer(ComPtr<ISVFBuffer>& spTextureBuffer, uint8** OutData, int32& OutDataSize, bool& bOutCalleeShouldFreeMemory);
@@ -107,6 +107,23 @@ bool FFrameDataAndroid::GetFrameVertices(FDynamicMeshVertex* OutVertices)
     return false;
 }
 
+bool FFrameDataAndroid::GetFrameStreams(const FSVFVertexStreams& OutStreams)
+{
+    WarnSVF("GetFrameStreams not implemented");
+    return false;
+}
+
+bool FFrameDataAndroid::GetFramePositions(TArray<FVector>& OutPositions)
+{
+    OutPositions.SetNumUninitialized(m_FrameInfo.vertexCount, false);
+    MeshVertex* pVertexBuffer = (MeshVertex*) m_VertexBuffer->GetData();
+    for (uint32 i = 0; i < m_FrameInfo.vertexCount; ++i)
+    {
+        OutPositions[i] = FVector(pVertexBuffer[i].pos.Z, pVertexBuffer[i].pos.X, pVertexBuffer[i].pos.Y);
+    }
+    return true;
+}
+
 bool FFrameDataAndroid::GetFrameIndices(TArray<int32>& OutIndices)
 {
     if (OutIndices.Num() != m_IndexBuffer->Num())
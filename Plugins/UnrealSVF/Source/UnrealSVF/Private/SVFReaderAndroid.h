@@ -41,11 +41,14 @@ struct UNREALSVF_API FFrameDataAndroid : public FFrameData
 
     virtual void UnrealRenderEvent_RenderThread() override;
     virtual bool GetFrameInfo(FSVFFrameInfo& OutFrameInfo) override;
+    virtual bool HasNormals() const override { return bUseNormals; }
 
     virtual bool GetFrameVerticesWithNormal(TArray<FSVFVertexNorm>& OutVertices) override;
     virtual bool GetFrameVerticesWithoutNormal(TArray<FSVFVertex>& OutVertices) override;
     virtual bool GetFrameVertices(TArray<FDynamicMeshVertex>& OutVertices) override;
     virtual bool GetFrameVertices(FDynamicMeshVertex* OutVertices) override;
+    virtual bool GetFrameStreams(const FSVFVertexStreams& OutStreams) override;
+    virtual bool GetFramePositions(TArray<FVector>& OutPositions) override;
 
     virtual bool GetFrameIndices(TArray<int32>& OutIndices) override;
     virtual bool GetFrameIndices(int32* OutIndices) override;
@@ -82,6 +85,9 @@ public:
     virtual bool CanSeek() override;
     virtual bool SeekToPercent(float SeekToPercent) override;
     virtual void SetReaderClockScale(float ClockScale) override;
+    // Buffering is managed inside the native plugin on Android
+    virtual void UpdateBufferingForRate(float InRate) override {};
+    virtual void SetBufferPriority(float InPriority) override {};
     virtual void SetPlayFlow(bool bIsForwardPlay) override {};
 
     virtual FSVFFileInfo GetFileInfo() override
@@ -12,9 +12,20 @@
 #include "D3D11Resources.h"
 #endif
 #include "Stats/Stats.h"
+#include "Async/Async.h"
+#include "SVFParkedClock.h"
+#include "SVFReaderPoolBudget.h"
+#include "SVFBufferBudgetManager.h"
+#include "Misc/ScopeExit.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogSVFReaderLive, Log, All);
 
+namespace SVFReaderPassThrough
+{
+    // How long before the end of a loop the standby reader is opened; covers open and preroll
+    const int64 LoopStandbyLeadTime = 2 * ETimespan::TicksPerSecond;
+}
+
 #define LogSVF(pmt, ...) UE_LOG(LogSVFReaderLive, Log, TEXT(pmt), ##__VA_ARGS__)
 #define WarnSVF(pmt, ...) UE_LOG(LogSVFReaderLive, Warning, TEXT(pmt), ##__VA_ARGS__)
 #define FatalSVF(pmt, ...) UE_LOG(LogSVFReaderLive, Fatal, TEXT(pmt), ##__VA_ARGS__)
@@ -48,6 +59,8 @@ bool USVFReaderPassThrough::CreateInstance(UObject* InOwner, const FString& File
     }
 
     HRESULT hr = S_OK;
+    pWrapperObj->m_FilePath = FilePath;
+    pWrapperObj->m_OpenInfo = OpenInfo;
     hr = pWrapperObj->CreateReader(FilePath, OpenInfo, CustomClockObject);
     if (FAILED(hr))
     {
@@ -62,6 +75,92 @@ bool USVFReaderPassThrough::CreateInstance(UObject* InOwner, const FString& File
 
 HRESULT USVFReaderPassThrough::CreateReader(const FString& FilePath, const FSVFOpenInfo& OpenInfo, UObject* CustomClockObject)
 {
+    SVFConfiguration svfConfig;
+    PrepareReaderConfig(FilePath, OpenInfo, svfConfig);
+    return OpenReader(FilePath, OpenInfo, CustomClockObject, svfConfig);
+}
+
+void USVFReaderPassThrough::PrepareReaderConfig(const FString& FilePath, const FSVFOpenInfo& OpenInfo, SVFConfiguration& svfConfig)
+{
+    svfConfig.disableAudio = OpenInfo.AudioDisabled;
+    svfConfig.returnAudio = false;
+    svfConfig.playAudio = !(OpenInfo.AudioDisabled);
+    svfConfig.outputNV12 = false; // we will use RGBA format
+    svfConfig.useHardwareDecode = true;
+    svfConfig.useKeyedMutex = OpenInfo.UseKeyedMutex;
+    svfConfig.useHardwareTextures = true;
+    svfConfig.outputVertexFormat = ESVFOutputVertexFormat::Position | ESVFOutputVertexFormat::UV | ESVFOutputVertexFormat::Uncompressed;
+    svfConfig.looping = OpenInfo.AutoLooping ? ESVFLoop::LoopViaRestart : ESVFLoop::NoLooping;
+    bLoop = OpenInfo.AutoLooping;
+    if (svfConfig.useHardwareDecode && FString(TEXT("D3D11")).Equals(GDynamicRHI->GetName()))
+    {
+        svfConfig.spDevice = nullptr;
+    }
+    if (svfConfig.useHardwareTextures == false)
+    {
+        // for software mode, re-adjust internal SVF buffers to prevent E_OUTOFMEMORY
+        svfConfig.minBufferSize = 15;
+        svfConfig.maxBufferSize = 50;
+        svfConfig.bufferHysteresis = 17;
+        svfConfig.maxBufferUpperBound = 100;
+        svfConfig.maxDropFramesPerCall = 3;
+        svfConfig.allowableDelay = 500;
+    }
+    svfConfig.looping = ESVFLoop::NoLooping; // plugin takes care of looping
+    if (OpenInfo.OutputNormals)
+    {
+        svfConfig.outputVertexFormat |= ESVFOutputVertexFormat::Normal;
+    }
+    bUseNormal = OpenInfo.OutputNormals;
+    svfConfig.clockScale = OpenInfo.playbackRate;
+
+    // Size the look-ahead for the rate the file is opened with
+    {
+        FSVFBufferingTargets BaseTargets;
+        BaseTargets.MinBufferFrames = svfConfig.minBufferSize;
+        BaseTargets.MaxBufferFrames = svfConfig.maxBufferSize;
+        BaseTargets.BufferHysteresisFrames = svfConfig.bufferHysteresis;
+        BaseTargets.MaxDropFramesPerCall = svfConfig.maxDropFramesPerCall;
+        BaseTargets.DownloadBufferSeconds = 10;
+        FString SectionBlock = GIsEditor ? TEXT("SVFSettings_Editor") : TEXT("SVFSettings");
+        GConfig->GetInt(*SectionBlock, TEXT("DownloadBufferSeconds"), BaseTargets.DownloadBufferSeconds, GEngineIni);
+        PlayRatePolicy.SetBaseTargets(BaseTargets, svfConfig.maxBufferUpperBound);
+
+        const FSVFBufferingTargets Targets = PlayRatePolicy.GetTargetsForRate(OpenInfo.playbackRate);
+        svfConfig.minBufferSize = Targets.MinBufferFrames;
+        svfConfig.maxBufferSize = Targets.MaxBufferFrames;
+        svfConfig.bufferHysteresis = Targets.BufferHysteresisFrames;
+        svfConfig.maxDropFramesPerCall = Targets.MaxDropFramesPerCall;
+    }
+    if (OpenInfo.LockStepDecode)
+    {
+        // Every frame is consumed in order, lateness is irrelevant; keep the decoder as far ahead as allowed
+        svfConfig.allowDroppedFrames = false;
+        svfConfig.maxDropFramesPerCall = 0;
+        svfConfig.maxBufferSize = FMath::Min(svfConfig.maxBufferSize * 2, svfConfig.maxBufferUpperBound);
+        svfConfig.startDownloadWhenOpen = true;
+    }
+
+    // Share the memory budget with the readers already open, the decoded depth is fixed from here on
+    FSVFBufferBudgetManager& BufferBudget = FSVFBufferBudgetManager::Get();
+    svfConfig.maxBufferSize = BufferBudget.ReserveFrames(GetUniqueID(), FilePath, svfConfig.minBufferSize, svfConfig.maxBufferSize,
+        PlayRatePolicy.GetTargetsForRate(OpenInfo.playbackRate).DownloadBufferSeconds, OpenInfo.BufferPriority);
+    svfConfig.bufferHysteresis = FMath::Min(svfConfig.bufferHysteresis, svfConfig.maxBufferSize);
+}
+
+HRESULT USVFReaderPassThrough::OpenReader(const FString& FilePath, const FSVFOpenInfo& OpenInfo, UObject* CustomClockObject, SVFConfiguration svfConfig)
+{
+    // The budget reservation from PrepareReaderConfig is released again if the reader doesn't open
+    FSVFBufferBudgetManager& BufferBudget = FSVFBufferBudgetManager::Get();
+    bool bOpened = false;
+    ON_SCOPE_EXIT
+    {
+        if (!bOpened)
+        {
+            BufferBudget.Unregister(GetUniqueID());
+        }
+    };
+
     HRESULT hr = S_OK;
     ComPtr<ISVFBufferAllocator> spBufferAllocator;
     SVFReaderConfiguration readerConfig;
@@ -92,6 +191,8 @@ HRESULT USVFReaderPassThrough::CreateReader(const FString& FilePath, const FSVFO
         {
             spCustomClock = spPluginClock;
             m_ClockObject = CustomClockObject;
+            // kept so the reader can be moved to another clock later (loop standby)
+            m_spPluginClock = spPluginClock;
         }
         spPluginClock = nullptr;
     }
@@ -104,53 +205,11 @@ HRESULT USVFReaderPassThrough::CreateReader(const FString& FilePath, const FSVFO
         return hr;
     }
 
+    hr = RegisterNotifier(spReader);
+    if (hr == E_OUTOFMEMORY)
     {
-        ComPtr<USVFReaderCallbackUseUnrealInterface> spNotifierWrapper = new USVFReaderCallbackUseUnrealInterface();
-        if (!spNotifierWrapper)
-        {
-            return E_OUTOFMEMORY;
-        }
-        hr = spNotifierWrapper->Initialize(this);
-        if (SUCCEEDED(hr))
-        {
-            spReader->SetNotifyState(spNotifierWrapper.Get());
-            spReader->SetNoifyInternalState(spNotifierWrapper.Get());
-        }
-        spNotifierWrapper = nullptr;
-    }
-
-    SVFConfiguration svfConfig;
-    svfConfig.disableAudio = OpenInfo.AudioDisabled;
-    svfConfig.returnAudio = false;
-    svfConfig.playAudio = !(OpenInfo.AudioDisabled);
-    svfConfig.outputNV12 = false; // we will use RGBA format
-    svfConfig.useHardwareDecode = true;
-    svfConfig.useKeyedMutex = OpenInfo.UseKeyedMutex;
-    svfConfig.useHardwareTextures = true;
-    svfConfig.outputVertexFormat = ESVFOutputVertexFormat::Position | ESVFOutputVertexFormat::UV | ESVFOutputVertexFormat::Uncompressed;
-    svfConfig.looping = OpenInfo.AutoLooping ? ESVFLoop::LoopViaRestart : ESVFLoop::NoLooping;
-    bLoop = OpenInfo.AutoLooping;
-    if (svfConfig.useHardwareDecode && FString(TEXT("D3D11")).Equals(GDynamicRHI->GetName()))
-    {
-        svfConfig.spDevice = nullptr;
-    }
-    if (svfConfig.useHardwareTextures == false)
-    {
-        // for software mode, re-adjust internal SVF buffers to prevent E_OUTOFMEMORY
-        svfConfig.minBufferSize = 15;
-        svfConfig.maxBufferSize = 50;
-        svfConfig.bufferHysteresis = 17;
-        svfConfig.maxBufferUpperBound = 100;
-        svfConfig.maxDropFramesPerCall = 3;
-        svfConfig.allowableDelay = 500;
-    }
-    svfConfig.looping = ESVFLoop::NoLooping; // plugin takes care of looping
-    if (OpenInfo.OutputNormals)
-    {
-        svfConfig.outputVertexFormat |= ESVFOutputVertexFormat::Normal;
+        return hr;
     }
-    bUseNormal = OpenInfo.OutputNormals;
-    svfConfig.clockScale = OpenInfo.playbackRate;
 
 #ifdef SUPPORT_HRTF
     // Initialize HRTF audio settings
@@ -205,9 +264,72 @@ HRESULT USVFReaderPassThrough::CreateReader(const FString& FilePath, const FSVFO
     SVFHelpers::CopyConfig(svfConfig, m_svfConfig);
     m_spReader = nullptr;
     m_spReader = spReader;
+    bOpened = true;
+    {
+        // Budget changes come from whichever reader opens or closes, apply them on the game thread
+        TWeakObjectPtr<USVFReaderPassThrough> WeakThis(this);
+        const uint64 FrameBytes = FSVFReaderPoolBudget::EstimateReaderBytes(FileInfo.FileWidth, FileInfo.FileHeight,
+            FileInfo.MaxVertexCount, FileInfo.MaxIndexCount, 1, bUseNormal);
+        const uint64 StreamBytesPerSecond = static_cast<uint64>(FMath::Max(0.f, FileInfo.BitrateMbps) * 1000.f * 1000.f / 8.f);
+        BufferBudget.OnReaderOpened(GetUniqueID(), FrameBytes, StreamBytesPerSecond, svfConfig.maxBufferSize, [WeakThis](int32 Seconds)
+        {
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, Seconds]()
+            {
+                if (USVFReaderPassThrough* Reader = WeakThis.Get())
+                {
+                    Reader->ApplyBudgetDownloadSeconds(Seconds);
+                }
+            });
+        });
+    }
+    if (OpenInfo.playbackRate != 1.f || FSVFBufferBudgetManager::Get().IsEnabled())
+    {
+        UpdateBufferingForRate(OpenInfo.playbackRate);
+    }
+    else
+    {
+        // At the normal rate without a budget the download buffer stays as the reader opened it; the policy
+        // only notes the rate so later changes are measured from it
+        FSVFBufferingTargets Targets;
+        PlayRatePolicy.UpdateRate(OpenInfo.playbackRate, Targets);
+    }
+    LoopSeam.Configure(FileInfo.FrameCount, FileInfo.Duration.GetTicks(), SVFReaderPassThrough::LoopStandbyLeadTime);
     return S_OK;
 }
 
+HRESULT USVFReaderPassThrough::RegisterNotifier(const ComPtr<ISVFReader>& spReader)
+{
+    ComPtr<USVFReaderCallbackUseUnrealInterface> spNotifierWrapper = new USVFReaderCallbackUseUnrealInterface();
+    if (!spNotifierWrapper)
+    {
+        return E_OUTOFMEMORY;
+    }
+    HRESULT hr = spNotifierWrapper->Initialize(this);
+    if (SUCCEEDED(hr))
+    {
+        spReader->SetNotifyState(spNotifierWrapper.Get());
+        spReader->SetNoifyInternalState(spNotifierWrapper.Get());
+    }
+    spNotifierWrapper = nullptr;
+    return hr;
+}
+
+HRESULT USVFReaderPassThrough::SetDownloadBufferSize(int32 Seconds)
+{
+    if (!m_spReader)
+    {
+        return E_POINTER;
+    }
+
+    ComPtr<ISVFBufferedStream> spBufferedStream;
+    HRESULT hr = m_spReader->QueryInterface(__uuidof(ISVFBufferedStream), (void**)(&spBufferedStream));
+    if (SUCCEEDED(hr))
+    {
+        hr = spBufferedStream->SetBufferSize(Seconds);
+    }
+    return hr;
+}
+
 /*USVFReaderPassThrough::USVFReaderPassThrough(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
     , m_svfBufferedFramesCount(0L)
@@ -227,9 +349,17 @@ USVFReaderPassThrough::USVFReaderPassThrough()
 
 USVFReaderPassThrough::~USVFReaderPassThrough()
 {
+    WaitForParkedOpen();
+    FSVFBufferBudgetManager::Get().Unregister(GetUniqueID());
     m_spReader = nullptr;
 }
 
+bool USVFReaderPassThrough::IsReadyForFinishDestroy()
+{
+    // A parked open still running on the thread pool writes into this object
+    return Super::IsReadyForFinishDestroy() && (!ParkedOpen.IsValid() || ParkedOpen.IsReady());
+}
+
 bool USVFReaderPassThrough::GetClock(ISVFClockInterface*& OutClock)
 {
     checkSlow(m_spReader);
@@ -256,7 +386,13 @@ bool USVFReaderPassThrough::BeginPlayback()
         return false;
     }
 
-    return SUCCEEDED(m_spReader->BeginPlayback());
+    // Parked readers began playback to preroll
+    if (bPlaybackBegun)
+    {
+        return true;
+    }
+    bPlaybackBegun = SUCCEEDED(m_spReader->BeginPlayback());
+    return bPlaybackBegun;
 }
 
 bool USVFReaderPassThrough::StartSource(int64 timeInStreamUnits)
@@ -271,6 +407,7 @@ bool USVFReaderPassThrough::StartSource(int64 timeInStreamUnits)
         SVFAutoLock lock(m_statusCS);
         m_svfBufferedFramesCount = 0L;
     }
+    LoopSeam.Reset();
 
     return SUCCEEDED(m_spReader->StartSource(timeInStreamUnits));
 }
@@ -344,6 +481,8 @@ bool USVFReaderPassThrough::GetNextFrameViaClock(bool& bNewFrame, bool *pEndOfSt
         return false;
     }
 
+    UpdateLoopSeam();
+
     ISVFFrame* ppFrame = nullptr;
     HRESULT hr = m_spReader->GetNextFrameViaClock(&ppFrame, pEndOfStream);
 
@@ -390,7 +529,7 @@ bool USVFReaderPassThrough::GetNextFrameViaClock(bool& bNewFrame, bool *pEndOfSt
 
             }
         }
-        if ((*pEndOfStream) && bLoop)
+        if ((*pEndOfStream) && bLoop && !IsGaplessLoopEnabled())
         {
             StartSource(0);
         }
@@ -398,9 +537,304 @@ bool USVFReaderPassThrough::GetNextFrameViaClock(bool& bNewFrame, bool *pEndOfSt
 
     bNewFrame = SUCCEEDED(hr) && hr != S_FALSE && ppFrame;
 
+    if (IsGaplessLoopEnabled() && (bNewFrame || *pEndOfStream))
+    {
+        LoopSeam.OnFramePresented(static_cast<int64>(m_FrameInfo.frameTimestamp), *pEndOfStream);
+    }
+    if (bNewFrame)
+    {
+        // the previous loop's last frame is off screen now
+        ReleaseRetiredReader();
+    }
+
     return SUCCEEDED(hr);
 }
 
+bool USVFReaderPassThrough::IsGaplessLoopEnabled() const
+{
+    // The seam is placed by shifting the presentation offset, which needs the plugin clock
+    return bLoop && m_OpenInfo.GaplessLooping && !m_OpenInfo.LockStepDecode && m_spPluginClock && m_ClockObject.IsValid();
+}
+
+void USVFReaderPassThrough::UpdateLoopSeam()
+{
+    if (!IsGaplessLoopEnabled())
+    {
+        return;
+    }
+
+    SVFTIME PresentationTime = 0;
+    if (FAILED(m_spPluginClock->GetPresentationTime(&PresentationTime)))
+    {
+        return;
+    }
+
+    switch (LoopSeam.Update(PresentationTime, GetLoopStandbyState()))
+    {
+    case ESVFLoopSeamAction::PrepareStandby:
+        PrepareLoopStandby();
+        break;
+    case ESVFLoopSeamAction::SwitchToStandby:
+        if (!SwitchToLoopStandby())
+        {
+            DiscardLoopStandby();
+            StartSource(0);
+        }
+        break;
+    case ESVFLoopSeamAction::RestartSource:
+        WarnSVF("Loop standby for %s not ready at the loop point, restarting the reader", *m_FilePath);
+        DiscardLoopStandby();
+        StartSource(0);
+        break;
+    default:
+        break;
+    }
+}
+
+void USVFReaderPassThrough::PrepareLoopStandby()
+{
+    if (LoopStandby)
+    {
+        return;
+    }
+    if (!LoopParkedClock)
+    {
+        LoopParkedClock = NewObject<USVFParkedClock>(this);
+    }
+    LoopStandby = NewObject<USVFReaderPassThrough>(this);
+    LoopStandbyOpen = LoopStandby->OpenParkedAsync(m_FilePath, m_OpenInfo, LoopParkedClock);
+}
+
+TSharedFuture<HRESULT> USVFReaderPassThrough::OpenParkedAsync(const FString& FilePath, const FSVFOpenInfo& OpenInfo, UObject* ParkedClock)
+{
+    check(IsInGameThread());
+    FSVFOpenInfo ParkedOpenInfo = OpenInfo;
+    ParkedOpenInfo.StartDownloadOnOpen = true;
+    // Set before the task starts so the reader can be matched while it is still opening
+    m_FilePath = FilePath;
+    m_OpenInfo = ParkedOpenInfo;
+
+    // Engine config, the RHI and the buffer budget are read here, the task only talks to SVF
+    SVFConfiguration svfConfig;
+    PrepareReaderConfig(FilePath, ParkedOpenInfo, svfConfig);
+
+    // The task uses this object until it finishes: Close waits for it and GC holds off destroying the
+    // object meanwhile (IsReadyForFinishDestroy), whoever else keeps the future
+    ParkedOpen = Async(EAsyncExecution::ThreadPool, [this, FilePath, ParkedOpenInfo, ParkedClock, svfConfig]() -> HRESULT
+    {
+        HRESULT hr = OpenReader(FilePath, ParkedOpenInfo, ParkedClock, svfConfig);
+        if (SUCCEEDED(hr))
+        {
+            hr = BeginPlayback() ? S_OK : E_FAIL;
+        }
+        return hr;
+    }).Share();
+    return ParkedOpen;
+}
+
+void USVFReaderPassThrough::WaitForParkedOpen()
+{
+    if (ParkedOpen.IsValid())
+    {
+        ParkedOpen.Wait();
+    }
+}
+
+bool USVFReaderPassThrough::Park(UObject* ParkedClock)
+{
+    if (!m_spReader || !m_spPluginClock || !ParkedClock)
+    {
+        return false;
+    }
+
+    DiscardLoopStandby();
+    ReleaseRetiredReader();
+
+    // Rebind first, so stopping the reader's clock does not stop the component
+    m_spPluginClock->Initialize(ParkedClock);
+    m_ClockObject = ParkedClock;
+    m_spReader->StopClock();
+    if (!StartSource(0))
+    {
+        return false;
+    }
+
+    if (m_Frame)
+    {
+        m_Frame->Release();
+        m_Frame = nullptr;
+    }
+    ZeroMemory(&m_FrameInfo, sizeof(m_FrameInfo));
+    {
+        SVFAutoLock lock(m_statusCS);
+        m_svfStatus.errorHresult = S_OK;
+        m_svfStatus.unsuccessfulReadFrameCount = 0;
+    }
+    return true;
+}
+
+bool USVFReaderPassThrough::RebindClock(UObject* ClockObject)
+{
+    if (!m_spReader || !m_spPluginClock || !ClockObject)
+    {
+        return false;
+    }
+    if (FAILED(m_spPluginClock->Initialize(ClockObject)))
+    {
+        return false;
+    }
+    m_ClockObject = ClockObject;
+    return true;
+}
+
+bool USVFReaderPassThrough::Unpark(UObject* ClockObject, float InPlayRate)
+{
+    if (!RebindClock(ClockObject))
+    {
+        return false;
+    }
+
+    // The clip starts wherever the new clock is now
+    m_spPluginClock->SnapPresentationOffset();
+    m_spReader->SetClockScale(InPlayRate);
+    UpdateBufferingForRate(InPlayRate);
+    return true;
+}
+
+bool USVFReaderPassThrough::IsOpenedWith(const FString& FilePath, const FSVFOpenInfo& OpenInfo) const
+{
+    // Everything baked into the reader configuration at open has to match; the rate is applied on unpark
+    return m_FilePath == FilePath &&
+        m_OpenInfo.AudioDisabled == OpenInfo.AudioDisabled &&
+        m_OpenInfo.UseKeyedMutex == OpenInfo.UseKeyedMutex &&
+        m_OpenInfo.OutputNormals == OpenInfo.OutputNormals &&
+        m_OpenInfo.AutoLooping == OpenInfo.AutoLooping &&
+        m_OpenInfo.GaplessLooping == OpenInfo.GaplessLooping &&
+        m_OpenInfo.LockStepDecode == OpenInfo.LockStepDecode &&
+        m_OpenInfo.forceSoftwareClock == OpenInfo.forceSoftwareClock &&
+        m_OpenInfo.AudioDeviceId == OpenInfo.AudioDeviceId;
+}
+
+uint64 USVFReaderPassThrough::GetEstimatedMemoryBytes() const
+{
+    return FSVFReaderPoolBudget::EstimateReaderBytes(FileInfo.FileWidth, FileInfo.FileHeight,
+        FileInfo.MaxVertexCount, FileInfo.MaxIndexCount, m_svfConfig.maxBufferSize, bUseNormal) + m_svfConfig.maxCompressedBufferSize;
+}
+
+ESVFLoopStandbyState USVFReaderPassThrough::GetLoopStandbyState()
+{
+    if (!LoopStandby || !LoopStandbyOpen.IsValid())
+    {
+        return ESVFLoopStandbyState::None;
+    }
+    if (!LoopStandbyOpen.IsReady())
+    {
+        return ESVFLoopStandbyState::Preparing;
+    }
+    if (FAILED(LoopStandbyOpen.Get()))
+    {
+        return ESVFLoopStandbyState::Failed;
+    }
+
+    FSVFStatus StandbyStatus;
+    if (!LoopStandby->GetSVFStatus(StandbyStatus))
+    {
+        return ESVFLoopStandbyState::Failed;
+    }
+    switch (static_cast<ESVFReaderState>(StandbyStatus.lastKnownState))
+    {
+    case ESVFReaderState::Ready:
+        return ESVFLoopStandbyState::Ready;
+    case ESVFReaderState::Unknown:
+    case ESVFReaderState::Initialized:
+    case ESVFReaderState::OpenPending:
+    case ESVFReaderState::Opened:
+    case ESVFReaderState::Prerolling:
+    case ESVFReaderState::Buffering:
+        return ESVFLoopStandbyState::Preparing;
+    default:
+        return ESVFLoopStandbyState::Failed;
+    }
+}
+
+bool USVFReaderPassThrough::SwitchToLoopStandby()
+{
+    if (!LoopStandby || !LoopStandby->m_spReader || !LoopStandby->m_spPluginClock)
+    {
+        return false;
+    }
+
+    SVFTIME PresentationOffset = 0;
+    float ClockScale = 1.f;
+    m_spPluginClock->GetPresentationOffset(&PresentationOffset);
+    m_spPluginClock->GetScale(&ClockScale);
+
+    // Retire the current reader: no more notifications, and it no longer follows the component clock
+    m_spReader->SetNotifyState(nullptr);
+    m_spReader->SetNoifyInternalState(nullptr);
+    m_spPluginClock->Initialize(LoopParkedClock);
+    ReleaseRetiredReader();
+    m_spRetiredReader = m_spReader;
+
+    m_spReader = LoopStandby->m_spReader;
+    m_spPluginClock = LoopStandby->m_spPluginClock;
+    // Same clip and buffering, the budget entry of this reader keeps covering it
+    FSVFBufferBudgetManager::Get().Unregister(LoopStandby->GetUniqueID());
+    LoopStandby->m_spReader = nullptr;
+    LoopStandby->m_spPluginClock = nullptr;
+    LoopStandby->MarkPendingKill();
+    LoopStandby = nullptr;
+    LoopStandbyOpen = TSharedFuture<HRESULT>();
+
+    m_spPluginClock->Initialize(m_ClockObject.Get());
+    RegisterNotifier(m_spReader);
+    {
+        SVFAutoLock lock(m_statusCS);
+        m_svfStatus.lastKnownState = static_cast<int>(ESVFReaderState::Ready);
+        m_svfBufferedFramesCount = 0L;
+    }
+    m_spReader->SetClockScale(ClockScale);
+    if (BudgetDownloadSeconds != INDEX_NONE)
+    {
+        SetDownloadBufferSize(BudgetDownloadSeconds);
+    }
+    m_spReader->StartClock();
+    // Frame 0 of the new loop is due exactly where the previous loop ends
+    m_spPluginClock->SetPresentationOffset(PresentationOffset + LoopSeam.GetLoopDuration());
+    m_FrameInfo.isEOS = false;
+    return true;
+}
+
+void USVFReaderPassThrough::DiscardLoopStandby()
+{
+    if (!LoopStandby)
+    {
+        return;
+    }
+    if (LoopStandbyOpen.IsValid())
+    {
+        LoopStandbyOpen.Wait();
+    }
+    LoopStandby->Close();
+    LoopStandby->MarkPendingKill();
+    LoopStandby = nullptr;
+    LoopStandbyOpen = TSharedFuture<HRESULT>();
+}
+
+void USVFReaderPassThrough::ReleaseRetiredReader()
+{
+    if (!m_spRetiredReader)
+    {
+        return;
+    }
+    ComPtr<ISVFReader> spRetiredReader = m_spRetiredReader;
+    m_spRetiredReader = nullptr;
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [spRetiredReader]()
+    {
+        spRetiredReader->Close();
+    });
+}
+
 void USVFReaderPassThrough::GetFrameInfo(FSVFFrameInfo& OutFrameInfo)
 {
     SVFHelpers::CopyFrameInfo(m_FrameInfo, OutFrameInfo);
@@ -447,6 +881,11 @@ void USVFReaderPassThrough::Wakeup()
 
 void USVFReaderPassThrough::Close()
 {
+    WaitForParkedOpen();
+    FSVFBufferBudgetManager::Get().Unregister(GetUniqueID());
+    DiscardLoopStandby();
+    ReleaseRetiredReader();
+    m_spPluginClock = nullptr;
     if (m_Frame)
     {
         m_Frame->Release();
@@ -463,6 +902,11 @@ void USVFReaderPassThrough::Close()
 
 void USVFReaderPassThrough::Close_BackgroundThread()
 {
+    WaitForParkedOpen();
+    FSVFBufferBudgetManager::Get().Unregister(GetUniqueID());
+    DiscardLoopStandby();
+    ReleaseRetiredReader();
+    m_spPluginClock = nullptr;
     if (m_Frame)
     {
         m_Frame->Release();
@@ -580,6 +1024,7 @@ void USVFReaderPassThrough::Rewind()
     {
         m_spReader->StartSource(0);
         m_FrameInfo.isEOS = false;
+        LoopSeam.Reset();
     }
 }
 
@@ -632,6 +1077,45 @@ void USVFReaderPassThrough::SetReaderClockScale(float ClockScale)
     m_spReader->SetClockScale(ClockScale);
 }
 
+void USVFReaderPassThrough::UpdateBufferingForRate(float InRate)
+{
+    // Decoded frame buffers are fixed once the file is open, only the download buffer can follow the rate
+    FSVFBufferingTargets Targets;
+    if (m_spReader && PlayRatePolicy.UpdateRate(InRate, Targets))
+    {
+        // A budgeted reader gets its share of what the rate asks for through ApplyBudgetDownloadSeconds
+        if (FSVFBufferBudgetManager::Get().SetMaxDownloadSeconds(GetUniqueID(), Targets.DownloadBufferSeconds))
+        {
+            return;
+        }
+        HRESULT hr = SetDownloadBufferSize(Targets.DownloadBufferSeconds);
+        if (FAILED(hr))
+        {
+            WarnSVF("Failed to resize download buffer to %d seconds, hr = 0x%08X", Targets.DownloadBufferSeconds, hr);
+        }
+    }
+}
+
+void USVFReaderPassThrough::ApplyBudgetDownloadSeconds(int32 Seconds)
+{
+    BudgetDownloadSeconds = Seconds;
+    if (!m_spReader)
+    {
+        return;
+    }
+    HRESULT hr = SetDownloadBufferSize(Seconds);
+    if (FAILED(hr))
+    {
+        WarnSVF("Failed to resize download buffer to %d seconds, hr = 0x%08X", Seconds, hr);
+    }
+}
+
+void USVFReaderPassThrough::SetBufferPriority(float InPriority)
+{
+    m_OpenInfo.BufferPriority = InPriority;
+    FSVFBufferBudgetManager::Get().SetPriority(GetUniqueID(), InPriority);
+}
+
 void USVFReaderPassThrough::SetAudioVolume(float volume)
 {
     checkSlow(m_spReader);
@@ -657,6 +1141,7 @@ float USVFReaderPassThrough::GetAudioVolume()
 #else
 USVFReaderPassThrough::USVFReaderPassThrough() {}
 USVFReaderPassThrough::~USVFReaderPassThrough() {}
+bool USVFReaderPassThrough::IsReadyForFinishDestroy() { return Super::IsReadyForFinishDestroy(); }
 #endif
 
 #undef LogSVF
@@ -6,6 +6,9 @@
 #include "UObject/NoExportTypes.h"
 #include "SVFSimpleInterface.h"
 #include "SVFCallbackInterface.h"
+#include "SVFPlayRatePolicy.h"
+#include "SVFLoopSeam.h"
+#include "Async/Future.h"
 
 #if PLATFORM_WINDOWS
 #include "PreSVFAPI.h"
@@ -26,6 +29,9 @@ public:
 
     USVFReaderPassThrough();
     ~USVFReaderPassThrough();
+
+    // ~ UObject interface
+    virtual bool IsReadyForFinishDestroy() override;
 #if PLATFORM_WINDOWS
 
     static bool CreateInstance(UObject* InOwner, const FString& FilePath, const FSVFOpenInfo& OpenInfo, UObject** OutWrapper, UObject* CustomClockObject);
@@ -66,6 +72,8 @@ public:
     virtual bool SeekToTime(const FTimespan& InTime) override;
     virtual bool SeekToPercent(float SeekToPercent) override;
     virtual void SetReaderClockScale(float ClockScale) override;
+    virtual void UpdateBufferingForRate(float InRate) override;
+    virtual void SetBufferPriority(float InPriority) override;
     virtual bool GetSeekRange(FInt32Range& OutFrameRange) override { return false; }
     virtual bool ForceFlush() override { return true; }
     virtual bool CanSeek() override;
@@ -92,12 +100,52 @@ public:
 
     virtual void UpdateSVFStatistics(uint32 unsuccessfulReadFrameCount, uint32 lastReadFrame, uint32 droppedFrameCount) override {};
 
+    // ~ Parked readers (warm reader pool, loop standby)
+
+    // Opens and prerolls on the thread pool; ParkedClock never runs, so the reader waits at its first frame.
+    // Game thread only, the engine state the reader needs is read before the task starts
+    TSharedFuture<HRESULT> OpenParkedAsync(const FString& FilePath, const FSVFOpenInfo& OpenInfo, UObject* ParkedClock);
+
+    // Detach from the presenting clock and rewind to the start, keeping the reader open
+    bool Park(UObject* ParkedClock);
+
+    // Attach a parked reader to the clock it is going to be presented with
+    bool Unpark(UObject* ClockObject, float InPlayRate);
+
+    // Move the reader to another clock object without touching its timeline
+    bool RebindClock(UObject* ClockObject);
+
+    bool IsOpenedWith(const FString& FilePath, const FSVFOpenInfo& OpenInfo) const;
+
+    uint64 GetEstimatedMemoryBytes() const;
+
 protected:
 
     HRESULT CreateReader(const FString& FilePath, const FSVFOpenInfo& OpenInfo, UObject* CustomClockObject);
+    // Game thread half of CreateReader: SVF settings from the open info, engine config and buffer budget
+    void PrepareReaderConfig(const FString& FilePath, const FSVFOpenInfo& OpenInfo, SVFConfiguration& svfConfig);
+    // Creates and opens the SVF reader, safe off the game thread
+    HRESULT OpenReader(const FString& FilePath, const FSVFOpenInfo& OpenInfo, UObject* CustomClockObject, SVFConfiguration svfConfig);
+    void WaitForParkedOpen();
+    HRESULT SetDownloadBufferSize(int32 Seconds);
+    // Download buffer granted by the process-wide buffer budget
+    void ApplyBudgetDownloadSeconds(int32 Seconds);
+    HRESULT RegisterNotifier(const ComPtr<ISVFReader>& spReader);
+
+    // Gapless looping: a second reader is opened at the loop start and prerolled on a parked clock
+    bool IsGaplessLoopEnabled() const;
+    void UpdateLoopSeam();
+    void PrepareLoopStandby();
+    ESVFLoopStandbyState GetLoopStandbyState();
+    bool SwitchToLoopStandby();
+    void DiscardLoopStandby();
+    void ReleaseRetiredReader();
 
     ComPtr<ISVFReader> m_spReader;
+    ComPtr<USVFClockUseUnrealInterface> m_spPluginClock;
     TWeakObjectPtr<UObject> m_ClockObject;
+    FString m_FilePath;
+    FSVFOpenInfo m_OpenInfo;
     FSVFStatus m_svfStatus;
     SVFCriticalSection m_statusCS;
     UINT32 m_svfBufferedFramesCount; // initialized when SVF hits reading thread EOS. 
@@ -107,10 +155,27 @@ protected:
     SVFFrameInfo m_FrameInfo;
     bool bUseNormal = true;
     bool bLoop = false;
+    bool bPlaybackBegun = false;
     FSVFConfiguration m_svfConfig;
     FSVFFileInfo FileInfo;
+    FSVFPlayRateBufferPolicy PlayRatePolicy;
+    int32 BudgetDownloadSeconds = INDEX_NONE;
+
+    FSVFLoopSeamScheduler LoopSeam;
+    TSharedFuture<HRESULT> LoopStandbyOpen;
+    // Set while this object is opened as a parked reader
+    TSharedFuture<HRESULT> ParkedOpen;
+    // Reader that played the previous loop, kept until the next loop delivered its first frame
+    ComPtr<ISVFReader> m_spRetiredReader;
 
     std::shared_ptr<std::queue<HostageFrameD3D11>> m_hostageFrames;
 
 #endif
+
+    // Declared outside the platform block, UHT does not parse UPROPERTYs inside it
+    UPROPERTY(Transient)
+    USVFReaderPassThrough* LoopStandby = nullptr;
+
+    UPROPERTY(Transient)
+    UObject* LoopParkedClock = nullptr;
 };
\ No newline at end of file
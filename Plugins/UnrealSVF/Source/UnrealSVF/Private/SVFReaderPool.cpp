@@ -0,0 +1,257 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFReaderPool.h"
+#include "SVFReaderPassThrough.h"
+#include "SVFParkedClock.h"
+#include "Misc/ConfigCacheIni.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSVFReaderPool, Log, All);
+
+#define LogSVF(pmt, ...) UE_LOG(LogSVFReaderPool, Log, TEXT(pmt), ##__VA_ARGS__)
+#define WarnSVF(pmt, ...) UE_LOG(LogSVFReaderPool, Warning, TEXT(pmt), ##__VA_ARGS__)
+#define FatalSVF(pmt, ...) UE_LOG(LogSVFReaderPool, Fatal, TEXT(pmt), ##__VA_ARGS__)
+
+namespace SVFReaderPool
+{
+    // Used when [SVFSettings] ReaderPoolBudgetMB is not set; 0 disables the pool
+    const int32 DefaultBudgetMB = 512;
+}
+
+USVFReaderPool* USVFReaderPool::Instance = nullptr;
+
+USVFReaderPool* USVFReaderPool::Get()
+{
+    if (!Instance)
+    {
+        Instance = NewObject<USVFReaderPool>(GetTransientPackage());
+        Instance->AddToRoot();
+
+        int32 BudgetMB = SVFReaderPool::DefaultBudgetMB;
+        FString SectionBlock = GIsEditor ? TEXT("SVFSettings_Editor") : TEXT("SVFSettings");
+        GConfig->GetInt(*SectionBlock, TEXT("ReaderPoolBudgetMB"), BudgetMB, GEngineIni);
+        Instance->Budget.SetBudget(static_cast<uint64>(FMath::Max(0, BudgetMB)) * 1024 * 1024);
+    }
+    return Instance;
+}
+
+void USVFReaderPool::Shutdown()
+{
+    if (Instance && UObjectInitialized())
+    {
+        Instance->Flush();
+        Instance->RemoveFromRoot();
+    }
+    Instance = nullptr;
+}
+
+void USVFReaderPool::BeginDestroy()
+{
+    Flush();
+    if (Instance == this)
+    {
+        Instance = nullptr;
+    }
+    Super::BeginDestroy();
+}
+
+#if PLATFORM_WINDOWS
+
+bool USVFReaderPool::Prewarm(const FString& FilePath, const FSVFOpenInfo& OpenInfo)
+{
+    // Parked readers are moved between clocks, which needs the plugin clock
+    if (FilePath.IsEmpty() || !OpenInfo.forceSoftwareClock || Budget.GetBudget() == 0)
+    {
+        return false;
+    }
+
+    FScopeLock Lock(&PoolCS);
+    SettlePendingOpens();
+
+    for (USVFReaderPassThrough* Reader : Readers)
+    {
+        if (Reader->IsOpenedWith(FilePath, OpenInfo))
+        {
+            Budget.Touch(Reader->GetUniqueID());
+            return true;
+        }
+    }
+
+    if (!ParkedClock)
+    {
+        ParkedClock = NewObject<USVFParkedClock>(this);
+    }
+    USVFReaderPassThrough* Reader = NewObject<USVFReaderPassThrough>(this);
+    const uint32 Id = Reader->GetUniqueID();
+    Readers.Add(Reader);
+    // Sized once the file info is known
+    Budget.Add(Id, 0, true);
+    PendingOpens.Add(Id, Reader->OpenParkedAsync(FilePath, OpenInfo, ParkedClock));
+    return true;
+}
+
+UObject* USVFReaderPool::Acquire(const FString& FilePath, const FSVFOpenInfo& OpenInfo, UObject* ClockObject, float InPlayRate)
+{
+    if (!OpenInfo.forceSoftwareClock || !ClockObject)
+    {
+        return nullptr;
+    }
+
+    FScopeLock Lock(&PoolCS);
+    SettlePendingOpens();
+
+    // Most recently pooled first
+    for (int32 Index = Readers.Num() - 1; Index >= 0; --Index)
+    {
+        USVFReaderPassThrough* Reader = Readers[Index];
+        if (!Reader->IsOpenedWith(FilePath, OpenInfo))
+        {
+            continue;
+        }
+
+        // Waiting for a reader that is still opening would stall the game thread for the whole open,
+        // it stays pooled for the next caller and this one opens its own
+        const uint32 Id = Reader->GetUniqueID();
+        if (PendingOpens.Contains(Id))
+        {
+            continue;
+        }
+
+        Readers.RemoveAt(Index);
+        Budget.Remove(Id);
+        if (!Reader->Unpark(ClockObject, InPlayRate))
+        {
+            Reader->Close();
+            Reader->MarkPendingKill();
+            continue;
+        }
+        Reader->Rename(nullptr, ClockObject, REN_DontCreateRedirectors | REN_NonTransactional);
+        LogSVF("Adopted warm reader for %s", *FilePath);
+        return Reader;
+    }
+    return nullptr;
+}
+
+bool USVFReaderPool::Recycle(UObject* ReaderObject)
+{
+    USVFReaderPassThrough* Reader = Cast<USVFReaderPassThrough>(ReaderObject);
+    if (!Reader || Budget.GetBudget() == 0)
+    {
+        return false;
+    }
+
+    FScopeLock Lock(&PoolCS);
+    if (!ParkedClock)
+    {
+        ParkedClock = NewObject<USVFParkedClock>(this);
+    }
+    if (!Budget.CanFit(Reader->GetEstimatedMemoryBytes()) || !Reader->Park(ParkedClock))
+    {
+        return false;
+    }
+
+    // The pool owns it now, it must not keep the closing component alive
+    Reader->Rename(nullptr, this, REN_DontCreateRedirectors | REN_NonTransactional);
+    Admit(Reader, false);
+    return true;
+}
+
+void USVFReaderPool::Admit(USVFReaderPassThrough* Reader, bool bDeclaredCue)
+{
+    const uint64 Bytes = Reader->GetEstimatedMemoryBytes();
+    EnforceBudget(Bytes);
+    Readers.Add(Reader);
+    Budget.Add(Reader->GetUniqueID(), Bytes, bDeclaredCue);
+}
+
+void USVFReaderPool::SettlePendingOpens()
+{
+    TArray<USVFReaderPassThrough*> Failed;
+    for (auto It = PendingOpens.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().IsReady())
+        {
+            continue;
+        }
+        const uint32 Id = It.Key();
+        const HRESULT hr = It.Value().Get();
+        It.RemoveCurrent();
+
+        USVFReaderPassThrough** Found = Readers.FindByPredicate([Id](USVFReaderPassThrough* Reader) { return Reader->GetUniqueID() == Id; });
+        if (!Found)
+        {
+            continue;
+        }
+        const uint64 Bytes = (*Found)->GetEstimatedMemoryBytes();
+        if (FAILED(hr) || !Budget.CanFit(Bytes))
+        {
+            WarnSVF("Dropping warm reader, open hr = 0x%08X, %llu bytes", hr, Bytes);
+            Failed.Add(*Found);
+            continue;
+        }
+        Budget.SetBytes(Id, Bytes);
+    }
+
+    for (USVFReaderPassThrough* Reader : Failed)
+    {
+        CloseReader(Reader);
+    }
+    EnforceBudget(0);
+}
+
+void USVFReaderPool::EnforceBudget(uint64 IncomingBytes)
+{
+    TArray<uint32> Evictions;
+    Budget.CollectEvictions(IncomingBytes, Evictions);
+    for (uint32 Id : Evictions)
+    {
+        USVFReaderPassThrough** Found = Readers.FindByPredicate([Id](USVFReaderPassThrough* Reader) { return Reader->GetUniqueID() == Id; });
+        if (Found)
+        {
+            CloseReader(*Found);
+        }
+    }
+}
+
+void USVFReaderPool::CloseReader(USVFReaderPassThrough* Reader)
+{
+    const uint32 Id = Reader->GetUniqueID();
+    if (TSharedFuture<HRESULT>* Pending = PendingOpens.Find(Id))
+    {
+        Pending->Wait();
+        PendingOpens.Remove(Id);
+    }
+    Readers.RemoveSingle(Reader);
+    Budget.Remove(Id);
+    Reader->Close();
+    Reader->MarkPendingKill();
+}
+
+void USVFReaderPool::Flush()
+{
+    FScopeLock Lock(&PoolCS);
+    while (Readers.Num() > 0)
+    {
+        CloseReader(Readers.Last());
+    }
+    PendingOpens.Reset();
+    Budget.Reset();
+}
+
+#else
+
+bool USVFReaderPool::Prewarm(const FString& FilePath, const FSVFOpenInfo& OpenInfo) { return false; }
+UObject* USVFReaderPool::Acquire(const FString& FilePath, const FSVFOpenInfo& OpenInfo, UObject* ClockObject, float InPlayRate) { return nullptr; }
+bool USVFReaderPool::Recycle(UObject* ReaderObject) { return false; }
+void USVFReaderPool::Admit(USVFReaderPassThrough* Reader, bool bDeclaredCue) {}
+void USVFReaderPool::SettlePendingOpens() {}
+void USVFReaderPool::EnforceBudget(uint64 IncomingBytes) {}
+void USVFReaderPool::CloseReader(USVFReaderPassThrough* Reader) {}
+void USVFReaderPool::Flush() {}
+
+#endif
+
+#undef LogSVF
+#undef WarnSVF
+#undef FatalSVF
@@ -0,0 +1,70 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Async/Future.h"
+#include "SVFTypes.h"
+#include "SVFReaderPoolBudget.h"
+#include "SVFReaderPool.generated.h"
+
+class USVFReaderPassThrough;
+class USVFParkedClock;
+
+/**
+ * Keeps opened, prerolled readers so a cue starts without Open and preroll.
+ * Readers are opened ahead of time for declared cues, or recycled when a component closes its file;
+ * they wait on a parked clock until a component opens the same file and adopts one.
+ * Pooled memory is kept under [SVFSettings] ReaderPoolBudgetMB, least recently used readers are closed first.
+ */
+UCLASS(Transient)
+class USVFReaderPool : public UObject
+{
+    GENERATED_BODY()
+
+public:
+
+    // Creates the pool on first use
+    static USVFReaderPool* Get();
+
+    // Closes every pooled reader, called before the SVF library is unloaded
+    static void Shutdown();
+
+    // Open and preroll a reader for a clip that is about to be played
+    bool Prewarm(const FString& FilePath, const FSVFOpenInfo& OpenInfo);
+
+    // Take a pooled reader for the file and attach it to ClockObject, nullptr if none has finished opening
+    UObject* Acquire(const FString& FilePath, const FSVFOpenInfo& OpenInfo, UObject* ClockObject, float InPlayRate);
+
+    // Keep a reader the caller is done with. Returns false if the reader was not taken and has to be closed.
+    bool Recycle(UObject* ReaderObject);
+
+    // Close every pooled reader
+    void Flush();
+
+    virtual void BeginDestroy() override;
+
+protected:
+
+    void Admit(USVFReaderPassThrough* Reader, bool bDeclaredCue);
+    void SettlePendingOpens();
+    void EnforceBudget(uint64 IncomingBytes);
+    void CloseReader(USVFReaderPassThrough* Reader);
+
+    UPROPERTY()
+    TArray<USVFReaderPassThrough*> Readers;
+
+    UPROPERTY()
+    USVFParkedClock* ParkedClock = nullptr;
+
+#if PLATFORM_WINDOWS
+    // Readers still opening, keyed by object id
+    TMap<uint32, TSharedFuture<HRESULT>> PendingOpens;
+#endif
+
+    FSVFReaderPoolBudget Budget;
+    FCriticalSection PoolCS;
+
+    static USVFReaderPool* Instance;
+};
@@ -0,0 +1,107 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFReaderPoolBudget.h"
+
+namespace SVFReaderPoolBudget
+{
+    // Position and UV, plus the normal when requested, all 32 bit floats
+    const uint64 VertexBytes = 5 * sizeof(float);
+    const uint64 NormalBytes = 3 * sizeof(float);
+    const uint64 IndexBytes = sizeof(uint32);
+    const uint64 TexelBytes = 4;
+}
+
+FSVFReaderPoolBudget::FSVFReaderPoolBudget()
+    : BudgetBytes(0)
+{
+    Reset();
+}
+
+void FSVFReaderPoolBudget::Reset()
+{
+    Entries.Reset();
+    UsedBytes = 0;
+    UseCounter = 0;
+}
+
+void FSVFReaderPoolBudget::Add(uint32 Id, uint64 Bytes, bool bDeclaredCue)
+{
+    Remove(Id);
+    FEntry& Entry = Entries.Add(Id);
+    Entry.Bytes = Bytes;
+    Entry.LastUse = ++UseCounter;
+    Entry.bDeclaredCue = bDeclaredCue;
+    UsedBytes += Bytes;
+}
+
+void FSVFReaderPoolBudget::SetBytes(uint32 Id, uint64 Bytes)
+{
+    if (FEntry* Entry = Entries.Find(Id))
+    {
+        UsedBytes = UsedBytes - Entry->Bytes + Bytes;
+        Entry->Bytes = Bytes;
+    }
+}
+
+void FSVFReaderPoolBudget::Touch(uint32 Id)
+{
+    if (FEntry* Entry = Entries.Find(Id))
+    {
+        Entry->LastUse = ++UseCounter;
+    }
+}
+
+void FSVFReaderPoolBudget::Remove(uint32 Id)
+{
+    FEntry Entry;
+    if (Entries.RemoveAndCopyValue(Id, Entry))
+    {
+        UsedBytes -= Entry.Bytes;
+    }
+}
+
+void FSVFReaderPoolBudget::CollectEvictions(uint64 IncomingBytes, TArray<uint32>& OutIds) const
+{
+    OutIds.Reset();
+    if (UsedBytes + IncomingBytes <= BudgetBytes)
+    {
+        return;
+    }
+
+    TArray<TPair<uint32, FEntry>> Order;
+    Order.Reserve(Entries.Num());
+    for (const TPair<uint32, FEntry>& Pair : Entries)
+    {
+        Order.Add(Pair);
+    }
+    Order.Sort([](const TPair<uint32, FEntry>& A, const TPair<uint32, FEntry>& B)
+    {
+        if (A.Value.bDeclaredCue != B.Value.bDeclaredCue)
+        {
+            return !A.Value.bDeclaredCue;
+        }
+        return A.Value.LastUse < B.Value.LastUse;
+    });
+
+    uint64 Remaining = UsedBytes;
+    for (const TPair<uint32, FEntry>& Pair : Order)
+    {
+        if (Remaining + IncomingBytes <= BudgetBytes)
+        {
+            break;
+        }
+        OutIds.Add(Pair.Key);
+        Remaining -= Pair.Value.Bytes;
+    }
+}
+
+uint64 FSVFReaderPoolBudget::EstimateReaderBytes(int32 TextureWidth, int32 TextureHeight, int32 MaxVertexCount, int32 MaxIndexCount,
+    uint32 BufferedFrames, bool bNormals)
+{
+    const uint64 TextureBytes = static_cast<uint64>(FMath::Max(0, TextureWidth)) * FMath::Max(0, TextureHeight) * SVFReaderPoolBudget::TexelBytes;
+    const uint64 VertexStride = SVFReaderPoolBudget::VertexBytes + (bNormals ? SVFReaderPoolBudget::NormalBytes : 0);
+    const uint64 MeshBytes = static_cast<uint64>(FMath::Max(0, MaxVertexCount)) * VertexStride +
+        static_cast<uint64>(FMath::Max(0, MaxIndexCount)) * SVFReaderPoolBudget::IndexBytes;
+    // One frame is always held even with no buffering configured
+    return (TextureBytes + MeshBytes) * FMath::Max(1u, BufferedFrames);
+}
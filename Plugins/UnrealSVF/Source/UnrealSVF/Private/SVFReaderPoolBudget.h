@@ -0,0 +1,57 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Memory accounting for warm readers. Entries are evicted least recently used first; readers
+// opened for declared cues go only after every recycled reader, since a cue is about to be played.
+class FSVFReaderPoolBudget
+{
+public:
+    FSVFReaderPoolBudget();
+
+    void SetBudget(uint64 InBudgetBytes) { BudgetBytes = InBudgetBytes; }
+
+    uint64 GetBudget() const { return BudgetBytes; }
+
+    uint64 GetUsedBytes() const { return UsedBytes; }
+
+    int32 Num() const { return Entries.Num(); }
+
+    bool Contains(uint32 Id) const { return Entries.Contains(Id); }
+
+    // A single reader larger than the whole budget is never pooled
+    bool CanFit(uint64 Bytes) const { return Bytes <= BudgetBytes; }
+
+    void Add(uint32 Id, uint64 Bytes, bool bDeclaredCue);
+
+    // Replace an estimate once the reader's file info is known
+    void SetBytes(uint32 Id, uint64 Bytes);
+
+    void Touch(uint32 Id);
+
+    void Remove(uint32 Id);
+
+    void Reset();
+
+    // Entries to evict, in eviction order, so the pool fits the budget with IncomingBytes added
+    void CollectEvictions(uint64 IncomingBytes, TArray<uint32>& OutIds) const;
+
+    // Decoded frames a reader keeps buffered: RGBA texture, uncompressed vertices and 32 bit indices
+    static uint64 EstimateReaderBytes(int32 TextureWidth, int32 TextureHeight, int32 MaxVertexCount, int32 MaxIndexCount,
+        uint32 BufferedFrames, bool bNormals);
+
+private:
+    struct FEntry
+    {
+        uint64 Bytes;
+        uint64 LastUse;
+        bool bDeclaredCue;
+    };
+
+    TMap<uint32, FEntry> Entries;
+    uint64 BudgetBytes;
+    uint64 UsedBytes;
+    uint64 UseCounter;
+};
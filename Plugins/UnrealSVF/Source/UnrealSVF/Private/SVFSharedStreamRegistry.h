@@ -0,0 +1,71 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeLock.h"
+
+/**
+ * Reference counts the members of shared streams. The first member to join a stream leads it: it owns the
+ * reader and advances it, the others only present what it decoded. When the leader leaves, the oldest
+ * remaining member takes over, so the stream keeps playing for as long as anyone references it.
+ */
+template<typename MemberType>
+class TSVFSharedStreamRegistry
+{
+public:
+
+    // Returns true if Member leads the stream
+    bool Join(const FString& Key, MemberType Member)
+    {
+        FScopeLock Lock(&RegistryCS);
+        TArray<MemberType>& Members = Streams.FindOrAdd(Key);
+        Members.AddUnique(Member);
+        return Members[0] == Member;
+    }
+
+    // Returns the number of members left; OutLeader is the stream's leader afterwards, or a default value
+    int32 Leave(const FString& Key, MemberType Member, MemberType& OutLeader)
+    {
+        FScopeLock Lock(&RegistryCS);
+        OutLeader = MemberType();
+        TArray<MemberType>* Members = Streams.Find(Key);
+        if (!Members)
+        {
+            return 0;
+        }
+        // Remove keeps the order, the oldest member becomes leader
+        Members->Remove(Member);
+        if (Members->Num() == 0)
+        {
+            Streams.Remove(Key);
+            return 0;
+        }
+        OutLeader = (*Members)[0];
+        return Members->Num();
+    }
+
+    MemberType GetLeader(const FString& Key) const
+    {
+        FScopeLock Lock(&RegistryCS);
+        const TArray<MemberType>* Members = Streams.Find(Key);
+        return Members && Members->Num() > 0 ? (*Members)[0] : MemberType();
+    }
+
+    bool IsLeader(const FString& Key, MemberType Member) const
+    {
+        return GetLeader(Key) == Member;
+    }
+
+    int32 Num(const FString& Key) const
+    {
+        FScopeLock Lock(&RegistryCS);
+        const TArray<MemberType>* Members = Streams.Find(Key);
+        return Members ? Members->Num() : 0;
+    }
+
+private:
+
+    mutable FCriticalSection RegistryCS;
+    TMap<FString, TArray<MemberType>> Streams;
+};
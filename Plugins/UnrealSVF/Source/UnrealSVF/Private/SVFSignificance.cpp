@@ -0,0 +1,97 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFSignificance.h"
+
+namespace SVFSignificance
+{
+    const float HalfRateFps = 15.f;
+    const float QuarterRateFps = 7.5f;
+}
+
+float FSVFSignificance::ComputeScreenSize(float SphereRadius, float Distance, float HalfFOVRadians)
+{
+    const float TanHalfFOV = FMath::Tan(FMath::Clamp(HalfFOVRadians, KINDA_SMALL_NUMBER, HALF_PI - KINDA_SMALL_NUMBER));
+    // Inside the bounds the hologram fills the view
+    if (Distance <= SphereRadius)
+    {
+        return 1.f;
+    }
+    return FMath::Min(1.f, SphereRadius / (Distance * TanHalfFOV));
+}
+
+ESVFUpdateTier FSVFSignificance::SelectTier(float ScreenSize, ESVFUpdateTier CurrentTier, const FSVFSignificanceSettings& Settings)
+{
+    ESVFUpdateTier Tier = ESVFUpdateTier::Quarter;
+    if (ScreenSize >= Settings.FullRateScreenSize)
+    {
+        Tier = ESVFUpdateTier::Full;
+    }
+    else if (ScreenSize >= Settings.HalfRateScreenSize)
+    {
+        Tier = ESVFUpdateTier::Half;
+    }
+
+    // Dropping to a lower tier waits until the size is clearly below its threshold, so a hologram
+    // hovering at a threshold doesn't toggle its rate every frame
+    if (Tier > CurrentTier)
+    {
+        const float Threshold = CurrentTier == ESVFUpdateTier::Full ? Settings.FullRateScreenSize : Settings.HalfRateScreenSize;
+        if (ScreenSize >= Threshold * (1.f - Settings.Hysteresis))
+        {
+            return CurrentTier;
+        }
+    }
+    return Tier;
+}
+
+FSVFUpdateRate FSVFSignificance::GetUpdateRate(ESVFUpdateTier Tier, float ContentFrameRate, const FSVFSignificanceSettings& Settings)
+{
+    FSVFUpdateRate Rate;
+    if (Tier == ESVFUpdateTier::Full || ContentFrameRate <= 0.f)
+    {
+        return Rate;
+    }
+
+    const float TargetFps = Tier == ESVFUpdateTier::Half ? SVFSignificance::HalfRateFps : SVFSignificance::QuarterRateFps;
+    Rate.MeshInterval = FMath::Max(1, FMath::RoundToInt(ContentFrameRate / TargetFps));
+    Rate.TextureInterval = Rate.MeshInterval * FMath::Max(1, Settings.TextureIntervalScale);
+    return Rate;
+}
+
+FSVFUpdateThrottle::FSVFUpdateThrottle()
+{
+    Reset();
+}
+
+void FSVFUpdateThrottle::Reset()
+{
+    LastMeshFrame = INDEX_NONE;
+    LastTextureFrame = INDEX_NONE;
+    bPendingKeyFrame = false;
+}
+
+FSVFUpdateDecision FSVFUpdateThrottle::OnNewFrame(int32 FrameId, bool bKeyFrame, const FSVFUpdateRate& Rate)
+{
+    // Seeks and loops: what was skipped before is unknown, refresh everything
+    const bool bDiscontinuity = LastMeshFrame == INDEX_NONE || FrameId < LastMeshFrame;
+    bPendingKeyFrame |= bKeyFrame || bDiscontinuity;
+
+    FSVFUpdateDecision Decision;
+    Decision.bUpdateMesh = bDiscontinuity || FrameId - LastMeshFrame >= Rate.MeshInterval;
+    if (!Decision.bUpdateMesh)
+    {
+        Decision.bUpdateTexture = false;
+        return Decision;
+    }
+    LastMeshFrame = FrameId;
+
+    Decision.bNewKeyFrameGroup = bPendingKeyFrame;
+    Decision.bUpdateTexture = bPendingKeyFrame || LastTextureFrame == INDEX_NONE ||
+        FrameId - LastTextureFrame >= Rate.TextureInterval;
+    if (Decision.bUpdateTexture)
+    {
+        LastTextureFrame = FrameId;
+        bPendingKeyFrame = false;
+    }
+    return Decision;
+}
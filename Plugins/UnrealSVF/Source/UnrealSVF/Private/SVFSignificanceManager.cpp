@@ -0,0 +1,70 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFSignificanceManager.h"
+#include "SVFSignificance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+
+FSVFSignificanceManager& FSVFSignificanceManager::Get()
+{
+    static FSVFSignificanceManager Instance;
+    return Instance;
+}
+
+const TArray<FSVFSignificanceManager::FViewPoint>& FSVFSignificanceManager::GatherViews(UWorld* World)
+{
+    check(IsInGameThread());
+    const FWorldViews* Cached = WorldViews.Find(World);
+    if (Cached && Cached->Frame == GFrameCounter)
+    {
+        return Cached->Views;
+    }
+
+    // Drop worlds that went away (PIE sessions, level travel)
+    for (auto It = WorldViews.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    FWorldViews& Current = WorldViews.FindOrAdd(World);
+    Current.Frame = GFrameCounter;
+    Current.Views.Reset();
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        if (PlayerController && PlayerController->IsLocalController() && PlayerController->PlayerCameraManager)
+        {
+            FViewPoint View;
+            View.Location = PlayerController->PlayerCameraManager->GetCameraLocation();
+            View.HalfFOVRadians = FMath::DegreesToRadians(PlayerController->PlayerCameraManager->GetFOVAngle() * 0.5f);
+            Current.Views.Add(View);
+        }
+    }
+    return Current.Views;
+}
+
+float FSVFSignificanceManager::GetScreenSize(UWorld* World, const FBoxSphereBounds& Bounds)
+{
+    if (!World)
+    {
+        return INDEX_NONE;
+    }
+
+    const TArray<FViewPoint>& Views = GatherViews(World);
+    if (Views.Num() == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    float ScreenSize = 0.f;
+    for (const FViewPoint& View : Views)
+    {
+        const float Distance = FVector::Dist(View.Location, Bounds.Origin);
+        ScreenSize = FMath::Max(ScreenSize, FSVFSignificance::ComputeScreenSize(Bounds.SphereRadius, Distance, View.HalfFOVRadians));
+    }
+    return ScreenSize;
+}
@@ -0,0 +1,40 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UWorld;
+
+/**
+ * Measures how large holograms are on screen across every player view of their world. The views are
+ * gathered once per engine frame and world and shared by all components asking in that frame.
+ */
+class FSVFSignificanceManager
+{
+public:
+
+    static FSVFSignificanceManager& Get();
+
+    // Largest screen size of the bounds over all views, INDEX_NONE if the world has no player views
+    float GetScreenSize(UWorld* World, const FBoxSphereBounds& Bounds);
+
+private:
+
+    struct FViewPoint
+    {
+        FVector Location;
+        float HalfFOVRadians;
+    };
+
+    struct FWorldViews
+    {
+        uint64 Frame = 0;
+        TArray<FViewPoint> Views;
+    };
+
+    const TArray<FViewPoint>& GatherViews(UWorld* World);
+
+    TMap<TWeakObjectPtr<UWorld>, FWorldViews> WorldViews;
+};
@@ -0,0 +1,134 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFSurfaceSampler.h"
+
+void FSVFSurfaceSampler::Build(const FSVFFrameSnapshotPtr& InSnapshot)
+{
+    Snapshot = InSnapshot;
+    Alias.Reset();
+    TotalArea = 0.f;
+    if (!Snapshot.IsValid())
+    {
+        return;
+    }
+
+    const TArray<FVector>& Positions = Snapshot->Positions;
+    const TArray<int32>& Indices = Snapshot->Indices;
+    const int32 NumTriangles = Snapshot->GetNumTriangles();
+    const int32 NumVertices = Positions.Num();
+
+    // Doubled areas, triangles with out of range indices count as empty
+    TArray<float> Areas;
+    Areas.SetNumUninitialized(NumTriangles);
+    double AreaSum = 0.0;
+    for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+    {
+        const int32 I0 = Indices[Triangle * 3 + 0];
+        const int32 I1 = Indices[Triangle * 3 + 1];
+        const int32 I2 = Indices[Triangle * 3 + 2];
+        float Area = 0.f;
+        if ((uint32)I0 < (uint32)NumVertices && (uint32)I1 < (uint32)NumVertices && (uint32)I2 < (uint32)NumVertices)
+        {
+            Area = ((Positions[I1] - Positions[I0]) ^ (Positions[I2] - Positions[I0])).Size();
+        }
+        Areas[Triangle] = Area;
+        AreaSum += Area;
+    }
+    if (AreaSum <= 0.0)
+    {
+        return;
+    }
+    TotalArea = static_cast<float>(AreaSum * 0.5);
+
+    // Vose: columns below the mean are topped up by one column above it, which moves its rest on
+    Alias.SetNumUninitialized(NumTriangles);
+    TArray<int32> Small;
+    TArray<int32> Large;
+    Small.Reserve(NumTriangles);
+    Large.Reserve(NumTriangles);
+    const double Scale = NumTriangles / AreaSum;
+    for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+    {
+        Areas[Triangle] = static_cast<float>(Areas[Triangle] * Scale);
+        (Areas[Triangle] < 1.f ? Small : Large).Add(Triangle);
+    }
+    while (Small.Num() > 0 && Large.Num() > 0)
+    {
+        const int32 Less = Small.Pop(false);
+        const int32 More = Large.Last();
+        Alias[Less] = { Areas[Less], More };
+        Areas[More] = (Areas[More] + Areas[Less]) - 1.f;
+        if (Areas[More] < 1.f)
+        {
+            Large.Pop(false);
+            Small.Add(More);
+        }
+    }
+    // What is left is 1 up to rounding
+    for (int32 Triangle : Large)
+    {
+        Alias[Triangle] = { 1.f, Triangle };
+    }
+    for (int32 Triangle : Small)
+    {
+        Alias[Triangle] = { 1.f, Triangle };
+    }
+}
+
+bool FSVFSurfaceSampler::Sample(FRandomStream& Random, FSVFSurfaceSample& OutSample) const
+{
+    if (IsEmpty())
+    {
+        return false;
+    }
+
+    // A column, then it or its alias; separate draws keep the full float precision for large frames
+    const int32 Index = Random.RandHelper(Alias.Num());
+    const FEntry& Entry = Alias[Index];
+    const int32 Triangle = Random.GetFraction() < Entry.Probability ? Index : Entry.Alias;
+
+    const int32* Corners = &Snapshot->Indices[Triangle * 3];
+    const int32 I0 = Corners[0];
+    const int32 I1 = Corners[1];
+    const int32 I2 = Corners[2];
+
+    // Uniform over the triangle without rejection
+    const float Root = FMath::Sqrt(Random.GetFraction());
+    const float V = Random.GetFraction();
+    const float W1 = Root * (1.f - V);
+    const float W2 = Root * V;
+    const float W0 = 1.f - W1 - W2;
+
+    const TArray<FVector>& Positions = Snapshot->Positions;
+    OutSample.Position = Positions[I0] * W0 + Positions[I1] * W1 + Positions[I2] * W2;
+    if (Snapshot->HasNormals())
+    {
+        const TArray<FVector>& Normals = Snapshot->Normals;
+        OutSample.Normal = (Normals[I0] * W0 + Normals[I1] * W1 + Normals[I2] * W2).GetSafeNormal();
+    }
+    else
+    {
+        // Same winding as the generated normals, front faces are clockwise
+        OutSample.Normal = ((Positions[I2] - Positions[I0]) ^ (Positions[I1] - Positions[I0])).GetSafeNormal();
+    }
+    const TArray<FVector2D>& TexCoords = Snapshot->TexCoords;
+    if (TexCoords.Num() == Positions.Num())
+    {
+        OutSample.TexCoord = TexCoords[I0] * W0 + TexCoords[I1] * W1 + TexCoords[I2] * W2;
+    }
+    OutSample.Triangle = Triangle;
+    return true;
+}
+
+void FSVFSurfaceSampler::SampleMany(FRandomStream& Random, int32 Count, TArray<FSVFSurfaceSample>& OutSamples) const
+{
+    if (IsEmpty() || Count <= 0)
+    {
+        return;
+    }
+    const int32 First = OutSamples.AddDefaulted(Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        Sample(Random, OutSamples[First + Index]);
+    }
+}
@@ -0,0 +1,200 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTexCoordPacker.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define SVF_TEXCOORD_SSE 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SVF_F16C_FUNCTION
+#else
+// GCC and Clang only emit F16C in functions built for it; the cpuid check guards the call
+#include <cpuid.h>
+#include <immintrin.h>
+#define SVF_F16C_FUNCTION __attribute__((target("f16c")))
+#endif
+#else
+#define SVF_TEXCOORD_SSE 0
+#endif
+
+#if PLATFORM_ANDROID && defined(__aarch64__)
+#define SVF_TEXCOORD_NEON 1
+#include <arm_neon.h>
+#else
+#define SVF_TEXCOORD_NEON 0
+#endif
+
+namespace SVFTexCoordPacker
+{
+#if SVF_TEXCOORD_SSE
+    bool DetectF16C()
+    {
+#if defined(_MSC_VER)
+        int32 Info[4];
+        __cpuid(Info, 1);
+        const uint32 Features = Info[2];
+#else
+        uint32 Info[4] = {};
+        __get_cpuid(1, &Info[0], &Info[1], &Info[2], &Info[3]);
+        const uint32 Features = Info[2];
+#endif
+        const bool bOSXSave = (Features & (1 << 27)) != 0;
+        const bool bAVX = (Features & (1 << 28)) != 0;
+        const bool bF16C = (Features & (1 << 29)) != 0;
+        if (!bOSXSave || !bAVX || !bF16C)
+        {
+            return false;
+        }
+        // F16C is VEX encoded, which also needs the OS to save the AVX registers
+#if defined(_MSC_VER)
+        const uint64 EnabledState = _xgetbv(0);
+#else
+        uint32 EnabledLow = 0;
+        uint32 EnabledHigh = 0;
+        __asm__ volatile("xgetbv" : "=a"(EnabledLow), "=d"(EnabledHigh) : "c"(0));
+        const uint64 EnabledState = EnabledLow | (static_cast<uint64>(EnabledHigh) << 32);
+#endif
+        return (EnabledState & 6) == 6;
+    }
+
+    // Eight floats at a time, returns how many were converted
+    SVF_F16C_FUNCTION int32 ToHalfF16C(const float* Source, int32 Count, uint16* Dest)
+    {
+        int32 Index = 0;
+        for (; Index + 8 <= Count; Index += 8)
+        {
+            const __m128i Low = _mm_cvtps_ph(_mm_loadu_ps(Source + Index), _MM_FROUND_TO_NEAREST_INT);
+            const __m128i High = _mm_cvtps_ph(_mm_loadu_ps(Source + Index + 4), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + Index), _mm_unpacklo_epi64(Low, High));
+        }
+        return Index;
+    }
+#endif
+
+    uint32 AsBits(float Value)
+    {
+        uint32 Bits;
+        FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+        return Bits;
+    }
+
+    float AsFloat(uint32 Bits)
+    {
+        float Value;
+        FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+        return Value;
+    }
+}
+
+bool FSVFTexCoordPacker::HasHardwareHalfConversion()
+{
+#if SVF_TEXCOORD_SSE
+    static const bool bHasF16C = SVFTexCoordPacker::DetectF16C();
+    return bHasF16C;
+#elif SVF_TEXCOORD_NEON
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint16 FSVFTexCoordPacker::FloatToHalf(float Value)
+{
+    using namespace SVFTexCoordPacker;
+
+    // Round to nearest even like the conversion instructions; FFloat16 truncates and flushes denormals
+    const uint32 Float32Infinity = 255u << 23;
+    const uint32 Float16Overflow = (127u + 16u) << 23;
+    const uint32 DenormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    uint32 Bits = AsBits(Value);
+    const uint32 Sign = Bits & 0x80000000u;
+    Bits ^= Sign;
+
+    uint16 Half;
+    if (Bits >= Float16Overflow)
+    {
+        // Infinity stays infinity, NaN becomes a quiet NaN
+        Half = Bits > Float32Infinity ? 0x7e00 : 0x7c00;
+    }
+    else if (Bits < (113u << 23))
+    {
+        // Half denormals and zero: the float adder does the rounding
+        Half = static_cast<uint16>(AsBits(AsFloat(Bits) + AsFloat(DenormalMagic)) - DenormalMagic);
+    }
+    else
+    {
+        const uint32 MantissaOdd = (Bits >> 13) & 1;
+        Bits += ((15u - 127u) << 23) + 0xfff;
+        Bits += MantissaOdd;
+        Half = static_cast<uint16>(Bits >> 13);
+    }
+    return Half | static_cast<uint16>(Sign >> 16);
+}
+
+void FSVFTexCoordPacker::ToHalf(const float* Source, int32 Count, FFloat16* Dest)
+{
+    uint16* DestBits = reinterpret_cast<uint16*>(Dest);
+    int32 Index = 0;
+#if SVF_TEXCOORD_SSE
+    if (HasHardwareHalfConversion())
+    {
+        Index = SVFTexCoordPacker::ToHalfF16C(Source, Count, DestBits);
+    }
+#elif SVF_TEXCOORD_NEON
+    // The conversion rounds as FPCR says, which is to nearest even unless someone changed it
+    for (; Index + 4 <= Count; Index += 4)
+    {
+        vst1_u16(DestBits + Index, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(Source + Index))));
+    }
+#endif
+    for (; Index < Count; ++Index)
+    {
+        DestBits[Index] = FloatToHalf(Source[Index]);
+    }
+}
+
+void FSVFTexCoordPacker::ToUNorm16(const float* Source, int32 Count, uint16* Dest)
+{
+    int32 Index = 0;
+#if SVF_TEXCOORD_SSE
+    const __m128 Zero = _mm_setzero_ps();
+    const __m128 One = _mm_set1_ps(1.f);
+    const __m128 Scale = _mm_set1_ps(65535.f);
+    const __m128 Half = _mm_set1_ps(0.5f);
+    const __m128i Bias = _mm_set1_epi32(32768);
+    const __m128i BiasWords = _mm_set1_epi16(static_cast<int16>(0x8000));
+    for (; Index + 8 <= Count; Index += 8)
+    {
+        // Truncation of non negative values is the scalar floor; SSE2 only packs signed, so the
+        // words are shifted into the signed range and back
+        const __m128 Low = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(Source + Index), One), Zero);
+        const __m128 High = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(Source + Index + 4), One), Zero);
+        const __m128i LowInts = _mm_sub_epi32(_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(Low, Scale), Half)), Bias);
+        const __m128i HighInts = _mm_sub_epi32(_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(High, Scale), Half)), Bias);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Dest + Index), _mm_xor_si128(_mm_packs_epi32(LowInts, HighInts), BiasWords));
+    }
+#endif
+    for (; Index < Count; ++Index)
+    {
+        Dest[Index] = FloatToUNorm16(Source[Index]);
+    }
+}
+
+void FSVFTexCoordPacker::Pack(const FVector2D* Source, int32 Count, ESVFTexCoordFormat Format, void* Dest)
+{
+    // FVector2D is two packed floats, so the coordinates are one float stream
+    const float* Floats = reinterpret_cast<const float*>(Source);
+    switch (Format)
+    {
+    case ESVFTexCoordFormat::Half:
+        ToHalf(Floats, 2 * Count, static_cast<FFloat16*>(Dest));
+        break;
+    case ESVFTexCoordFormat::UNorm16:
+        ToUNorm16(Floats, 2 * Count, static_cast<uint16*>(Dest));
+        break;
+    default:
+        FMemory::Memcpy(Dest, Source, Count * sizeof(FVector2D));
+        break;
+    }
+}
@@ -0,0 +1,45 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Element format of the texture coordinate buffer
+enum class ESVFTexCoordFormat : uint8
+{
+    Float,
+    Half,
+    // Unsigned normalized 16 bit, for clips whose UVs stay within 0..1
+    UNorm16,
+};
+
+// Converts float texture coordinates to the buffer formats a whole stream at a time. Half floats use
+// F16C on x64 CPUs that have it and NEON on 64 bit ARM; every path rounds to nearest even and gives
+// the same bits for every finite input, so the scalar loops elsewhere match the hardware ones.
+class FSVFTexCoordPacker
+{
+public:
+    static uint32 GetStride(ESVFTexCoordFormat Format)
+    {
+        return Format == ESVFTexCoordFormat::Float ? sizeof(FVector2D) : 2 * sizeof(uint16);
+    }
+
+    // Count coordinates from Source into Dest, which holds GetStride(Format) bytes for each
+    static void Pack(const FVector2D* Source, int32 Count, ESVFTexCoordFormat Format, void* Dest);
+
+    // Count floats to half floats
+    static void ToHalf(const float* Source, int32 Count, FFloat16* Dest);
+    // Count floats to unsigned normalized 16 bit, clamped to 0..1
+    static void ToUNorm16(const float* Source, int32 Count, uint16* Dest);
+
+    // Whether ToHalf runs on conversion instructions on this CPU
+    static bool HasHardwareHalfConversion();
+
+    // The scalar conversions all paths agree with
+    static uint16 FloatToHalf(float Value);
+    static uint16 FloatToUNorm16(float Value)
+    {
+        // Min first so NaN ends up at 1, the way the SSE min and max order it
+        return static_cast<uint16>(FMath::FloorToInt(FMath::Max(FMath::Min(Value, 1.f), 0.f) * 65535.f + 0.5f));
+    }
+};
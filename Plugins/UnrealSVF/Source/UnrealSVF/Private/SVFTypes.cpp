@@ -23,8 +23,11 @@ FSVFOpenInfo::FSVFOpenInfo()
     , OutputNormals(true)
     , StartDownloadOnOpen(true)
     , AutoLooping(false)
+    , GaplessLooping(false)
+    , LockStepDecode(false)
     , forceSoftwareClock(true)
     , playbackRate(1.f)
+    , BufferPriority(1.f)
 {
 }
 
@@ -34,8 +37,11 @@ FSVFOpenInfo::FSVFOpenInfo(EUSVFOpenPreset PresetMode)
     , OutputNormals(true)
     , StartDownloadOnOpen(false)
     , AutoLooping(false)
+    , GaplessLooping(false)
+    , LockStepDecode(false)
     , forceSoftwareClock(true)
     , playbackRate(1.f)
+    , BufferPriority(1.f)
 {
     switch (PresetMode) {
     case EUSVFOpenPreset::FirstMovie:
@@ -0,0 +1,142 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFVertexCacheOptimizer.h"
+
+void FSVFVertexCacheOptimizer::Optimize(TArrayView<const int32> Indices, int32 NumVertices, TArray<int32>& OutIndices, int32 CacheSize)
+{
+    OutIndices.Reset(Indices.Num());
+    const int32 NumTriangles = Indices.Num() / 3;
+    for (const int32 Vertex : Indices)
+    {
+        if (Vertex < 0 || Vertex >= NumVertices)
+        {
+            OutIndices.Append(Indices.GetData(), Indices.Num());
+            return;
+        }
+    }
+
+    // Triangles around every vertex (compressed rows), and how many of them are still to be emitted
+    TArray<int32> LiveTriangles;
+    TArray<int32> AdjacencyStart;
+    TArray<int32> Adjacency;
+    LiveTriangles.SetNumZeroed(NumVertices);
+    AdjacencyStart.SetNumZeroed(NumVertices + 1);
+    for (int32 Index = 0; Index < NumTriangles * 3; ++Index)
+    {
+        ++LiveTriangles[Indices[Index]];
+    }
+    for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+    {
+        AdjacencyStart[Vertex + 1] = AdjacencyStart[Vertex] + LiveTriangles[Vertex];
+    }
+    Adjacency.SetNumUninitialized(NumTriangles * 3);
+    {
+        TArray<int32> Fill(AdjacencyStart.GetData(), NumVertices);
+        for (int32 Index = 0; Index < NumTriangles * 3; ++Index)
+        {
+            Adjacency[Fill[Indices[Index]]++] = Index / 3;
+        }
+    }
+
+    TArray<int32> CacheTime;
+    CacheTime.SetNumZeroed(NumVertices);
+    TArray<bool> Emitted;
+    Emitted.SetNumZeroed(NumTriangles);
+    TArray<int32> DeadEnds;
+    DeadEnds.Reserve(NumTriangles * 3);
+    TArray<int32> Candidates;
+
+    int32 Time = CacheSize + 1;
+    int32 Cursor = 0;
+    int32 Fanning = NumVertices > 0 ? 0 : INDEX_NONE;
+    while (Fanning != INDEX_NONE)
+    {
+        // Emit every remaining triangle around the fanning vertex
+        Candidates.Reset();
+        for (int32 Entry = AdjacencyStart[Fanning]; Entry < AdjacencyStart[Fanning + 1]; ++Entry)
+        {
+            const int32 Triangle = Adjacency[Entry];
+            if (Emitted[Triangle])
+            {
+                continue;
+            }
+            Emitted[Triangle] = true;
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                const int32 Vertex = Indices[Triangle * 3 + Corner];
+                OutIndices.Add(Vertex);
+                DeadEnds.Add(Vertex);
+                Candidates.Add(Vertex);
+                --LiveTriangles[Vertex];
+                if (Time - CacheTime[Vertex] > CacheSize)
+                {
+                    CacheTime[Vertex] = Time++;
+                }
+            }
+        }
+
+        // Next fan: the candidate that stays in cache longest while its fan is emitted
+        Fanning = INDEX_NONE;
+        int32 BestPriority = -1;
+        for (const int32 Vertex : Candidates)
+        {
+            if (LiveTriangles[Vertex] > 0)
+            {
+                const int32 Priority = (Time - CacheTime[Vertex] + 2 * LiveTriangles[Vertex] <= CacheSize) ? Time - CacheTime[Vertex] : 0;
+                if (Priority > BestPriority)
+                {
+                    BestPriority = Priority;
+                    Fanning = Vertex;
+                }
+            }
+        }
+
+        // Dead end: go back to a recently used vertex, then to the next vertex in input order
+        while (Fanning == INDEX_NONE && DeadEnds.Num() > 0)
+        {
+            const int32 Vertex = DeadEnds.Pop(false);
+            if (LiveTriangles[Vertex] > 0)
+            {
+                Fanning = Vertex;
+            }
+        }
+        while (Fanning == INDEX_NONE && Cursor < NumVertices)
+        {
+            if (LiveTriangles[Cursor] > 0)
+            {
+                Fanning = Cursor;
+            }
+            ++Cursor;
+        }
+    }
+
+    // A trailing partial triangle is not drawn either way
+    OutIndices.Append(Indices.GetData() + NumTriangles * 3, Indices.Num() - NumTriangles * 3);
+}
+
+float FSVFVertexCacheOptimizer::ComputeACMR(TArrayView<const int32> Indices, int32 NumVertices, int32 CacheSize)
+{
+    const int32 NumTriangles = Indices.Num() / 3;
+    if (NumTriangles == 0)
+    {
+        return 0.f;
+    }
+
+    // A vertex is in the FIFO cache if fewer than CacheSize misses happened since it was loaded
+    TArray<int32> LoadedAt;
+    LoadedAt.Init(INDEX_NONE, NumVertices);
+    int32 Misses = 0;
+    for (int32 Index = 0; Index < NumTriangles * 3; ++Index)
+    {
+        const int32 Vertex = Indices[Index];
+        if (Vertex < 0 || Vertex >= NumVertices)
+        {
+            continue;
+        }
+        if (LoadedAt[Vertex] == INDEX_NONE || Misses - LoadedAt[Vertex] >= CacheSize)
+        {
+            LoadedAt[Vertex] = Misses++;
+        }
+    }
+    return static_cast<float>(Misses) / NumTriangles;
+}
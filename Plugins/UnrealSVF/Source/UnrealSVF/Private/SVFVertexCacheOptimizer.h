@@ -0,0 +1,22 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Reorders triangles for the post-transform vertex cache with Tipsify (Sander, Nehab and Barczak 2007).
+// Triangles are emitted in fans around vertices still in a simulated cache, so several views drawing
+// the same hologram run fewer vertex shader invocations. Linear in the triangle count; the winding of
+// every triangle is kept.
+class FSVFVertexCacheOptimizer
+{
+public:
+    // Entries of the simulated FIFO cache, a conservative size for current GPUs
+    static const int32 DefaultCacheSize = 16;
+
+    // Reordered copy of Indices. Meshes indexing outside NumVertices are copied as they are.
+    static void Optimize(TArrayView<const int32> Indices, int32 NumVertices, TArray<int32>& OutIndices, int32 CacheSize = DefaultCacheSize);
+
+    // Average cache misses per triangle of a FIFO cache, 0.5 is ideal and 3 the worst case
+    static float ComputeACMR(TArrayView<const int32> Indices, int32 NumVertices, int32 CacheSize = DefaultCacheSize);
+};
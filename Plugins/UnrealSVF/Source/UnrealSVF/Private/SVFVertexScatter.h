@@ -0,0 +1,49 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SVFVertexStreams.h"
+#include "SVFNormalPacking.h"
+
+namespace SVFVertexScatter
+{
+    // One pass from the decoder's interleaved vertices to the separate streams, each vertex read once.
+    // SVF's (x, y, z) is Unreal's (y, z, x); PackTangentZ gives the packed TangentZ of a vertex.
+    template <typename SVFVertexType, typename PackTangentZType>
+    void Scatter(const SVFVertexType* Vertices, uint32 VertexCount, const FSVFVertexStreams& Streams, PackTangentZType PackTangentZ)
+    {
+        const FPackedNormal TangentX(FVector(1, 0, 0));
+        const int32 Stride = Streams.TexCoordStride;
+        for (uint32 i = 0; i < VertexCount; ++i)
+        {
+            const SVFVertexType& Vertex = Vertices[i];
+            Streams.Positions[i] = FVector(Vertex.z, Vertex.x, Vertex.y);
+            if (Streams.Tangents)
+            {
+                Streams.Tangents[2 * i + 0] = TangentX;
+                Streams.Tangents[2 * i + 1].Vector.Packed = PackTangentZ(Vertex);
+            }
+            if (Streams.TexCoords)
+            {
+                Streams.TexCoords[i * Stride] = FVector2D(Vertex.u, Vertex.v);
+            }
+        }
+    }
+
+    // Vertices without normals (CSVFVertex_Full) all face up
+    template <typename SVFVertexType>
+    void ScatterSVFVertices(const SVFVertexType* Vertices, uint32 VertexCount, const FSVFVertexStreams& Streams)
+    {
+        const uint32 UpTangentZ = FPackedNormal(FVector4(0, 0, 1, 1)).Vector.Packed;
+        Scatter(Vertices, VertexCount, Streams, [UpTangentZ](const SVFVertexType&) { return UpTangentZ; });
+    }
+
+    // Vertices with normals (CSVFVertex_Norm_Full)
+    template <typename SVFVertexType>
+    void ScatterSVFNormalVertices(const SVFVertexType* Vertices, uint32 VertexCount, const FSVFVertexStreams& Streams)
+    {
+        // nx, ny, nz are followed by u, so the four float load stays inside the vertex
+        Scatter(Vertices, VertexCount, Streams, [](const SVFVertexType& Vertex) { return SVFNormalPacking::PackSVFNormal(&Vertex.nx); });
+    }
+}
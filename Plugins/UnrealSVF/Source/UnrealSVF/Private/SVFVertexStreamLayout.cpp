@@ -0,0 +1,64 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFVertexStreamLayout.h"
+#include "SVFHalfPosition.h"
+#include "PackedNormal.h"
+
+namespace SVFVertexStreamLayout
+{
+    FSVFVertexStreamDesc MakeDesc(ESVFVertexStreamBuffer Buffer, uint32 Offset, uint32 Stride, EVertexElementType Type)
+    {
+        FSVFVertexStreamDesc Desc;
+        Desc.Buffer = Buffer;
+        Desc.Offset = Offset;
+        Desc.Stride = Stride;
+        Desc.Type = Type;
+        return Desc;
+    }
+}
+
+FSVFVertexStreamLayout FSVFVertexStreamLayout::Build(bool bHalfPositions, ESVFTexCoordFormat TexCoordFormat, uint32 NumTexCoords,
+    bool bHasNormals, bool bSharedColor)
+{
+    using namespace SVFVertexStreamLayout;
+
+    FSVFVertexStreamLayout Layout;
+    Layout.Position = bHalfPositions ?
+        MakeDesc(ESVFVertexStreamBuffer::Position, 0, sizeof(FSVFHalfPosition), VET_Half4) :
+        MakeDesc(ESVFVertexStreamBuffer::Position, 0, sizeof(FVector), VET_Float3);
+
+    const uint32 TangentStride = 2 * sizeof(FPackedNormal);
+    Layout.TangentBasis[0] = MakeDesc(ESVFVertexStreamBuffer::Tangent, 0, TangentStride, VET_PackedNormal);
+    Layout.TangentBasis[1] = MakeDesc(ESVFVertexStreamBuffer::Tangent, sizeof(FPackedNormal), TangentStride, VET_PackedNormal);
+
+    EVertexElementType DoubleWideType = VET_Float4;
+    EVertexElementType SingleType = VET_Float2;
+    if (TexCoordFormat == ESVFTexCoordFormat::UNorm16)
+    {
+        DoubleWideType = VET_UShort4N;
+        SingleType = VET_UShort2N;
+    }
+    else if (TexCoordFormat == ESVFTexCoordFormat::Half)
+    {
+        DoubleWideType = VET_Half4;
+        SingleType = VET_Half2;
+    }
+    const uint32 UVSize = FSVFTexCoordPacker::GetStride(TexCoordFormat);
+    const uint32 UVStride = UVSize * NumTexCoords;
+    uint32 UVIndex = 0;
+    for (; UVIndex + 1 < NumTexCoords; UVIndex += 2)
+    {
+        Layout.TexCoords.Add(MakeDesc(ESVFVertexStreamBuffer::TexCoord, UVSize * UVIndex, UVStride, DoubleWideType));
+    }
+    if (UVIndex < NumTexCoords)
+    {
+        Layout.TexCoords.Add(MakeDesc(ESVFVertexStreamBuffer::TexCoord, UVSize * UVIndex, UVStride, SingleType));
+    }
+
+    // Captures have no vertex colour. Without the index mask, manual vertex fetch reads the colour view at
+    // the vertex index, which would run past the null buffer's single entry.
+    Layout.Color = bSharedColor ?
+        MakeDesc(ESVFVertexStreamBuffer::NullColor, 0, 0, VET_Color) :
+        MakeDesc(ESVFVertexStreamBuffer::Color, 0, sizeof(FColor), VET_Color);
+    return Layout;
+}
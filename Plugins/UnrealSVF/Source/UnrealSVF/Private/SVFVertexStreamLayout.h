@@ -0,0 +1,50 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHIDefinitions.h"
+#include "SVFTexCoordPacker.h"
+
+// Buffers the mesh vertex factory streams from
+enum class ESVFVertexStreamBuffer : uint8
+{
+    Position,
+    Tangent,
+    TexCoord,
+    // One white colour per vertex, for engines whose vertex factory has no colour index mask
+    Color,
+    // The engine's null colour buffer, a single white entry every vertex reads
+    NullColor,
+};
+
+struct FSVFVertexStreamDesc
+{
+    ESVFVertexStreamBuffer Buffer = ESVFVertexStreamBuffer::Position;
+    uint32 Offset = 0;
+    uint32 Stride = 0;
+    EVertexElementType Type = VET_None;
+
+    bool operator==(const FSVFVertexStreamDesc& Other) const
+    {
+        return Buffer == Other.Buffer && Offset == Other.Offset && Stride == Other.Stride && Type == Other.Type;
+    }
+};
+
+// Streams of the mesh vertex factory, worked out apart from the RHI so they can be checked without it
+struct FSVFVertexStreamLayout
+{
+    FSVFVertexStreamDesc Position;
+    // TangentX and TangentZ, interleaved in one buffer
+    FSVFVertexStreamDesc TangentBasis[2];
+    // Two channels per stream, the last one alone when the count is odd
+    TArray<FSVFVertexStreamDesc> TexCoords;
+    FSVFVertexStreamDesc Color;
+
+    // bSharedColor says the vertex factory has a colour index mask (4.20 and later), so every vertex can
+    // read the one entry of the null colour buffer. Tangents stay per vertex without normals: manual vertex
+    // fetch indexes the tangent view by vertex whatever the stride, and the buffer then holds the default
+    // basis written at init.
+    static FSVFVertexStreamLayout Build(bool bHalfPositions, ESVFTexCoordFormat TexCoordFormat, uint32 NumTexCoords,
+        bool bHasNormals, bool bSharedColor);
+};
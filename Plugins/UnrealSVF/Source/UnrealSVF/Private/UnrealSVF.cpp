@@ -1,12 +1,14 @@
 // Copyright (C) Microsoft Corporation. All rights reserved.
 
 #include "UnrealSVF.h"
+#include "SVFMeshComponents.h"
 
 #if PLATFORM_WINDOWS
 #include "Misc/Paths.h"
 #include "SVF.h"
 #include "Windows/AllowWindowsPlatformTypes.h"
 #include "Interfaces/IPluginManager.h"
+#include "SVFReaderPool.h"
 #endif
 #if PLATFORM_ANDROID
 #include "Android/AndroidJNI.h"
@@ -151,7 +153,10 @@ void FUnrealSVFModule::StartupModule()
 
 void FUnrealSVFModule::ShutdownModule()
 {
+    FSVFMeshRenderData::EmptyPool();
 #if PLATFORM_WINDOWS
+    // Pooled readers have to be closed while SVF is still loaded
+    USVFReaderPool::Shutdown();
     FPlatformProcess::FreeDllHandle(dllHandle);
 #endif
 }
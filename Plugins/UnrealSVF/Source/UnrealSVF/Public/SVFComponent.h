@@ -2,11 +2,23 @@
 
 #include "CoreMinimal.h"
 #include "Components/MeshComponent.h"
+#include "Async/Future.h"
 #include "SVFClockInterface.h"
+#include "SVFFrameSnapshot.h"
+#include "SVFFramePacing.h"
+#include "SVFLockStep.h"
+#include "SVFSignificance.h"
+#include "SVFSurfaceSampler.h"
 #include "Interfaces/Interface_CollisionDataProvider.h"
 #include "SVFComponent.generated.h"
 
 class ISVFSimpleInterface;
+class FSVFMeshRenderData;
+class FSVFBoundsTrack;
+class FSVFMeshBVH;
+class UBodySetup;
+struct FSVFCompactMesh;
+struct FSVFMeshRenderSettings;
 
 UCLASS(
     Blueprintable,
@@ -48,16 +60,22 @@ public:
         return LastFrameData;
     }
 
-    // Returns the greater between file's max vertex count and user-defined default vertex count
+    // GPU buffers drawn by this component's scene proxy, shared with the other members of a shared stream
+    TSharedPtr<FSVFMeshRenderData, ESPMode::ThreadSafe> GetRenderData(ERHIFeatureLevel::Type InFeatureLevel);
+
+    // Clustering and LOD settings the render data is created with
+    FSVFMeshRenderSettings GetRenderSettings() const;
+
+    // Returns the file's max vertex count, or the user-defined default vertex count for files without one
     int32 GetMaxVertexCount()
     {
-        return FMath::Max(DefaultVertexCount, FileInfo.MaxVertexCount);
+        return FileInfo.MaxVertexCount > 0 ? FileInfo.MaxVertexCount : DefaultVertexCount;
     }
 
-    // Returns the greater between file's max index count and user-defined default index count
+    // Returns the file's max index count, or the user-defined default index count for files without one
     int32 GetMaxIndexCount()
     {
-        return FMath::Max(DefaultIndexCount, FileInfo.MaxIndexCount);
+        return FileInfo.MaxIndexCount > 0 ? FileInfo.MaxIndexCount : DefaultIndexCount;
     }
 
     UFUNCTION(BlueprintCallable, Category = "SVFComponent")
@@ -78,12 +96,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SVFComponent")
     void SVF_Stop();
 
+    // Any rate up to +/-10x is played as is; 0 pauses
     UFUNCTION(BlueprintCallable, Category = "SVFComponent")
     void SVF_SetPlayRate(float InPlayRate = 1.f);
 
     UFUNCTION(BlueprintCallable, Category = "SVFComponent")
     float SVF_GetPlayRate();
 
+    // Share of the buffer memory budget relative to other holograms, 1 is normal
+    UFUNCTION(BlueprintCallable, Category = "SVFComponent")
+    void SVF_SetBufferPriority(float InPriority = 1.f);
+
     UFUNCTION(BlueprintCallable, Category = "SVFComponent")
     bool SVF_CanSeek();
 
@@ -123,6 +146,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SVFComponent")
     bool SVF_Open(const FString& FileName, bool InStartPlayingImmediately = false);
 
+    // Open and preroll this component's file in the reader pool, so a later SVF_Open shows the first frame right away
+    UFUNCTION(BlueprintCallable, Category = "SVFComponent")
+    bool SVF_PrewarmCue();
+
     UFUNCTION(BlueprintCallable, Category = "SVFComponent")
     void SVF_StartReader();
 
@@ -144,9 +171,35 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SVFComponent")
     static bool GetMovies(TArray<FString>& Files);
 
+    // Copies the latest frame's positions, see GetFrameSnapshot to read them without copying
     UFUNCTION(BlueprintCallable, Category = "SVFComponent")
     bool GetVertices(TArray<FVector>& Vertices);
 
+    // Positions, normals, texture coordinates and indices of the latest frame, in local space. The snapshot never changes and
+    // may be read from any thread for as long as it is held. Null until the first frame is converted.
+    FSVFFrameSnapshotPtr GetFrameSnapshot() const;
+
+    // Closest hit of the segment on the hologram's triangles, needs bBuildTriangleBVH.
+    // The triangles are those of the latest frame the worker finished, usually a frame behind the drawn one.
+    UFUNCTION(BlueprintCallable, Category = "SVFComponent")
+    bool SVF_LineTraceFrame(const FVector& Start, const FVector& End, FVector& OutLocation, FVector& OutNormal, float& OutDistance) const;
+
+    // Point on the hologram's triangles closest to Center, if one lies within Radius; needs bBuildTriangleBVH
+    UFUNCTION(BlueprintCallable, Category = "SVFComponent")
+    bool SVF_SphereOverlapFrame(const FVector& Center, float Radius, FVector& OutClosestPoint) const;
+
+    // Count points spread evenly over the hologram's surface in world space, with interpolated normals and
+    // texture coordinates; needs bBuildSurfaceSampler. The same seed gives the same points on the same frame.
+    UFUNCTION(BlueprintCallable, Category = "SVFComponent")
+    bool SVF_SampleSurface(int32 Count, int32 Seed, TArray<FVector>& OutPositions, TArray<FVector>& OutNormals, TArray<FVector2D>& OutTexCoords) const;
+
+    // Area weighted sampler of the latest frame it was built for, in local space; needs bBuildSurfaceSampler.
+    // Read only and usable from any thread while held. Null until the first one is built.
+    FSVFSurfaceSamplerPtr GetSurfaceSampler() const
+    {
+        return SurfaceSampler;
+    }
+
 protected:
 
     UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF, Meta = (ExposeOnSpawn = true))
@@ -164,6 +217,112 @@ protected:
     UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
     int32 UpdateFrameInterval;
 
+    // Ask SVF for the frame that will be on screen when this tick reaches the display
+    // (game, render thread and GPU latency) instead of the frame at tick time
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bPredictDisplayTime = false;
+
+    // Latency of the output device in milliseconds (projectors, video processors), added to the prediction
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF, Meta = (EditCondition = "bPredictDisplayTime", ClampMin = "0"))
+    float DisplayLatencyMs = 0.f;
+
+    // Fraction of a content frame a frame boundary may be overshot before the cadence is broken
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF, Meta = (EditCondition = "bPredictDisplayTime", ClampMin = "0", ClampMax = "0.5"))
+    float CadenceHysteresis = 0.25f;
+
+    // Step playback by the engine's frame time instead of the realtime clock and wait for every frame to decode
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bLockStepPlayback = false;
+
+    // Switch to lock-step automatically while the engine runs with a fixed timestep (Movie Render Queue, fixed frame rate captures)
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bLockStepWithFixedTimeStep = true;
+
+    // Longest time in seconds a lock-step frame waits for the decoder before rendering what is available
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF, Meta = (ClampMin = "0"))
+    float LockStepTimeout = FSVFLockStepController::DefaultTimeoutSeconds;
+
+    // Open from warm readers in the reader pool when available, and hand readers back to the pool on close
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bUseReaderPool = false;
+
+    // Share one reader, GPU buffers and texture with every other sharing component that plays the same file.
+    // They all show the same frame; playback controls on any of them act on the shared stream.
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bShareStream = false;
+
+    // Refresh holograms that are small on screen at 15 or 7.5 fps, their textures less often than their geometry
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bScaleUpdateRateWithScreenSize = false;
+
+    // Screen size (bounds diameter over view width) from which every content frame is shown
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF, Meta = (EditCondition = "bScaleUpdateRateWithScreenSize", ClampMin = "0", ClampMax = "1"))
+    float FullRateScreenSize = 0.15f;
+
+    // Screen size from which 15 fps are shown, smaller holograms get 7.5 fps
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF, Meta = (EditCondition = "bScaleUpdateRateWithScreenSize", ClampMin = "0", ClampMax = "1"))
+    float HalfRateScreenSize = 0.05f;
+
+    // (Windows) Split every frame into spatial clusters and draw only those inside each view's frustum,
+    // for setups that render several viewports of which a hologram is in only some
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bCullClustersPerView = false;
+
+    // (Windows) Reorder each keyframe group's triangles on a worker thread so fewer vertices are shaded per view
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bOptimizeVertexCache = false;
+
+    // (Windows) Build reduced meshes on worker threads and draw them when the hologram is small on screen
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bGenerateLODs = false;
+
+    // Screen size below which LOD 1, 2, ... is drawn; every level has about a quarter of the triangles of the one before
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF, Meta = (EditCondition = "bGenerateLODs"))
+    TArray<float> LODScreenSizes = { 0.2f, 0.1f, 0.05f };
+
+    // Compute vertex normals on worker threads for clips without normals, or opened without Output Normals,
+    // so lit materials are shaded; the frames otherwise all face +Z
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bGenerateMissingNormals = false;
+
+    // Upload vertex positions as half floats, a third less position data per frame. Precision is about a thousandth of a
+    // position's distance from the clip origin, around a millimetre across a performer. Ignored with a warning on
+    // platforms with manual vertex fetch, which read positions as floats
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bHalfPrecisionPositions = false;
+
+    // Upload texture coordinates as 16 bit unsigned normalized integers instead of half floats, for clips that declare
+    // their UVs within 0..1. Same size, evenly spaced steps of 1/65535 where half floats step by up to 1/2048
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bNormalizedTexCoords = false;
+
+    // Keep a triangle BVH of the current frame on worker threads for SVF_LineTraceFrame and SVF_SphereOverlapFrame
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bBuildTriangleBVH = false;
+
+    // Build an area weighted triangle sampler of every presented frame on worker threads, for SVF_SampleSurface
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bBuildSurfaceSampler = false;
+
+    // Cook a decimated copy of the current frame as complex collision on a background thread, so
+    // physics props collide with the performer instead of its bounds
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    bool bCookTriangleCollision = false;
+
+    // Most triangles in the collision mesh, the frame is decimated down to it
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF, Meta = (EditCondition = "bCookTriangleCollision", ClampMin = "1"))
+    int32 CollisionTriangleBudget = 2000;
+
+    // Seconds between collision updates, each one cooks the frame shown when it starts
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF, Meta = (EditCondition = "bCookTriangleCollision", ClampMin = "0"))
+    float CollisionCookInterval = 0.5f;
+
+    // Frames per bounds window: bounds cover every frame of the window and only change between windows,
+    // 1 follows every frame. Bounds of frames not played yet come from a .svfbounds file next to the clip,
+    // or in Saved/SVF where one is written after the clip has played through once.
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF, Meta = (ClampMin = "1"))
+    int32 BoundsWindowFrames = 15;
+
     UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = Debug)
     uint32 DisableUpdateMesh : 1;
 
@@ -217,18 +376,45 @@ protected:
 
     bool IsWorldPlaying() const;
 
+    // Whether rate changes have to go through the reader's own clock rather than only ours
+    bool NeedsReaderClockScale() const;
+
     static bool ValidateFilePath(const FString& InFilePath);
 
     void CloseCurrent(bool InAsync = false);
     bool OpenFilePath();
+    // Swaps buffers sized for another clip for a set sized for the open one
+    void FitRenderDataToClip();
 #if WITH_EDITOR
     bool GeneratePreview();
 #endif
     void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent);
 
-    void GenerateMesh();
+    // Uploads LastFrameData to the GPU
+    virtual void GenerateMesh();
+    // Decides from the on-screen size what the frame in LastFrameData refreshes, returns true if the mesh is due
+    bool ThrottleFrameUpdate();
+    void UpdatePresentationPrediction(float DeltaTime);
+    bool IsLockStepActive() const;
+    void TickLockStep(float DeltaTime);
     void UpdateMaterial();
+    void UpdateMaterialInstance();
     void UpdateMaterialEditor();
+
+    // Shared streams: the leader owns and advances the reader, followers present its frames
+    FString MakeSharedStreamKey() const;
+    bool JoinSharedStream();
+    bool LeaveSharedStream();
+    bool IsSharedStreamFollower() const;
+    void TickSharedStreamFollower();
+    void TakeStreamLeadership(USVFComponent* PreviousLeader);
+    // Null unless this component follows another one
+    USVFComponent* GetSharedStreamLeader() const;
+
+    TSharedPtr<FSVFMeshRenderData, ESPMode::ThreadSafe> RenderData;
+    FString SharedStreamKey;
+    TWeakObjectPtr<USVFComponent> SharedStreamLeader;
+
     UPROPERTY(Transient)
     UObject* SVFReaderObject = nullptr;
 
@@ -239,6 +425,10 @@ protected:
     bool bIsBeginPlayback = false;
     bool bUpdateTexture = true;
 
+    FSVFUpdateThrottle UpdateThrottle;
+    ESVFUpdateTier UpdateTier = ESVFUpdateTier::Full;
+    FSVFUpdateDecision FrameUpdate;
+
     UPROPERTY(VisibleAnyWhere, BlueprintReadOnly, Category = SVF)
     UTexture2D* DynTexture = nullptr;
 
@@ -293,12 +483,21 @@ public:
 protected:
 
     EUSVFClockState ClockState = EUSVFClockState::Stopped;
-    float ClockCurrentTime = 0.f;
+    // Seconds, double so very slow rates still advance smoothly late into long clips
+    double ClockCurrentTime = 0.0;
     float m_ClockScale = 1.f;
     int64 PresentationOffset = 0L;
     int32 PauseCounter = 0;
     const int32 PauseCounterResetValue = 5;
 
+    FSVFPresentationTimePredictor PresentationPredictor;
+    FSVFCadencePolicy CadencePolicy;
+    // Presentation time handed to SVF while display time prediction is active, advancing between updates
+    FSVFPresentationClock PredictedPresentationClock;
+
+    FSVFLockStepController LockStepController;
+    bool bWasLockStepActive = false;
+
     // ~ END: ISVFClockInterface
 
 public:
@@ -318,9 +517,56 @@ public:
     virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
     virtual class UBodySetup* GetBodySetup() override;
 
+    // Body setups being cooked, oldest first; a finished one replaces MeshBodySetup
+    UPROPERTY(Transient)
+    TArray<UBodySetup*> AsyncBodySetupQueue;
+
     // Ensure MeshBodySetup is allocated and configured
     void UpdateBodySetup();
     void UpdateCollision();
+    UBodySetup* CreateBodySetup();
+
+    // Decimates a frame on the thread pool once the interval has passed, then starts cooking it
+    void TickTriangleCollision();
+    void FinishCollisionCook(bool bSuccess, UBodySetup* FinishedBodySetup);
+    void ResetTriangleCollision();
+
+    // Decimated frame GetPhysicsTriMeshData hands to the cook
+    TSharedPtr<FSVFCompactMesh, ESPMode::ThreadSafe> CollisionMesh;
+    TFuture<TSharedPtr<FSVFCompactMesh, ESPMode::ThreadSafe>> PendingCollisionMesh;
+    double LastCollisionCookTime = 0.0;
+
+    // Starts a BVH build or refit for LastFrameData once the previous one is done
+    void UpdateTriangleBVH();
+    void ResetTriangleBVH();
+
+    // Published tree, only read once published; the pending one replaces it when done
+    TSharedPtr<FSVFMeshBVH, ESPMode::ThreadSafe> TriangleBVH;
+    TFuture<TSharedPtr<FSVFMeshBVH, ESPMode::ThreadSafe>> PendingTriangleBVH;
+    // Frame and topology the last build or refit was started for
+    int32 TriangleBVHFrameId = INDEX_NONE;
+    int32 TriangleBVHIndexCount = 0;
+    uint32 TriangleBVHIndicesCrc = 0;
+
+    // Starts a sampler build for the latest snapshot once the previous one is done
+    void UpdateSurfaceSampler();
+    void ResetSurfaceSampler();
+
+    FSVFSurfaceSamplerPtr SurfaceSampler;
+    TFuture<TSharedPtr<FSVFSurfaceSampler, ESPMode::ThreadSafe>> PendingSurfaceSampler;
+    int32 SurfaceSamplerFrameId = INDEX_NONE;
+
+    // Loads the clip's bounds track, or starts an empty one that fills as frames are shown
+    void OpenBoundsTrack();
+    // Moves the bounds to LastFrameData's window, only updating them when they changed
+    void UpdateFrameBounds();
+    FString GetSavedBoundsTrackPath() const;
+
+    TSharedPtr<FSVFBoundsTrack> BoundsTrack;
+    // Local bounds CalcBounds returns, invalid until a frame is shown
+    FBox FrameBounds = FBox(ForceInit);
+    int32 FrameBoundsFrameId = INDEX_NONE;
+    bool bSaveBoundsTrack = false;
 
     virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
 
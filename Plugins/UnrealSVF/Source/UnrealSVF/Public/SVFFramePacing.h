@@ -0,0 +1,98 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+// Estimates when the frame being built on the game thread will actually be scanned out,
+// from the smoothed game frame interval and the render thread / GPU time of recent frames.
+// Engine independent on purpose: the caller feeds the timings, so recorded traces can be replayed.
+class FSVFPresentationTimePredictor
+{
+public:
+    FSVFPresentationTimePredictor();
+
+    void Reset();
+
+    // Record the timings of the frame that just finished, all values in seconds
+    void AddFrameTiming(double GameDeltaSeconds, double RenderThreadSeconds, double GPUSeconds);
+
+    // Fixed latency added on top of the measured pipeline (display / projector processing)
+    void SetExtraLatency(double InSeconds) { ExtraLatency = FMath::Max(0.0, InSeconds); }
+
+    // Smoothed interval between two displayed frames
+    double GetFrameInterval() const { return FrameInterval; }
+
+    // Time from the current game tick until its result reaches the display
+    double GetPredictedLatency() const;
+
+    bool HasSamples() const { return NumSamples > 0; }
+
+private:
+    double SmoothSample(double Average, double Sample) const;
+
+    double FrameInterval;
+    double RenderThreadTime;
+    double GPUTime;
+    double ExtraLatency;
+    int32 NumSamples;
+};
+
+// Chooses the content frame to show at a predicted display time so that each content frame is held
+// for an even number of display refreshes (2-2-2 instead of 1-3-2 at 30 fps on 60 Hz).
+// A frame boundary is only crossed early when the current frame was already held for its full cadence,
+// and only crossed late by less than the hysteresis window; larger jumps (seeks, hitches) resync.
+class FSVFCadencePolicy
+{
+public:
+    FSVFCadencePolicy();
+
+    void Reset();
+
+    void SetFrameDuration(double InSeconds) { FrameDuration = InSeconds; }
+
+    // Fraction of a content frame a boundary may be overshot before the policy is forced to advance
+    void SetHysteresis(float InFraction) { Hysteresis = FMath::Clamp(InFraction, 0.f, 0.5f); }
+
+    // Returns the content frame to present for the given predicted content time
+    int64 SelectFrame(double PredictedContentTime, double DisplayInterval);
+
+    // Content time at the middle of the selected frame, safe to hand to a frame-accurate reader
+    double GetSelectedFrameTime() const;
+
+    int64 GetSelectedFrame() const { return SelectedFrame; }
+
+    bool IsValid() const { return FrameDuration > 0.0; }
+
+private:
+    double FrameDuration;
+    float Hysteresis;
+    int64 SelectedFrame;
+    // Predicted content time at which SelectedFrame was first chosen; the refreshes it has been held
+    // for follow from this rather than from the number of calls, which may skip refreshes
+    double SelectedAtTime;
+};
+
+// Content time anchored to the real time clock, so it keeps advancing between the game ticks that set it.
+// The reader asks for the presentation time from its own threads, hence the lock.
+class FSVFPresentationClock
+{
+public:
+    FSVFPresentationClock();
+
+    // Content time is ContentSeconds at real time NowSeconds and then advances by Rate per real second
+    void Set(double ContentSeconds, double NowSeconds, double Rate);
+
+    void Invalidate();
+
+    // False while not set
+    bool Get(double NowSeconds, double& OutContentSeconds) const;
+
+private:
+    mutable FCriticalSection Lock;
+    double BaseContentTime;
+    double AnchorTime;
+    double Rate;
+    bool bValid;
+};
@@ -0,0 +1,54 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Geometry of one frame in the component's local space, published once per mesh update. Never changed
+ * after it is published: any thread may read it for as long as it holds the pointer, later frames are
+ * published as new snapshots.
+ */
+struct UNREALSVF_API FSVFFrameSnapshot
+{
+    int32 FrameId = 0;
+    TArray<FVector> Positions;
+    // One per position, empty for clips without normals
+    TArray<FVector> Normals;
+    // First texture coordinate of each position
+    TArray<FVector2D> TexCoords;
+    // Three per triangle, in the order the file stores them
+    TArray<int32> Indices;
+
+    TArrayView<const FVector> GetPositions() const
+    {
+        return Positions;
+    }
+
+    TArrayView<const FVector> GetNormals() const
+    {
+        return Normals;
+    }
+
+    TArrayView<const FVector2D> GetTexCoords() const
+    {
+        return TexCoords;
+    }
+
+    TArrayView<const int32> GetIndices() const
+    {
+        return Indices;
+    }
+
+    bool HasNormals() const
+    {
+        return Normals.Num() == Positions.Num() && Normals.Num() > 0;
+    }
+
+    int32 GetNumTriangles() const
+    {
+        return Indices.Num() / 3;
+    }
+};
+
+typedef TSharedPtr<const FSVFFrameSnapshot, ESPMode::ThreadSafe> FSVFFrameSnapshotPtr;
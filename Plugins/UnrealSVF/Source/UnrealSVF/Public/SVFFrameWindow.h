@@ -0,0 +1,50 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// A ring of the most recently decoded frames, so instances of one clip can show frames from the past.
+// Every pushed frame gets a window position that grows with the content frame index; dropped frames
+// leave gaps, loops and seeks continue from the newest position, so offsets stay meaningful across them.
+// Instances ask for a frame offset behind the newest frame and get the slot holding the closest frame
+// at or before it.
+class FSVFFrameWindow
+{
+public:
+    FSVFFrameWindow();
+
+    // Drops every frame
+    void Configure(int32 InNumSlots);
+
+    void Reset();
+
+    // Records a new frame and returns the slot it has to be written to, overwriting the oldest frame
+    int32 Push(int32 FrameIndex);
+
+    // Slot showing the frame FrameOffset frames behind the newest one, INDEX_NONE while empty.
+    // Offsets further back than the window holds get the oldest frame.
+    int32 FindSlot(int32 FrameOffset) const;
+
+    // FindSlot for every instance
+    void AssignInstances(const TArray<int32>& FrameOffsets, TArray<int32>& OutSlots) const;
+
+    // Content frame index held by a slot, INDEX_NONE if the slot is empty
+    int32 GetSlotFrame(int32 Slot) const;
+
+    int32 GetNumSlots() const { return Slots.Num(); }
+
+    int32 GetNumFrames() const { return NumFrames; }
+
+private:
+    struct FSlot
+    {
+        int32 FrameIndex = INDEX_NONE;
+        int64 Position = 0;
+    };
+
+    TArray<FSlot> Slots;
+    // Slot of the newest frame
+    int32 Head;
+    int32 NumFrames;
+};
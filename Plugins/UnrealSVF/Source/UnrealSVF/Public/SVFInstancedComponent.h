@@ -0,0 +1,99 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SVFComponent.h"
+#include "SVFFrameWindow.h"
+#include "SVFInstancedComponent.generated.h"
+
+USTRUCT(Blueprintable, BlueprintType)
+struct UNREALSVF_API FSVFInstance
+{
+    GENERATED_USTRUCT_BODY();
+
+    // Relative to the component
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SVF")
+    FTransform Transform;
+
+    // Frames this instance lags behind the newest decoded frame, limited by the frame window
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SVF", Meta = (ClampMin = "0"))
+    int32 FrameOffset = 0;
+};
+
+/**
+ * Draws many copies of one clip from a single reader. The most recent frames are kept in a ring of GPU
+ * buffers and textures, every instance shows one of them according to its frame offset, so a crowd of
+ * duplicates costs one decode and one scene proxy.
+ * With no instances the clip is drawn once at the component's transform.
+ */
+UCLASS(
+    Blueprintable,
+    BlueprintType,
+    EditInlineNew,
+    ClassGroup = UnrealSVF,
+    meta = (BlueprintSpawnableComponent),
+    hideCategories = (Input, Physics),
+    showCategories = (Mobility)
+)
+class UNREALSVF_API USVFInstancedComponent : public USVFComponent
+{
+    GENERATED_BODY()
+
+    friend class FSVFInstancedMeshSceneProxy;
+
+public:
+
+    virtual void OnRegister() override;
+
+    // Returns the index of the new instance
+    UFUNCTION(BlueprintCallable, Category = "SVFComponent")
+    int32 SVF_AddInstance(const FTransform& InstanceTransform, int32 FrameOffset = 0);
+
+    UFUNCTION(BlueprintCallable, Category = "SVFComponent")
+    bool SVF_SetInstanceFrameOffset(int32 InstanceIndex, int32 FrameOffset);
+
+    UFUNCTION(BlueprintCallable, Category = "SVFComponent")
+    void SVF_ClearInstances();
+
+    UFUNCTION(BlueprintCallable, Category = "SVFComponent")
+    int32 SVF_GetInstanceCount() const { return Instances.Num(); }
+
+    virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+    virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+    virtual void GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials = false) const override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+
+    // Frames kept on the GPU; the largest usable frame offset is one less
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF, Meta = (ClampMin = "1", ClampMax = "64"))
+    int32 FrameWindowSize = 8;
+
+    UPROPERTY(EditAnyWhere, BlueprintReadOnly, Category = SVF)
+    TArray<FSVFInstance> Instances;
+
+    virtual void GenerateMesh() override;
+
+    // (Re)creates the slot buffers, textures and materials when the window size changed, returns true if it did
+    bool InitSlots();
+    void UpdateSlotTexture(int32 Slot);
+    // Reassigns instances to slots and hands the result to the scene proxy
+    void UpdateInstanceSlots();
+    void GetInstanceOffsets(TArray<int32>& OutOffsets) const;
+    void GetInstanceTransforms(TArray<FMatrix>& OutTransforms) const;
+
+    FSVFFrameWindow FrameWindow;
+    TArray<TSharedPtr<FSVFMeshRenderData, ESPMode::ThreadSafe>> SlotRenderData;
+    TArray<FBox> SlotBounds;
+    TArray<int32> InstanceSlots;
+
+    UPROPERTY(Transient)
+    TArray<UTexture2D*> SlotTextures;
+
+    UPROPERTY(Transient)
+    TArray<UMaterialInstanceDynamic*> SlotMaterials;
+};
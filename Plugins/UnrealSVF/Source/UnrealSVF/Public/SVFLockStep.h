@@ -0,0 +1,78 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ESVFLockStepResult : uint8
+{
+    // The target frame was fetched and should be displayed
+    NewFrame,
+    // The frame on screen already is the target (output rate above content rate)
+    CurrentFrame,
+    // Decode did not deliver the target frame in time, the current frame may still have advanced
+    TimedOut,
+    // The stream ended before the target frame (and could not be restarted, when looping)
+    EndOfStream,
+};
+
+// Drives playback from a fixed output timestep instead of the realtime clock, for offline renders.
+// Every step maps to exactly one content frame; frames are pulled from the reader until that frame
+// is reached, blocking on decode up to a timeout. Frame fetching, time and sleeping are injected
+// so the controller can be driven by a synthetic reader.
+class FSVFLockStepController
+{
+public:
+    // Fetches the next decoded frame. Returns false if none is ready yet; OutFrameIndex is the
+    // frame's index from the start of the clip
+    typedef TFunctionRef<bool(int32& OutFrameIndex, bool& bOutEndOfStream)> FFetchFrame;
+    // Seeks the reader back to the start of the clip; returns false if it could not
+    typedef TFunctionRef<bool()> FRestartStream;
+
+    // Longest wait for the decoder per step unless SetTimeout says otherwise; also the component's default
+    static constexpr float DefaultTimeoutSeconds = 5.f;
+
+    FSVFLockStepController();
+
+    // Restart at the given content time, nothing is considered on screen afterwards
+    void Reset(double InOutputTime = 0.0);
+
+    void SetFrameDuration(double InSeconds) { FrameDuration = InSeconds; }
+
+    void SetTimeout(double InSeconds) { TimeoutSeconds = FMath::Max(0.0, InSeconds); }
+
+    double GetTimeout() const { return TimeoutSeconds; }
+
+    // Replace the wall clock and sleep used while blocking on decode
+    void SetTimeSource(TFunction<double()> InNow, TFunction<void(float)> InSleep);
+
+    // Move the output time forward by one step of content time
+    void Advance(double StepSeconds);
+
+    // Pull frames until the frame for the current output time is reached
+    ESVFLockStepResult WaitForTargetFrame(FFetchFrame FetchFrame);
+
+    // As above, but a stream that ends before the target frame is restarted and the output time wrapped
+    // by the clip's length within the same step, so the seam shows frame 0 instead of repeating the last
+    ESVFLockStepResult WaitForTargetFrame(FFetchFrame FetchFrame, FRestartStream RestartStream);
+
+    int32 GetTargetFrame() const;
+
+    int32 GetCurrentFrame() const { return CurrentFrame; }
+
+    double GetOutputTime() const { return OutputTime; }
+
+    bool IsValid() const { return FrameDuration > 0.0; }
+
+private:
+    ESVFLockStepResult FetchUntilTarget(FFetchFrame FetchFrame, const FRestartStream* RestartStream);
+
+    double FrameDuration;
+    double TimeoutSeconds;
+    double OutputTime;
+    int32 CurrentFrame;
+    bool bStarted;
+
+    TFunction<double()> Now;
+    TFunction<void(float)> SleepFor;
+};
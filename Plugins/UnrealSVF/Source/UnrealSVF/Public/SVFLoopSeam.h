@@ -0,0 +1,57 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ESVFLoopStandbyState : uint8
+{
+    None,
+    Preparing,
+    Ready,
+    Failed,
+};
+
+enum class ESVFLoopSeamAction : uint8
+{
+    None,
+    // Open and preroll a reader at the loop start
+    PrepareStandby,
+    // Present from the standby reader, shifting the presentation offset by one loop
+    SwitchToStandby,
+    // No standby available, restart the current reader (re-prerolls)
+    RestartSource,
+};
+
+// Decides when a looping clip prepares its next loop and when presentation switches over.
+// The standby is requested a lead time before the tail; the switch happens once the last frame
+// has been presented and the presentation time reaches the end of the loop, so the standby's first
+// frame follows the last one exactly. All times are in 100ns presentation units.
+class FSVFLoopSeamScheduler
+{
+public:
+    FSVFLoopSeamScheduler();
+
+    void Configure(int32 InFrameCount, int64 InLoopDuration, int64 InLeadTime);
+
+    // Start of a new loop
+    void Reset();
+
+    // Call before fetching the next frame
+    ESVFLoopSeamAction Update(int64 PresentationTime, ESVFLoopStandbyState StandbyState);
+
+    // Call for every frame handed out for presentation
+    void OnFramePresented(int64 FrameTimestamp, bool bEndOfStream);
+
+    // Presentation offset shift that maps the standby's loop start onto the end of the current loop
+    int64 GetLoopDuration() const { return LoopDuration; }
+
+    bool IsTailReached() const { return bTailReached; }
+
+private:
+    int64 LoopDuration;
+    int64 FrameDuration;
+    int64 LeadTime;
+    bool bTailReached;
+    bool bStandbyRequested;
+};
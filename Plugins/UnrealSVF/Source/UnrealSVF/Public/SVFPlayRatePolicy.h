@@ -0,0 +1,60 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// How much decoded and compressed data a reader keeps ahead of the playhead
+struct FSVFBufferingTargets
+{
+    // Decoded frames that must be buffered before playback leaves the buffering state
+    uint32 MinBufferFrames = 0;
+    // Decoded frames buffered at most
+    uint32 MaxBufferFrames = 0;
+    // Decoded frames needed to restart playback after buffering
+    uint32 BufferHysteresisFrames = 0;
+    // Frames SVF may drop in a single GetNextFrameViaClock call to catch up
+    uint32 MaxDropFramesPerCall = 0;
+    // Seconds of compressed data downloaded ahead
+    int32 DownloadBufferSeconds = 0;
+
+    bool operator==(const FSVFBufferingTargets& Other) const
+    {
+        return MinBufferFrames == Other.MinBufferFrames && MaxBufferFrames == Other.MaxBufferFrames &&
+            BufferHysteresisFrames == Other.BufferHysteresisFrames && MaxDropFramesPerCall == Other.MaxDropFramesPerCall &&
+            DownloadBufferSeconds == Other.DownloadBufferSeconds;
+    }
+    bool operator!=(const FSVFBufferingTargets& Other) const { return !(*this == Other); }
+};
+
+// Scales the reader's look-ahead with the playback rate. Faster playback consumes frames and
+// compressed data proportionally faster, so buffers grow with the rate to avoid underruns; slower
+// playback keeps the base buffering, shrinking it would only cause needless flushes.
+// The rate is quantized into steps and only re-targeted once it leaves the current step by a margin,
+// so a slowly ramped rate does not reconfigure the reader every frame.
+class FSVFPlayRateBufferPolicy
+{
+public:
+    FSVFPlayRateBufferPolicy();
+
+    // Buffering used at 1x; MaxBufferUpperBound caps every scaled frame count
+    void SetBaseTargets(const FSVFBufferingTargets& InBase, uint32 InMaxBufferUpperBound);
+
+    const FSVFBufferingTargets& GetBaseTargets() const { return Base; }
+
+    // Buffering for an arbitrary rate, independent of the policy's current state
+    FSVFBufferingTargets GetTargetsForRate(float Rate) const;
+
+    // Feed the current rate. Returns true and fills OutTargets when the reader should be re-targeted.
+    bool UpdateRate(float Rate, FSVFBufferingTargets& OutTargets);
+
+    void Reset();
+
+private:
+    // Look-ahead multiplier for a rate, rounded up to the policy step
+    float GetLookAheadScale(float Rate) const;
+
+    FSVFBufferingTargets Base;
+    uint32 MaxBufferUpperBound;
+    float CurrentScale;
+};
@@ -0,0 +1,74 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ESVFUpdateTier : uint8
+{
+    // Every content frame
+    Full,
+    // About 15 fps
+    Half,
+    // About 7.5 fps
+    Quarter,
+};
+
+// How often mesh and texture are refreshed, in content frames
+struct FSVFUpdateRate
+{
+    int32 MeshInterval = 1;
+    int32 TextureInterval = 1;
+};
+
+struct FSVFSignificanceSettings
+{
+    // Screen sizes (bounding sphere diameter over view width) at and above which a tier is used
+    float FullRateScreenSize = 0.15f;
+    float HalfRateScreenSize = 0.05f;
+    // Relative margin the screen size has to clear before a higher tier is given up
+    float Hysteresis = 0.2f;
+    // Textures of throttled holograms refresh this many times less often than their geometry
+    int32 TextureIntervalScale = 2;
+};
+
+// Maps how large a hologram is on screen to how often it is updated. Engine independent, the caller
+// provides the views.
+class FSVFSignificance
+{
+public:
+    // Fraction of the view width covered by a bounding sphere, as for UE's LOD screen sizes
+    static float ComputeScreenSize(float SphereRadius, float Distance, float HalfFOVRadians);
+
+    static ESVFUpdateTier SelectTier(float ScreenSize, ESVFUpdateTier CurrentTier, const FSVFSignificanceSettings& Settings);
+
+    static FSVFUpdateRate GetUpdateRate(ESVFUpdateTier Tier, float ContentFrameRate, const FSVFSignificanceSettings& Settings);
+};
+
+// What to refresh for a frame fetched from the reader
+struct FSVFUpdateDecision
+{
+    bool bUpdateMesh = true;
+    bool bUpdateTexture = true;
+    // A keyframe was passed since the last texture update: the UVs refer to a new texture layout,
+    // so the texture has to be refreshed along with the mesh
+    bool bNewKeyFrameGroup = false;
+};
+
+// Skips frames according to an update rate. Texture updates only ever happen with a mesh update and
+// are forced when the keyframe group changed, so geometry and texture never disagree.
+class FSVFUpdateThrottle
+{
+public:
+    FSVFUpdateThrottle();
+
+    void Reset();
+
+    // Call for every frame fetched from the reader
+    FSVFUpdateDecision OnNewFrame(int32 FrameId, bool bKeyFrame, const FSVFUpdateRate& Rate);
+
+private:
+    int32 LastMeshFrame;
+    int32 LastTextureFrame;
+    bool bPendingKeyFrame;
+};
@@ -103,6 +103,12 @@ public:
 
     virtual void SetReaderClockScale(float InScale) PURE_VIRTUAL(ISVFReaderInterface::SetReaderClockScale, );
 
+    /** Scales the reader's look-ahead to the playback rate without flushing what is already buffered */
+    virtual void UpdateBufferingForRate(float InRate) PURE_VIRTUAL(ISVFReaderInterface::UpdateBufferingForRate, );
+
+    /** Share of the process-wide buffer budget relative to other readers, 1 is normal */
+    virtual void SetBufferPriority(float InPriority) PURE_VIRTUAL(ISVFReaderInterface::SetBufferPriority, );
+
     virtual bool GetSeekRange(FInt32Range& OutFrameRange) PURE_VIRTUAL(ISVFReaderInterface::GetSeekRange, return false; );
 
     virtual bool ForceFlush() PURE_VIRTUAL(ISVFReaderInterface::ForceFlush, return false; );
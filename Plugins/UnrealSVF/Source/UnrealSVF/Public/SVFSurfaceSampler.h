@@ -0,0 +1,64 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SVFFrameSnapshot.h"
+
+// Point on a frame's surface, in the local space of its snapshot
+struct FSVFSurfaceSample
+{
+    FVector Position = FVector::ZeroVector;
+    FVector Normal = FVector::UpVector;
+    FVector2D TexCoord = FVector2D::ZeroVector;
+    int32 Triangle = INDEX_NONE;
+};
+
+/**
+ * Draws points spread evenly over the area of one frame's triangles. The alias table is built once per
+ * frame, after which every sample costs four random numbers and one triangle, independent of the
+ * triangle count. Read only after Build, so one sampler may serve any number of threads.
+ */
+class UNREALSVF_API FSVFSurfaceSampler
+{
+public:
+    // Keeps Snapshot for the vertex data; degenerate triangles and bad indices get no weight
+    void Build(const FSVFFrameSnapshotPtr& InSnapshot);
+
+    bool IsEmpty() const
+    {
+        return Alias.Num() == 0;
+    }
+
+    int32 GetFrameId() const
+    {
+        return Snapshot.IsValid() ? Snapshot->FrameId : 0;
+    }
+
+    float GetTotalArea() const
+    {
+        return TotalArea;
+    }
+
+    // Area weighted triangle, then a uniform point on it. Normals and texture coordinates are interpolated,
+    // clips without normals get the face normal.
+    bool Sample(FRandomStream& Random, FSVFSurfaceSample& OutSample) const;
+
+    // Appends Count samples
+    void SampleMany(FRandomStream& Random, int32 Count, TArray<FSVFSurfaceSample>& OutSamples) const;
+
+private:
+    struct FEntry
+    {
+        // Chance of keeping the triangle in its own column, else Alias is drawn
+        float Probability;
+        int32 Alias;
+    };
+
+    FSVFFrameSnapshotPtr Snapshot;
+    // One column per triangle of the snapshot
+    TArray<FEntry> Alias;
+    float TotalArea = 0.f;
+};
+
+typedef TSharedPtr<const FSVFSurfaceSampler, ESPMode::ThreadSafe> FSVFSurfaceSamplerPtr;
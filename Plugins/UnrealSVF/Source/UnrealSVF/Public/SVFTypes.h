@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "DynamicMeshBuilder.h"
+#include "SVFVertexStreams.h"
 #include "SVFTypes.generated.h"
 
 // Forward declaration
@@ -177,6 +178,14 @@ struct UNREALSVF_API FSVFOpenInfo {
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SVF")
         uint32 AutoLooping : 1;
 
+    // if true, auto looping pre-opens the loop start before the tail and switches to it on the exact frame instead of rewinding
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SVF")
+        uint32 GaplessLooping : 1;
+
+    // if true, SVF never drops frames and buffers for decode throughput instead of realtime playback (offline renders)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SVF")
+        uint32 LockStepDecode : 1;
+
     // if true, we enforce custom software clock to enable clock scaling. If false: filers with audio will have default scaling, files with no audio: no scaling
     // @TODO: remove it and force to TRUE
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SVF")
@@ -187,6 +196,10 @@ struct UNREALSVF_API FSVFOpenInfo {
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SVF")
         float playbackRate;
 
+    // Share of the [SVFSettings] BufferBudgetMB memory relative to other readers (1.0f = normal)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SVF")
+        float BufferPriority;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SVF")
         FHrtfAudioDecaySettings hrtf;
 
@@ -427,6 +440,10 @@ struct UNREALSVF_API FSVFFileInfo {
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SVF")
         bool hasNormals = false;
 
+    // Texture coordinates stay within 0..1 instead of -1..1
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SVF")
+        bool hasUnsignedUVs = false;
+
     FSVFFileInfo() {};
 
 };
@@ -444,11 +461,17 @@ struct UNREALSVF_API FFrameData {
 #endif
 
     virtual bool GetFrameInfo(FSVFFrameInfo& OutFrameInfo) PURE_VIRTUAL(FFrameData::GetFrameInfo, return false; );
+    // Whether GetFrameVertices fills per-vertex normals; without them every vertex gets the same tangent basis
+    virtual bool HasNormals() const PURE_VIRTUAL(FFrameData::HasNormals, return true; );
 
     virtual bool GetFrameVerticesWithNormal(TArray<FSVFVertexNorm>& OutVertices) PURE_VIRTUAL(FFrameData::GetFrameVerticesWithNormal, return false; );
     virtual bool GetFrameVerticesWithoutNormal(TArray<FSVFVertex>& OutVertices) PURE_VIRTUAL(FFrameData::GetFrameVerticesWithoutNormal, return false; );
     virtual bool GetFrameVertices(TArray<FDynamicMeshVertex>& OutVertices) PURE_VIRTUAL(FFrameData::GetFrameVertices, return false; );
     virtual bool GetFrameVertices(FDynamicMeshVertex* OutVertices) PURE_VIRTUAL(FFrameData::GetFrameVertices, return false; );
+    // Vertices converted straight into the separate streams the mesh buffers upload, no intermediate vertex
+    virtual bool GetFrameStreams(const FSVFVertexStreams& OutStreams) PURE_VIRTUAL(FFrameData::GetFrameStreams, return false; );
+    // Vertex positions only, for CPU side queries that do not need the full vertex
+    virtual bool GetFramePositions(TArray<FVector>& OutPositions) PURE_VIRTUAL(FFrameData::GetFramePositions, return false; );
 
     virtual bool GetFrameIndices(TArray<int32>& OutIndices) PURE_VIRTUAL(FFrameData::GetFrameIndices, return false; );
     virtual bool GetFrameIndices(int32* OutIndices) PURE_VIRTUAL(FFrameData::GetFrameIndices, return false; );
@@ -0,0 +1,18 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PackedNormal.h"
+
+// Destination of FFrameData::GetFrameStreams, one array per vertex stream of the mesh buffers
+struct FSVFVertexStreams
+{
+    FVector* Positions = nullptr;
+    // TangentX and TangentZ of every vertex, interleaved; not written when null
+    FPackedNormal* Tangents = nullptr;
+    // First texture coordinate of every vertex; not written when null
+    FVector2D* TexCoords = nullptr;
+    // Elements between the texture coordinates of two vertices, the other channels are left alone
+    int32 TexCoordStride = 1;
+};
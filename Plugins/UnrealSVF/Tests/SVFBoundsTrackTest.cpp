@@ -0,0 +1,139 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFBoundsTrack.h"
+
+namespace SVFBoundsTrackTest
+{
+    // A performer walking along X, one unit per frame
+    FBox FrameBounds(int32 FrameId)
+    {
+        return FBox(FVector(FrameId, -10.f, 0.f), FVector(FrameId + 20.f, 10.f, 180.f));
+    }
+
+    bool BoxesEqual(const FBox& A, const FBox& B)
+    {
+        return A.IsValid == B.IsValid && A.Min == B.Min && A.Max == B.Max;
+    }
+}
+
+using namespace SVFBoundsTrackTest;
+
+SVF_TEST(RecordsEachFrameOnce)
+{
+    FSVFBoundsTrack Track(4);
+    SVF_CHECK_EQUAL(Track.GetNumFrames(), 4);
+    SVF_CHECK(!Track.IsComplete());
+
+    SVF_CHECK(Track.Record(1, FrameBounds(1)));
+    // Frames are shown again when the clip loops, the first bounds stay
+    SVF_CHECK(!Track.Record(1, FrameBounds(7)));
+    SVF_CHECK(BoxesEqual(Track.GetWindowBounds(1, 1), FrameBounds(1)));
+    // Out of range ids and invalid boxes are ignored
+    SVF_CHECK(!Track.Record(0, FrameBounds(0)));
+    SVF_CHECK(!Track.Record(5, FrameBounds(5)));
+    SVF_CHECK(!Track.Record(2, FBox(ForceInit)));
+
+    for (int32 FrameId = 2; FrameId <= 4; ++FrameId)
+    {
+        SVF_CHECK(Track.Record(FrameId, FrameBounds(FrameId)));
+    }
+    SVF_CHECK(Track.IsComplete());
+    SVF_CHECK(!FSVFBoundsTrack(0).IsComplete());
+}
+
+SVF_TEST(WindowBoundsOnlyChangeBetweenWindows)
+{
+    const int32 NumFrames = 100;
+    const int32 WindowFrames = 30;
+    FSVFBoundsTrack Track(NumFrames);
+    for (int32 FrameId = 1; FrameId <= NumFrames; ++FrameId)
+    {
+        Track.Record(FrameId, FrameBounds(FrameId));
+    }
+
+    // Playing through the clip, the bounds change once per window and always cover the current frame
+    int32 Changes = 0;
+    FBox Previous(ForceInit);
+    for (int32 FrameId = 1; FrameId <= NumFrames; ++FrameId)
+    {
+        const FBox Window = Track.GetWindowBounds(FrameId, WindowFrames);
+        SVF_CHECK(BoxesEqual(Window + FrameBounds(FrameId), Window));
+        Changes += BoxesEqual(Window, Previous) ? 0 : 1;
+        Previous = Window;
+    }
+    SVF_CHECK_EQUAL(Changes, 4);
+
+    // Windows start at frame 1, the last one is cut short by the clip's end
+    SVF_CHECK(BoxesEqual(Track.GetWindowBounds(31, WindowFrames), FrameBounds(31) + FrameBounds(60)));
+    SVF_CHECK(BoxesEqual(Track.GetWindowBounds(100, WindowFrames), FrameBounds(91) + FrameBounds(100)));
+    // A window of one frame follows the frame; zero is treated as one
+    SVF_CHECK(BoxesEqual(Track.GetWindowBounds(42, 0), FrameBounds(42)));
+    SVF_CHECK(!Track.GetWindowBounds(0, WindowFrames).IsValid);
+    SVF_CHECK(!Track.GetWindowBounds(101, WindowFrames).IsValid);
+}
+
+SVF_TEST(PartialTrackUsesKnownFrames)
+{
+    FSVFBoundsTrack Track(60);
+    SVF_CHECK(!Track.GetWindowBounds(5, 30).IsValid);
+    Track.Record(3, FrameBounds(3));
+    Track.Record(10, FrameBounds(10));
+    SVF_CHECK(BoxesEqual(Track.GetWindowBounds(5, 30), FrameBounds(3) + FrameBounds(10)));
+    SVF_CHECK(!Track.GetWindowBounds(31, 30).IsValid);
+}
+
+SVF_TEST(SaveLoadRoundTrip)
+{
+    FSVFBoundsTrack Track(12);
+    for (int32 FrameId = 1; FrameId <= 12; ++FrameId)
+    {
+        Track.Record(FrameId, FrameBounds(FrameId));
+    }
+    TArray<uint8> Data;
+    Track.Save(Data);
+
+    FSVFBoundsTrack Loaded(12);
+    SVF_CHECK(Loaded.Load(Data));
+    SVF_CHECK(Loaded.IsComplete());
+    for (int32 FrameId = 1; FrameId <= 12; ++FrameId)
+    {
+        SVF_CHECK(BoxesEqual(Loaded.GetWindowBounds(FrameId, 1), FrameBounds(FrameId)));
+    }
+
+    // A sidecar of another clip, a truncated or padded file, or another format leave the track as it was
+    FSVFBoundsTrack Other(13);
+    SVF_CHECK(!Other.Load(Data));
+    SVF_CHECK(!Other.IsComplete());
+    TArray<uint8> Truncated = Data;
+    Truncated.SetNum(Data.Num() - 1);
+    FSVFBoundsTrack Fresh(12);
+    SVF_CHECK(!Fresh.Load(Truncated));
+    TArray<uint8> Padded = Data;
+    Padded.Add(0);
+    SVF_CHECK(!Fresh.Load(Padded));
+    TArray<uint8> Corrupt = Data;
+    Corrupt[0] ^= 0xff;
+    SVF_CHECK(!Fresh.Load(Corrupt));
+    SVF_CHECK(!Fresh.Load(TArray<uint8>()));
+    SVF_CHECK(!Fresh.IsComplete());
+    SVF_CHECK(!Fresh.GetWindowBounds(1, 1).IsValid);
+}
+
+SVF_TEST(SidecarFileRoundTrip)
+{
+    FSVFBoundsTrack Track(3);
+    for (int32 FrameId = 1; FrameId <= 3; ++FrameId)
+    {
+        Track.Record(FrameId, FrameBounds(FrameId));
+    }
+    const FString Path = FString("SVFBoundsTrackTest.") + FSVFBoundsTrack::FileExtension;
+    SVF_CHECK(Track.SaveToFile(Path));
+    FSVFBoundsTrack Loaded(3);
+    SVF_CHECK(Loaded.LoadFromFile(Path));
+    SVF_CHECK(BoxesEqual(Loaded.GetWindowBounds(1, 3), Track.GetWindowBounds(1, 3)));
+    std::remove(*Path);
+
+    FSVFBoundsTrack Missing(3);
+    SVF_CHECK(!Missing.LoadFromFile(Path));
+}
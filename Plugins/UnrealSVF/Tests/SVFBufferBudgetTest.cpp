@@ -0,0 +1,90 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFBufferBudget.h"
+
+namespace SVFBufferBudgetTest
+{
+    FSVFBufferRequest MakeRequest(float Priority = 1.f)
+    {
+        FSVFBufferRequest Request;
+        Request.FrameBytes = 1000;
+        Request.StreamBytesPerSecond = 500;
+        Request.MinFrames = 2;
+        Request.MaxFrames = 12;
+        Request.MinDownloadSeconds = 1;
+        Request.MaxDownloadSeconds = 5;
+        Request.Priority = Priority;
+        return Request;
+    }
+
+    // 12 frames and 5 seconds
+    const uint64 MaxBytes = 12 * 1000 + 5 * 500;
+    // 2 frames and 1 second
+    const uint64 MinBytes = 2 * 1000 + 1 * 500;
+}
+
+using namespace SVFBufferBudgetTest;
+
+SVF_TEST(UnlimitedBudgetGrantsMaximums)
+{
+    TArray<FSVFBufferRequest> Requests = { MakeRequest(), MakeRequest(0.f) };
+    TArray<FSVFBufferAllocation> Allocations;
+    SVF_CHECK_EQUAL(FSVFBufferBudgetSolver::Solve(Requests, 0, Allocations), 2 * MaxBytes);
+    SVF_CHECK_EQUAL(Allocations.Num(), 2);
+    for (const FSVFBufferAllocation& Allocation : Allocations)
+    {
+        SVF_CHECK_EQUAL(Allocation.Frames, 12u);
+        SVF_CHECK_EQUAL(Allocation.DownloadSeconds, 5);
+    }
+
+    // A budget that fits everything behaves the same
+    SVF_CHECK_EQUAL(FSVFBufferBudgetSolver::Solve(Requests, 10 * MaxBytes, Allocations), 2 * MaxBytes);
+}
+
+SVF_TEST(TightBudgetStaysWithinAndNearlyFilled)
+{
+    TArray<FSVFBufferRequest> Requests = { MakeRequest(), MakeRequest(), MakeRequest() };
+    const uint64 Budget = 3 * MinBytes + 9000;
+    TArray<FSVFBufferAllocation> Allocations;
+    const uint64 Used = FSVFBufferBudgetSolver::Solve(Requests, Budget, Allocations);
+    SVF_CHECK(Used <= Budget);
+    // Within one frame per reader of the budget
+    SVF_CHECK(Used + 3 * 1000 >= Budget);
+    // Equal requests are treated equally
+    SVF_CHECK(Allocations[0] == Allocations[1] && Allocations[1] == Allocations[2]);
+}
+
+SVF_TEST(MinimumsAlwaysGranted)
+{
+    TArray<FSVFBufferRequest> Requests = { MakeRequest(), MakeRequest() };
+    TArray<FSVFBufferAllocation> Allocations;
+    const uint64 Used = FSVFBufferBudgetSolver::Solve(Requests, 100, Allocations);
+    SVF_CHECK_EQUAL(Used, 2 * MinBytes);
+    SVF_CHECK_EQUAL(Allocations[0].Frames, 2u);
+    SVF_CHECK_EQUAL(Allocations[1].DownloadSeconds, 1);
+}
+
+SVF_TEST(PriorityBuysMoreHeadroom)
+{
+    TArray<FSVFBufferRequest> Requests = { MakeRequest(1.f), MakeRequest(3.f) };
+    TArray<FSVFBufferAllocation> Allocations;
+    FSVFBufferBudgetSolver::Solve(Requests, 2 * MinBytes + 8000, Allocations);
+    SVF_CHECK(Allocations[1].Frames > Allocations[0].Frames);
+    SVF_CHECK(Allocations[1].DownloadSeconds >= Allocations[0].DownloadSeconds);
+    SVF_CHECK(Allocations[1].Frames <= 12u);
+}
+
+SVF_TEST(UsageGrowsWithBudget)
+{
+    TArray<FSVFBufferRequest> Requests = { MakeRequest(0.5f), MakeRequest(1.f), MakeRequest(2.f) };
+    TArray<FSVFBufferAllocation> Allocations;
+    uint64 Previous = 0;
+    for (uint64 Budget = 3 * MinBytes; Budget <= 3 * MaxBytes; Budget += 700)
+    {
+        const uint64 Used = FSVFBufferBudgetSolver::Solve(Requests, Budget, Allocations);
+        SVF_CHECK(Used <= Budget);
+        SVF_CHECK(Used >= Previous);
+        Previous = Used;
+    }
+}
@@ -0,0 +1,208 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFFramePacing.h"
+
+namespace SVFFramePacingTest
+{
+    // Deterministic display jitter of up to +-Amplitude seconds
+    double Jitter(int32 Refresh, double Amplitude)
+    {
+        const uint32 Hash = static_cast<uint32>(Refresh) * 2654435761u;
+        return ((Hash >> 8) / static_cast<double>(1u << 24) * 2.0 - 1.0) * Amplitude;
+    }
+
+    // Plays ContentFps content on a RefreshHz display for NumRefreshes refreshes, calling SelectFrame
+    // every CallInterval refreshes, and returns how many refreshes each content frame stayed on screen
+    TArray<int32> RunTrace(double ContentFps, double RefreshHz, int32 NumRefreshes, double JitterSeconds, double Offset,
+        int32 CallInterval = 1, bool bUsePolicy = true)
+    {
+        FSVFCadencePolicy Policy;
+        Policy.SetFrameDuration(1.0 / ContentFps);
+
+        TArray<int32> Holds;
+        int64 Shown = INDEX_NONE;
+        for (int32 Refresh = 0; Refresh < NumRefreshes; Refresh += CallInterval)
+        {
+            const double Time = Offset + Refresh / RefreshHz + Jitter(Refresh, JitterSeconds);
+            const int64 Frame = bUsePolicy ? Policy.SelectFrame(Time, 1.0 / RefreshHz) : static_cast<int64>(FMath::FloorToDouble(Time * ContentFps));
+            if (Frame != Shown)
+            {
+                Holds.Add(0);
+                Shown = Frame;
+            }
+            Holds.Last() += CallInterval;
+        }
+        // The first and last frames are cut off by the trace
+        if (Holds.Num() >= 2)
+        {
+            Holds.RemoveAt(Holds.Num() - 1);
+            Holds.RemoveAt(0);
+        }
+        return Holds;
+    }
+
+    int32 CountHoldsOutside(const TArray<int32>& Holds, int32 Low, int32 High)
+    {
+        int32 Count = 0;
+        for (int32 Hold : Holds)
+        {
+            Count += (Hold < Low || Hold > High) ? 1 : 0;
+        }
+        return Count;
+    }
+}
+
+using namespace SVFFramePacingTest;
+
+SVF_TEST(PredictorLatencyIsPipelineSum)
+{
+    FSVFPresentationTimePredictor Predictor;
+    Predictor.SetExtraLatency(0.02);
+    for (int32 Frame = 0; Frame < 200; ++Frame)
+    {
+        Predictor.AddFrameTiming(1.0 / 60.0, 0.004, 0.008);
+    }
+    SVF_CHECK(Predictor.HasSamples());
+    SVF_CHECK_NEAR(Predictor.GetFrameInterval(), 1.0 / 60.0, 1e-9);
+    SVF_CHECK_NEAR(Predictor.GetPredictedLatency(), 1.0 / 60.0 + 0.004 + 0.008 + 0.02, 1e-9);
+}
+
+SVF_TEST(PredictorClampsHitches)
+{
+    FSVFPresentationTimePredictor Predictor;
+    for (int32 Frame = 0; Frame < 100; ++Frame)
+    {
+        Predictor.AddFrameTiming(1.0 / 60.0, 0.0, 0.0);
+    }
+    // A one second loading hitch counts as four intervals at most, weighted by the smoothing factor
+    Predictor.AddFrameTiming(1.0, 0.0, 0.0);
+    SVF_CHECK(Predictor.GetFrameInterval() <= (1.0 / 60.0) * (1.0 + 3.0 * 0.1) + 1e-9);
+
+    // Non positive deltas (paused, first frame) are ignored
+    const double Interval = Predictor.GetFrameInterval();
+    Predictor.AddFrameTiming(0.0, 1.0, 1.0);
+    SVF_CHECK_EQUAL(Predictor.GetFrameInterval(), Interval);
+
+    Predictor.Reset();
+    SVF_CHECK(!Predictor.HasSamples());
+}
+
+SVF_TEST(CadenceHoldsEvenly30On60)
+{
+    // Refreshes right at the content frame boundaries with +-2 ms of jitter: the plain floor flickers
+    // between 1 and 3 refresh holds, the policy keeps every frame for exactly two
+    const TArray<int32> Naive = RunTrace(30.0, 60.0, 600, 0.002, 1.0, 1, false);
+    const TArray<int32> Paced = RunTrace(30.0, 60.0, 600, 0.002, 1.0);
+    SVF_CHECK(CountHoldsOutside(Naive, 2, 2) > 0);
+    SVF_CHECK_EQUAL(CountHoldsOutside(Paced, 2, 2), 0);
+    SVF_CHECK(Paced.Num() >= 295);
+}
+
+SVF_TEST(CadencePulldown24On60)
+{
+    // 24 fps on 60 Hz alternates 2 and 3 refresh holds; jitter must never produce 1 or 4
+    const TArray<int32> Paced = RunTrace(24.0, 60.0, 1200, 0.002, 1.0);
+    SVF_CHECK_EQUAL(CountHoldsOutside(Paced, 2, 3), 0);
+    int32 Total = 0;
+    for (int32 Hold : Paced)
+    {
+        Total += Hold;
+    }
+    SVF_CHECK_NEAR(static_cast<double>(Total) / Paced.Num(), 2.5, 0.05);
+}
+
+SVF_TEST(CadenceCountsRefreshesNotCalls)
+{
+    // Selecting on every second refresh (UpdateFrameInterval 2) at 30 fps on 60 Hz: every call is a new
+    // content frame. Counting calls instead of refreshes would hold each frame back until the hysteresis
+    // forced it forward
+    const TArray<int32> Paced = RunTrace(30.0, 60.0, 600, 0.002, 1.0, 2);
+    SVF_CHECK_EQUAL(CountHoldsOutside(Paced, 2, 2), 0);
+
+    FSVFCadencePolicy Policy;
+    Policy.SetFrameDuration(1.0 / 30.0);
+    Policy.SelectFrame(0.05 / 30.0, 1.0 / 60.0);
+    for (int32 Call = 1; Call < 50; ++Call)
+    {
+        // Just past each boundary, inside the hysteresis window
+        const double Time = (Call + 0.05) / 30.0;
+        SVF_CHECK_EQUAL(Policy.SelectFrame(Time, 1.0 / 60.0), static_cast<int64>(Call));
+    }
+}
+
+SVF_TEST(CadenceResyncsAndNeverStepsBack)
+{
+    FSVFCadencePolicy Policy;
+    SVF_CHECK_EQUAL(Policy.SelectFrame(1.0, 1.0 / 60.0), static_cast<int64>(INDEX_NONE));
+
+    Policy.SetFrameDuration(1.0 / 30.0);
+    SVF_CHECK_EQUAL(Policy.SelectFrame(10.5 / 30.0, 1.0 / 60.0), static_cast<int64>(10));
+    // Jitter pulling the prediction back over the boundary doesn't step backwards
+    SVF_CHECK_EQUAL(Policy.SelectFrame(9.9 / 30.0, 1.0 / 60.0), static_cast<int64>(10));
+    // Seeks take the new frame immediately
+    SVF_CHECK_EQUAL(Policy.SelectFrame(40.5 / 30.0, 1.0 / 60.0), static_cast<int64>(40));
+    SVF_CHECK_EQUAL(Policy.SelectFrame(3.5 / 30.0, 1.0 / 60.0), static_cast<int64>(3));
+    SVF_CHECK_NEAR(Policy.GetSelectedFrameTime(), 3.5 / 30.0, 1e-12);
+
+    Policy.Reset();
+    SVF_CHECK_EQUAL(Policy.GetSelectedFrame(), static_cast<int64>(INDEX_NONE));
+}
+
+SVF_TEST(PresentationClockAdvancesWithRealTime)
+{
+    FSVFPresentationClock Clock;
+    double Time = -1.0;
+    SVF_CHECK(!Clock.Get(0.0, Time));
+
+    Clock.Set(2.0, 100.0, 1.0);
+    SVF_CHECK(Clock.Get(100.0, Time));
+    SVF_CHECK_NEAR(Time, 2.0, 1e-12);
+    // Keeps advancing between the updates that anchor it instead of freezing
+    SVF_CHECK(Clock.Get(100.25, Time));
+    SVF_CHECK_NEAR(Time, 2.25, 1e-12);
+
+    Clock.Set(2.0, 100.0, 0.5);
+    SVF_CHECK(Clock.Get(101.0, Time));
+    SVF_CHECK_NEAR(Time, 2.5, 1e-12);
+
+    // Reverse playback stops at the start of the clip
+    Clock.Set(0.1, 100.0, -1.0);
+    SVF_CHECK(Clock.Get(101.0, Time));
+    SVF_CHECK_EQUAL(Time, 0.0);
+
+    Clock.Invalidate();
+    SVF_CHECK(!Clock.Get(101.0, Time));
+}
+
+SVF_TEST(PresentationClockIsConsistentAcrossThreads)
+{
+    // The writer always anchors content time N at real time N, so any read that mixes two updates
+    // shows up as a content time different from the query time
+    FSVFPresentationClock Clock;
+    Clock.Set(0.0, 0.0, 1.0);
+    std::atomic<bool> bDone(false);
+    std::thread Writer([&Clock, &bDone]()
+    {
+        for (int32 Update = 1; Update <= 200000; ++Update)
+        {
+            Clock.Set(Update, Update, 1.0 + (Update & 1));
+        }
+        bDone = true;
+    });
+
+    const double Query = 1000000.0;
+    int32 Torn = 0;
+    while (!bDone)
+    {
+        double Time = 0.0;
+        Clock.Get(Query, Time);
+        // Rate 1 anchors give exactly Query, rate 2 anchors (odd N) give 2 * Query - N; a torn read mixes
+        // a rate or base with the wrong anchor
+        const double Anchor = 2.0 * Query - Time;
+        const bool bConsistent = Time == Query || (Anchor == FMath::FloorToDouble(Anchor) && static_cast<int64>(Anchor) % 2 == 1);
+        Torn += bConsistent ? 0 : 1;
+    }
+    Writer.join();
+    SVF_CHECK_EQUAL(Torn, 0);
+}
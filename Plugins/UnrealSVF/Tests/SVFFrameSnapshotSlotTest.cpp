@@ -0,0 +1,198 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFFrameSnapshotSlot.h"
+#include "DynamicMeshBuilder.h"
+
+namespace SVFFrameSnapshotSlotTest
+{
+    // Every position of a published snapshot carries its frame id, so a reader can tell a snapshot that
+    // was refilled under it from one that is intact
+    void FillFrame(FSVFFrameSnapshot& Snapshot, int32 FrameId, int32 NumVertices)
+    {
+        Snapshot.FrameId = FrameId;
+        Snapshot.Positions.Init(FVector(static_cast<float>(FrameId)), NumVertices);
+        Snapshot.Indices.Init(FrameId, 3);
+    }
+
+    bool IsIntact(const FSVFFrameSnapshot& Snapshot)
+    {
+        for (const FVector& Position : Snapshot.GetPositions())
+        {
+            if (Position.X != static_cast<float>(Snapshot.FrameId) || Position.Z != static_cast<float>(Snapshot.FrameId))
+            {
+                return false;
+            }
+        }
+        return Snapshot.Indices.Num() == 3 && Snapshot.Indices[0] == Snapshot.FrameId;
+    }
+}
+
+using namespace SVFFrameSnapshotSlotTest;
+
+SVF_TEST(PublishDropsStaleSequences)
+{
+    FSVFFrameSnapshotSlot Slot;
+    SVF_CHECK(!Slot.Get().IsValid());
+
+    FSVFFrameSnapshotSlot::FWritablePtr Snapshot = Slot.Allocate();
+    FillFrame(*Snapshot, 5, 4);
+    SVF_CHECK(Slot.Publish(MoveTemp(Snapshot), 2));
+    SVF_CHECK_EQUAL(Slot.Get()->FrameId, 5);
+
+    // A staging worker that finished late must not replace a newer frame, nor may a repeat of the same one
+    Snapshot = Slot.Allocate();
+    FillFrame(*Snapshot, 4, 4);
+    SVF_CHECK(!Slot.Publish(MoveTemp(Snapshot), 1));
+    Snapshot = Slot.Allocate();
+    FillFrame(*Snapshot, 4, 4);
+    SVF_CHECK(!Slot.Publish(MoveTemp(Snapshot), 2));
+    SVF_CHECK_EQUAL(Slot.Get()->FrameId, 5);
+    SVF_CHECK(!Slot.Publish(FSVFFrameSnapshotSlot::FWritablePtr(), 9));
+
+    // Reset starts the sequence over for the next clip
+    Slot.Reset();
+    SVF_CHECK(!Slot.Get().IsValid());
+    Snapshot = Slot.Allocate();
+    FillFrame(*Snapshot, 0, 4);
+    SVF_CHECK(Slot.Publish(MoveTemp(Snapshot), 1));
+}
+
+SVF_TEST(RetiredSnapshotsAreReusedOnlyOnceUnread)
+{
+    FSVFFrameSnapshotSlot Slot;
+    FSVFFrameSnapshotSlot::FWritablePtr First = Slot.Allocate();
+    const FSVFFrameSnapshot* FirstAddress = First.Get();
+    FillFrame(*First, 1, 8);
+    Slot.Publish(MoveTemp(First), 1);
+
+    // A reader still holds frame 1 after frame 2 replaced it
+    FSVFFrameSnapshotPtr Held = Slot.Get();
+    FSVFFrameSnapshotSlot::FWritablePtr Second = Slot.Allocate();
+    SVF_CHECK(Second.Get() != FirstAddress);
+    FillFrame(*Second, 2, 8);
+    Slot.Publish(MoveTemp(Second), 2);
+    FSVFFrameSnapshotSlot::FWritablePtr Third = Slot.Allocate();
+    SVF_CHECK(Third.Get() != FirstAddress);
+    SVF_CHECK(IsIntact(*Held));
+    SVF_CHECK_EQUAL(Held->FrameId, 1);
+
+    // Once the reader lets go, the retired snapshot is handed out again with its allocations
+    Held.Reset();
+    FSVFFrameSnapshotSlot::FWritablePtr Reused = Slot.Allocate();
+    SVF_CHECK(Reused.Get() == FirstAddress);
+    SVF_CHECK(Reused->Positions.Max() >= 8);
+}
+
+SVF_TEST(FillFromVertexStreams)
+{
+    const FVector Positions[] = { FVector(1.f, 2.f, 3.f), FVector(4.f, 5.f, 6.f) };
+    // TangentX and TangentZ interleaved
+    const FPackedNormal Tangents[] = { FPackedNormal(FVector(1.f, 0.f, 0.f)), FPackedNormal(FVector(0.f, 0.f, 1.f)),
+        FPackedNormal(FVector(1.f, 0.f, 0.f)), FPackedNormal(FVector(0.f, -1.f, 0.f)) };
+    // Two texture coordinate channels per vertex, only the first is kept
+    const FVector2D TexCoords[] = { FVector2D(0.25f, 0.5f), FVector2D(9.f, 9.f), FVector2D(0.75f, 1.f), FVector2D(9.f, 9.f) };
+    const int32 Indices[] = { 0, 1, 0 };
+
+    FSVFFrameSnapshot Snapshot;
+    FSVFFrameSnapshotSlot::Fill(Snapshot, 7, MakeArrayView(Positions, 2), MakeArrayView(Tangents, 4), TexCoords, 2, MakeArrayView(Indices, 3));
+    SVF_CHECK_EQUAL(Snapshot.FrameId, 7);
+    SVF_CHECK(Snapshot.HasNormals());
+    SVF_CHECK(Snapshot.Positions[1] == Positions[1]);
+    SVF_CHECK(Snapshot.Normals[1] == FVector(0.f, -1.f, 0.f));
+    SVF_CHECK(Snapshot.TexCoords[1] == FVector2D(0.75f, 1.f));
+    SVF_CHECK_EQUAL(Snapshot.GetNumTriangles(), 1);
+
+    // Without tangents or texture coordinates the snapshot has no normals and zero coordinates
+    FSVFFrameSnapshotSlot::Fill(Snapshot, 8, MakeArrayView(Positions, 2), TArrayView<const FPackedNormal>(), nullptr, 0, MakeArrayView(Indices, 3));
+    SVF_CHECK(!Snapshot.HasNormals());
+    SVF_CHECK(Snapshot.TexCoords[0] == FVector2D::ZeroVector);
+
+    // The Android path packs the same data into dynamic mesh vertices
+    FDynamicMeshVertex Vertices[2];
+    for (int32 Vertex = 0; Vertex < 2; ++Vertex)
+    {
+        Vertices[Vertex].Position = Positions[Vertex];
+        Vertices[Vertex].TextureCoordinate[0] = TexCoords[Vertex * 2];
+        Vertices[Vertex].TangentZ = Tangents[Vertex * 2 + 1];
+    }
+    FSVFFrameSnapshot FromVertices;
+    FSVFFrameSnapshotSlot::Fill(FromVertices, 7, MakeArrayView(Vertices, 2), MakeArrayView(Indices, 3), true);
+    for (int32 Vertex = 0; Vertex < 2; ++Vertex)
+    {
+        FSVFFrameSnapshotSlot::Fill(Snapshot, 7, MakeArrayView(Positions, 2), MakeArrayView(Tangents, 4), TexCoords, 2, MakeArrayView(Indices, 3));
+        SVF_CHECK(FromVertices.Positions[Vertex] == Snapshot.Positions[Vertex]);
+        SVF_CHECK(FromVertices.Normals[Vertex] == Snapshot.Normals[Vertex]);
+        SVF_CHECK(FromVertices.TexCoords[Vertex] == Snapshot.TexCoords[Vertex]);
+    }
+}
+
+SVF_TEST(ReadersNeverSeeASnapshotChange)
+{
+    // Two publishers race like the staging worker and the render thread do; readers hold on to each
+    // snapshot for a while and check it is still intact when they let go
+    FSVFFrameSnapshotSlot Slot;
+    // Publishing runs until the readers got through this many snapshots, however the threads are scheduled
+    const int32 NumReads = 20000;
+    const int32 NumVertices = 64;
+    std::atomic<int32> NextFrame(1);
+    std::atomic<int32> NumPublishers(2);
+    std::atomic<int32> Torn(0);
+    std::atomic<int32> SteppedBack(0);
+    std::atomic<int32> Reads(0);
+    std::atomic<int32> NumReadersStarted(0);
+
+    auto Publish = [&]()
+    {
+        // Start once every reader is running so the publishes actually overlap the reads
+        while (NumReadersStarted < 3)
+        {
+            std::this_thread::yield();
+        }
+        while (Reads < NumReads)
+        {
+            const int32 Frame = NextFrame++;
+            FSVFFrameSnapshotSlot::FWritablePtr Snapshot = Slot.Allocate();
+            FillFrame(*Snapshot, Frame, NumVertices);
+            Slot.Publish(MoveTemp(Snapshot), static_cast<uint32>(Frame));
+            std::this_thread::yield();
+        }
+        --NumPublishers;
+    };
+    auto Read = [&]()
+    {
+        int32 LastFrame = 0;
+        ++NumReadersStarted;
+        while (NumPublishers > 0)
+        {
+            const FSVFFrameSnapshotPtr Snapshot = Slot.Get();
+            if (!Snapshot.IsValid())
+            {
+                continue;
+            }
+            // A refill would rewrite the frame id along with the positions, so remember the one first seen
+            const int32 FrameId = Snapshot->FrameId;
+            const bool bIntactBefore = IsIntact(*Snapshot);
+            // Long enough for the snapshot to be retired and come up for reuse
+            for (int32 Yield = 0; Yield < 8; ++Yield)
+            {
+                std::this_thread::yield();
+            }
+            Torn += (bIntactBefore && IsIntact(*Snapshot) && Snapshot->FrameId == FrameId) ? 0 : 1;
+            SteppedBack += FrameId < LastFrame ? 1 : 0;
+            LastFrame = FrameId;
+            ++Reads;
+        }
+    };
+
+    std::thread Threads[] = { std::thread(Publish), std::thread(Publish), std::thread(Read), std::thread(Read), std::thread(Read) };
+    for (std::thread& Thread : Threads)
+    {
+        Thread.join();
+    }
+    SVF_CHECK_EQUAL(Torn.load(), 0);
+    // Publishes of older sequences are dropped, so each reader only ever moves forward
+    SVF_CHECK_EQUAL(SteppedBack.load(), 0);
+    SVF_CHECK(IsIntact(*Slot.Get()));
+    SVF_CHECK(Slot.Get()->FrameId > 1);
+}
@@ -0,0 +1,83 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFFrameWindow.h"
+
+SVF_TEST(EmptyWindowHasNoSlot)
+{
+    FSVFFrameWindow Window;
+    Window.Configure(4);
+    SVF_CHECK_EQUAL(Window.FindSlot(0), INDEX_NONE);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(0), INDEX_NONE);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(7), INDEX_NONE);
+}
+
+SVF_TEST(OffsetsCountBackFromNewest)
+{
+    FSVFFrameWindow Window;
+    Window.Configure(4);
+    for (int32 Frame = 0; Frame < 10; ++Frame)
+    {
+        Window.Push(Frame);
+    }
+    SVF_CHECK_EQUAL(Window.GetNumFrames(), 4);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Window.FindSlot(0)), 9);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Window.FindSlot(2)), 7);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Window.FindSlot(3)), 6);
+    // Further back than the window holds gets the oldest frame, negative offsets the newest
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Window.FindSlot(50)), 6);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Window.FindSlot(-3)), 9);
+}
+
+SVF_TEST(DroppedFramesLeaveGaps)
+{
+    FSVFFrameWindow Window;
+    Window.Configure(8);
+    Window.Push(0);
+    Window.Push(1);
+    Window.Push(4);
+    Window.Push(5);
+    // Three frames back from 5 is frame 2, which was dropped: the closest frame before it is 1
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Window.FindSlot(3)), 1);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Window.FindSlot(1)), 4);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Window.FindSlot(2)), 1);
+}
+
+SVF_TEST(LoopsContinueAfterNewest)
+{
+    FSVFFrameWindow Window;
+    Window.Configure(8);
+    Window.Push(28);
+    Window.Push(29);
+    Window.Push(0);
+    Window.Push(1);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Window.FindSlot(0)), 1);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Window.FindSlot(2)), 29);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Window.FindSlot(3)), 28);
+}
+
+SVF_TEST(InstancesGetTheirOwnSlots)
+{
+    FSVFFrameWindow Window;
+    Window.Configure(3);
+    int32 Written[3];
+    for (int32 Frame = 0; Frame < 3; ++Frame)
+    {
+        Written[Frame] = Window.Push(Frame);
+    }
+    // Every slot is written once before the oldest is overwritten
+    SVF_CHECK(Written[0] != Written[1] && Written[1] != Written[2] && Written[0] != Written[2]);
+    SVF_CHECK_EQUAL(Window.Push(3), Written[0]);
+
+    TArray<int32> Slots;
+    Window.AssignInstances({ 0, 1, 2, 9 }, Slots);
+    SVF_CHECK_EQUAL(Slots.Num(), 4);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Slots[0]), 3);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Slots[1]), 2);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Slots[2]), 1);
+    SVF_CHECK_EQUAL(Window.GetSlotFrame(Slots[3]), 1);
+
+    Window.Reset();
+    SVF_CHECK_EQUAL(Window.GetNumFrames(), 0);
+    SVF_CHECK_EQUAL(Window.FindSlot(0), INDEX_NONE);
+}
@@ -0,0 +1,114 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFHalfPosition.h"
+
+namespace SVFHalfPositionTest
+{
+    float Decode(uint16 Encoded)
+    {
+        FFloat16 Half;
+        Half.Encoded = Encoded;
+        return Half.GetFloat();
+    }
+
+    // No other half of the same sign lies closer, and ties keep an even mantissa
+    bool IsNearest(float Value, uint16 Encoded)
+    {
+        const double Error = FMath::Abs(static_cast<double>(Value) - Decode(Encoded));
+        const uint16 Magnitude = Encoded & 0x7fff;
+        const uint16 Sign = Encoded & 0x8000;
+        for (const int32 Neighbour : { Magnitude - 1, Magnitude + 1 })
+        {
+            if (Neighbour < 0 || Neighbour >= 0x7c00)
+            {
+                continue;
+            }
+            const double NeighbourError = FMath::Abs(static_cast<double>(Value) - Decode(static_cast<uint16>(Neighbour | Sign)));
+            if (NeighbourError < Error || (NeighbourError == Error && (Encoded & 1) != 0))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Positions across a performer, clip units from the origin
+    float PositionAt(uint32& Seed)
+    {
+        Seed = Seed * 1664525u + 1013904223u;
+        return ((Seed >> 8) / static_cast<float>(1u << 24) * 2.f - 1.f) * 2000.f;
+    }
+}
+
+using namespace SVFHalfPositionTest;
+
+SVF_TEST(LayoutMatchesHalf4Stream)
+{
+    SVF_CHECK_EQUAL(sizeof(FSVFHalfPosition), 4 * sizeof(uint16));
+    const FSVFHalfPosition Position(FVector(1.f, -2.f, 0.5f));
+    SVF_CHECK(Position.ToFVector() == FVector(1.f, -2.f, 0.5f));
+    SVF_CHECK_EQUAL(Position.W.GetFloat(), 1.f);
+}
+
+SVF_TEST(RepresentableValuesAreExact)
+{
+    // Every finite half comes back unchanged, in every component
+    int32 Mismatches = 0;
+    for (uint32 Encoded = 0; Encoded < 0x10000; ++Encoded)
+    {
+        if ((Encoded & 0x7c00) == 0x7c00)
+        {
+            continue;
+        }
+        const float Value = Decode(static_cast<uint16>(Encoded));
+        const FSVFHalfPosition Position(FVector(Value, -Value, Value));
+        Mismatches += Position.X.Encoded == Encoded && Position.Z.Encoded == Encoded ? 0 : 1;
+        Mismatches += Position.Y.GetFloat() == -Value ? 0 : 1;
+    }
+    SVF_CHECK_EQUAL(Mismatches, 0);
+}
+
+SVF_TEST(RoundsToNearest)
+{
+    uint32 Seed = 11;
+    int32 NotNearest = 0;
+    double WorstRelativeError = 0.0;
+    double WorstTruncatedError = 0.0;
+    for (int32 Sample = 0; Sample < 300000; ++Sample)
+    {
+        const FVector Value(PositionAt(Seed), PositionAt(Seed), PositionAt(Seed));
+        const FSVFHalfPosition Position(Value);
+        NotNearest += IsNearest(Value.X, Position.X.Encoded) && IsNearest(Value.Y, Position.Y.Encoded) &&
+            IsNearest(Value.Z, Position.Z.Encoded) ? 0 : 1;
+
+        const FVector Error = Position.ToFVector() - Value;
+        const FVector Truncated(FFloat16(Value.X).GetFloat(), FFloat16(Value.Y).GetFloat(), FFloat16(Value.Z).GetFloat());
+        const FVector TruncatedError = Truncated - Value;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            if (FMath::Abs(Value[Axis]) >= 1.f)
+            {
+                WorstRelativeError = FMath::Max(WorstRelativeError, static_cast<double>(FMath::Abs(Error[Axis] / Value[Axis])));
+                WorstTruncatedError = FMath::Max(WorstTruncatedError, static_cast<double>(FMath::Abs(TruncatedError[Axis] / Value[Axis])));
+            }
+        }
+    }
+    SVF_CHECK_EQUAL(NotNearest, 0);
+    // Half an ulp at most, where FFloat16's truncation gives up to a whole one
+    SVF_CHECK(WorstRelativeError <= 1.0 / 2048.0);
+    SVF_CHECK(WorstTruncatedError > 1.0 / 1024.0 * 0.99);
+
+    // Millimetre precision around a performer a metre out, in centimetres
+    const float Far = 149.96f;
+    SVF_CHECK_NEAR(FSVFHalfPosition(FVector(Far)).ToFVector().X, Far, 0.0625f);
+}
+
+SVF_TEST(TiesRoundToEven)
+{
+    // Halfway between 1 + 2^-10 and 1 + 2^-9 rounds up to the even mantissa, halfway below it rounds down
+    const FSVFHalfPosition Position(FVector(1.f + 3.f / 2048.f, 1.f + 1.f / 2048.f, -(1.f + 3.f / 2048.f)));
+    SVF_CHECK_EQUAL(Position.X.GetFloat(), 1.f + 2.f / 1024.f);
+    SVF_CHECK_EQUAL(Position.Y.GetFloat(), 1.f);
+    SVF_CHECK_EQUAL(Position.Z.GetFloat(), -(1.f + 2.f / 1024.f));
+}
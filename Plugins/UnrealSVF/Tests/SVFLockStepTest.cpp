@@ -0,0 +1,210 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFLockStep.h"
+
+namespace SVFLockStepTest
+{
+    // Reader stand-in: delivers NumFrames frames in order, each after DecodePolls unsuccessful polls,
+    // then reports the end of the stream until restarted
+    struct FSyntheticReader
+    {
+        int32 NumFrames = 0;
+        int32 DecodePolls = 0;
+        int32 NextFrame = 0;
+        int32 PollsLeft = 0;
+        int32 Restarts = 0;
+        bool bStall = false;
+
+        bool Fetch(int32& OutFrameIndex, bool& bOutEndOfStream)
+        {
+            if (NextFrame >= NumFrames)
+            {
+                bOutEndOfStream = true;
+                return false;
+            }
+            if (bStall || PollsLeft-- > 0)
+            {
+                return false;
+            }
+            PollsLeft = DecodePolls;
+            OutFrameIndex = NextFrame++;
+            return true;
+        }
+
+        bool Restart()
+        {
+            NextFrame = 0;
+            PollsLeft = DecodePolls;
+            ++Restarts;
+            return true;
+        }
+    };
+
+    struct FFakeTime
+    {
+        double Seconds = 0.0;
+        int32 Sleeps = 0;
+    };
+
+    void UseFakeTime(FSVFLockStepController& Controller, FFakeTime& Time)
+    {
+        Controller.SetTimeSource([&Time]() { return Time.Seconds; }, [&Time](float Seconds) { Time.Seconds += Seconds; ++Time.Sleeps; });
+    }
+
+    // Frames on screen after each of NumSteps output steps
+    TArray<int32> Play(FSyntheticReader& Reader, double ContentFps, double OutputFps, int32 NumSteps, bool bLoop,
+        TArray<ESVFLockStepResult>* OutResults = nullptr)
+    {
+        FFakeTime Time;
+        FSVFLockStepController Controller;
+        UseFakeTime(Controller, Time);
+        Controller.SetFrameDuration(1.0 / ContentFps);
+
+        auto Fetch = [&Reader](int32& OutFrameIndex, bool& bOutEndOfStream) { return Reader.Fetch(OutFrameIndex, bOutEndOfStream); };
+        auto Restart = [&Reader]() { return Reader.Restart(); };
+
+        TArray<int32> Shown;
+        for (int32 Step = 0; Step < NumSteps; ++Step)
+        {
+            Controller.Advance(1.0 / OutputFps);
+            const ESVFLockStepResult Result = bLoop ? Controller.WaitForTargetFrame(Fetch, Restart) : Controller.WaitForTargetFrame(Fetch);
+            Shown.Add(Controller.GetCurrentFrame());
+            if (OutResults)
+            {
+                OutResults->Add(Result);
+            }
+        }
+        return Shown;
+    }
+}
+
+using namespace SVFLockStepTest;
+
+SVF_TEST(EveryStepShowsItsContentFrame)
+{
+    FSyntheticReader Reader;
+    Reader.NumFrames = 1000;
+    const TArray<int32> Shown = Play(Reader, 30.0, 60.0, 600, false);
+    for (int32 Step = 0; Step < Shown.Num(); ++Step)
+    {
+        SVF_CHECK_EQUAL(Shown[Step], Step / 2);
+    }
+
+    // Output slower than the content passes frames over, but still lands on exactly floor(t * fps)
+    FSyntheticReader SlowOutput;
+    SlowOutput.NumFrames = 1000;
+    const TArray<int32> Skipped = Play(SlowOutput, 30.0, 24.0, 480, false);
+    for (int32 Step = 0; Step < Skipped.Num(); ++Step)
+    {
+        SVF_CHECK_EQUAL(Skipped[Step], Step * 30 / 24);
+    }
+}
+
+SVF_TEST(DecodeSpeedDoesNotChangeOutput)
+{
+    FSyntheticReader Fast;
+    Fast.NumFrames = 300;
+    FSyntheticReader Slow;
+    Slow.NumFrames = 300;
+    Slow.DecodePolls = 20;
+    const TArray<int32> FromFast = Play(Fast, 30.0, 50.0, 400, true);
+    const TArray<int32> FromSlow = Play(Slow, 30.0, 50.0, 400, true);
+    SVF_CHECK(FromFast == FromSlow);
+}
+
+SVF_TEST(LoopSeamDoesNotRepeatLastFrame)
+{
+    // Output at the content rate: 0..9, 0..9, ... with the seam inside the step that hit the end
+    FSyntheticReader Reader;
+    Reader.NumFrames = 10;
+    TArray<ESVFLockStepResult> Results;
+    const TArray<int32> Shown = Play(Reader, 30.0, 30.0, 35, true, &Results);
+    for (int32 Step = 0; Step < Shown.Num(); ++Step)
+    {
+        SVF_CHECK_EQUAL(Shown[Step], Step % 10);
+        SVF_CHECK(Results[Step] == ESVFLockStepResult::NewFrame);
+    }
+    SVF_CHECK_EQUAL(Reader.Restarts, 3);
+
+    // Output at twice the content rate holds every frame for exactly two steps, across the seams too
+    FSyntheticReader Doubled;
+    Doubled.NumFrames = 10;
+    const TArray<int32> Held = Play(Doubled, 30.0, 60.0, 70, true);
+    for (int32 Step = 0; Step < Held.Num(); ++Step)
+    {
+        SVF_CHECK_EQUAL(Held[Step], (Step / 2) % 10);
+    }
+}
+
+SVF_TEST(StreamEndWithoutLooping)
+{
+    FSyntheticReader Reader;
+    Reader.NumFrames = 10;
+    TArray<ESVFLockStepResult> Results;
+    const TArray<int32> Shown = Play(Reader, 30.0, 30.0, 15, false, &Results);
+    SVF_CHECK_EQUAL(Shown[9], 9);
+    SVF_CHECK(Results[9] == ESVFLockStepResult::NewFrame);
+    for (int32 Step = 10; Step < Shown.Num(); ++Step)
+    {
+        SVF_CHECK_EQUAL(Shown[Step], 9);
+        SVF_CHECK(Results[Step] == ESVFLockStepResult::EndOfStream);
+    }
+    SVF_CHECK_EQUAL(Reader.Restarts, 0);
+}
+
+SVF_TEST(EmptyStreamDoesNotLoopForever)
+{
+    FSyntheticReader Reader;
+    TArray<ESVFLockStepResult> Results;
+    Play(Reader, 30.0, 30.0, 3, true, &Results);
+    for (ESVFLockStepResult Result : Results)
+    {
+        SVF_CHECK(Result == ESVFLockStepResult::EndOfStream);
+    }
+    SVF_CHECK_EQUAL(Reader.Restarts, 0);
+}
+
+SVF_TEST(StalledDecodeTimesOut)
+{
+    FFakeTime Time;
+    FSVFLockStepController Controller;
+    // Same default as the component's Lock Step Timeout
+    SVF_CHECK_EQUAL(Controller.GetTimeout(), static_cast<double>(FSVFLockStepController::DefaultTimeoutSeconds));
+    UseFakeTime(Controller, Time);
+    Controller.SetFrameDuration(1.0 / 30.0);
+    Controller.SetTimeout(0.5);
+    SVF_CHECK_EQUAL(Controller.GetTimeout(), 0.5);
+
+    FSyntheticReader Reader;
+    Reader.NumFrames = 100;
+    Reader.bStall = true;
+    auto Fetch = [&Reader](int32& OutFrameIndex, bool& bOutEndOfStream) { return Reader.Fetch(OutFrameIndex, bOutEndOfStream); };
+
+    Controller.Advance(1.0 / 30.0);
+    SVF_CHECK(Controller.WaitForTargetFrame(Fetch) == ESVFLockStepResult::TimedOut);
+    SVF_CHECK(Time.Seconds >= 0.5 && Time.Seconds < 0.51);
+    SVF_CHECK(Time.Sleeps > 0);
+    SVF_CHECK_EQUAL(Controller.GetCurrentFrame(), INDEX_NONE);
+
+    // Once decode catches up the same step completes
+    Reader.bStall = false;
+    SVF_CHECK(Controller.WaitForTargetFrame(Fetch) == ESVFLockStepResult::NewFrame);
+    SVF_CHECK_EQUAL(Controller.GetCurrentFrame(), 0);
+    SVF_CHECK(Controller.WaitForTargetFrame(Fetch) == ESVFLockStepResult::CurrentFrame);
+}
+
+SVF_TEST(ResetRestartsAtGivenTime)
+{
+    FSVFLockStepController Controller;
+    Controller.SetFrameDuration(0.1);
+    Controller.Reset(0.35);
+    // The first step shows the reset time itself, later ones advance
+    Controller.Advance(0.1);
+    SVF_CHECK_EQUAL(Controller.GetTargetFrame(), 3);
+    Controller.Advance(0.1);
+    SVF_CHECK_EQUAL(Controller.GetTargetFrame(), 4);
+    // Accumulated step error right below a boundary still lands on the next frame
+    Controller.Reset(0.3 - 1e-9);
+    SVF_CHECK_EQUAL(Controller.GetTargetFrame(), 3);
+}
@@ -0,0 +1,117 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFLoopSeam.h"
+
+namespace SVFLoopSeamTest
+{
+    const int64 TicksPerSecond = 10000000;
+    const int32 FrameCount = 30;
+    const int64 LoopDuration = TicksPerSecond;
+    const int64 FrameDuration = LoopDuration / FrameCount;
+    const int64 LeadTime = TicksPerSecond / 2;
+
+    struct FSeamTrace
+    {
+        int64 PrepareTime = -1;
+        int64 SwitchTime = -1;
+        int64 RestartTime = -1;
+        int32 Prepares = 0;
+    };
+
+    // Presents one loop at 60 Hz; the standby is ready ReadyAfter ticks after it was requested,
+    // never if negative, or fails instead when bFail is set
+    FSeamTrace Run(int64 ReadyAfter, bool bFail = false)
+    {
+        FSVFLoopSeamScheduler Seam;
+        Seam.Configure(FrameCount, LoopDuration, LeadTime);
+
+        FSeamTrace Trace;
+        ESVFLoopStandbyState Standby = ESVFLoopStandbyState::None;
+        for (int64 Time = 0; Time < 3 * LoopDuration; Time += TicksPerSecond / 60)
+        {
+            if (Standby == ESVFLoopStandbyState::Preparing && ReadyAfter >= 0 && Time >= Trace.PrepareTime + ReadyAfter)
+            {
+                Standby = bFail ? ESVFLoopStandbyState::Failed : ESVFLoopStandbyState::Ready;
+            }
+
+            switch (Seam.Update(Time, Standby))
+            {
+            case ESVFLoopSeamAction::PrepareStandby:
+                Trace.PrepareTime = Time;
+                ++Trace.Prepares;
+                Standby = ESVFLoopStandbyState::Preparing;
+                break;
+            case ESVFLoopSeamAction::SwitchToStandby:
+                Trace.SwitchTime = Time;
+                return Trace;
+            case ESVFLoopSeamAction::RestartSource:
+                Trace.RestartTime = Time;
+                return Trace;
+            default:
+                break;
+            }
+
+            // The reader hands out the frame due at this time, the last one stays up past the end
+            const int64 Frame = FMath::Min<int64>(Time / FrameDuration, FrameCount - 1);
+            Seam.OnFramePresented(Frame * FrameDuration, Frame == FrameCount - 1 && Time >= LoopDuration);
+        }
+        return Trace;
+    }
+}
+
+using namespace SVFLoopSeamTest;
+
+SVF_TEST(StandbyRequestedOnceAtLeadTime)
+{
+    const FSeamTrace Trace = Run(TicksPerSecond / 10);
+    SVF_CHECK_EQUAL(Trace.Prepares, 1);
+    SVF_CHECK(Trace.PrepareTime >= LoopDuration - LeadTime);
+    SVF_CHECK(Trace.PrepareTime < LoopDuration - LeadTime + TicksPerSecond / 60);
+}
+
+SVF_TEST(SwitchesExactlyAtLoopEnd)
+{
+    // The last frame stays up for its full duration, then the standby takes over on the first update
+    // at or after the loop end. 30 frames don't divide a second of ticks evenly, so the last frame's
+    // timestamp ends just short of the loop duration
+    const FSeamTrace Trace = Run(TicksPerSecond / 10);
+    SVF_CHECK(Trace.SwitchTime >= LoopDuration);
+    SVF_CHECK(Trace.SwitchTime < LoopDuration + TicksPerSecond / 60);
+    SVF_CHECK_EQUAL(Trace.RestartTime, -1);
+}
+
+SVF_TEST(LateStandbyStillPreferredOverRestart)
+{
+    // Ready a little after the loop end: still switches rather than re-prerolling
+    const FSeamTrace Late = Run(LeadTime + TicksPerSecond / 5);
+    SVF_CHECK(Late.SwitchTime > LoopDuration);
+    SVF_CHECK_EQUAL(Late.RestartTime, -1);
+
+    // Never ready: gives up one lead time after the end
+    const FSeamTrace Never = Run(-1);
+    SVF_CHECK_EQUAL(Never.SwitchTime, -1);
+    SVF_CHECK(Never.RestartTime >= LoopDuration + LeadTime);
+    SVF_CHECK(Never.RestartTime < LoopDuration + LeadTime + TicksPerSecond / 60);
+}
+
+SVF_TEST(FailedStandbyRestartsAtTail)
+{
+    const FSeamTrace Trace = Run(0, true);
+    SVF_CHECK_EQUAL(Trace.SwitchTime, -1);
+    SVF_CHECK(Trace.RestartTime >= (FrameCount - 1) * FrameDuration);
+    SVF_CHECK(Trace.RestartTime <= LoopDuration);
+}
+
+SVF_TEST(UnknownLengthRestartsOnEndOfStream)
+{
+    FSVFLoopSeamScheduler Seam;
+    Seam.Configure(0, 0, LeadTime);
+    SVF_CHECK(Seam.Update(0, ESVFLoopStandbyState::None) == ESVFLoopSeamAction::None);
+    Seam.OnFramePresented(5 * TicksPerSecond, false);
+    SVF_CHECK(!Seam.IsTailReached());
+    Seam.OnFramePresented(5 * TicksPerSecond, true);
+    SVF_CHECK(Seam.IsTailReached());
+    SVF_CHECK(Seam.Update(0, ESVFLoopStandbyState::None) == ESVFLoopSeamAction::RestartSource);
+    SVF_CHECK(!Seam.IsTailReached());
+}
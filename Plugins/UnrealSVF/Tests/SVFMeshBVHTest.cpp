@@ -0,0 +1,304 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFTestMeshes.h"
+#include "SVFMeshBVH.h"
+
+using namespace SVFTestMeshes;
+
+namespace SVFMeshBVHTest
+{
+    // Closest hit time over every triangle, either winding, 2 if the segment misses
+    float BruteForceRaycast(const FTestMesh& Mesh, const FVector& Start, const FVector& End)
+    {
+        const FVector Dir = End - Start;
+        float Best = 2.f;
+        for (int32 Index = 0; Index + 2 < Mesh.Indices.Num(); Index += 3)
+        {
+            const FVector& A = Mesh.Positions[Mesh.Indices[Index + 0]];
+            const FVector Edge1 = Mesh.Positions[Mesh.Indices[Index + 1]] - A;
+            const FVector Edge2 = Mesh.Positions[Mesh.Indices[Index + 2]] - A;
+            const FVector Normal = Edge1 ^ Edge2;
+            const float Denom = Normal | Dir;
+            if (FMath::Abs(Denom) < SMALL_NUMBER)
+            {
+                continue;
+            }
+            const float Time = (Normal | (A - Start)) / Denom;
+            if (Time < 0.f || Time > 1.f)
+            {
+                continue;
+            }
+            // Inside test through the signed areas of the hit point against each edge
+            const FVector Hit = Start + Dir * Time - A;
+            const float U = ((Hit ^ Edge2) | Normal) / Normal.SizeSquared();
+            const float V = ((Edge1 ^ Hit) | Normal) / Normal.SizeSquared();
+            if (U >= -1e-5f && V >= -1e-5f && U + V <= 1.f + 1e-5f)
+            {
+                Best = FMath::Min(Best, Time);
+            }
+        }
+        return Best;
+    }
+
+    float BruteForceClosestDistance(const FTestMesh& Mesh, const FVector& Center)
+    {
+        float Best = BIG_NUMBER;
+        for (int32 Index = 0; Index + 2 < Mesh.Indices.Num(); Index += 3)
+        {
+            const FVector Point = FMath::ClosestPointOnTriangleToPoint(Center, Mesh.Positions[Mesh.Indices[Index + 0]],
+                Mesh.Positions[Mesh.Indices[Index + 1]], Mesh.Positions[Mesh.Indices[Index + 2]]);
+            Best = FMath::Min(Best, FVector::Dist(Point, Center));
+        }
+        return Best;
+    }
+
+    // Deterministic point in [-Extent, Extent]^3
+    FVector RandomPoint(uint32& Seed, float Extent)
+    {
+        FVector Point;
+        float* Components[3] = { &Point.X, &Point.Y, &Point.Z };
+        for (float* Component : Components)
+        {
+            Seed = Seed * 1664525u + 1013904223u;
+            *Component = ((Seed >> 8) / static_cast<float>(1u << 24) * 2.f - 1.f) * Extent;
+        }
+        return Point;
+    }
+
+    // Wavy displacement so a refit has to move boxes and not just scale them
+    FTestMesh Displace(const FTestMesh& Mesh, float Phase)
+    {
+        FTestMesh Moved = Mesh;
+        for (FVector& Position : Moved.Positions)
+        {
+            Position += FVector(FMath::Sin(Position.Z * 0.1f + Phase), FMath::Cos(Position.X * 0.1f + Phase), FMath::Sin(Position.Y * 0.07f)) * 8.f;
+        }
+        return Moved;
+    }
+
+    // Raycasts and closest point queries of the tree agree with checking every triangle
+    void CheckAgainstBruteForce(const FSVFMeshBVH& BVH, const FTestMesh& Mesh, uint32 Seed, int32& OutHits)
+    {
+        for (int32 Query = 0; Query < 300; ++Query)
+        {
+            const FVector Start = RandomPoint(Seed, 120.f);
+            const FVector End = RandomPoint(Seed, 120.f);
+            FSVFMeshRayHit Hit;
+            const bool bHit = BVH.Raycast(Start, End, Hit);
+            const float Expected = BruteForceRaycast(Mesh, Start, End);
+            SVF_CHECK_EQUAL(bHit, Expected <= 1.f);
+            if (bHit && Expected <= 1.f)
+            {
+                ++OutHits;
+                SVF_CHECK_NEAR(Hit.Time, Expected, 1e-4f);
+                // The reported triangle and barycentrics reproduce the hit point
+                FVector A, B, C;
+                BVH.GetTriangle(Hit.Triangle, A, B, C);
+                const FVector FromBarycentrics = A * (1.f - Hit.U - Hit.V) + B * Hit.U + C * Hit.V;
+                SVF_CHECK(FVector::Dist(FromBarycentrics, Start + (End - Start) * Hit.Time) < 1e-2f);
+            }
+
+            const FVector Center = RandomPoint(Seed, 80.f);
+            const float Radius = 30.f;
+            FVector Point;
+            int32 Triangle = INDEX_NONE;
+            const bool bFound = BVH.ClosestPoint(Center, Radius, Point, Triangle);
+            const float ExpectedDistance = BruteForceClosestDistance(Mesh, Center);
+            SVF_CHECK_EQUAL(bFound, ExpectedDistance <= Radius);
+            if (bFound && ExpectedDistance <= Radius)
+            {
+                SVF_CHECK_NEAR(FVector::Dist(Point, Center), ExpectedDistance, 1e-3f);
+                FVector A, B, C;
+                BVH.GetTriangle(Triangle, A, B, C);
+                SVF_CHECK(FVector::Dist(FMath::ClosestPointOnTriangleToPoint(Center, A, B, C), Point) < 1e-3f);
+            }
+        }
+    }
+}
+
+using namespace SVFMeshBVHTest;
+
+SVF_TEST(QueriesMatchBruteForce)
+{
+    const FTestMesh Meshes[] = { MakeSphere(24, 32), MakeGrid(20), Displace(MakeSphere(16, 20, 70.f), 0.3f) };
+    uint32 Seed = 1;
+    for (const FTestMesh& Mesh : Meshes)
+    {
+        FSVFMeshBVH BVH;
+        TArray<FVector> Positions = Mesh.Positions;
+        BVH.Build(MoveTemp(Positions), Mesh.Indices);
+        SVF_CHECK_EQUAL(BVH.GetNumTriangles(), Mesh.Indices.Num() / 3);
+        SVF_CHECK_EQUAL(BVH.GetNumVertices(), Mesh.Positions.Num());
+
+        int32 Hits = 0;
+        CheckAgainstBruteForce(BVH, Mesh, Seed++, Hits);
+        // Enough of the random segments cross the surface for the comparison to mean something
+        SVF_CHECK(Hits > 30);
+    }
+}
+
+SVF_TEST(AxisAlignedRays)
+{
+    // Straight down onto the flat grid, the direction has two zero components
+    const FTestMesh Grid = MakeGrid(10);
+    FSVFMeshBVH BVH;
+    TArray<FVector> Positions = Grid.Positions;
+    BVH.Build(MoveTemp(Positions), Grid.Indices);
+
+    FSVFMeshRayHit Hit;
+    SVF_CHECK(BVH.Raycast(FVector(37.f, 61.f, 10.f), FVector(37.f, 61.f, -10.f), Hit));
+    SVF_CHECK_NEAR(Hit.Time, 0.5f, 1e-6f);
+    // Back face
+    SVF_CHECK(BVH.Raycast(FVector(37.f, 61.f, -10.f), FVector(37.f, 61.f, 30.f), Hit));
+    SVF_CHECK_NEAR(Hit.Time, 0.25f, 1e-6f);
+    // Stops short of the surface, or passes beside it
+    SVF_CHECK(!BVH.Raycast(FVector(37.f, 61.f, 10.f), FVector(37.f, 61.f, 1.f), Hit));
+    SVF_CHECK(!BVH.Raycast(FVector(137.f, 61.f, 10.f), FVector(137.f, 61.f, -10.f), Hit));
+}
+
+SVF_TEST(RefitMatchesRebuild)
+{
+    const FTestMesh Rest = MakeSphere(20, 24);
+    FSVFMeshBVH BVH;
+    TArray<FVector> Positions = Rest.Positions;
+    BVH.Build(MoveTemp(Positions), Rest.Indices);
+
+    uint32 Seed = 7;
+    for (int32 Frame = 1; Frame <= 3; ++Frame)
+    {
+        const FTestMesh Moved = Displace(Rest, Frame * 0.9f);
+        Positions = Moved.Positions;
+        SVF_CHECK(BVH.Refit(MoveTemp(Positions)));
+
+        FSVFMeshBVH Rebuilt;
+        Positions = Moved.Positions;
+        Rebuilt.Build(MoveTemp(Positions), Moved.Indices);
+        SVF_CHECK(FVector::Dist(BVH.GetBounds().Min, Rebuilt.GetBounds().Min) < 1e-4f);
+        SVF_CHECK(FVector::Dist(BVH.GetBounds().Max, Rebuilt.GetBounds().Max) < 1e-4f);
+
+        // A refit tree is looser than a rebuild but must still find every hit
+        int32 Hits = 0;
+        CheckAgainstBruteForce(BVH, Moved, Seed++, Hits);
+        SVF_CHECK(Hits > 30);
+    }
+
+    // A different vertex count is another topology and can't be refit
+    Positions = Rest.Positions;
+    Positions.Add(FVector::ZeroVector);
+    SVF_CHECK(!BVH.Refit(MoveTemp(Positions)));
+}
+
+SVF_TEST(RefitFromLeavesSourceIntact)
+{
+    const FTestMesh Rest = MakeSphere(12, 16);
+    FSVFMeshBVH Source;
+    TArray<FVector> Positions = Rest.Positions;
+    Source.Build(MoveTemp(Positions), Rest.Indices);
+    const FBox SourceBounds = Source.GetBounds();
+
+    // Moved well away, so any sharing of state with the source would show up in its queries
+    FTestMesh Moved = Rest;
+    for (FVector& Position : Moved.Positions)
+    {
+        Position += FVector(500.f, 0.f, 0.f);
+    }
+    FSVFMeshBVH Next;
+    Positions = Moved.Positions;
+    SVF_CHECK(Next.RefitFrom(Source, MoveTemp(Positions)));
+    SVF_CHECK_NEAR(Next.GetBounds().Min.X, SourceBounds.Min.X + 500.f, 1e-3f);
+
+    SVF_CHECK(FVector::Dist(Source.GetBounds().Min, SourceBounds.Min) == 0.f);
+    FSVFMeshRayHit Hit;
+    SVF_CHECK(Source.Raycast(FVector(0.f, 0.f, 100.f), FVector(0.f, 0.f, -100.f), Hit));
+    SVF_CHECK_NEAR(Hit.Time, 0.25f, 1e-3f);
+    SVF_CHECK(Next.Raycast(FVector(500.f, 0.f, 100.f), FVector(500.f, 0.f, -100.f), Hit));
+    SVF_CHECK_NEAR(Hit.Time, 0.25f, 1e-3f);
+    SVF_CHECK(!Next.Raycast(FVector(0.f, 0.f, 100.f), FVector(0.f, 0.f, -100.f), Hit));
+}
+
+SVF_TEST(DropsInvalidTriangles)
+{
+    FTestMesh Grid = MakeGrid(2);
+    const int32 NumValid = Grid.Indices.Num() / 3;
+    Grid.Indices.Append({ 0, 1, Grid.Positions.Num(), -1, 0, 1 });
+    // A trailing partial triangle is ignored too
+    Grid.Indices.Append({ 0, 1 });
+
+    FSVFMeshBVH BVH;
+    TArray<FVector> Positions = Grid.Positions;
+    BVH.Build(MoveTemp(Positions), Grid.Indices);
+    SVF_CHECK_EQUAL(BVH.GetNumTriangles(), NumValid);
+
+    FSVFMeshBVH Empty;
+    Positions = Grid.Positions;
+    Empty.Build(MoveTemp(Positions), TArray<int32>());
+    SVF_CHECK(Empty.IsEmpty());
+    FSVFMeshRayHit Hit;
+    SVF_CHECK(!Empty.Raycast(FVector(50.f, 50.f, 10.f), FVector(50.f, 50.f, -10.f), Hit));
+    FVector Point;
+    int32 Triangle;
+    SVF_CHECK(!Empty.ClosestPoint(FVector::ZeroVector, 100.f, Point, Triangle));
+}
+
+SVF_TEST(BuildRefitAndRaycastThroughput)
+{
+    // A capture sized frame, queried the way collision and surface queries do on the game thread
+    const FTestMesh Rest = Displace(MakeSphere(128, 256), 0.f);
+    const FTestMesh Moved = Displace(Rest, 0.9f);
+    const int32 NumTriangles = Rest.Indices.Num() / 3;
+
+    FSVFMeshBVH BVH;
+    const double BuildSeconds = SVFTest::TimeBest(5, [&Rest, &BVH]()
+    {
+        TArray<FVector> Positions = Rest.Positions;
+        BVH.Build(MoveTemp(Positions), Rest.Indices);
+    });
+    const double RefitSeconds = SVFTest::TimeBest(5, [&Moved, &BVH]()
+    {
+        TArray<FVector> Positions = Moved.Positions;
+        SVF_CHECK(BVH.Refit(MoveTemp(Positions)));
+    });
+
+    const int32 NumRays = 2000;
+    TArray<FVector> Starts;
+    TArray<FVector> Ends;
+    uint32 Seed = 11;
+    for (int32 Ray = 0; Ray < NumRays; ++Ray)
+    {
+        Starts.Add(RandomPoint(Seed, 120.f));
+        Ends.Add(RandomPoint(Seed, 120.f));
+    }
+    int32 Hits = 0;
+    const double RaycastSeconds = SVFTest::TimeBest(5, [&]()
+    {
+        Hits = 0;
+        FSVFMeshRayHit Hit;
+        for (int32 Ray = 0; Ray < NumRays; ++Ray)
+        {
+            Hits += BVH.Raycast(Starts[Ray], Ends[Ray], Hit) ? 1 : 0;
+        }
+    });
+    // Every triangle per ray is slow enough that a slice of the rays gives the rate
+    const int32 NumBruteForceRays = 50;
+    int32 BruteForceHits = 0;
+    const double BruteForceSeconds = SVFTest::TimeBest(3, [&]()
+    {
+        BruteForceHits = 0;
+        for (int32 Ray = 0; Ray < NumBruteForceRays; ++Ray)
+        {
+            BruteForceHits += BruteForceRaycast(Moved, Starts[Ray], Ends[Ray]) <= 1.f ? 1 : 0;
+        }
+    });
+    SVF_CHECK(Hits > NumRays / 10);
+    SVF_CHECK(BruteForceHits > 0);
+
+    const double RaysPerSecond = NumRays / RaycastSeconds;
+    const double BruteForceRaysPerSecond = NumBruteForceRays / BruteForceSeconds;
+    std::printf("BVH: %d triangles, build %.2f ms, refit %.2f ms\n", NumTriangles, BuildSeconds * 1e3, RefitSeconds * 1e3);
+    std::printf("Raycast: %.0f rays/s, brute force %.0f rays/s, %.0fx\n", RaysPerSecond, BruteForceRaysPerSecond,
+        RaysPerSecond / BruteForceRaysPerSecond);
+    // Refitting skips the partitioning, and the tree has to beat checking every triangle by far
+    SVF_CHECK(RefitSeconds < BuildSeconds);
+    SVF_CHECK(RaysPerSecond > 10.0 * BruteForceRaysPerSecond);
+}
@@ -0,0 +1,93 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFMeshBufferPool.h"
+
+namespace SVFMeshBufferPoolTest
+{
+    // Pooled sets are identified by a name, the feature level filter by its first letter
+    struct FItem
+    {
+        int32 Id = 0;
+        char Level = 'a';
+    };
+
+    auto AnyLevel = [](const FItem&) { return true; };
+}
+
+using namespace SVFMeshBufferPoolTest;
+
+SVF_TEST(DisabledPoolKeepsNothing)
+{
+    TSVFMeshBufferPool<FItem> Pool;
+    SVF_CHECK(!Pool.IsEnabled());
+    TArray<FItem> Evicted;
+    SVF_CHECK(!Pool.Release(FItem{ 1 }, FSVFMeshBufferSize(100, 300), Evicted));
+    FItem Item;
+    SVF_CHECK(!Pool.Acquire(FSVFMeshBufferSize(10, 30), AnyLevel, Item));
+}
+
+SVF_TEST(AcquireTakesSmallestFittingSet)
+{
+    TSVFMeshBufferPool<FItem> Pool;
+    Pool.SetBudget(100 * 1024 * 1024);
+    TArray<FItem> Evicted;
+    Pool.Release(FItem{ 1 }, FSVFMeshBufferSize(20000, 60000), Evicted);
+    Pool.Release(FItem{ 2 }, FSVFMeshBufferSize(12000, 36000), Evicted);
+    Pool.Release(FItem{ 3 }, FSVFMeshBufferSize(9000, 27000), Evicted);
+    SVF_CHECK_EQUAL(Evicted.Num(), 0);
+
+    // 3 is too small, 1 and 2 hold it, 2 is the smaller
+    FItem Item;
+    SVF_CHECK(Pool.Acquire(FSVFMeshBufferSize(10000, 30000), AnyLevel, Item));
+    SVF_CHECK_EQUAL(Item.Id, 2);
+    SVF_CHECK_EQUAL(Pool.GetUsedBytes(), FSVFMeshBufferSize(20000, 60000).GetBytes() + FSVFMeshBufferSize(9000, 27000).GetBytes());
+
+    // Set 1 is more than twice as large as this clip needs, it isn't pinned by it
+    SVF_CHECK(!Pool.Acquire(FSVFMeshBufferSize(5000, 15000), [](const FItem& Candidate) { return Candidate.Id == 1; }, Item));
+    // Vertices and indices both have to fit
+    SVF_CHECK(!Pool.Acquire(FSVFMeshBufferSize(8000, 40000), [](const FItem& Candidate) { return Candidate.Id == 3; }, Item));
+}
+
+SVF_TEST(MatchFiltersOtherSettings)
+{
+    TSVFMeshBufferPool<FItem> Pool;
+    Pool.SetBudget(100 * 1024 * 1024);
+    TArray<FItem> Evicted;
+    Pool.Release(FItem{ 1, 'b' }, FSVFMeshBufferSize(1000, 3000), Evicted);
+    FItem Item;
+    SVF_CHECK(!Pool.Acquire(FSVFMeshBufferSize(1000, 3000), [](const FItem& Candidate) { return Candidate.Level == 'a'; }, Item));
+    SVF_CHECK(Pool.Acquire(FSVFMeshBufferSize(1000, 3000), [](const FItem& Candidate) { return Candidate.Level == 'b'; }, Item));
+    SVF_CHECK_EQUAL(Pool.GetUsedBytes(), 0u);
+}
+
+SVF_TEST(ReleaseEvictsOldestOverBudget)
+{
+    const FSVFMeshBufferSize Size(1000, 3000);
+    TSVFMeshBufferPool<FItem> Pool;
+    Pool.SetBudget(Size.GetBytes() * 2);
+    TArray<FItem> Evicted;
+    SVF_CHECK(Pool.Release(FItem{ 1 }, Size, Evicted));
+    SVF_CHECK(Pool.Release(FItem{ 2 }, Size, Evicted));
+    SVF_CHECK(Pool.Release(FItem{ 3 }, Size, Evicted));
+    SVF_CHECK_EQUAL(Evicted.Num(), 1);
+    SVF_CHECK_EQUAL(Evicted[0].Id, 1);
+    SVF_CHECK_EQUAL(Pool.GetUsedBytes(), Size.GetBytes() * 2);
+
+    // A set larger than the whole budget is handed back to be freed
+    SVF_CHECK(!Pool.Release(FItem{ 4 }, FSVFMeshBufferSize(3000, 9000), Evicted));
+
+    TArray<FItem> Remaining;
+    Pool.Empty(Remaining);
+    SVF_CHECK_EQUAL(Remaining.Num(), 2);
+    SVF_CHECK_EQUAL(Pool.GetUsedBytes(), 0u);
+}
+
+SVF_TEST(SizeCountsEveryBuffer)
+{
+    // float3 position, two packed normals, four half float UV pairs, 32 bit indices
+    SVF_CHECK_EQUAL(FSVFMeshBufferSize(10, 30).GetBytes(), 10u * 36 + 30u * 4);
+    SVF_CHECK_EQUAL(FSVFMeshBufferSize(-5, -1).GetBytes(), 0u);
+    SVF_CHECK(FSVFMeshBufferSize(10, 30).Holds(FSVFMeshBufferSize(10, 30)));
+    SVF_CHECK(!FSVFMeshBufferSize(10, 30).Holds(FSVFMeshBufferSize(11, 3)));
+}
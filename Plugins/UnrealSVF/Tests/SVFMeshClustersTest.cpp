@@ -0,0 +1,108 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFTestMeshes.h"
+#include "SVFMeshClusters.h"
+
+using namespace SVFTestMeshes;
+
+namespace SVFMeshClustersTest
+{
+    TArray<FSVFMeshCluster> BuildClusters(FTestMesh& Mesh)
+    {
+        FSVFMeshClusterBuilder Builder;
+        TArray<FSVFMeshCluster> Clusters;
+        const TArray<FVector>& Positions = Mesh.Positions;
+        Builder.Build(Mesh.Indices, Positions.Num(), [&Positions](int32 VertexIndex) -> const FVector& { return Positions[VertexIndex]; }, Clusters);
+        return Clusters;
+    }
+
+    // Frustum planes (normals pointing out) of the half space X <= Limit
+    FPlane KeepBelowX(float Limit)
+    {
+        return FPlane(1.f, 0.f, 0.f, Limit);
+    }
+}
+
+using namespace SVFMeshClustersTest;
+
+SVF_TEST(SmallMeshIsOneCluster)
+{
+    FTestMesh Mesh = MakeGrid(10);
+    const TArray<int32> Original = Mesh.Indices;
+    const TArray<FSVFMeshCluster> Clusters = BuildClusters(Mesh);
+    SVF_CHECK_EQUAL(Clusters.Num(), 1);
+    SVF_CHECK_EQUAL(Clusters[0].FirstIndex, 0u);
+    SVF_CHECK_EQUAL(Clusters[0].NumTriangles, 200u);
+    SVF_CHECK(Mesh.Indices == Original);
+}
+
+SVF_TEST(ClustersPartitionTheTriangles)
+{
+    // 2 * 128^2 = 32768 triangles, about 16 clusters
+    FTestMesh Mesh = MakeGrid(128);
+    const TArray<uint64> Before = SortedTriangles(Mesh.Indices);
+    const TArray<FSVFMeshCluster> Clusters = BuildClusters(Mesh);
+    SVF_CHECK(Clusters.Num() >= 8);
+    SVF_CHECK(Clusters.Num() <= FSVFMeshClusterBuilder::MaxCellsPerAxis * FSVFMeshClusterBuilder::MaxCellsPerAxis);
+
+    // Same triangles, regrouped into back to back ranges
+    SVF_CHECK(SortedTriangles(Mesh.Indices) == Before);
+    uint32 NextIndex = 0;
+    for (const FSVFMeshCluster& Cluster : Clusters)
+    {
+        SVF_CHECK_EQUAL(Cluster.FirstIndex, NextIndex);
+        SVF_CHECK(Cluster.NumTriangles > 0);
+        NextIndex += Cluster.NumTriangles * 3;
+
+        // The bounds hold every vertex of the cluster's triangles
+        for (uint32 Index = Cluster.FirstIndex; Index < Cluster.FirstIndex + Cluster.NumTriangles * 3; ++Index)
+        {
+            SVF_CHECK(Cluster.Bounds.IsInsideOrOn(Mesh.Positions[Mesh.Indices[Index]]));
+        }
+    }
+    SVF_CHECK_EQUAL(NextIndex, static_cast<uint32>(Mesh.Indices.Num()));
+}
+
+SVF_TEST(FrustumCullsClustersOutside)
+{
+    FTestMesh Mesh = MakeGrid(128);
+    const TArray<FSVFMeshCluster> Clusters = BuildClusters(Mesh);
+    const FPlane Planes[] = { KeepBelowX(30.f) };
+
+    TArray<FSVFIndexRange> Ranges;
+    FSVFMeshClusterBuilder::GatherVisibleRanges(Clusters, FMatrix::Identity, MakeArrayView(Planes, 1), Ranges);
+    uint32 Visible = 0;
+    for (const FSVFIndexRange& Range : Ranges)
+    {
+        Visible += Range.NumTriangles;
+        // Nothing drawn lies completely beyond the plane
+        for (uint32 Index = Range.FirstIndex; Index < Range.FirstIndex + Range.NumTriangles * 3; Index += 3)
+        {
+            const float MinX = FMath::Min3(Mesh.Positions[Mesh.Indices[Index]].X, Mesh.Positions[Mesh.Indices[Index + 1]].X,
+                Mesh.Positions[Mesh.Indices[Index + 2]].X);
+            SVF_CHECK(MinX <= 30.f + 100.f / FSVFMeshClusterBuilder::MaxCellsPerAxis);
+        }
+    }
+    // About 30% of the grid, with at most one column of cells extra
+    SVF_CHECK(Visible > 0);
+    SVF_CHECK(Visible < static_cast<uint32>(Mesh.Indices.Num() / 3) / 2);
+
+    // Every triangle a visible one: all of it in view
+    const FPlane AllPlanes[] = { KeepBelowX(1000.f) };
+    FSVFMeshClusterBuilder::GatherVisibleRanges(Clusters, FMatrix::Identity, MakeArrayView(AllPlanes, 1), Ranges);
+    SVF_CHECK_EQUAL(Ranges.Num(), 1);
+    SVF_CHECK_EQUAL(Ranges[0].NumTriangles * 3, static_cast<uint32>(Mesh.Indices.Num()));
+}
+
+SVF_TEST(FrustumTestUsesTheTransform)
+{
+    const FBox Box(FVector(0.f), FVector(10.f));
+    const FPlane Planes[] = { KeepBelowX(50.f) };
+    SVF_CHECK(FSVFMeshClusterBuilder::IntersectsFrustum(Box, FMatrix::Identity, MakeArrayView(Planes, 1)));
+    SVF_CHECK(!FSVFMeshClusterBuilder::IntersectsFrustum(Box, FTranslationMatrix(FVector(100.f, 0.f, 0.f)), MakeArrayView(Planes, 1)));
+    SVF_CHECK(FSVFMeshClusterBuilder::IntersectsFrustum(Box, FTranslationMatrix(FVector(45.f, 0.f, 0.f)), MakeArrayView(Planes, 1)));
+    SVF_CHECK(!FSVFMeshClusterBuilder::IntersectsFrustum(Box, FScaleMatrix(FVector(10.f)) * FTranslationMatrix(FVector(60.f, 0.f, 0.f)),
+        MakeArrayView(Planes, 1)));
+    SVF_CHECK(!FSVFMeshClusterBuilder::IntersectsFrustum(FBox(ForceInit), FMatrix::Identity, MakeArrayView(Planes, 1)));
+}
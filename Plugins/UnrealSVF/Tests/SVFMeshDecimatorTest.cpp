@@ -0,0 +1,236 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFTestMeshes.h"
+#include "SVFMeshDecimator.h"
+#include "SVFMeshClusters.h"
+#include "SVFMeshBVH.h"
+
+using namespace SVFTestMeshes;
+
+SVF_TEST(DecimateKeepsValidTriangles)
+{
+    const FTestMesh Mesh = MakeSphere(64, 128);
+    TArray<int32> Reduced;
+    FSVFMeshDecimator::Decimate(Mesh.Indices, Mesh.Positions, 10.f, Reduced);
+    SVF_CHECK(Reduced.Num() > 0);
+    SVF_CHECK(Reduced.Num() < Mesh.Indices.Num() / 4);
+    SVF_CHECK_EQUAL(Reduced.Num() % 3, 0);
+
+    // Indices into the original vertices, no degenerate or repeated triangles
+    for (int32 Index = 0; Index < Reduced.Num(); Index += 3)
+    {
+        const int32 A = Reduced[Index];
+        const int32 B = Reduced[Index + 1];
+        const int32 C = Reduced[Index + 2];
+        SVF_CHECK(A >= 0 && A < Mesh.Positions.Num() && B >= 0 && B < Mesh.Positions.Num() && C >= 0 && C < Mesh.Positions.Num());
+        SVF_CHECK(A != B && B != C && A != C);
+    }
+    TArray<uint64> Triangles = SortedTriangles(Reduced);
+    int32 Repeats = 0;
+    for (int32 Index = 1; Index < Triangles.Num(); ++Index)
+    {
+        Repeats += Triangles[Index] == Triangles[Index - 1] ? 1 : 0;
+    }
+    SVF_CHECK_EQUAL(Repeats, 0);
+
+    // Representatives are original vertices, so the surface stays on the sphere
+    for (int32 Vertex : Reduced)
+    {
+        SVF_CHECK_NEAR(Mesh.Positions[Vertex].Size(), 50.f, 1e-3);
+    }
+}
+
+SVF_TEST(LODsShrinkLevelByLevel)
+{
+    const FTestMesh Mesh = MakeSphere(128, 256);
+    TArray<TArray<int32>> LODs;
+    FSVFMeshDecimator::BuildLODs(Mesh.Indices, Mesh.Positions, 3, LODs);
+    SVF_CHECK_EQUAL(LODs.Num(), 3);
+    int32 Previous = Mesh.Indices.Num();
+    for (const TArray<int32>& LOD : LODs)
+    {
+        SVF_CHECK(LOD.Num() <= Previous * 0.8f);
+        Previous = LOD.Num();
+    }
+
+    // A mesh too coarse to reduce gets no levels
+    const FTestMesh Coarse = MakeSphere(4, 8);
+    FSVFMeshDecimator::BuildLODs(Coarse.Indices, Coarse.Positions, 3, LODs);
+    SVF_CHECK_EQUAL(LODs.Num(), 0);
+}
+
+SVF_TEST(BudgetIsRespectedAndCompacted)
+{
+    const FTestMesh Mesh = MakeSphere(64, 128);
+    FSVFCompactMesh Compact;
+    FSVFMeshDecimator::DecimateToBudget(Mesh.Indices, Mesh.Positions, 1000, Compact);
+    SVF_CHECK(Compact.Indices.Num() / 3 <= 1000);
+    SVF_CHECK(Compact.Indices.Num() / 3 > 100);
+
+    // Every kept vertex is used
+    TArray<bool> Used;
+    Used.Init(false, Compact.Positions.Num());
+    for (int32 Vertex : Compact.Indices)
+    {
+        Used[Vertex] = true;
+    }
+    SVF_CHECK(!Used.Contains(false));
+
+    // Within budget already: the same triangles, only compacted
+    const FTestMesh Small = MakeGrid(4);
+    FSVFMeshDecimator::DecimateToBudget(Small.Indices, Small.Positions, 1000, Compact);
+    SVF_CHECK_EQUAL(Compact.Indices.Num(), Small.Indices.Num());
+    SVF_CHECK_EQUAL(Compact.Positions.Num(), Small.Positions.Num());
+}
+
+SVF_TEST(BudgetTakesFinestFittingGrid)
+{
+    // Each step grows the cells by sqrt(2) and keeps about half the triangles, so the finest grid that
+    // fits never lands far below the budget
+    const FTestMesh Mesh = MakeSphere(96, 192);
+    const int32 Budgets[] = { 250, 2000, 8000 };
+    for (int32 Budget : Budgets)
+    {
+        FSVFCompactMesh Compact;
+        FSVFMeshDecimator::DecimateToBudget(Mesh.Indices, Mesh.Positions, Budget, Compact);
+        SVF_CHECK(Compact.Indices.Num() / 3 <= Budget);
+        SVF_CHECK(Compact.Indices.Num() / 3 > Budget / 4);
+
+        // Collapsed vertices are original vertices, so the collision stays on the captured surface
+        for (const FVector& Position : Compact.Positions)
+        {
+            SVF_CHECK_NEAR(Position.Size(), 50.f, 1e-3f);
+        }
+        // Still a closed surface: every edge is shared by exactly two triangles with opposite winding
+        TMap<uint64, int32> Edges;
+        for (int32 Index = 0; Index < Compact.Indices.Num(); Index += 3)
+        {
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                const uint64 From = Compact.Indices[Index + Corner];
+                const uint64 To = Compact.Indices[Index + (Corner + 1) % 3];
+                Edges.FindOrAdd((From << 32) | To) += 1;
+            }
+        }
+        int32 Unpaired = 0;
+        for (const auto& Edge : Edges)
+        {
+            const uint64 Reverse = (Edge.Key << 32) | (Edge.Key >> 32);
+            Unpaired += (Edge.Value == 1 && Edges.FindRef(Reverse) == 1) ? 0 : 1;
+        }
+        SVF_CHECK_EQUAL(Unpaired, 0);
+    }
+}
+
+SVF_TEST(BudgetEdgeCases)
+{
+    const FTestMesh Grid = MakeGrid(8);
+    FSVFCompactMesh Compact;
+    Compact.Positions.Add(FVector::ZeroVector);
+
+    // No budget or no vertices leave nothing, including the previous output
+    FSVFMeshDecimator::DecimateToBudget(Grid.Indices, Grid.Positions, 0, Compact);
+    SVF_CHECK_EQUAL(Compact.Positions.Num(), 0);
+    SVF_CHECK_EQUAL(Compact.Indices.Num(), 0);
+    FSVFMeshDecimator::DecimateToBudget(Grid.Indices, TArrayView<const FVector>(), 100, Compact);
+    SVF_CHECK_EQUAL(Compact.Indices.Num(), 0);
+
+    // Within budget, out of range triangles and a trailing partial triangle are dropped
+    TArray<int32> Indices = Grid.Indices;
+    Indices.Append({ 0, 1, Grid.Positions.Num(), 0, 1 });
+    FSVFMeshDecimator::DecimateToBudget(Indices, Grid.Positions, 1000, Compact);
+    SVF_CHECK_EQUAL(Compact.Indices.Num(), Grid.Indices.Num());
+}
+
+SVF_TEST(LODClusterBoundsFollowTheFrame)
+{
+    // LOD clusters are built once from the group's first frame and their bounds refreshed for later frames
+    FTestMesh Mesh = MakeGrid(160);
+    TArray<TArray<int32>> LODs;
+    FSVFMeshDecimator::BuildLODs(Mesh.Indices, Mesh.Positions, 1, LODs);
+    SVF_CHECK_EQUAL(LODs.Num(), 1);
+    TArray<int32>& LODIndices = LODs[0];
+    SVF_CHECK(LODIndices.Num() / 3 >= 2 * FSVFMeshClusterBuilder::TargetTrianglesPerCluster);
+
+    FSVFMeshClusterBuilder Builder;
+    TArray<FSVFMeshCluster> Clusters;
+    const TArray<FVector>& Positions = Mesh.Positions;
+    auto GetPosition = [&Positions](int32 VertexIndex) -> const FVector& { return Positions[VertexIndex]; };
+    Builder.Build(LODIndices, Positions.Num(), GetPosition, Clusters);
+    SVF_CHECK(Clusters.Num() >= 2);
+    const TArray<FSVFMeshCluster> Built = Clusters;
+
+    // Same frame: the bounds come out as built
+    FSVFMeshClusterBuilder::UpdateBounds(LODIndices, Positions.Num(), GetPosition, Clusters);
+    for (int32 Cluster = 0; Cluster < Clusters.Num(); ++Cluster)
+    {
+        SVF_CHECK(Clusters[Cluster].Bounds == Built[Cluster].Bounds);
+    }
+
+    // The performer moves: the ranges stay, the bounds move with the vertices
+    for (FVector& Position : Mesh.Positions)
+    {
+        Position += FVector(0.f, 0.f, 25.f);
+    }
+    FSVFMeshClusterBuilder::UpdateBounds(LODIndices, Positions.Num(), GetPosition, Clusters);
+    for (int32 Cluster = 0; Cluster < Clusters.Num(); ++Cluster)
+    {
+        SVF_CHECK_EQUAL(Clusters[Cluster].FirstIndex, Built[Cluster].FirstIndex);
+        SVF_CHECK_EQUAL(Clusters[Cluster].NumTriangles, Built[Cluster].NumTriangles);
+        SVF_CHECK(Clusters[Cluster].Bounds.Min.Equals(Built[Cluster].Bounds.Min + FVector(0.f, 0.f, 25.f)));
+        SVF_CHECK(Clusters[Cluster].Bounds.Max.Equals(Built[Cluster].Bounds.Max + FVector(0.f, 0.f, 25.f)));
+    }
+}
+
+SVF_TEST(LODQualityAndThroughput)
+{
+    // A bumpy performer sized sphere, so merged vertices actually move the surface
+    FTestMesh Mesh = MakeSphere(128, 256);
+    for (FVector& Position : Mesh.Positions)
+    {
+        Position *= 1.f + 0.05f * FMath::Sin(Position.X * 0.3f) * FMath::Cos(Position.Z * 0.2f);
+    }
+
+    TArray<TArray<int32>> LODs;
+    const double Seconds = SVFTest::TimeBest(5, [&]()
+    {
+        FSVFMeshDecimator::BuildLODs(Mesh.Indices, Mesh.Positions, 3, LODs);
+    });
+    std::printf("BuildLODs: %d triangles in %.2f ms, %.1f Mtriangles/s\n", Mesh.Indices.Num() / 3, Seconds * 1e3,
+        Mesh.Indices.Num() / 3 / Seconds * 1e-6);
+    SVF_CHECK_EQUAL(LODs.Num(), 3);
+
+    // One-sided distance from every source vertex to each level's surface, relative to the mesh size
+    FBox Bounds(ForceInit);
+    for (const FVector& Position : Mesh.Positions)
+    {
+        Bounds += Position;
+    }
+    const float Diagonal = Bounds.GetSize().Size();
+    float PreviousRms = 0.f;
+    for (int32 Level = 0; Level < LODs.Num(); ++Level)
+    {
+        FSVFMeshBVH Surface;
+        TArray<FVector> Positions = Mesh.Positions;
+        Surface.Build(MoveTemp(Positions), LODs[Level]);
+        double SumSquared = 0.0;
+        float Hausdorff = 0.f;
+        for (const FVector& Vertex : Mesh.Positions)
+        {
+            FVector Closest;
+            int32 Triangle;
+            SVF_CHECK(Surface.ClosestPoint(Vertex, Diagonal, Closest, Triangle));
+            const float Distance = FVector::Dist(Vertex, Closest);
+            SumSquared += static_cast<double>(Distance) * Distance;
+            Hausdorff = FMath::Max(Hausdorff, Distance);
+        }
+        const float Rms = static_cast<float>(FMath::Sqrt(SumSquared / Mesh.Positions.Num()));
+        std::printf("LOD %d: %.3f of the triangles, RMS distance %.4f, Hausdorff %.4f of the diagonal\n", Level + 1,
+            static_cast<float>(LODs[Level].Num()) / Mesh.Indices.Num(), Rms / Diagonal, Hausdorff / Diagonal);
+        // Coarser levels stray further, but stay within a few grid cells of the source
+        SVF_CHECK(Rms >= PreviousRms);
+        SVF_CHECK(Hausdorff / Diagonal < 0.1f);
+        PreviousRms = Rms;
+    }
+}
@@ -0,0 +1,272 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFTestMeshes.h"
+#include "SVFMeshStaging.h"
+
+namespace SVFMeshStagingTest
+{
+    // Decoded frame of a grid; frames of one keyframe group share the indices
+    struct FTestFrameData : public FFrameData
+    {
+        FSVFFrameInfo FrameInfo;
+        SVFTestMeshes::FTestMesh Mesh;
+        bool bNormals = false;
+
+        FTestFrameData(int32 FrameId, bool bKeyFrame, const SVFTestMeshes::FTestMesh& InMesh)
+            : Mesh(InMesh)
+        {
+            FrameInfo.frameId = FrameId;
+            FrameInfo.isKeyFrame = bKeyFrame;
+            FrameInfo.vertexCount = Mesh.Positions.Num();
+            FrameInfo.indexCount = Mesh.Indices.Num();
+        }
+
+        virtual bool GetFrameInfo(FSVFFrameInfo& OutFrameInfo) override
+        {
+            OutFrameInfo = FrameInfo;
+            return true;
+        }
+
+        virtual bool HasNormals() const override
+        {
+            return bNormals;
+        }
+
+        virtual bool GetFrameStreams(const FSVFVertexStreams& OutStreams) override
+        {
+            for (int32 Index = 0; Index < Mesh.Positions.Num(); ++Index)
+            {
+                OutStreams.Positions[Index] = Mesh.Positions[Index];
+                if (OutStreams.Tangents)
+                {
+                    OutStreams.Tangents[2 * Index + 0] = FPackedNormal(FVector(1, 0, 0));
+                    OutStreams.Tangents[2 * Index + 1] = FPackedNormal(FVector4(0, 0, 1, 1));
+                }
+                if (OutStreams.TexCoords)
+                {
+                    OutStreams.TexCoords[Index * OutStreams.TexCoordStride] = FVector2D(Mesh.Positions[Index].X, Mesh.Positions[Index].Y) / 100.f;
+                }
+            }
+            return true;
+        }
+
+        virtual bool GetFrameIndices(TArray<int32>& OutIndices) override
+        {
+            OutIndices = Mesh.Indices;
+            return true;
+        }
+    };
+
+    // Same vertices and index count as Mesh, triangles in reverse order
+    SVFTestMeshes::FTestMesh Reordered(const SVFTestMeshes::FTestMesh& Mesh)
+    {
+        SVFTestMeshes::FTestMesh Result = Mesh;
+        const int32 NumTriangles = Mesh.Indices.Num() / 3;
+        for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+        {
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                Result.Indices[3 * Triangle + Corner] = Mesh.Indices[3 * (NumTriangles - 1 - Triangle) + Corner];
+            }
+        }
+        return Result;
+    }
+
+    FSVFMeshRenderSettings TopologySettings()
+    {
+        FSVFMeshRenderSettings Settings;
+        Settings.bOptimizeVertexCache = true;
+        return Settings;
+    }
+
+    FSVFMeshStagingBlockPtr StageFrame(FSVFMeshStager& Stager, int32 FrameId, bool bKeyFrame, const SVFTestMeshes::FTestMesh& Mesh)
+    {
+        FTestFrameData Frame(FrameId, bKeyFrame, Mesh);
+        FSVFMeshStagingBlockPtr Block = Stager.Stage(Frame, Stager.NextSequence());
+        // A build is only ever handed out for the topology it was started for
+        SVF_CHECK(Block.IsValid() && (!Block->TopologyBuild.IsValid() || Block->TopologyBuild->Generation == Block->TopologyGeneration));
+        return Block;
+    }
+}
+
+using namespace SVFMeshStagingTest;
+
+SVF_TEST(OutOfOrderFramesDropped)
+{
+    // FSVFMeshRenderData::Update takes sequences in frame order, its stage tasks may run in any order
+    FSVFMeshStager Stager(FSVFMeshRenderSettings(), 1, ESVFTexCoordFormat::Half);
+    const SVFTestMeshes::FTestMesh Mesh = SVFTestMeshes::MakeGrid(4);
+    FTestFrameData First(1, true, Mesh);
+    FTestFrameData Second(2, false, Mesh);
+    const uint32 FirstSequence = Stager.NextSequence();
+    const uint32 SecondSequence = Stager.NextSequence();
+
+    FSVFMeshStagingBlockPtr Block = Stager.Stage(Second, SecondSequence);
+    SVF_CHECK(Block.IsValid());
+    SVF_CHECK_EQUAL(Block->Sequence, SecondSequence);
+    SVF_CHECK(!Stager.Stage(First, FirstSequence).IsValid());
+    SVF_CHECK(!Stager.Stage(Second, SecondSequence).IsValid());
+    SVF_CHECK(Stager.Stage(First, Stager.NextSequence()).IsValid());
+
+    // Frames without geometry are not staged
+    FTestFrameData Empty(0, true, Mesh);
+    SVF_CHECK(!Stager.Stage(Empty, Stager.NextSequence()).IsValid());
+}
+
+SVF_TEST(BlocksRecycledUpToPoolSize)
+{
+    FSVFMeshStager Stager(FSVFMeshRenderSettings(), 1, ESVFTexCoordFormat::Half);
+    const SVFTestMeshes::FTestMesh Mesh = SVFTestMeshes::MakeGrid(4);
+
+    FSVFMeshStagingBlockPtr Block = StageFrame(Stager, 1, true, Mesh);
+    const FSVFMeshStagingBlock* First = Block.Get();
+    Stager.Recycle(MoveTemp(Block));
+    SVF_CHECK(!Block.IsValid());
+    SVF_CHECK(StageFrame(Stager, 2, false, Mesh).Get() == First);
+
+    // More blocks in flight than the pool keeps: only MaxFreeBlocks of them stay alive for reuse
+    const int32 NumInFlight = FSVFMeshStager::MaxFreeBlocks + 3;
+    TArray<FSVFMeshStagingBlockPtr> InFlight;
+    TArray<TWeakPtr<FSVFMeshStagingBlock, ESPMode::ThreadSafe>> Released;
+    for (int32 Index = 0; Index < NumInFlight; ++Index)
+    {
+        InFlight.Add(StageFrame(Stager, 3 + Index, false, Mesh));
+        Released.Add(InFlight.Last());
+    }
+    for (FSVFMeshStagingBlockPtr& InFlightBlock : InFlight)
+    {
+        Stager.Recycle(MoveTemp(InFlightBlock));
+    }
+    int32 NumPooled = 0;
+    for (const TWeakPtr<FSVFMeshStagingBlock, ESPMode::ThreadSafe>& Block : Released)
+    {
+        NumPooled += Block.IsValid() ? 1 : 0;
+    }
+    SVF_CHECK_EQUAL(NumPooled, FSVFMeshStager::MaxFreeBlocks);
+
+    // Pooled blocks are handed out again before new ones are made
+    TArray<FSVFMeshStagingBlockPtr> Restaged;
+    for (int32 Index = 0; Index < FSVFMeshStager::MaxFreeBlocks; ++Index)
+    {
+        Restaged.Add(StageFrame(Stager, 3 + NumInFlight + Index, false, Mesh));
+        bool bReused = false;
+        for (const TWeakPtr<FSVFMeshStagingBlock, ESPMode::ThreadSafe>& Block : Released)
+        {
+            bReused |= Block.Pin().Get() == Restaged.Last().Get();
+        }
+        SVF_CHECK(bReused);
+    }
+}
+
+SVF_TEST(NewTopologyDropsReadyBuild)
+{
+    FSVFMeshStager Stager(TopologySettings(), 1, ESVFTexCoordFormat::Half);
+    const SVFTestMeshes::FTestMesh Mesh = SVFTestMeshes::MakeGrid(6);
+    const SVFTestMeshes::FTestMesh OtherMesh = Reordered(Mesh);
+
+    FSVFMeshStagingBlockPtr Key = StageFrame(Stager, 1, true, Mesh);
+    const uint32 Generation = Key->TopologyGeneration;
+    SVF_CHECK(!Key->TopologyBuild.IsValid());
+    // The build started on the keyframe is taken up by the next frame of the group
+    FSVFMeshStagingBlockPtr Next = StageFrame(Stager, 2, false, Mesh);
+    SVF_CHECK_EQUAL(Next->TopologyGeneration, Generation);
+    SVF_CHECK(Next->TopologyBuild.IsValid());
+    SVF_CHECK_EQUAL(Next->TopologyBuild->OptimizedIndices.Num(), Mesh.Indices.Num());
+
+    // A keyframe starts a new group even with the same indices
+    FSVFMeshStagingBlockPtr Keyframe = StageFrame(Stager, 3, true, Mesh);
+    SVF_CHECK_EQUAL(Keyframe->TopologyGeneration, Generation + 1);
+    SVF_CHECK(!Keyframe->TopologyBuild.IsValid());
+    SVF_CHECK(StageFrame(Stager, 4, false, Mesh)->TopologyBuild.IsValid());
+
+    // After a skip the indices are compared: unchanged ones keep the build
+    FSVFMeshStagingBlockPtr Skipped = StageFrame(Stager, 10, false, Mesh);
+    SVF_CHECK_EQUAL(Skipped->TopologyGeneration, Generation + 1);
+    SVF_CHECK(Skipped->TopologyBuild.IsValid());
+
+    // ... and other indices of the same count, a keyframe hidden by the skip, drop it
+    FSVFMeshStagingBlockPtr Changed = StageFrame(Stager, 20, false, OtherMesh);
+    SVF_CHECK_EQUAL(Changed->TopologyGeneration, Generation + 2);
+    SVF_CHECK(!Changed->TopologyBuild.IsValid());
+    FSVFMeshStagingBlockPtr AfterChange = StageFrame(Stager, 21, false, OtherMesh);
+    SVF_CHECK(AfterChange->TopologyBuild.IsValid());
+    SVF_CHECK_EQUAL(AfterChange->TopologyBuild->Generation, Generation + 2);
+}
+
+SVF_TEST(StalePendingBuildDiscarded)
+{
+    FSVFMeshStager Stager(TopologySettings(), 1, ESVFTexCoordFormat::Half);
+    const SVFTestMeshes::FTestMesh Mesh = SVFTestMeshes::MakeGrid(6);
+    const SVFTestMeshes::FTestMesh OtherMesh = Reordered(Mesh);
+
+    // Each keyframe starts a build that is still pending when the next keyframe arrives
+    const uint32 FirstGeneration = StageFrame(Stager, 1, true, Mesh)->TopologyGeneration;
+    FSVFMeshStagingBlockPtr Second = StageFrame(Stager, 2, true, OtherMesh);
+    SVF_CHECK_EQUAL(Second->TopologyGeneration, FirstGeneration + 1);
+    SVF_CHECK(!Second->TopologyBuild.IsValid());
+
+    // The first group's build finished, but only the second group's is used
+    FSVFMeshStagingBlockPtr Next = StageFrame(Stager, 3, false, OtherMesh);
+    SVF_CHECK(Next->TopologyBuild.IsValid());
+    SVF_CHECK_EQUAL(Next->TopologyBuild->Generation, FirstGeneration + 1);
+}
+
+SVF_TEST(ResetBetweenClips)
+{
+    FSVFMeshStager Stager(TopologySettings(), 1, ESVFTexCoordFormat::Half);
+    const SVFTestMeshes::FTestMesh Mesh = SVFTestMeshes::MakeGrid(6);
+    StageFrame(Stager, 1, true, Mesh);
+    FSVFMeshStagingBlockPtr Last = StageFrame(Stager, 2, false, Mesh);
+    SVF_CHECK(Last->TopologyBuild.IsValid());
+
+    // The next clip's first frame could continue the frame ids and share the indices, it still starts over
+    Stager.Reset();
+    FSVFMeshStagingBlockPtr First = StageFrame(Stager, 3, false, Mesh);
+    SVF_CHECK_EQUAL(First->TopologyGeneration, Last->TopologyGeneration + 1);
+    SVF_CHECK(!First->TopologyBuild.IsValid());
+    SVF_CHECK(StageFrame(Stager, 4, false, Mesh)->TopologyBuild.IsValid());
+}
+
+SVF_TEST(StreamSizes)
+{
+    const SVFTestMeshes::FTestMesh Mesh = SVFTestMeshes::MakeGrid(5);
+    const int32 NumVertices = Mesh.Positions.Num();
+    for (const bool bHalfPositions : { false, true })
+    {
+        for (const ESVFTexCoordFormat Format : { ESVFTexCoordFormat::Float, ESVFTexCoordFormat::Half, ESVFTexCoordFormat::UNorm16 })
+        {
+            for (const uint32 NumTexCoords : { 1u, 2u })
+            {
+                for (const bool bNormals : { false, true })
+                {
+                    FSVFMeshRenderSettings Settings;
+                    Settings.bHalfPrecisionPositions = bHalfPositions;
+                    FSVFMeshStager Stager(Settings, NumTexCoords, Format);
+                    FTestFrameData Frame(1, true, Mesh);
+                    Frame.bNormals = bNormals;
+                    FSVFMeshStagingBlockPtr Block = Stager.Stage(Frame, Stager.NextSequence());
+                    SVF_CHECK(Block.IsValid());
+                    SVF_CHECK_EQUAL(Block->Positions.Num(), NumVertices);
+                    SVF_CHECK_EQUAL(Block->HalfPositions.Num(), bHalfPositions ? NumVertices : 0);
+                    SVF_CHECK_EQUAL(Block->Tangents.Num(), bNormals ? 2 * NumVertices : 0);
+                    SVF_CHECK_EQUAL(Block->TexCoords.Num(), static_cast<int32>(NumTexCoords * NumVertices * FSVFTexCoordPacker::GetStride(Format)));
+                    SVF_CHECK_EQUAL(Block->Indices.Num(), Mesh.Indices.Num());
+                    if (bHalfPositions)
+                    {
+                        SVF_CHECK(Block->HalfPositions.Last().ToFVector().Equals(Mesh.Positions.Last(), 0.1f));
+                    }
+                }
+            }
+        }
+    }
+
+    // Generated normals fill the whole basis
+    FSVFMeshRenderSettings Settings;
+    Settings.bGenerateNormals = true;
+    FSVFMeshStager Stager(Settings, 1, ESVFTexCoordFormat::Half);
+    FTestFrameData Frame(1, true, Mesh);
+    FSVFMeshStagingBlockPtr Block = Stager.Stage(Frame, Stager.NextSequence());
+    SVF_CHECK_EQUAL(Block->Tangents.Num(), 2 * NumVertices);
+    SVF_CHECK(Block->Tangents[1].ToFVector().Equals(FVector(0, 0, 1), 0.01f) || Block->Tangents[1].ToFVector().Equals(FVector(0, 0, -1), 0.01f));
+}
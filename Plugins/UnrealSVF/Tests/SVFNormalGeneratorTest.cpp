@@ -0,0 +1,189 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFTestMeshes.h"
+#include "SVFNormalGenerator.h"
+
+using namespace SVFTestMeshes;
+
+namespace SVFNormalGeneratorTest
+{
+    // The test meshes are counter clockwise seen from the front; the engine wants clockwise
+    FTestMesh ToEngineWinding(FTestMesh Mesh)
+    {
+        for (int32 Index = 0; Index + 2 < Mesh.Indices.Num(); Index += 3)
+        {
+            Swap(Mesh.Indices[Index + 1], Mesh.Indices[Index + 2]);
+        }
+        return Mesh;
+    }
+
+    TArray<FVector> Compute(FSVFNormalGenerator& Generator, const TArray<FVector>& Positions)
+    {
+        TArray<FVector> Normals;
+        Normals.Init(FVector::ZeroVector, Positions.Num());
+        Generator.Compute([&Positions](int32 Vertex) { return Positions[Vertex]; },
+            [&Normals](int32 Vertex, const FVector& Normal) { Normals[Vertex] = Normal; });
+        return Normals;
+    }
+
+    // One vertex at a time, summing the faces of every triangle that touches it
+    TArray<FVector> ComputeSerial(const FTestMesh& Mesh)
+    {
+        TArray<FVector> Sums;
+        Sums.Init(FVector::ZeroVector, Mesh.Positions.Num());
+        for (int32 Index = 0; Index + 2 < Mesh.Indices.Num(); Index += 3)
+        {
+            const FVector& A = Mesh.Positions[Mesh.Indices[Index + 0]];
+            const FVector& B = Mesh.Positions[Mesh.Indices[Index + 1]];
+            const FVector& C = Mesh.Positions[Mesh.Indices[Index + 2]];
+            const FVector Face = (C - A) ^ (B - A);
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                Sums[Mesh.Indices[Index + Corner]] += Face;
+            }
+        }
+        for (FVector& Sum : Sums)
+        {
+            Sum = Sum.GetSafeNormal();
+        }
+        return Sums;
+    }
+
+    FTestMesh Displace(const FTestMesh& Mesh, float Phase)
+    {
+        FTestMesh Moved = Mesh;
+        for (FVector& Position : Moved.Positions)
+        {
+            Position += FVector(FMath::Sin(Position.Z * 0.2f + Phase), FMath::Cos(Position.X * 0.2f), FMath::Sin(Position.Y * 0.1f + Phase)) * 3.f;
+        }
+        return Moved;
+    }
+}
+
+using namespace SVFNormalGeneratorTest;
+
+SVF_TEST(MatchesSerialReferenceAcrossBatches)
+{
+    // More vertices and triangles than one batch, so both passes split the work
+    const FTestMesh Mesh = ToEngineWinding(Displace(MakeSphere(64, 160), 0.f));
+    SVF_CHECK(Mesh.Positions.Num() > 2 * FSVFNormalGenerator::BatchSize);
+
+    FSVFNormalGenerator Generator;
+    Generator.SetTopology(Mesh.Indices, Mesh.Positions.Num());
+    SVF_CHECK(Generator.HasTopology(Mesh.Positions.Num(), Mesh.Indices.Num()));
+    const TArray<FVector> Normals = Compute(Generator, Mesh.Positions);
+    const TArray<FVector> Expected = ComputeSerial(Mesh);
+    int32 Mismatches = 0;
+    for (int32 Vertex = 0; Vertex < Mesh.Positions.Num(); ++Vertex)
+    {
+        Mismatches += FVector::Dist(Normals[Vertex], Expected[Vertex]) < 1e-4f ? 0 : 1;
+    }
+    SVF_CHECK_EQUAL(Mismatches, 0);
+}
+
+SVF_TEST(NormalsFaceOutOfEngineWoundSurfaces)
+{
+    const FTestMesh Sphere = ToEngineWinding(MakeSphere(24, 32));
+    FSVFNormalGenerator Generator;
+    Generator.SetTopology(Sphere.Indices, Sphere.Positions.Num());
+    const TArray<FVector> Normals = Compute(Generator, Sphere.Positions);
+    // The pole vertices see only one triangle each, the rest are smoothed over their whole fan
+    for (int32 Vertex = 32; Vertex < Sphere.Positions.Num() - 32; ++Vertex)
+    {
+        SVF_CHECK((Normals[Vertex] | Sphere.Positions[Vertex].GetSafeNormal()) > 0.99f);
+        SVF_CHECK_NEAR(Normals[Vertex].Size(), 1.f, 1e-4f);
+    }
+
+    const FTestMesh Grid = ToEngineWinding(MakeGrid(6));
+    Generator.SetTopology(Grid.Indices, Grid.Positions.Num());
+    for (const FVector& Normal : Compute(Generator, Grid.Positions))
+    {
+        SVF_CHECK(FVector::Dist(Normal, FVector(0.f, 0.f, 1.f)) < 1e-6f);
+    }
+}
+
+SVF_TEST(WeightedByArea)
+{
+    // A fold along the X axis: a flat triangle four times the area of a wall triangle
+    FTestMesh Fold;
+    Fold.Positions.Append({ FVector(0.f, 0.f, 0.f), FVector(4.f, 0.f, 0.f), FVector(0.f, -4.f, 0.f), FVector(0.f, 0.f, 1.f) });
+    // Engine winding: the floor faces +Z, the wall -Y, away from the floor
+    Fold.Indices.Append({ 0, 1, 2, 0, 3, 1 });
+    FSVFNormalGenerator Generator;
+    Generator.SetTopology(Fold.Indices, Fold.Positions.Num());
+    const TArray<FVector> Normals = Compute(Generator, Fold.Positions);
+    SVF_CHECK(FVector::Dist(Normals[0], FVector(0.f, -4.f, 16.f).GetSafeNormal()) < 1e-5f);
+    SVF_CHECK(FVector::Dist(Normals[2], FVector(0.f, 0.f, 1.f)) < 1e-5f);
+    SVF_CHECK(FVector::Dist(Normals[3], FVector(0.f, -1.f, 0.f)) < 1e-5f);
+}
+
+SVF_TEST(TopologyIsReusedAcrossFrames)
+{
+    const FTestMesh Rest = ToEngineWinding(MakeSphere(20, 28));
+    FSVFNormalGenerator Generator;
+    Generator.SetTopology(Rest.Indices, Rest.Positions.Num());
+    for (int32 Frame = 1; Frame <= 3; ++Frame)
+    {
+        const FTestMesh Moved = Displace(Rest, Frame * 0.7f);
+        const TArray<FVector> Normals = Compute(Generator, Moved.Positions);
+        const TArray<FVector> Expected = ComputeSerial(Moved);
+        for (int32 Vertex = 0; Vertex < Moved.Positions.Num(); ++Vertex)
+        {
+            SVF_CHECK(FVector::Dist(Normals[Vertex], Expected[Vertex]) < 1e-4f);
+        }
+    }
+    // A new keyframe with another vertex or index count needs a new table
+    SVF_CHECK(!Generator.HasTopology(Rest.Positions.Num() + 1, Rest.Indices.Num()));
+    SVF_CHECK(!Generator.HasTopology(Rest.Positions.Num(), Rest.Indices.Num() - 3));
+    Generator.Reset();
+    SVF_CHECK(!Generator.HasTopology(Rest.Positions.Num(), Rest.Indices.Num()));
+    // Nothing to compute without a topology
+    int32 Calls = 0;
+    Generator.Compute([&Rest](int32 Vertex) { return Rest.Positions[Vertex]; }, [&Calls](int32, const FVector&) { ++Calls; });
+    SVF_CHECK_EQUAL(Calls, 0);
+}
+
+SVF_TEST(LooseAndDegenerateVerticesFaceUp)
+{
+    FTestMesh Mesh;
+    Mesh.Positions.Append({ FVector(0.f, 0.f, 0.f), FVector(1.f, 0.f, 0.f), FVector(2.f, 0.f, 0.f), FVector(5.f, 5.f, 5.f),
+        FVector(0.f, 1.f, 0.f) });
+    // A triangle collapsed onto a line, one with an out of range index, a trailing partial triangle;
+    // vertex 3 is used by none and vertex 4 only by the invalid one
+    Mesh.Indices.Append({ 0, 1, 2, 0, 4, 99, 0, 1 });
+    FSVFNormalGenerator Generator;
+    Generator.SetTopology(Mesh.Indices, Mesh.Positions.Num());
+    SVF_CHECK(Generator.HasTopology(Mesh.Positions.Num(), Mesh.Indices.Num()));
+    for (const FVector& Normal : Compute(Generator, Mesh.Positions))
+    {
+        SVF_CHECK(Normal == FVector::UpVector);
+    }
+}
+
+SVF_TEST(TopologyAndComputeThroughput)
+{
+    // A capture sized frame: the table is built once per keyframe group, the normals every frame
+    const FTestMesh Mesh = ToEngineWinding(Displace(MakeSphere(128, 256), 0.f));
+    const int32 NumTriangles = Mesh.Indices.Num() / 3;
+    FSVFNormalGenerator Generator;
+    const double TopologySeconds = SVFTest::TimeBest(5, [&Generator, &Mesh]()
+    {
+        Generator.SetTopology(Mesh.Indices, Mesh.Positions.Num());
+    });
+
+    TArray<FVector> Normals;
+    Normals.Init(FVector::ZeroVector, Mesh.Positions.Num());
+    const double ComputeSeconds = SVFTest::TimeBest(5, [&Generator, &Mesh, &Normals]()
+    {
+        Generator.Compute([&Mesh](int32 Vertex) -> const FVector& { return Mesh.Positions[Vertex]; },
+            [&Normals](int32 Vertex, const FVector& Normal) { Normals[Vertex] = Normal; });
+    });
+    const double SerialSeconds = SVFTest::TimeBest(5, [&Mesh]()
+    {
+        ComputeSerial(Mesh);
+    });
+    SVF_CHECK(FVector::Dist(Normals[Mesh.Positions.Num() / 2], ComputeSerial(Mesh)[Mesh.Positions.Num() / 2]) < 1e-4f);
+    std::printf("Normals: %d triangles, SetTopology %.2f ms, Compute %.2f ms (%.1f Mtriangles/s), serial reference %.2f ms\n",
+        NumTriangles, TopologySeconds * 1e3, ComputeSeconds * 1e3, NumTriangles / ComputeSeconds * 1e-6, SerialSeconds * 1e3);
+}
@@ -0,0 +1,100 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFNormalPacking.h"
+#include "PackedNormal.h"
+
+namespace SVFNormalPackingTest
+{
+    // What the stager wrote before: the flipped normal in Unreal's axes through FPackedNormal, W forced to 127
+    uint32 PackReference(float NX, float NY, float NZ)
+    {
+        FPackedNormal Packed(FVector(-NZ, -NX, -NY));
+        Packed.Vector.W = 127;
+        return Packed.Vector.Packed;
+    }
+
+    // Packs one normal the way the stager reads it, with u following the normal
+    uint32 Pack(float NX, float NY, float NZ, float U = 0.25f)
+    {
+        const float NormalAndU[4] = { NX, NY, NZ, U };
+        return SVFNormalPacking::PackSVFNormal(NormalAndU);
+    }
+
+    // Every component value gets checked in every lane, with the other lanes on simple values
+    int32 CountMismatches(float Value)
+    {
+        int32 Mismatches = 0;
+        Mismatches += Pack(Value, 0.f, 0.f) == PackReference(Value, 0.f, 0.f) ? 0 : 1;
+        Mismatches += Pack(0.5f, Value, 0.f) == PackReference(0.5f, Value, 0.f) ? 0 : 1;
+        Mismatches += Pack(0.f, -0.5f, Value) == PackReference(0.f, -0.5f, Value) ? 0 : 1;
+        return Mismatches;
+    }
+}
+
+using namespace SVFNormalPackingTest;
+
+SVF_TEST(AxesAndSign)
+{
+    // SVF +X is Unreal's +Y, SVF +Y is Unreal's +Z and SVF +Z is Unreal's +X, all flipped
+    SVF_CHECK_EQUAL(Pack(0.f, 0.f, 1.f), FPackedNormal(-127, 0, 0, 127).Vector.Packed);
+    SVF_CHECK_EQUAL(Pack(1.f, 0.f, 0.f), FPackedNormal(0, -127, 0, 127).Vector.Packed);
+    SVF_CHECK_EQUAL(Pack(0.f, 1.f, 0.f), FPackedNormal(0, 0, -127, 127).Vector.Packed);
+    SVF_CHECK_EQUAL(Pack(0.f, -1.f, 0.f), FPackedNormal(0, 0, 127, 127).Vector.Packed);
+    // u never leaks into W
+    SVF_CHECK_EQUAL(Pack(0.f, -1.f, 0.f, 1000.f), Pack(0.f, -1.f, 0.f, -3.f));
+    SVF_CHECK_EQUAL(Pack(0.f, -1.f, 0.f, 1000.f) >> 24, 127u);
+}
+
+SVF_TEST(BitExactWithPackedNormal)
+{
+    // Evenly over the normal range and past it, where the result saturates
+    int32 Mismatches = 0;
+    const int32 NumSteps = 1 << 20;
+    for (int32 Step = 0; Step <= NumSteps; ++Step)
+    {
+        Mismatches += CountMismatches(-1.25f + 2.5f * Step / NumSteps);
+    }
+
+    // Every float within 64 ulps of each rounding boundary, where an exact half falls, and of zero
+    for (int32 Boundary = -128; Boundary <= 128; ++Boundary)
+    {
+        const float Edge = (Boundary + 0.5f) / 127.f;
+        float Below = Edge;
+        float Above = Edge;
+        for (int32 Ulp = 0; Ulp < 64; ++Ulp)
+        {
+            Below = std::nextafter(Below, -2.f);
+            Above = std::nextafter(Above, 2.f);
+            Mismatches += CountMismatches(Below) + CountMismatches(Above);
+        }
+        Mismatches += CountMismatches(Edge);
+    }
+    float Tiny = 0.f;
+    for (int32 Ulp = 0; Ulp < 64; ++Ulp)
+    {
+        Tiny = std::nextafter(Tiny, 1.f);
+        Mismatches += CountMismatches(Tiny) + CountMismatches(-Tiny);
+    }
+    SVF_CHECK_EQUAL(Mismatches, 0);
+}
+
+SVF_TEST(ScalarFallbackMatches)
+{
+    // The path builds without SSE take, and it agrees with the SSE one
+    uint32 Seed = 3;
+    int32 Mismatches = 0;
+    for (int32 Sample = 0; Sample < 200000; ++Sample)
+    {
+        float Components[3];
+        for (float& Component : Components)
+        {
+            Seed = Seed * 1664525u + 1013904223u;
+            Component = ((Seed >> 8) / static_cast<float>(1u << 24) * 2.f - 1.f) * 1.1f;
+        }
+        const uint32 Expected = PackReference(Components[0], Components[1], Components[2]);
+        Mismatches += SVFNormalPacking::PackSVFNormalScalar(Components[0], Components[1], Components[2]) == Expected ? 0 : 1;
+        Mismatches += Pack(Components[0], Components[1], Components[2]) == Expected ? 0 : 1;
+    }
+    SVF_CHECK_EQUAL(Mismatches, 0);
+}
@@ -0,0 +1,88 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFPlayRatePolicy.h"
+
+namespace SVFPlayRatePolicyTest
+{
+    FSVFBufferingTargets MakeBase()
+    {
+        FSVFBufferingTargets Base;
+        Base.MinBufferFrames = 4;
+        Base.MaxBufferFrames = 10;
+        Base.BufferHysteresisFrames = 3;
+        Base.MaxDropFramesPerCall = 2;
+        Base.DownloadBufferSeconds = 5;
+        return Base;
+    }
+}
+
+using namespace SVFPlayRatePolicyTest;
+
+SVF_TEST(TargetsScaleWithFastRates)
+{
+    FSVFPlayRateBufferPolicy Policy;
+    Policy.SetBaseTargets(MakeBase(), 64);
+
+    // Slow and normal rates keep the base buffering
+    SVF_CHECK(Policy.GetTargetsForRate(1.f) == MakeBase());
+    SVF_CHECK(Policy.GetTargetsForRate(0.25f) == MakeBase());
+    SVF_CHECK(Policy.GetTargetsForRate(0.f) == MakeBase());
+
+    // 1.7x rounds up to the 2x step
+    const FSVFBufferingTargets Fast = Policy.GetTargetsForRate(1.7f);
+    SVF_CHECK_EQUAL(Fast.MinBufferFrames, 8u);
+    SVF_CHECK_EQUAL(Fast.MaxBufferFrames, 20u);
+    SVF_CHECK_EQUAL(Fast.BufferHysteresisFrames, 6u);
+    SVF_CHECK_EQUAL(Fast.MaxDropFramesPerCall, 4u);
+    SVF_CHECK_EQUAL(Fast.DownloadBufferSeconds, 10);
+
+    // Reverse playback drains the buffers just as fast
+    SVF_CHECK(Policy.GetTargetsForRate(-1.7f) == Fast);
+}
+
+SVF_TEST(FrameCountsStayWithinUpperBound)
+{
+    FSVFPlayRateBufferPolicy Policy;
+    Policy.SetBaseTargets(MakeBase(), 16);
+    const FSVFBufferingTargets Targets = Policy.GetTargetsForRate(8.f);
+    SVF_CHECK_EQUAL(Targets.MinBufferFrames, 16u);
+    SVF_CHECK_EQUAL(Targets.MaxBufferFrames, 16u);
+    SVF_CHECK(Targets.BufferHysteresisFrames <= Targets.MaxBufferFrames);
+    SVF_CHECK(Targets.MinBufferFrames <= Targets.MaxBufferFrames);
+
+    // The bound never cuts below the base maximum
+    Policy.SetBaseTargets(MakeBase(), 2);
+    SVF_CHECK_EQUAL(Policy.GetTargetsForRate(1.f).MaxBufferFrames, 10u);
+}
+
+SVF_TEST(RampRetargetsOncePerStep)
+{
+    FSVFPlayRateBufferPolicy Policy;
+    Policy.SetBaseTargets(MakeBase(), 1000);
+
+    // Ramping 1x to 3x in 0.01 steps reconfigures the reader once initially and once per 0.5 step
+    FSVFBufferingTargets Targets;
+    int32 Retargets = 0;
+    for (int32 Step = 100; Step <= 300; ++Step)
+    {
+        Retargets += Policy.UpdateRate(Step * 0.01f, Targets) ? 1 : 0;
+    }
+    SVF_CHECK_EQUAL(Retargets, 5);
+    SVF_CHECK(Targets == Policy.GetTargetsForRate(3.f));
+
+    // Wobbling around a step boundary doesn't flip the reader back and forth
+    Retargets = 0;
+    for (int32 Wobble = 0; Wobble < 100; ++Wobble)
+    {
+        Retargets += Policy.UpdateRate((Wobble & 1) ? 2.45f : 2.55f, Targets) ? 1 : 0;
+    }
+    SVF_CHECK_EQUAL(Retargets, 0);
+
+    // Dropping clearly below shrinks again
+    SVF_CHECK(Policy.UpdateRate(1.f, Targets));
+    SVF_CHECK(Targets == MakeBase());
+
+    Policy.Reset();
+    SVF_CHECK(Policy.UpdateRate(1.f, Targets));
+}
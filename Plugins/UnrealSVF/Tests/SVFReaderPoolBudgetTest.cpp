@@ -0,0 +1,101 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFReaderPoolBudget.h"
+
+SVF_TEST(NothingEvictedWithinBudget)
+{
+    FSVFReaderPoolBudget Budget;
+    Budget.SetBudget(100);
+    Budget.Add(1, 40, false);
+    Budget.Add(2, 40, false);
+    SVF_CHECK_EQUAL(Budget.GetUsedBytes(), 80u);
+
+    TArray<uint32> Evictions;
+    Budget.CollectEvictions(20, Evictions);
+    SVF_CHECK_EQUAL(Evictions.Num(), 0);
+}
+
+SVF_TEST(EvictsLeastRecentlyUsedFirst)
+{
+    FSVFReaderPoolBudget Budget;
+    Budget.SetBudget(100);
+    Budget.Add(1, 40, false);
+    Budget.Add(2, 40, false);
+    Budget.Add(3, 20, false);
+    Budget.Touch(1);
+
+    TArray<uint32> Evictions;
+    Budget.CollectEvictions(30, Evictions);
+    SVF_CHECK_EQUAL(Evictions.Num(), 1);
+    SVF_CHECK_EQUAL(Evictions[0], 2u);
+
+    // Enough for a second eviction: the next oldest is 3, then the touched 1
+    Budget.CollectEvictions(50, Evictions);
+    SVF_CHECK_EQUAL(Evictions.Num(), 2);
+    SVF_CHECK_EQUAL(Evictions[0], 2u);
+    SVF_CHECK_EQUAL(Evictions[1], 3u);
+}
+
+SVF_TEST(DeclaredCuesGoLast)
+{
+    FSVFReaderPoolBudget Budget;
+    Budget.SetBudget(100);
+    Budget.Add(1, 50, true);
+    Budget.Add(2, 30, false);
+    Budget.Add(3, 20, false);
+
+    TArray<uint32> Evictions;
+    Budget.CollectEvictions(40, Evictions);
+    SVF_CHECK_EQUAL(Evictions.Num(), 2);
+    SVF_CHECK_EQUAL(Evictions[0], 2u);
+    SVF_CHECK_EQUAL(Evictions[1], 3u);
+
+    Budget.CollectEvictions(90, Evictions);
+    SVF_CHECK_EQUAL(Evictions.Num(), 3);
+    SVF_CHECK_EQUAL(Evictions.Last(), 1u);
+}
+
+SVF_TEST(PendingOpensAreResizedAndRemoved)
+{
+    // A prewarmed reader is admitted with no size and sized once its file info is known
+    FSVFReaderPoolBudget Budget;
+    Budget.SetBudget(100);
+    Budget.Add(7, 0, true);
+    SVF_CHECK(Budget.Contains(7));
+    SVF_CHECK_EQUAL(Budget.GetUsedBytes(), 0u);
+    Budget.SetBytes(7, 60);
+    SVF_CHECK_EQUAL(Budget.GetUsedBytes(), 60u);
+
+    // Re-adding replaces the entry instead of counting it twice
+    Budget.Add(7, 70, true);
+    SVF_CHECK_EQUAL(Budget.GetUsedBytes(), 70u);
+    SVF_CHECK_EQUAL(Budget.Num(), 1);
+
+    Budget.Remove(7);
+    Budget.Remove(7);
+    SVF_CHECK_EQUAL(Budget.GetUsedBytes(), 0u);
+    SVF_CHECK(!Budget.Contains(7));
+}
+
+SVF_TEST(ZeroBudgetPoolsNothing)
+{
+    FSVFReaderPoolBudget Budget;
+    SVF_CHECK_EQUAL(Budget.GetBudget(), 0u);
+    SVF_CHECK(!Budget.CanFit(1));
+
+    Budget.SetBudget(100);
+    SVF_CHECK(Budget.CanFit(100));
+    SVF_CHECK(!Budget.CanFit(101));
+}
+
+SVF_TEST(EstimateCountsEveryBufferedFrame)
+{
+    // 1024x1024 RGBA, 10000 vertices of 5 floats, 30000 indices
+    const uint64 Frame = 1024ull * 1024 * 4 + 10000ull * 20 + 30000ull * 4;
+    SVF_CHECK_EQUAL(FSVFReaderPoolBudget::EstimateReaderBytes(1024, 1024, 10000, 30000, 1, false), Frame);
+    SVF_CHECK_EQUAL(FSVFReaderPoolBudget::EstimateReaderBytes(1024, 1024, 10000, 30000, 8, false), Frame * 8);
+    SVF_CHECK_EQUAL(FSVFReaderPoolBudget::EstimateReaderBytes(1024, 1024, 10000, 30000, 0, false), Frame);
+    SVF_CHECK_EQUAL(FSVFReaderPoolBudget::EstimateReaderBytes(1024, 1024, 10000, 30000, 1, true), Frame + 10000ull * 12);
+    SVF_CHECK_EQUAL(FSVFReaderPoolBudget::EstimateReaderBytes(-1, 1024, -5, 0, 1, false), 0u);
+}
@@ -0,0 +1,84 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFSharedStreamRegistry.h"
+
+SVF_TEST(FirstMemberLeads)
+{
+    TSVFSharedStreamRegistry<int32> Registry;
+    SVF_CHECK(Registry.Join(TEXT("a.svf"), 1));
+    SVF_CHECK(!Registry.Join(TEXT("a.svf"), 2));
+    SVF_CHECK(!Registry.Join(TEXT("a.svf"), 3));
+    // Joining twice doesn't count twice
+    SVF_CHECK(!Registry.Join(TEXT("a.svf"), 2));
+    SVF_CHECK_EQUAL(Registry.Num(TEXT("a.svf")), 3);
+    SVF_CHECK(Registry.IsLeader(TEXT("a.svf"), 1));
+
+    // Streams are keyed independently
+    SVF_CHECK(Registry.Join(TEXT("b.svf"), 2));
+    SVF_CHECK_EQUAL(Registry.GetLeader(TEXT("b.svf")), 2);
+}
+
+SVF_TEST(OldestMemberTakesOver)
+{
+    TSVFSharedStreamRegistry<int32> Registry;
+    Registry.Join(TEXT("a.svf"), 1);
+    Registry.Join(TEXT("a.svf"), 2);
+    Registry.Join(TEXT("a.svf"), 3);
+
+    int32 Leader = INDEX_NONE;
+    // A follower leaving keeps the leader
+    SVF_CHECK_EQUAL(Registry.Leave(TEXT("a.svf"), 2, Leader), 2);
+    SVF_CHECK_EQUAL(Leader, 1);
+
+    SVF_CHECK_EQUAL(Registry.Leave(TEXT("a.svf"), 1, Leader), 1);
+    SVF_CHECK_EQUAL(Leader, 3);
+    SVF_CHECK(Registry.IsLeader(TEXT("a.svf"), 3));
+
+    SVF_CHECK_EQUAL(Registry.Leave(TEXT("a.svf"), 3, Leader), 0);
+    SVF_CHECK_EQUAL(Leader, 0);
+    SVF_CHECK_EQUAL(Registry.Num(TEXT("a.svf")), 0);
+
+    // The stream is gone, the next member to join starts a new one
+    SVF_CHECK(Registry.Join(TEXT("a.svf"), 2));
+}
+
+SVF_TEST(LeavingUnknownStreamIsHarmless)
+{
+    TSVFSharedStreamRegistry<int32> Registry;
+    int32 Leader = 7;
+    SVF_CHECK_EQUAL(Registry.Leave(TEXT("missing.svf"), 1, Leader), 0);
+    SVF_CHECK_EQUAL(Leader, 0);
+
+    Registry.Join(TEXT("a.svf"), 1);
+    SVF_CHECK_EQUAL(Registry.Leave(TEXT("a.svf"), 5, Leader), 1);
+    SVF_CHECK_EQUAL(Leader, 1);
+}
+
+SVF_TEST(ConcurrentJoinAndLeaveKeepsCount)
+{
+    TSVFSharedStreamRegistry<int32> Registry;
+    TArray<std::thread> Threads;
+    for (int32 Thread = 0; Thread < 4; ++Thread)
+    {
+        Threads.Add(std::thread([&Registry, Thread]()
+        {
+            for (int32 Round = 0; Round < 2000; ++Round)
+            {
+                const int32 Member = 1 + Thread * 10000 + Round;
+                int32 Leader = 0;
+                Registry.Join(TEXT("a.svf"), Member);
+                if (Round % 2 == 1)
+                {
+                    Registry.Leave(TEXT("a.svf"), Member, Leader);
+                    Registry.Leave(TEXT("a.svf"), Member - 1, Leader);
+                }
+            }
+        }));
+    }
+    for (std::thread& Thread : Threads)
+    {
+        Thread.join();
+    }
+    SVF_CHECK_EQUAL(Registry.Num(TEXT("a.svf")), 0);
+}
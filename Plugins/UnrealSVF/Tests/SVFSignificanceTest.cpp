@@ -0,0 +1,101 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFSignificance.h"
+
+SVF_TEST(ScreenSizeMatchesViewWidth)
+{
+    // 90 degree FOV: at distance D the view is 2D wide, a sphere of radius r covers 2r of it
+    SVF_CHECK_NEAR(FSVFSignificance::ComputeScreenSize(1.f, 10.f, HALF_PI / 2.f), 0.1f, 1e-5);
+    SVF_CHECK_NEAR(FSVFSignificance::ComputeScreenSize(1.f, 20.f, HALF_PI / 2.f), 0.05f, 1e-5);
+    // Inside or right up to the bounds fills the view
+    SVF_CHECK_EQUAL(FSVFSignificance::ComputeScreenSize(1.f, 0.5f, HALF_PI / 2.f), 1.f);
+    SVF_CHECK_EQUAL(FSVFSignificance::ComputeScreenSize(1.f, 1.01f, 0.01f), 1.f);
+}
+
+SVF_TEST(TiersFollowThresholds)
+{
+    const FSVFSignificanceSettings Settings;
+    SVF_CHECK(FSVFSignificance::SelectTier(0.2f, ESVFUpdateTier::Quarter, Settings) == ESVFUpdateTier::Full);
+    SVF_CHECK(FSVFSignificance::SelectTier(0.1f, ESVFUpdateTier::Quarter, Settings) == ESVFUpdateTier::Half);
+    SVF_CHECK(FSVFSignificance::SelectTier(0.01f, ESVFUpdateTier::Full, Settings) == ESVFUpdateTier::Quarter);
+}
+
+SVF_TEST(TierHysteresisPreventsToggling)
+{
+    const FSVFSignificanceSettings Settings;
+    // Hovering just below the full rate threshold keeps the full rate
+    ESVFUpdateTier Tier = ESVFUpdateTier::Full;
+    int32 Changes = 0;
+    for (int32 Frame = 0; Frame < 100; ++Frame)
+    {
+        const float ScreenSize = Settings.FullRateScreenSize * ((Frame & 1) ? 1.02f : 0.9f);
+        const ESVFUpdateTier NewTier = FSVFSignificance::SelectTier(ScreenSize, Tier, Settings);
+        Changes += NewTier != Tier ? 1 : 0;
+        Tier = NewTier;
+    }
+    SVF_CHECK_EQUAL(Changes, 0);
+    SVF_CHECK(Tier == ESVFUpdateTier::Full);
+
+    // Clearly below it does drop
+    SVF_CHECK(FSVFSignificance::SelectTier(Settings.FullRateScreenSize * 0.7f, ESVFUpdateTier::Full, Settings) == ESVFUpdateTier::Half);
+}
+
+SVF_TEST(UpdateRatesScaleWithContentRate)
+{
+    const FSVFSignificanceSettings Settings;
+    FSVFUpdateRate Rate = FSVFSignificance::GetUpdateRate(ESVFUpdateTier::Full, 30.f, Settings);
+    SVF_CHECK_EQUAL(Rate.MeshInterval, 1);
+    SVF_CHECK_EQUAL(Rate.TextureInterval, 1);
+
+    Rate = FSVFSignificance::GetUpdateRate(ESVFUpdateTier::Half, 30.f, Settings);
+    SVF_CHECK_EQUAL(Rate.MeshInterval, 2);
+    SVF_CHECK_EQUAL(Rate.TextureInterval, 4);
+
+    Rate = FSVFSignificance::GetUpdateRate(ESVFUpdateTier::Quarter, 30.f, Settings);
+    SVF_CHECK_EQUAL(Rate.MeshInterval, 4);
+
+    // Content already slower than the tier isn't throttled further
+    Rate = FSVFSignificance::GetUpdateRate(ESVFUpdateTier::Half, 10.f, Settings);
+    SVF_CHECK_EQUAL(Rate.MeshInterval, 1);
+}
+
+SVF_TEST(ThrottleNeverShowsTextureWithoutMesh)
+{
+    FSVFUpdateRate Rate;
+    Rate.MeshInterval = 2;
+    Rate.TextureInterval = 4;
+
+    FSVFUpdateThrottle Throttle;
+    int32 MeshUpdates = 0;
+    int32 TextureUpdates = 0;
+    for (int32 Frame = 0; Frame < 40; ++Frame)
+    {
+        const FSVFUpdateDecision Decision = Throttle.OnNewFrame(Frame, false, Rate);
+        SVF_CHECK(!Decision.bUpdateTexture || Decision.bUpdateMesh);
+        MeshUpdates += Decision.bUpdateMesh ? 1 : 0;
+        TextureUpdates += Decision.bUpdateTexture ? 1 : 0;
+    }
+    SVF_CHECK_EQUAL(MeshUpdates, 20);
+    SVF_CHECK_EQUAL(TextureUpdates, 10);
+}
+
+SVF_TEST(ThrottleRefreshesTextureAfterKeyFrame)
+{
+    FSVFUpdateRate Rate;
+    Rate.MeshInterval = 2;
+    Rate.TextureInterval = 8;
+
+    FSVFUpdateThrottle Throttle;
+    SVF_CHECK(Throttle.OnNewFrame(0, true, Rate).bUpdateTexture);
+    SVF_CHECK(!Throttle.OnNewFrame(1, false, Rate).bUpdateMesh);
+    SVF_CHECK(!Throttle.OnNewFrame(2, false, Rate).bUpdateTexture);
+    // A keyframe on a skipped frame forces the texture with the next mesh update
+    SVF_CHECK(!Throttle.OnNewFrame(3, true, Rate).bUpdateMesh);
+    const FSVFUpdateDecision Decision = Throttle.OnNewFrame(4, false, Rate);
+    SVF_CHECK(Decision.bUpdateMesh && Decision.bUpdateTexture && Decision.bNewKeyFrameGroup);
+
+    // Looping back refreshes everything
+    const FSVFUpdateDecision Loop = Throttle.OnNewFrame(0, false, Rate);
+    SVF_CHECK(Loop.bUpdateMesh && Loop.bUpdateTexture);
+}
@@ -0,0 +1,227 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFTestMeshes.h"
+#include "SVFSurfaceSampler.h"
+
+using namespace SVFTestMeshes;
+
+namespace SVFSurfaceSamplerTest
+{
+    TSharedPtr<FSVFFrameSnapshot, ESPMode::ThreadSafe> MakeSnapshot(const FTestMesh& Mesh)
+    {
+        TSharedPtr<FSVFFrameSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FSVFFrameSnapshot, ESPMode::ThreadSafe>();
+        Snapshot->FrameId = 3;
+        Snapshot->Positions = Mesh.Positions;
+        Snapshot->Indices = Mesh.Indices;
+        return Snapshot;
+    }
+
+    // A fan of right triangles with legs 1 and 1 + Triangle, so areas grow linearly along the fan
+    FTestMesh MakeRamp(int32 NumTriangles)
+    {
+        FTestMesh Mesh;
+        for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+        {
+            const FVector Origin(Triangle * 100.f, 0.f, 0.f);
+            const int32 First = Mesh.Positions.Num();
+            Mesh.Positions.Append({ Origin, Origin + FVector(1.f, 0.f, 0.f), Origin + FVector(0.f, 1.f + Triangle, 0.f) });
+            Mesh.Indices.Append({ First, First + 1, First + 2 });
+        }
+        return Mesh;
+    }
+}
+
+using namespace SVFSurfaceSamplerTest;
+
+SVF_TEST(TrianglesDrawnInProportionToArea)
+{
+    const int32 NumTriangles = 40;
+    FSVFSurfaceSampler Sampler;
+    Sampler.Build(MakeSnapshot(MakeRamp(NumTriangles)));
+    SVF_CHECK(!Sampler.IsEmpty());
+    SVF_CHECK_EQUAL(Sampler.GetFrameId(), 3);
+    // Sum of (1 + n) / 2 over the fan
+    const float ExpectedArea = 0.5f * (NumTriangles + NumTriangles * (NumTriangles - 1) / 2.f);
+    SVF_CHECK_NEAR(Sampler.GetTotalArea(), ExpectedArea, 1e-3f);
+
+    FRandomStream Random(1234);
+    const int32 NumSamples = 400000;
+    TArray<int32> Counts;
+    Counts.Init(0, NumTriangles);
+    FSVFSurfaceSample Sample;
+    for (int32 Index = 0; Index < NumSamples; ++Index)
+    {
+        SVF_CHECK(Sampler.Sample(Random, Sample));
+        ++Counts[Sample.Triangle];
+    }
+    // Every triangle within five standard deviations of its share
+    for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+    {
+        const double Share = 0.5 * (1.0 + Triangle) / ExpectedArea;
+        const double Expected = NumSamples * Share;
+        const double Sigma = FMath::Sqrt(NumSamples * Share * (1.0 - Share));
+        SVF_CHECK(FMath::Abs(Counts[Triangle] - Expected) < 5.0 * Sigma);
+    }
+}
+
+SVF_TEST(PointsAreUniformOnTheTriangle)
+{
+    FTestMesh Mesh;
+    Mesh.Positions.Append({ FVector(0.f, 0.f, 0.f), FVector(10.f, 0.f, 0.f), FVector(0.f, 10.f, 0.f) });
+    Mesh.Indices.Append({ 0, 1, 2 });
+    FSVFSurfaceSampler Sampler;
+    Sampler.Build(MakeSnapshot(Mesh));
+
+    // The corner triangle of half the size holds a quarter of the area, the band x + y in [5, 10] the rest
+    FRandomStream Random(77);
+    const int32 NumSamples = 100000;
+    int32 InCorner = 0;
+    FSVFSurfaceSample Sample;
+    for (int32 Index = 0; Index < NumSamples; ++Index)
+    {
+        Sampler.Sample(Random, Sample);
+        SVF_CHECK(Sample.Position.X >= 0.f && Sample.Position.Y >= 0.f && Sample.Position.X + Sample.Position.Y <= 10.f + 1e-4f);
+        SVF_CHECK_EQUAL(Sample.Position.Z, 0.f);
+        InCorner += (Sample.Position.X + Sample.Position.Y < 5.f) ? 1 : 0;
+    }
+    SVF_CHECK_NEAR(static_cast<double>(InCorner) / NumSamples, 0.25, 0.01);
+}
+
+SVF_TEST(AttributesAreInterpolated)
+{
+    // Grid texture coordinates follow the position, so an interpolated coordinate must match its point
+    const FTestMesh Grid = MakeGrid(8);
+    TSharedPtr<FSVFFrameSnapshot, ESPMode::ThreadSafe> Flat = MakeSnapshot(Grid);
+    for (const FVector& Position : Grid.Positions)
+    {
+        Flat->TexCoords.Add(FVector2D(Position.X / 100.f, Position.Y / 100.f));
+    }
+    FSVFSurfaceSampler Sampler;
+    Sampler.Build(Flat);
+    FRandomStream Random(5);
+    TArray<FSVFSurfaceSample> Samples;
+    Sampler.SampleMany(Random, 1000, Samples);
+    SVF_CHECK_EQUAL(Samples.Num(), 1000);
+    for (const FSVFSurfaceSample& Sample : Samples)
+    {
+        SVF_CHECK_NEAR(Sample.TexCoord.X, Sample.Position.X / 100.f, 1e-5f);
+        SVF_CHECK_NEAR(Sample.TexCoord.Y, Sample.Position.Y / 100.f, 1e-5f);
+        // No normals in the clip: the face normal. The grid is counter clockwise seen from +Z, so with the
+        // engine's clockwise front faces it faces down
+        SVF_CHECK(Sample.Normal == FVector(0.f, 0.f, -1.f));
+    }
+
+    // Sphere normals are the normalized positions; interpolated ones stay close to the sampled point's
+    const FTestMesh Sphere = MakeSphere(32, 48);
+    TSharedPtr<FSVFFrameSnapshot, ESPMode::ThreadSafe> Round = MakeSnapshot(Sphere);
+    for (const FVector& Position : Sphere.Positions)
+    {
+        Round->Normals.Add(Position.GetSafeNormal());
+    }
+    Sampler.Build(Round);
+    Samples.Reset();
+    Sampler.SampleMany(Random, 1000, Samples);
+    for (const FSVFSurfaceSample& Sample : Samples)
+    {
+        SVF_CHECK_NEAR(Sample.Normal.Size(), 1.f, 1e-4f);
+        SVF_CHECK((Sample.Normal | Sample.Position.GetSafeNormal()) > 0.995f);
+        SVF_CHECK(Sample.Position.Size() <= 50.f + 1e-3f);
+        SVF_CHECK(Sample.Position.Size() > 49.f);
+    }
+}
+
+SVF_TEST(DegenerateAndInvalidTrianglesAreNeverDrawn)
+{
+    FTestMesh Mesh = MakeGrid(2);
+    const int32 NumValid = Mesh.Indices.Num() / 3;
+    // Out of range, and collapsed onto a line
+    Mesh.Indices.Append({ 0, 1, 999, 0, 1, 2 });
+    FSVFSurfaceSampler Sampler;
+    Sampler.Build(MakeSnapshot(Mesh));
+    SVF_CHECK_NEAR(Sampler.GetTotalArea(), 100.f * 100.f, 1e-2f);
+
+    FRandomStream Random(9);
+    FSVFSurfaceSample Sample;
+    for (int32 Index = 0; Index < 50000; ++Index)
+    {
+        Sampler.Sample(Random, Sample);
+        SVF_CHECK(Sample.Triangle < NumValid);
+    }
+
+    // Nothing to draw from
+    Sampler.Build(FSVFFrameSnapshotPtr());
+    SVF_CHECK(Sampler.IsEmpty());
+    SVF_CHECK_EQUAL(Sampler.GetFrameId(), 0);
+    SVF_CHECK(!Sampler.Sample(Random, Sample));
+    FTestMesh Line;
+    Line.Positions.Append({ FVector::ZeroVector, FVector(1.f, 0.f, 0.f), FVector(2.f, 0.f, 0.f) });
+    Line.Indices.Append({ 0, 1, 2 });
+    Sampler.Build(MakeSnapshot(Line));
+    SVF_CHECK(Sampler.IsEmpty());
+    TArray<FSVFSurfaceSample> Samples;
+    Sampler.SampleMany(Random, 10, Samples);
+    SVF_CHECK_EQUAL(Samples.Num(), 0);
+}
+
+SVF_TEST(SharedAcrossThreads)
+{
+    // One sampler, one stream per thread: each thread gets exactly what it would get alone
+    FSVFSurfaceSampler Sampler;
+    Sampler.Build(MakeSnapshot(MakeSphere(24, 32)));
+    const int32 NumThreads = 4;
+    const int32 NumSamples = 20000;
+    TArray<TArray<FSVFSurfaceSample>> Expected;
+    for (int32 Thread = 0; Thread < NumThreads; ++Thread)
+    {
+        FRandomStream Random(100 + Thread);
+        Sampler.SampleMany(Random, NumSamples, Expected.AddDefaulted_GetRef());
+    }
+
+    std::atomic<int32> Mismatches(0);
+    std::vector<std::thread> Threads;
+    for (int32 Thread = 0; Thread < NumThreads; ++Thread)
+    {
+        Threads.emplace_back([&Sampler, &Expected, &Mismatches, Thread]()
+        {
+            FRandomStream Random(100 + Thread);
+            FSVFSurfaceSample Sample;
+            for (int32 Index = 0; Index < NumSamples; ++Index)
+            {
+                Sampler.Sample(Random, Sample);
+                const FSVFSurfaceSample& Reference = Expected[Thread][Index];
+                Mismatches += (Sample.Triangle == Reference.Triangle && Sample.Position == Reference.Position) ? 0 : 1;
+            }
+        });
+    }
+    for (std::thread& Thread : Threads)
+    {
+        Thread.join();
+    }
+    SVF_CHECK_EQUAL(Mismatches.load(), 0);
+}
+
+SVF_TEST(SamplingThroughput)
+{
+    // A capture sized frame; the alias table makes each draw constant time whatever the triangle count
+    const TSharedPtr<FSVFFrameSnapshot, ESPMode::ThreadSafe> Snapshot = MakeSnapshot(MakeSphere(128, 256));
+    const int32 NumTriangles = Snapshot->Indices.Num() / 3;
+    FSVFSurfaceSampler Sampler;
+    const double BuildSeconds = SVFTest::TimeBest(5, [&Sampler, &Snapshot]()
+    {
+        Sampler.Build(Snapshot);
+    });
+
+    const int32 NumSamples = 1000000;
+    TArray<FSVFSurfaceSample> Samples;
+    const double Seconds = SVFTest::TimeBest(5, [&Sampler, &Samples]()
+    {
+        // SampleMany appends; the allocation is kept between runs
+        Samples.Reset();
+        FRandomStream Random(42);
+        Sampler.SampleMany(Random, NumSamples, Samples);
+    });
+    SVF_CHECK_EQUAL(Samples.Num(), NumSamples);
+    std::printf("Surface sampler: build %.2f ms for %d triangles, %.1f Msamples/s\n", BuildSeconds * 1e3, NumTriangles,
+        NumSamples / Seconds * 1e-6);
+}
@@ -0,0 +1,88 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Minimal test registry: each SVF_TEST registers itself, SVFTestMain.cpp runs them all and the process
+// exit code is the number of failed checks, which is what ctest looks at.
+namespace SVFTest
+{
+    typedef void (*FTestFunction)();
+
+    struct FTestCase
+    {
+        const char* Name;
+        FTestFunction Function;
+    };
+
+    inline std::vector<FTestCase>& GetTests()
+    {
+        static std::vector<FTestCase> Tests;
+        return Tests;
+    }
+
+    inline int32& GetFailureCount()
+    {
+        static int32 Failures = 0;
+        return Failures;
+    }
+
+    struct FRegistrar
+    {
+        FRegistrar(const char* Name, FTestFunction Function)
+        {
+            GetTests().push_back(FTestCase{ Name, Function });
+        }
+    };
+
+    inline void ReportFailure(const char* File, int32 Line, const char* Expression)
+    {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", File, Line, Expression);
+        ++GetFailureCount();
+    }
+
+    // Wall time of Count calls to Function, best of a few runs, for the throughput lines in the test log
+    template <typename FunctionType>
+    double TimeBest(int32 Runs, FunctionType Function)
+    {
+        double Best = std::numeric_limits<double>::max();
+        for (int32 Run = 0; Run < Runs; ++Run)
+        {
+            const double Start = FPlatformTime::Seconds();
+            Function();
+            Best = FMath::Min(Best, FPlatformTime::Seconds() - Start);
+        }
+        return Best;
+    }
+}
+
+#define SVF_TEST(Name) \
+    static void Name(); \
+    static SVFTest::FRegistrar Name##Registrar(#Name, &Name); \
+    static void Name()
+
+#define SVF_CHECK(Expression) \
+    do { if (!(Expression)) { SVFTest::ReportFailure(__FILE__, __LINE__, #Expression); } } while (0)
+
+#define SVF_CHECK_EQUAL(Actual, Expected) \
+    do { \
+        const auto SVFActual = (Actual); \
+        const auto SVFExpected = (Expected); \
+        if (!(SVFActual == SVFExpected)) \
+        { \
+            SVFTest::ReportFailure(__FILE__, __LINE__, #Actual " == " #Expected); \
+            std::fprintf(stderr, "    actual %.9g, expected %.9g\n", static_cast<double>(SVFActual), static_cast<double>(SVFExpected)); \
+        } \
+    } while (0)
+
+#define SVF_CHECK_NEAR(Actual, Expected, Tolerance) \
+    do { \
+        const double SVFActual = static_cast<double>(Actual); \
+        const double SVFExpected = static_cast<double>(Expected); \
+        if (!(std::fabs(SVFActual - SVFExpected) <= (Tolerance))) \
+        { \
+            SVFTest::ReportFailure(__FILE__, __LINE__, #Actual " ~= " #Expected); \
+            std::fprintf(stderr, "    actual %.9g, expected %.9g, tolerance %.3g\n", SVFActual, SVFExpected, static_cast<double>(Tolerance)); \
+        } \
+    } while (0)
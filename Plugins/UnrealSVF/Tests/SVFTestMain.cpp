@@ -0,0 +1,14 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+
+int main()
+{
+    for (const SVFTest::FTestCase& Test : SVFTest::GetTests())
+    {
+        const int32 FailuresBefore = SVFTest::GetFailureCount();
+        Test.Function();
+        std::printf("[%s] %s\n", SVFTest::GetFailureCount() == FailuresBefore ? "  OK  " : "FAILED", Test.Name);
+    }
+    return FMath::Min(SVFTest::GetFailureCount(), 255);
+}
@@ -0,0 +1,89 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Procedural meshes shared by the geometry tests
+namespace SVFTestMeshes
+{
+    struct FTestMesh
+    {
+        TArray<FVector> Positions;
+        TArray<int32> Indices;
+    };
+
+    // Flat grid of Cells x Cells quads in the XY plane, Size units wide, two triangles per quad
+    inline FTestMesh MakeGrid(int32 Cells, float Size = 100.f)
+    {
+        FTestMesh Mesh;
+        for (int32 Y = 0; Y <= Cells; ++Y)
+        {
+            for (int32 X = 0; X <= Cells; ++X)
+            {
+                Mesh.Positions.Add(FVector(X * Size / Cells, Y * Size / Cells, 0.f));
+            }
+        }
+        for (int32 Y = 0; Y < Cells; ++Y)
+        {
+            for (int32 X = 0; X < Cells; ++X)
+            {
+                const int32 V0 = Y * (Cells + 1) + X;
+                const int32 V1 = V0 + 1;
+                const int32 V2 = V0 + Cells + 1;
+                const int32 V3 = V2 + 1;
+                Mesh.Indices.Append({ V0, V1, V2, V1, V3, V2 });
+            }
+        }
+        return Mesh;
+    }
+
+    // UV sphere around the origin, closed at the poles
+    inline FTestMesh MakeSphere(int32 Rings, int32 Segments, float Radius = 50.f)
+    {
+        FTestMesh Mesh;
+        for (int32 Ring = 0; Ring <= Rings; ++Ring)
+        {
+            const float Theta = PI * Ring / Rings;
+            for (int32 Segment = 0; Segment < Segments; ++Segment)
+            {
+                const float Phi = 2.f * PI * Segment / Segments;
+                Mesh.Positions.Add(FVector(FMath::Sin(Theta) * FMath::Cos(Phi), FMath::Sin(Theta) * FMath::Sin(Phi), FMath::Cos(Theta)) * Radius);
+            }
+        }
+        for (int32 Ring = 0; Ring < Rings; ++Ring)
+        {
+            for (int32 Segment = 0; Segment < Segments; ++Segment)
+            {
+                const int32 V0 = Ring * Segments + Segment;
+                const int32 V1 = Ring * Segments + (Segment + 1) % Segments;
+                const int32 V2 = V0 + Segments;
+                const int32 V3 = V1 + Segments;
+                // Outward facing, counter clockwise seen from outside
+                if (Ring > 0)
+                {
+                    Mesh.Indices.Append({ V0, V2, V1 });
+                }
+                if (Ring < Rings - 1)
+                {
+                    Mesh.Indices.Append({ V1, V2, V3 });
+                }
+            }
+        }
+        return Mesh;
+    }
+
+    // Triangles as sorted vertex triples, to compare index buffers that hold the same triangles in another order
+    inline TArray<uint64> SortedTriangles(const TArray<int32>& Indices)
+    {
+        TArray<uint64> Triangles;
+        for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+        {
+            int32 Corners[3] = { Indices[Index], Indices[Index + 1], Indices[Index + 2] };
+            std::sort(Corners, Corners + 3);
+            Triangles.Add((static_cast<uint64>(Corners[0]) << 42) | (static_cast<uint64>(Corners[1]) << 21) | static_cast<uint64>(Corners[2]));
+        }
+        Triangles.Sort();
+        return Triangles;
+    }
+}
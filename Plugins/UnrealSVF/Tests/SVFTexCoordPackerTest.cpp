@@ -0,0 +1,250 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFTexCoordPacker.h"
+
+namespace SVFTexCoordPackerTest
+{
+    float FromBits(uint32 Bits)
+    {
+        float Value;
+        std::memcpy(&Value, &Bits, sizeof(Value));
+        return Value;
+    }
+
+    // Exact value of a finite half
+    double HalfToDouble(uint16 Half)
+    {
+        const int32 Exponent = (Half >> 10) & 0x1f;
+        const int32 Mantissa = Half & 0x3ff;
+        const double Magnitude = Exponent == 0 ? std::ldexp(static_cast<double>(Mantissa), -24) :
+            std::ldexp(static_cast<double>(Mantissa | 0x400), Exponent - 25);
+        return (Half & 0x8000) ? -Magnitude : Magnitude;
+    }
+
+    // Round to nearest even, worked out in doubles: the half is at least as close as both neighbours,
+    // a tie keeps the even mantissa, and anything from 65520 up overflows to infinity
+    bool IsNearestEven(float Value, uint16 Half)
+    {
+        const uint16 Sign = Value < 0.f || (Value == 0.f && std::signbit(Value)) ? 0x8000 : 0;
+        if ((Half & 0x8000) != Sign)
+        {
+            return false;
+        }
+        if (FMath::Abs(Value) >= 65520.f)
+        {
+            return (Half & 0x7fff) == 0x7c00;
+        }
+        const uint16 Magnitude = Half & 0x7fff;
+        if (Magnitude >= 0x7c00)
+        {
+            return false;
+        }
+        const double Error = FMath::Abs(static_cast<double>(Value) - HalfToDouble(Half));
+        for (const int32 Neighbour : { Magnitude - 1, Magnitude + 1 })
+        {
+            if (Neighbour < 0 || Neighbour >= 0x7c00)
+            {
+                continue;
+            }
+            const double NeighbourError = FMath::Abs(static_cast<double>(Value) - HalfToDouble(static_cast<uint16>(Neighbour | Sign)));
+            if (NeighbourError < Error || (NeighbourError == Error && (Half & 1) != 0))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Every float exponent and sign, every pattern of the mantissa bits a half keeps plus the next
+    // two, and the low bits that decide rounding: zero, just above zero, just below and at the tie
+    TArray<float> MakeRoundingCases()
+    {
+        const uint32 LowPatterns[] = { 0x0000, 0x0001, 0x03ff, 0x0400, 0x0401, 0x07ff };
+        TArray<float> Values;
+        for (uint32 Sign = 0; Sign < 2; ++Sign)
+        {
+            for (uint32 Exponent = 0; Exponent < 255; ++Exponent)
+            {
+                for (uint32 High = 0; High < (1u << 12); ++High)
+                {
+                    for (const uint32 Low : LowPatterns)
+                    {
+                        Values.Add(FromBits((Sign << 31) | (Exponent << 23) | (High << 11) | Low));
+                    }
+                }
+            }
+        }
+        // Infinities convert too, only NaN payloads are left to the hardware
+        Values.Add(FromBits(0x7f800000u));
+        Values.Add(FromBits(0xff800000u));
+        return Values;
+    }
+
+    float RandomFloat(uint32& Seed)
+    {
+        Seed = Seed * 1664525u + 1013904223u;
+        return (Seed >> 8) / static_cast<float>(1u << 24);
+    }
+}
+
+using namespace SVFTexCoordPackerTest;
+
+SVF_TEST(ScalarHalfRoundsToNearestEven)
+{
+    int32 Mismatches = 0;
+    for (const float Value : MakeRoundingCases())
+    {
+        const uint32 Exponent = (FMath::Abs(Value) == 0.f) ? 0 : static_cast<uint32>(std::ilogb(Value) + 127);
+        // Beyond the half range only overflow matters, which IsNearestEven checks as infinity
+        if (Exponent >= 100 || FMath::Abs(Value) == 0.f)
+        {
+            Mismatches += IsNearestEven(Value, FSVFTexCoordPacker::FloatToHalf(Value)) ? 0 : 1;
+        }
+        else
+        {
+            Mismatches += (FSVFTexCoordPacker::FloatToHalf(Value) & 0x7fff) == 0 ? 0 : 1;
+        }
+    }
+    SVF_CHECK_EQUAL(Mismatches, 0);
+
+    // Largest half, the tie above it, denormals and the tie below the smallest denormal
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToHalf(65504.f), 0x7bff);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToHalf(65519.99f), 0x7bff);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToHalf(65520.f), 0x7c00);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToHalf(-1e9f), 0xfc00);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToHalf(std::ldexp(1.f, -24)), 0x0001);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToHalf(std::ldexp(1.f, -25)), 0x0000);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToHalf(std::ldexp(3.f, -25)), 0x0002);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToHalf(-0.f), 0x8000);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToHalf(FromBits(0x7fc00000u)), 0x7e00);
+}
+
+SVF_TEST(BatchHalfIsBitExactWithScalar)
+{
+    std::printf("hardware half conversion: %s\n", FSVFTexCoordPacker::HasHardwareHalfConversion() ? "yes" : "no");
+    const TArray<float> Values = MakeRoundingCases();
+    TArray<FFloat16> Halves;
+    Halves.SetNumUninitialized(Values.Num());
+    FSVFTexCoordPacker::ToHalf(Values.GetData(), Values.Num(), Halves.GetData());
+    int32 Mismatches = 0;
+    for (int32 Index = 0; Index < Values.Num(); ++Index)
+    {
+        Mismatches += Halves[Index].Encoded == FSVFTexCoordPacker::FloatToHalf(Values[Index]) ? 0 : 1;
+    }
+    SVF_CHECK_EQUAL(Mismatches, 0);
+
+    // Counts that are not a multiple of the vector width finish on the scalar loop
+    for (int32 Count = 0; Count < 20; ++Count)
+    {
+        TArray<FFloat16> Tail;
+        Tail.Init(FFloat16(), Count + 1);
+        Tail[Count].Encoded = 0xabcd;
+        FSVFTexCoordPacker::ToHalf(Values.GetData() + 1000, Count, Tail.GetData());
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            SVF_CHECK_EQUAL(Tail[Index].Encoded, FSVFTexCoordPacker::FloatToHalf(Values[1000 + Index]));
+        }
+        SVF_CHECK_EQUAL(Tail[Count].Encoded, 0xabcd);
+    }
+}
+
+SVF_TEST(BatchUNorm16IsBitExactWithScalar)
+{
+    TArray<float> Values;
+    // Every rounding boundary of the 16 bit range, with the floats just around it
+    for (int32 Step = 0; Step <= 65535; ++Step)
+    {
+        const float Edge = (Step + 0.5f) / 65535.f;
+        float Below = Edge;
+        float Above = Edge;
+        Values.Add(Edge);
+        for (int32 Ulp = 0; Ulp < 4; ++Ulp)
+        {
+            Below = std::nextafter(Below, -1.f);
+            Above = std::nextafter(Above, 2.f);
+            Values.Add(Below);
+            Values.Add(Above);
+        }
+    }
+    // Out of range, infinities and NaN clamp the same way on every path
+    uint32 Seed = 5;
+    for (int32 Index = 0; Index < 100000; ++Index)
+    {
+        Values.Add(RandomFloat(Seed) * 1.4f - 0.2f);
+    }
+    Values.Append({ 0.f, -0.f, 1.f, -1e30f, 1e30f, FromBits(0x7f800000u), FromBits(0xff800000u), FromBits(0x7fc00000u) });
+
+    TArray<uint16> Packed;
+    Packed.SetNumUninitialized(Values.Num());
+    FSVFTexCoordPacker::ToUNorm16(Values.GetData(), Values.Num(), Packed.GetData());
+    int32 Mismatches = 0;
+    for (int32 Index = 0; Index < Values.Num(); ++Index)
+    {
+        Mismatches += Packed[Index] == FSVFTexCoordPacker::FloatToUNorm16(Values[Index]) ? 0 : 1;
+    }
+    SVF_CHECK_EQUAL(Mismatches, 0);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToUNorm16(1.f), 65535);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToUNorm16(-3.f), 0);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToUNorm16(0.5f), 32768);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::FloatToUNorm16(FromBits(0x7fc00000u)), 65535);
+}
+
+SVF_TEST(PackWritesEachFormat)
+{
+    const FVector2D Source[] = { FVector2D(0.25f, 1.f), FVector2D(0.5f, -0.5f), FVector2D(0.f, 0.75f) };
+    FVector2D Floats[3];
+    FSVFTexCoordPacker::Pack(Source, 3, ESVFTexCoordFormat::Float, Floats);
+    SVF_CHECK(Floats[1] == Source[1]);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::GetStride(ESVFTexCoordFormat::Float), sizeof(FVector2D));
+
+    uint16 Halves[6];
+    FSVFTexCoordPacker::Pack(Source, 3, ESVFTexCoordFormat::Half, Halves);
+    SVF_CHECK_EQUAL(Halves[0], 0x3400);
+    SVF_CHECK_EQUAL(Halves[1], 0x3c00);
+    SVF_CHECK_EQUAL(Halves[3], 0xb800);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::GetStride(ESVFTexCoordFormat::Half), 4u);
+
+    uint16 Normalized[6];
+    FSVFTexCoordPacker::Pack(Source, 3, ESVFTexCoordFormat::UNorm16, Normalized);
+    SVF_CHECK_EQUAL(Normalized[1], 65535);
+    SVF_CHECK_EQUAL(Normalized[3], 0);
+    SVF_CHECK_EQUAL(Normalized[5], 49151);
+    SVF_CHECK_EQUAL(FSVFTexCoordPacker::GetStride(ESVFTexCoordFormat::UNorm16), 4u);
+}
+
+SVF_TEST(BatchThroughput)
+{
+    // Two channels of a large frame's coordinates
+    const int32 Count = 1 << 21;
+    TArray<float> Values;
+    uint32 Seed = 9;
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        Values.Add(RandomFloat(Seed));
+    }
+    TArray<uint16> Dest;
+    Dest.SetNumUninitialized(Count);
+
+    const double Scalar = SVFTest::TimeBest(5, [&]()
+    {
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Dest[Index] = FSVFTexCoordPacker::FloatToHalf(Values[Index]);
+        }
+    });
+    const double Batch = SVFTest::TimeBest(5, [&]()
+    {
+        FSVFTexCoordPacker::ToHalf(Values.GetData(), Count, reinterpret_cast<FFloat16*>(Dest.GetData()));
+    });
+    const double UNorm = SVFTest::TimeBest(5, [&]()
+    {
+        FSVFTexCoordPacker::ToUNorm16(Values.GetData(), Count, Dest.GetData());
+    });
+    std::printf("half scalar %.0f Mfloat/s, half batch %.0f Mfloat/s, unorm16 batch %.0f Mfloat/s\n",
+        Count / Scalar * 1e-6, Count / Batch * 1e-6, Count / UNorm * 1e-6);
+    if (FSVFTexCoordPacker::HasHardwareHalfConversion())
+    {
+        SVF_CHECK(Batch < Scalar);
+    }
+}
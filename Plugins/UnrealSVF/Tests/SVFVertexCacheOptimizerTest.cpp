@@ -0,0 +1,106 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFTestMeshes.h"
+#include "SVFVertexCacheOptimizer.h"
+
+using namespace SVFTestMeshes;
+
+namespace SVFVertexCacheOptimizerTest
+{
+    // Decoded SVF triangles come in no particular order; a deterministic shuffle stands in for that
+    void ShuffleTriangles(TArray<int32>& Indices)
+    {
+        uint32 State = 12345;
+        for (int32 Triangle = Indices.Num() / 3 - 1; Triangle > 0; --Triangle)
+        {
+            State = State * 1664525u + 1013904223u;
+            const int32 Other = static_cast<int32>((State >> 8) % static_cast<uint32>(Triangle + 1));
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                Swap(Indices[Triangle * 3 + Corner], Indices[Other * 3 + Corner]);
+            }
+        }
+    }
+
+    // Triangles rotated smallest index first, winding kept, sorted
+    TArray<FIntVector> WoundTriangles(const TArray<int32>& Indices)
+    {
+        TArray<FIntVector> Triangles;
+        for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+        {
+            const int32* Corners = &Indices[Index];
+            const int32 First = Corners[0] < Corners[1] ? (Corners[0] < Corners[2] ? 0 : 2) : (Corners[1] < Corners[2] ? 1 : 2);
+            Triangles.Add(FIntVector(Corners[First], Corners[(First + 1) % 3], Corners[(First + 2) % 3]));
+        }
+        Triangles.Sort([](const FIntVector& A, const FIntVector& B)
+        {
+            return A.X != B.X ? A.X < B.X : A.Y != B.Y ? A.Y < B.Y : A.Z < B.Z;
+        });
+        return Triangles;
+    }
+}
+
+using namespace SVFVertexCacheOptimizerTest;
+
+SVF_TEST(OptimizedOrderHasFewerMisses)
+{
+    FTestMesh Mesh = MakeSphere(64, 128);
+    ShuffleTriangles(Mesh.Indices);
+    const int32 NumVertices = Mesh.Positions.Num();
+
+    TArray<int32> Optimized;
+    FSVFVertexCacheOptimizer::Optimize(Mesh.Indices, NumVertices, Optimized);
+    const float Before = FSVFVertexCacheOptimizer::ComputeACMR(Mesh.Indices, NumVertices);
+    const float After = FSVFVertexCacheOptimizer::ComputeACMR(Optimized, NumVertices);
+    std::printf("    ACMR %.3f -> %.3f\n", Before, After);
+    SVF_CHECK(Before > 2.f);
+    // Tipsify reaches about 0.7 on regular meshes with a 16 entry cache
+    SVF_CHECK(After < 0.8f);
+}
+
+SVF_TEST(SameTrianglesSameWinding)
+{
+    FTestMesh Mesh = MakeSphere(32, 64);
+    ShuffleTriangles(Mesh.Indices);
+    TArray<int32> Optimized;
+    FSVFVertexCacheOptimizer::Optimize(Mesh.Indices, Mesh.Positions.Num(), Optimized);
+    SVF_CHECK_EQUAL(Optimized.Num(), Mesh.Indices.Num());
+    SVF_CHECK(WoundTriangles(Optimized) == WoundTriangles(Mesh.Indices));
+}
+
+SVF_TEST(OutOfRangeIndicesCopied)
+{
+    const TArray<int32> Indices = { 0, 1, 2, 2, 1, 7 };
+    TArray<int32> Optimized;
+    FSVFVertexCacheOptimizer::Optimize(Indices, 4, Optimized);
+    SVF_CHECK(Optimized == Indices);
+
+    FSVFVertexCacheOptimizer::Optimize(TArray<int32>(), 4, Optimized);
+    SVF_CHECK_EQUAL(Optimized.Num(), 0);
+}
+
+SVF_TEST(ACMRBounds)
+{
+    // Three fresh vertices per triangle is the worst case
+    const TArray<int32> Disjoint = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+    SVF_CHECK_NEAR(FSVFVertexCacheOptimizer::ComputeACMR(Disjoint, 9), 3.0, 1e-6);
+    // A strip-like fan reuses two vertices per triangle
+    const TArray<int32> Fan = { 0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 5 };
+    SVF_CHECK_NEAR(FSVFVertexCacheOptimizer::ComputeACMR(Fan, 6), 6.0 / 4.0, 1e-6);
+}
+
+SVF_TEST(OptimizerThroughput)
+{
+    // About the triangle count of a full body capture keyframe
+    FTestMesh Mesh = MakeSphere(128, 256);
+    ShuffleTriangles(Mesh.Indices);
+    const int32 NumTriangles = Mesh.Indices.Num() / 3;
+    TArray<int32> Optimized;
+    const double Seconds = SVFTest::TimeBest(5, [&]()
+    {
+        FSVFVertexCacheOptimizer::Optimize(Mesh.Indices, Mesh.Positions.Num(), Optimized);
+    });
+    std::printf("    Optimize: %d triangles in %.2f ms, %.1f Mtriangles/s\n", NumTriangles, Seconds * 1e3, NumTriangles / Seconds * 1e-6);
+    SVF_CHECK_EQUAL(Optimized.Num(), Mesh.Indices.Num());
+}
@@ -0,0 +1,170 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFVertexScatter.h"
+
+namespace SVFVertexScatterTest
+{
+    // The decoder's uncompressed layouts, as SVFCore.h declares them
+    struct FTestVertex
+    {
+        float x, y, z;
+        float u, v;
+    };
+
+    struct FTestNormalVertex
+    {
+        float x, y, z;
+        float nx, ny, nz;
+        float u, v;
+    };
+
+    float RandomFloat(uint32& Seed, float Range)
+    {
+        Seed = Seed * 1664525u + 1013904223u;
+        return ((Seed >> 8) / static_cast<float>(1u << 24) * 2.f - 1.f) * Range;
+    }
+
+    TArray<FTestNormalVertex> MakeVertices(int32 Count)
+    {
+        uint32 Seed = 21;
+        TArray<FTestNormalVertex> Vertices;
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            FTestNormalVertex Vertex;
+            Vertex.x = RandomFloat(Seed, 100.f);
+            Vertex.y = RandomFloat(Seed, 100.f);
+            Vertex.z = RandomFloat(Seed, 100.f);
+            const FVector Normal = FVector(RandomFloat(Seed, 1.f), RandomFloat(Seed, 1.f), RandomFloat(Seed, 1.f)).GetSafeNormal();
+            Vertex.nx = Normal.X;
+            Vertex.ny = Normal.Y;
+            Vertex.nz = Normal.Z;
+            Vertex.u = RandomFloat(Seed, 1.f);
+            Vertex.v = RandomFloat(Seed, 1.f);
+            Vertices.Add(Vertex);
+        }
+        return Vertices;
+    }
+
+    // What the decoder handed the stager before, one FDynamicMeshVertex at a time
+    struct FReferenceVertex
+    {
+        FVector Position;
+        FVector2D TexCoord;
+        FPackedNormal TangentX;
+        FPackedNormal TangentZ;
+    };
+
+    FReferenceVertex ConvertReference(const FTestNormalVertex& Vertex, bool bUseNormal)
+    {
+        FReferenceVertex Result;
+        Result.Position = FVector(Vertex.z, Vertex.x, Vertex.y);
+        Result.TexCoord = FVector2D(Vertex.u, Vertex.v);
+        Result.TangentX = FPackedNormal(FVector(1, 0, 0));
+        if (bUseNormal)
+        {
+            Result.TangentZ = FPackedNormal(FVector(-Vertex.nz, -Vertex.nx, -Vertex.ny));
+            Result.TangentZ.Vector.W = 127;
+        }
+        else
+        {
+            Result.TangentZ = FPackedNormal(FVector4(0, 0, 1, 1));
+        }
+        return Result;
+    }
+
+    struct FStreams
+    {
+        TArray<FVector> Positions;
+        TArray<FPackedNormal> Tangents;
+        TArray<FVector2D> TexCoords;
+        FSVFVertexStreams View;
+
+        FStreams(int32 NumVertices, int32 TexCoordStride)
+        {
+            Positions.Init(FVector::ZeroVector, NumVertices);
+            Tangents.Init(FPackedNormal(), 2 * NumVertices);
+            // Other channels hold a marker the scatter must leave alone
+            TexCoords.Init(FVector2D(-7.f, -7.f), TexCoordStride * NumVertices);
+            View.Positions = Positions.GetData();
+            View.Tangents = Tangents.GetData();
+            View.TexCoords = TexCoords.GetData();
+            View.TexCoordStride = TexCoordStride;
+        }
+    };
+}
+
+using namespace SVFVertexScatterTest;
+
+SVF_TEST(MatchesPerVertexConversion)
+{
+    const TArray<FTestNormalVertex> Vertices = MakeVertices(5000);
+    FStreams Streams(Vertices.Num(), 1);
+    SVFVertexScatter::ScatterSVFNormalVertices(Vertices.GetData(), Vertices.Num(), Streams.View);
+    int32 Mismatches = 0;
+    for (int32 Index = 0; Index < Vertices.Num(); ++Index)
+    {
+        const FReferenceVertex Expected = ConvertReference(Vertices[Index], true);
+        Mismatches += Streams.Positions[Index] == Expected.Position ? 0 : 1;
+        Mismatches += Streams.TexCoords[Index] == Expected.TexCoord ? 0 : 1;
+        Mismatches += Streams.Tangents[2 * Index + 0] == Expected.TangentX ? 0 : 1;
+        Mismatches += Streams.Tangents[2 * Index + 1] == Expected.TangentZ ? 0 : 1;
+    }
+    SVF_CHECK_EQUAL(Mismatches, 0);
+
+    // SVF (x, y, z) lands on Unreal (z, x, y); normals are flipped as well, so SVF -Z packs to Unreal +X
+    const FTestNormalVertex Up = { 1.f, 2.f, 3.f, 0.f, 0.f, -1.f, 0.25f, 0.75f };
+    FStreams One(1, 1);
+    SVFVertexScatter::ScatterSVFNormalVertices(&Up, 1, One.View);
+    SVF_CHECK(One.Positions[0] == FVector(3.f, 1.f, 2.f));
+    SVF_CHECK(One.Tangents[1] == FPackedNormal(127, 0, 0, 127));
+}
+
+SVF_TEST(VerticesWithoutNormalsFaceUp)
+{
+    const TArray<FTestNormalVertex> Source = MakeVertices(300);
+    TArray<FTestVertex> Vertices;
+    for (const FTestNormalVertex& Vertex : Source)
+    {
+        Vertices.Add({ Vertex.x, Vertex.y, Vertex.z, Vertex.u, Vertex.v });
+    }
+    FStreams Streams(Vertices.Num(), 1);
+    SVFVertexScatter::ScatterSVFVertices(Vertices.GetData(), Vertices.Num(), Streams.View);
+    int32 Mismatches = 0;
+    for (int32 Index = 0; Index < Vertices.Num(); ++Index)
+    {
+        const FReferenceVertex Expected = ConvertReference(Source[Index], false);
+        Mismatches += Streams.Positions[Index] == Expected.Position ? 0 : 1;
+        Mismatches += Streams.TexCoords[Index] == Expected.TexCoord ? 0 : 1;
+        Mismatches += Streams.Tangents[2 * Index + 0] == Expected.TangentX ? 0 : 1;
+        Mismatches += Streams.Tangents[2 * Index + 1] == Expected.TangentZ ? 0 : 1;
+    }
+    SVF_CHECK_EQUAL(Mismatches, 0);
+}
+
+SVF_TEST(OptionalStreamsAndStride)
+{
+    const TArray<FTestNormalVertex> Vertices = MakeVertices(64);
+
+    // Only the first of three channels is written
+    FStreams Strided(Vertices.Num(), 3);
+    SVFVertexScatter::ScatterSVFNormalVertices(Vertices.GetData(), Vertices.Num(), Strided.View);
+    for (int32 Index = 0; Index < Vertices.Num(); ++Index)
+    {
+        SVF_CHECK(Strided.TexCoords[3 * Index] == FVector2D(Vertices[Index].u, Vertices[Index].v));
+        SVF_CHECK(Strided.TexCoords[3 * Index + 1] == FVector2D(-7.f, -7.f));
+        SVF_CHECK(Strided.TexCoords[3 * Index + 2] == FVector2D(-7.f, -7.f));
+    }
+
+    // Streams left null are not touched, positions are always written
+    FStreams Positions(Vertices.Num(), 1);
+    Positions.View.Tangents = nullptr;
+    Positions.View.TexCoords = nullptr;
+    SVFVertexScatter::ScatterSVFNormalVertices(Vertices.GetData(), Vertices.Num(), Positions.View);
+    for (int32 Index = 0; Index < Vertices.Num(); ++Index)
+    {
+        SVF_CHECK(Positions.Positions[Index] == FVector(Vertices[Index].z, Vertices[Index].x, Vertices[Index].y));
+        SVF_CHECK_EQUAL(Positions.Tangents[2 * Index + 1].Vector.Packed, 0u);
+        SVF_CHECK(Positions.TexCoords[Index] == FVector2D(-7.f, -7.f));
+    }
+}
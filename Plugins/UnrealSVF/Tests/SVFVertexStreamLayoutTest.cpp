@@ -0,0 +1,100 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#include "SVFTestHarness.h"
+#include "SVFVertexStreamLayout.h"
+
+namespace SVFVertexStreamLayoutTest
+{
+    FSVFVertexStreamDesc Desc(ESVFVertexStreamBuffer Buffer, uint32 Offset, uint32 Stride, EVertexElementType Type)
+    {
+        FSVFVertexStreamDesc Result;
+        Result.Buffer = Buffer;
+        Result.Offset = Offset;
+        Result.Stride = Stride;
+        Result.Type = Type;
+        return Result;
+    }
+
+    bool SameLayout(const FSVFVertexStreamLayout& A, const FSVFVertexStreamLayout& B)
+    {
+        return A.Position == B.Position && A.TangentBasis[0] == B.TangentBasis[0] && A.TangentBasis[1] == B.TangentBasis[1] &&
+            A.TexCoords == B.TexCoords && A.Color == B.Color;
+    }
+}
+
+using namespace SVFVertexStreamLayoutTest;
+
+SVF_TEST(PositionFormats)
+{
+    const FSVFVertexStreamLayout Full = FSVFVertexStreamLayout::Build(false, ESVFTexCoordFormat::Half, 1, true, true);
+    SVF_CHECK(Full.Position == Desc(ESVFVertexStreamBuffer::Position, 0, 12, VET_Float3));
+
+    const FSVFVertexStreamLayout Half = FSVFVertexStreamLayout::Build(true, ESVFTexCoordFormat::Half, 1, true, true);
+    SVF_CHECK(Half.Position == Desc(ESVFVertexStreamBuffer::Position, 0, 8, VET_Half4));
+}
+
+SVF_TEST(TexCoordFormatsAndCounts)
+{
+    struct FCase
+    {
+        ESVFTexCoordFormat Format;
+        uint32 Size;
+        EVertexElementType DoubleWide;
+        EVertexElementType Single;
+    };
+    const FCase Cases[] =
+    {
+        { ESVFTexCoordFormat::Float, 8, VET_Float4, VET_Float2 },
+        { ESVFTexCoordFormat::Half, 4, VET_Half4, VET_Half2 },
+        { ESVFTexCoordFormat::UNorm16, 4, VET_UShort4N, VET_UShort2N },
+    };
+    for (const FCase& Case : Cases)
+    {
+        for (uint32 NumTexCoords = 1; NumTexCoords <= 4; ++NumTexCoords)
+        {
+            const FSVFVertexStreamLayout Layout = FSVFVertexStreamLayout::Build(false, Case.Format, NumTexCoords, true, true);
+            SVF_CHECK_EQUAL(Layout.TexCoords.Num(), static_cast<int32>((NumTexCoords + 1) / 2));
+            // Channels pair up, an odd last one gets a stream of its own; all share the vertex's stride
+            for (int32 Stream = 0; Stream < Layout.TexCoords.Num(); ++Stream)
+            {
+                const bool bSingle = static_cast<uint32>(2 * Stream + 1) == NumTexCoords;
+                SVF_CHECK(Layout.TexCoords[Stream] == Desc(ESVFVertexStreamBuffer::TexCoord, 2 * Stream * Case.Size,
+                    NumTexCoords * Case.Size, bSingle ? Case.Single : Case.DoubleWide));
+            }
+        }
+    }
+}
+
+SVF_TEST(TangentsInterleaved)
+{
+    const FSVFVertexStreamLayout Layout = FSVFVertexStreamLayout::Build(false, ESVFTexCoordFormat::Half, 2, true, true);
+    SVF_CHECK(Layout.TangentBasis[0] == Desc(ESVFVertexStreamBuffer::Tangent, 0, 8, VET_PackedNormal));
+    SVF_CHECK(Layout.TangentBasis[1] == Desc(ESVFVertexStreamBuffer::Tangent, 4, 8, VET_PackedNormal));
+}
+
+SVF_TEST(NormalsDoNotChangeLayout)
+{
+    // Manual vertex fetch reads the tangents per vertex either way, clips without normals keep the default basis
+    for (const bool bHalfPositions : { false, true })
+    {
+        for (const ESVFTexCoordFormat Format : { ESVFTexCoordFormat::Float, ESVFTexCoordFormat::Half, ESVFTexCoordFormat::UNorm16 })
+        {
+            for (uint32 NumTexCoords = 1; NumTexCoords <= 4; ++NumTexCoords)
+            {
+                SVF_CHECK(SameLayout(FSVFVertexStreamLayout::Build(bHalfPositions, Format, NumTexCoords, true, true),
+                    FSVFVertexStreamLayout::Build(bHalfPositions, Format, NumTexCoords, false, true)));
+            }
+        }
+    }
+}
+
+SVF_TEST(ColorStream)
+{
+    // With the index mask every vertex reads the null buffer's one entry
+    const FSVFVertexStreamLayout Shared = FSVFVertexStreamLayout::Build(false, ESVFTexCoordFormat::Half, 1, false, true);
+    SVF_CHECK(Shared.Color == Desc(ESVFVertexStreamBuffer::NullColor, 0, 0, VET_Color));
+
+    // Without it the view is read at the vertex index, so each vertex needs its own entry
+    const FSVFVertexStreamLayout PerVertex = FSVFVertexStreamLayout::Build(false, ESVFTexCoordFormat::Half, 1, false, false);
+    SVF_CHECK(PerVertex.Color == Desc(ESVFVertexStreamBuffer::Color, 0, 4, VET_Color));
+}
@@ -0,0 +1,28 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+enum class EAsyncExecution
+{
+    TaskGraph,
+    TaskGraphMainThread,
+    Thread,
+    ThreadIfForkSafe,
+    ThreadPool,
+    LargeThreadPool,
+};
+
+// Runs the task on the calling thread before returning, so tests see its result at a fixed point: a
+// future is ready as soon as Async returns
+template <typename CallableType>
+auto Async(EAsyncExecution Execution, CallableType&& Callable) -> TFuture<decltype(Forward<CallableType>(Callable)())>
+{
+    typedef decltype(Forward<CallableType>(Callable)()) ResultType;
+    std::packaged_task<ResultType()> Task(Forward<CallableType>(Callable));
+    std::shared_future<ResultType> Future = Task.get_future().share();
+    Task();
+    return TFuture<ResultType>(std::move(Future));
+}
@@ -0,0 +1,22 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// A future is std::shared_future underneath; default constructed ones are not valid
+template <typename ResultType>
+class TFuture
+{
+public:
+    TFuture() = default;
+    explicit TFuture(std::shared_future<ResultType>&& InFuture) : Future(std::move(InFuture)) {}
+
+    bool IsValid() const { return Future.valid(); }
+    bool IsReady() const { return Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+    void Wait() const { Future.wait(); }
+    const ResultType& Get() const { return Future.get(); }
+
+private:
+    std::shared_future<ResultType> Future;
+};
@@ -0,0 +1,42 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Runs the body on real threads, at least two so that code relying on disjoint writes is exercised
+// even on a single core machine
+inline void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, bool bForceSingleThread = false)
+{
+    if (Num <= 0)
+    {
+        return;
+    }
+    const int32 NumThreads = bForceSingleThread ? 1 : FMath::Min<int32>(Num, FMath::Max<int32>(std::thread::hardware_concurrency(), 2));
+    if (NumThreads == 1)
+    {
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            Body(Index);
+        }
+        return;
+    }
+    std::atomic<int32> Next(0);
+    auto Work = [&Next, &Body, Num]()
+    {
+        for (int32 Index = Next++; Index < Num; Index = Next++)
+        {
+            Body(Index);
+        }
+    };
+    std::vector<std::thread> Threads;
+    for (int32 Thread = 1; Thread < NumThreads; ++Thread)
+    {
+        Threads.emplace_back(Work);
+    }
+    Work();
+    for (std::thread& Thread : Threads)
+    {
+        Thread.join();
+    }
+}
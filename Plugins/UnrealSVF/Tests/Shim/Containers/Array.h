@@ -0,0 +1,416 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Contiguous array with the TArray interface the plugin uses. Elements are relocated with their move
+// constructor; uninitialized growth leaves trivially constructible elements untouched like the engine does.
+// The allocator only exists for source compatibility, every array lives on the heap.
+struct FDefaultAllocator {};
+template <uint32 NumInlineElements>
+struct TInlineAllocator {};
+
+template <typename T, typename AllocatorType = FDefaultAllocator>
+class TArray
+{
+public:
+    typedef T ElementType;
+    typedef int32 SizeType;
+
+    TArray() = default;
+    TArray(std::initializer_list<T> Init) { Append(Init.begin(), static_cast<int32>(Init.size())); }
+    TArray(const T* Ptr, int32 Count) { Append(Ptr, Count); }
+    TArray(const TArray& Other) { Append(Other.GetData(), Other.Num()); }
+    TArray(TArray&& Other) noexcept { StealFrom(Other); }
+    ~TArray() { Empty(); }
+
+    TArray& operator=(const TArray& Other)
+    {
+        if (this != &Other)
+        {
+            Reset();
+            Append(Other.GetData(), Other.Num());
+        }
+        return *this;
+    }
+    TArray& operator=(TArray&& Other) noexcept
+    {
+        if (this != &Other)
+        {
+            Empty();
+            StealFrom(Other);
+        }
+        return *this;
+    }
+
+    int32 Num() const { return ArrayNum; }
+    int32 Max() const { return ArrayMax; }
+    SIZE_T GetAllocatedSize() const { return static_cast<SIZE_T>(ArrayMax) * sizeof(T); }
+    static constexpr uint32 GetTypeSize() { return sizeof(T); }
+    T* GetData() { return Data; }
+    const T* GetData() const { return Data; }
+    bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < ArrayNum; }
+
+    T& operator[](int32 Index) { check(IsValidIndex(Index)); return Data[Index]; }
+    const T& operator[](int32 Index) const { check(IsValidIndex(Index)); return Data[Index]; }
+    T& Last(int32 IndexFromEnd = 0) { return (*this)[ArrayNum - 1 - IndexFromEnd]; }
+    const T& Last(int32 IndexFromEnd = 0) const { return (*this)[ArrayNum - 1 - IndexFromEnd]; }
+    T& Top() { return Last(); }
+
+    T* begin() { return Data; }
+    T* end() { return Data + ArrayNum; }
+    const T* begin() const { return Data; }
+    const T* end() const { return Data + ArrayNum; }
+
+    void Reserve(int32 Number)
+    {
+        if (Number > ArrayMax)
+        {
+            Reallocate(Number);
+        }
+    }
+
+    void Reset(int32 NewSize = 0)
+    {
+        DestructRange(0, ArrayNum);
+        ArrayNum = 0;
+        Reserve(NewSize);
+    }
+
+    void Empty(int32 Slack = 0)
+    {
+        DestructRange(0, ArrayNum);
+        ArrayNum = 0;
+        if (ArrayMax != Slack)
+        {
+            Reallocate(Slack);
+        }
+    }
+
+    void Shrink()
+    {
+        if (ArrayMax != ArrayNum)
+        {
+            Reallocate(ArrayNum);
+        }
+    }
+
+    int32 AddUninitialized(int32 Count = 1)
+    {
+        const int32 Index = ArrayNum;
+        Grow(ArrayNum + Count);
+        if (!std::is_trivially_default_constructible<T>::value)
+        {
+            for (int32 Offset = 0; Offset < Count; ++Offset)
+            {
+                new (Data + Index + Offset) T();
+            }
+        }
+        ArrayNum += Count;
+        return Index;
+    }
+
+    int32 AddZeroed(int32 Count = 1)
+    {
+        const int32 Index = AddUninitialized(Count);
+        std::memset(static_cast<void*>(Data + Index), 0, sizeof(T) * Count);
+        return Index;
+    }
+
+    int32 AddDefaulted(int32 Count = 1)
+    {
+        const int32 Index = ArrayNum;
+        Grow(ArrayNum + Count);
+        for (int32 Offset = 0; Offset < Count; ++Offset)
+        {
+            new (Data + Index + Offset) T();
+        }
+        ArrayNum += Count;
+        return Index;
+    }
+
+    template <typename... ArgTypes>
+    int32 Emplace(ArgTypes&&... Args)
+    {
+        const int32 Index = ArrayNum;
+        if (ArrayNum == ArrayMax)
+        {
+            // Args may refer into the array, so construct before the old storage goes away
+            T Value(std::forward<ArgTypes>(Args)...);
+            Grow(ArrayNum + 1);
+            new (Data + Index) T(std::move(Value));
+        }
+        else
+        {
+            new (Data + Index) T(std::forward<ArgTypes>(Args)...);
+        }
+        ++ArrayNum;
+        return Index;
+    }
+
+    template <typename... ArgTypes>
+    T& Emplace_GetRef(ArgTypes&&... Args) { const int32 Index = Emplace(std::forward<ArgTypes>(Args)...); return Data[Index]; }
+
+    int32 Add(const T& Item) { return Emplace(Item); }
+    int32 Add(T&& Item) { return Emplace(std::move(Item)); }
+    T& Add_GetRef(const T& Item) { const int32 Index = Emplace(Item); return Data[Index]; }
+    T& AddDefaulted_GetRef() { const int32 Index = AddDefaulted(); return Data[Index]; }
+
+    int32 AddUnique(const T& Item)
+    {
+        const int32 Index = Find(Item);
+        return Index != INDEX_NONE ? Index : Add(Item);
+    }
+
+    void Push(const T& Item) { Add(Item); }
+    T Pop(bool bAllowShrinking = true)
+    {
+        T Result = std::move(Last());
+        RemoveAt(ArrayNum - 1, 1, bAllowShrinking);
+        return Result;
+    }
+
+    void Append(const T* Ptr, int32 Count)
+    {
+        Grow(ArrayNum + Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            new (Data + ArrayNum + Index) T(Ptr[Index]);
+        }
+        ArrayNum += Count;
+    }
+    void Append(const TArray& Other) { Append(Other.GetData(), Other.Num()); }
+    void Append(std::initializer_list<T> Init) { Append(Init.begin(), static_cast<int32>(Init.size())); }
+
+    void Insert(const T& Item, int32 Index)
+    {
+        check(Index >= 0 && Index <= ArrayNum);
+        T Value(Item);
+        Emplace(std::move(Value));
+        std::rotate(Data + Index, Data + ArrayNum - 1, Data + ArrayNum);
+    }
+
+    void RemoveAt(int32 Index, int32 Count = 1, bool bAllowShrinking = true)
+    {
+        check(Index >= 0 && Count >= 0 && Index + Count <= ArrayNum);
+        std::move(Data + Index + Count, Data + ArrayNum, Data + Index);
+        DestructRange(ArrayNum - Count, ArrayNum);
+        ArrayNum -= Count;
+    }
+
+    void RemoveAtSwap(int32 Index, int32 Count = 1, bool bAllowShrinking = true)
+    {
+        for (int32 Removed = 0; Removed < Count; ++Removed)
+        {
+            if (Index != ArrayNum - 1)
+            {
+                Data[Index] = std::move(Data[ArrayNum - 1]);
+            }
+            DestructRange(ArrayNum - 1, ArrayNum);
+            --ArrayNum;
+        }
+    }
+
+    template <typename PredicateType>
+    int32 RemoveAll(const PredicateType& Predicate)
+    {
+        T* NewEnd = std::remove_if(Data, Data + ArrayNum, Predicate);
+        const int32 Removed = static_cast<int32>((Data + ArrayNum) - NewEnd);
+        DestructRange(ArrayNum - Removed, ArrayNum);
+        ArrayNum -= Removed;
+        return Removed;
+    }
+
+    int32 Remove(const T& Item) { return RemoveAll([&Item](const T& Element) { return Element == Item; }); }
+    int32 RemoveSwap(const T& Item) { return Remove(Item); }
+
+    void SetNum(int32 NewNum, bool bAllowShrinking = true)
+    {
+        if (NewNum > ArrayNum)
+        {
+            AddDefaulted(NewNum - ArrayNum);
+        }
+        else
+        {
+            TruncateTo(NewNum);
+        }
+    }
+
+    void SetNumUninitialized(int32 NewNum, bool bAllowShrinking = true)
+    {
+        if (NewNum > ArrayNum)
+        {
+            AddUninitialized(NewNum - ArrayNum);
+        }
+        else
+        {
+            TruncateTo(NewNum);
+        }
+    }
+
+    void SetNumZeroed(int32 NewNum, bool bAllowShrinking = true)
+    {
+        if (NewNum > ArrayNum)
+        {
+            AddZeroed(NewNum - ArrayNum);
+        }
+        else
+        {
+            TruncateTo(NewNum);
+        }
+    }
+
+    void Init(const T& Element, int32 Number)
+    {
+        Reset(Number);
+        for (int32 Index = 0; Index < Number; ++Index)
+        {
+            Add(Element);
+        }
+    }
+
+    int32 Find(const T& Item) const
+    {
+        for (int32 Index = 0; Index < ArrayNum; ++Index)
+        {
+            if (Data[Index] == Item)
+            {
+                return Index;
+            }
+        }
+        return INDEX_NONE;
+    }
+    bool Find(const T& Item, int32& OutIndex) const
+    {
+        OutIndex = Find(Item);
+        return OutIndex != INDEX_NONE;
+    }
+    bool Contains(const T& Item) const { return Find(Item) != INDEX_NONE; }
+
+    template <typename PredicateType>
+    int32 IndexOfByPredicate(const PredicateType& Predicate) const
+    {
+        for (int32 Index = 0; Index < ArrayNum; ++Index)
+        {
+            if (Predicate(Data[Index]))
+            {
+                return Index;
+            }
+        }
+        return INDEX_NONE;
+    }
+    template <typename KeyType>
+    int32 IndexOfByKey(const KeyType& Key) const { return IndexOfByPredicate([&Key](const T& Element) { return Element == Key; }); }
+    template <typename PredicateType>
+    T* FindByPredicate(const PredicateType& Predicate)
+    {
+        const int32 Index = IndexOfByPredicate(Predicate);
+        return Index != INDEX_NONE ? Data + Index : nullptr;
+    }
+    template <typename PredicateType>
+    bool ContainsByPredicate(const PredicateType& Predicate) const { return IndexOfByPredicate(Predicate) != INDEX_NONE; }
+
+    void Sort() { std::sort(Data, Data + ArrayNum); }
+    template <typename PredicateType>
+    void Sort(const PredicateType& Predicate) { std::sort(Data, Data + ArrayNum, Predicate); }
+    template <typename PredicateType>
+    void StableSort(const PredicateType& Predicate) { std::stable_sort(Data, Data + ArrayNum, Predicate); }
+    void Swap(int32 A, int32 B) { std::swap(Data[A], Data[B]); }
+
+    bool operator==(const TArray& Other) const { return ArrayNum == Other.ArrayNum && std::equal(Data, Data + ArrayNum, Other.Data); }
+    bool operator!=(const TArray& Other) const { return !(*this == Other); }
+
+private:
+    void StealFrom(TArray& Other)
+    {
+        Data = Other.Data;
+        ArrayNum = Other.ArrayNum;
+        ArrayMax = Other.ArrayMax;
+        Other.Data = nullptr;
+        Other.ArrayNum = 0;
+        Other.ArrayMax = 0;
+    }
+
+    // Drops the tail; nothing moves, unlike RemoveAt
+    void TruncateTo(int32 NewNum)
+    {
+        check(NewNum >= 0 && NewNum <= ArrayNum);
+        DestructRange(NewNum, ArrayNum);
+        ArrayNum = NewNum;
+    }
+
+    void DestructRange(int32 From, int32 To)
+    {
+        for (int32 Index = From; Index < To; ++Index)
+        {
+            Data[Index].~T();
+        }
+    }
+
+    void Grow(int32 Required)
+    {
+        if (Required > ArrayMax)
+        {
+            Reallocate(FMath::Max(Required, ArrayMax + ArrayMax / 2 + 4));
+        }
+    }
+
+    void Reallocate(int32 NewMax)
+    {
+        T* NewData = NewMax > 0 ? static_cast<T*>(FMemory::Malloc(sizeof(T) * NewMax, alignof(T))) : nullptr;
+        for (int32 Index = 0; Index < ArrayNum; ++Index)
+        {
+            new (NewData + Index) T(std::move(Data[Index]));
+            Data[Index].~T();
+        }
+        FMemory::Free(Data);
+        Data = NewData;
+        ArrayMax = NewMax;
+    }
+
+    T* Data = nullptr;
+    int32 ArrayNum = 0;
+    int32 ArrayMax = 0;
+};
+
+// Non owning view of contiguous elements
+template <typename T>
+class TArrayView
+{
+public:
+    typedef T ElementType;
+
+    TArrayView() = default;
+    TArrayView(T* InData, int32 InNum) : Data(InData), ArrayNum(InNum) {}
+    template <typename OtherType, typename = std::enable_if_t<std::is_convertible<OtherType*, T*>::value>>
+    TArrayView(TArray<OtherType>& Array) : Data(Array.GetData()), ArrayNum(Array.Num()) {}
+    template <typename OtherType, typename = std::enable_if_t<std::is_convertible<const OtherType*, T*>::value>>
+    TArrayView(const TArray<OtherType>& Array) : Data(Array.GetData()), ArrayNum(Array.Num()) {}
+    template <typename OtherType, typename = std::enable_if_t<std::is_convertible<OtherType*, T*>::value>>
+    TArrayView(const TArrayView<OtherType>& Other) : Data(Other.GetData()), ArrayNum(Other.Num()) {}
+
+    int32 Num() const { return ArrayNum; }
+    T* GetData() const { return Data; }
+    bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < ArrayNum; }
+    T& operator[](int32 Index) const { check(IsValidIndex(Index)); return Data[Index]; }
+    T& Last() const { return (*this)[ArrayNum - 1]; }
+    T* begin() const { return Data; }
+    T* end() const { return Data + ArrayNum; }
+    TArrayView Slice(int32 Index, int32 Count) const { check(Index >= 0 && Index + Count <= ArrayNum); return TArrayView(Data + Index, Count); }
+
+private:
+    T* Data = nullptr;
+    int32 ArrayNum = 0;
+};
+
+// Sorts a range in place
+template <typename T, typename PredicateType>
+void Sort(T* First, int32 Num, const PredicateType& Predicate) { std::sort(First, First + Num, Predicate); }
+
+template <typename T>
+TArrayView<T> MakeArrayView(T* Data, int32 Num) { return TArrayView<T>(Data, Num); }
+template <typename T>
+TArrayView<T> MakeArrayView(TArray<T>& Array) { return TArrayView<T>(Array); }
+template <typename T>
+TArrayView<const T> MakeArrayView(const TArray<T>& Array) { return TArrayView<const T>(Array); }
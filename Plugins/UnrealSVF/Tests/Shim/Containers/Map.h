@@ -0,0 +1,142 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/TypeHash.h"
+#include <unordered_map>
+
+template <typename KeyType, typename ValueType>
+struct TPair
+{
+    KeyType Key;
+    ValueType Value;
+
+    TPair() = default;
+    TPair(const KeyType& InKey, const ValueType& InValue) : Key(InKey), Value(InValue) {}
+};
+
+// Associative container with the TMap interface the plugin uses. Pairs are stored densely and found
+// through a hash index; like the engine's, the iteration order is not the insertion order once
+// pairs have been removed.
+template <typename KeyType, typename ValueType>
+class TMap
+{
+public:
+    typedef TPair<KeyType, ValueType> ElementType;
+
+    int32 Num() const { return Pairs.Num(); }
+    void Reset() { Pairs.Reset(); Lookup.clear(); }
+    void Empty() { Pairs.Empty(); Lookup.clear(); }
+    void Reserve(int32 Count) { Pairs.Reserve(Count); Lookup.reserve(Count); }
+
+    ValueType& Add(const KeyType& Key) { return Add(Key, ValueType()); }
+    ValueType& Add(const KeyType& Key, const ValueType& Value)
+    {
+        if (ValueType* Existing = Find(Key))
+        {
+            *Existing = Value;
+            return *Existing;
+        }
+        Lookup.emplace(Key, Pairs.Num());
+        Pairs.Add(ElementType(Key, Value));
+        return Pairs.Last().Value;
+    }
+    ValueType& FindOrAdd(const KeyType& Key)
+    {
+        ValueType* Existing = Find(Key);
+        return Existing ? *Existing : Add(Key);
+    }
+
+    ValueType* Find(const KeyType& Key)
+    {
+        const int32 Index = IndexOf(Key);
+        return Index != INDEX_NONE ? &Pairs[Index].Value : nullptr;
+    }
+    const ValueType* Find(const KeyType& Key) const { return const_cast<TMap*>(this)->Find(Key); }
+    ValueType FindRef(const KeyType& Key) const
+    {
+        const ValueType* Value = Find(Key);
+        return Value ? *Value : ValueType();
+    }
+    ValueType& FindChecked(const KeyType& Key) { ValueType* Value = Find(Key); check(Value); return *Value; }
+    ValueType& operator[](const KeyType& Key) { return FindChecked(Key); }
+    bool Contains(const KeyType& Key) const { return IndexOf(Key) != INDEX_NONE; }
+
+    int32 Remove(const KeyType& Key)
+    {
+        const int32 Index = IndexOf(Key);
+        if (Index == INDEX_NONE)
+        {
+            return 0;
+        }
+        RemoveIndex(Index);
+        return 1;
+    }
+    bool RemoveAndCopyValue(const KeyType& Key, ValueType& OutValue)
+    {
+        const int32 Index = IndexOf(Key);
+        if (Index == INDEX_NONE)
+        {
+            return false;
+        }
+        OutValue = MoveTemp(Pairs[Index].Value);
+        RemoveIndex(Index);
+        return true;
+    }
+
+    void GenerateKeyArray(TArray<KeyType>& OutKeys) const
+    {
+        OutKeys.Reset();
+        for (const ElementType& Pair : Pairs)
+        {
+            OutKeys.Add(Pair.Key);
+        }
+    }
+
+    class TIterator
+    {
+    public:
+        explicit TIterator(TMap& InMap) : Map(InMap), Index(0) {}
+        explicit operator bool() const { return Index < Map.Pairs.Num(); }
+        TIterator& operator++() { ++Index; return *this; }
+        const KeyType& Key() const { return Map.Pairs[Index].Key; }
+        ValueType& Value() const { return Map.Pairs[Index].Value; }
+        void RemoveCurrent()
+        {
+            // The last pair moves into this slot, so step back for the caller's increment
+            Map.RemoveIndex(Index--);
+        }
+
+    private:
+        TMap& Map;
+        int32 Index;
+    };
+    TIterator CreateIterator() { return TIterator(*this); }
+
+    ElementType* begin() { return Pairs.begin(); }
+    ElementType* end() { return Pairs.end(); }
+    const ElementType* begin() const { return Pairs.begin(); }
+    const ElementType* end() const { return Pairs.end(); }
+
+private:
+    int32 IndexOf(const KeyType& Key) const
+    {
+        const auto Found = Lookup.find(Key);
+        return Found != Lookup.end() ? Found->second : INDEX_NONE;
+    }
+
+    void RemoveIndex(int32 Index)
+    {
+        Lookup.erase(Pairs[Index].Key);
+        const int32 LastIndex = Pairs.Num() - 1;
+        if (Index != LastIndex)
+        {
+            Lookup[Pairs[LastIndex].Key] = Index;
+        }
+        Pairs.RemoveAtSwap(Index);
+    }
+
+    TArray<ElementType> Pairs;
+    std::unordered_map<KeyType, int32, FShimKeyHash> Lookup;
+};
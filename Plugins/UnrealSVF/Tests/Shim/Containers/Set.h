@@ -0,0 +1,35 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/TypeHash.h"
+#include <unordered_set>
+
+// Hash set with the TSet interface the plugin uses
+template <typename ElementType>
+class TSet
+{
+public:
+    int32 Num() const { return static_cast<int32>(Elements.size()); }
+    void Reset() { Elements.clear(); }
+    void Empty() { Elements.clear(); }
+    void Reserve(int32 Count) { Elements.reserve(Count); }
+
+    void Add(const ElementType& Element, bool* bIsAlreadyInSetPtr = nullptr)
+    {
+        const bool bInserted = Elements.insert(Element).second;
+        if (bIsAlreadyInSetPtr)
+        {
+            *bIsAlreadyInSetPtr = !bInserted;
+        }
+    }
+    bool Contains(const ElementType& Element) const { return Elements.count(Element) != 0; }
+    int32 Remove(const ElementType& Element) { return static_cast<int32>(Elements.erase(Element)); }
+
+    auto begin() const { return Elements.begin(); }
+    auto end() const { return Elements.end(); }
+
+private:
+    std::unordered_set<ElementType, FShimKeyHash> Elements;
+};
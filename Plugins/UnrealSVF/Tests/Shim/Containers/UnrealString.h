@@ -0,0 +1,34 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <string>
+
+// Narrow character string with the FString interface the plugin uses
+class FString
+{
+public:
+    FString() = default;
+    FString(const TCHAR* Str) : Data(Str ? Str : "") {}
+    explicit FString(const std::string& Str) : Data(Str) {}
+
+    const TCHAR* operator*() const { return Data.c_str(); }
+    int32 Len() const { return static_cast<int32>(Data.size()); }
+    bool IsEmpty() const { return Data.empty(); }
+    void Empty() { Data.clear(); }
+    void Reset() { Data.clear(); }
+
+    FString& operator+=(const FString& Other) { Data += Other.Data; return *this; }
+    friend FString operator+(const FString& A, const FString& B) { return FString(A.Data + B.Data); }
+    bool operator==(const FString& Other) const { return Data == Other.Data; }
+    bool operator!=(const FString& Other) const { return Data != Other.Data; }
+    bool operator<(const FString& Other) const { return Data < Other.Data; }
+
+    static FString FromInt(int32 Value) { return FString(std::to_string(Value)); }
+
+    friend uint32 GetTypeHash(const FString& Str) { return static_cast<uint32>(std::hash<std::string>()(Str.Data)); }
+
+private:
+    std::string Data;
+};
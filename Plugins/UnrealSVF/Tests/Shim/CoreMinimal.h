@@ -0,0 +1,170 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+// The slice of the engine's Core module that the engine independent plugin sources use, enough to build
+// them unchanged in the standalone tests. Behaviour follows UE 4.26 where the tests depend on it.
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+typedef uint8_t uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef uint64_t uint64;
+typedef int8_t int8;
+typedef int16_t int16;
+typedef int32_t int32;
+typedef int64_t int64;
+typedef char TCHAR;
+typedef char ANSICHAR;
+typedef size_t SIZE_T;
+
+#define PLATFORM_WINDOWS 0
+#define PLATFORM_ANDROID 0
+#define FORCEINLINE inline
+#define FORCENOINLINE
+#define TEXT(x) x
+#define INDEX_NONE (-1)
+#define UE_ARRAY_COUNT(Array) (sizeof(Array) / sizeof((Array)[0]))
+#define SMALL_NUMBER (1.e-8f)
+#define KINDA_SMALL_NUMBER (1.e-4f)
+#define BIG_NUMBER (3.4e+38f)
+#define MAX_int32 (std::numeric_limits<int32>::max())
+#define MAX_uint32 (std::numeric_limits<uint32>::max())
+#define MAX_flt (3.402823466e+38F)
+#define PI (3.1415926535897932f)
+#define HALF_PI (1.57079632679f)
+
+#define check(Expr) do { if (!(Expr)) { std::fprintf(stderr, "check failed: %s (%s:%d)\n", #Expr, __FILE__, __LINE__); std::abort(); } } while (0)
+#define checkf(Expr, ...) check(Expr)
+#define checkSlow(Expr) check(Expr)
+#define verify(Expr) check(Expr)
+#define ensure(Expr) (!!(Expr))
+#define ensureMsgf(Expr, ...) (!!(Expr))
+#define PURE_VIRTUAL(Func, ...) { check(!"Pure virtual not implemented: " #Func); __VA_ARGS__ }
+
+// Logging and stats compile away
+#define DECLARE_LOG_CATEGORY_EXTERN(...)
+#define DEFINE_LOG_CATEGORY(...)
+#define DEFINE_LOG_CATEGORY_STATIC(...)
+#define UE_LOG(...) do { } while (0)
+#define DECLARE_STATS_GROUP(...)
+#define DECLARE_CYCLE_STAT(...)
+#define DECLARE_CYCLE_STAT_EXTERN(...)
+#define DEFINE_STAT(...)
+#define SCOPE_CYCLE_COUNTER(...)
+#define QUICK_SCOPE_CYCLE_COUNTER(...)
+#define TRACE_CPUPROFILER_EVENT_SCOPE(...)
+
+struct FVector;
+
+struct FMath
+{
+    template <typename T> static constexpr T Max(T A, T B) { return A >= B ? A : B; }
+    template <typename T> static constexpr T Min(T A, T B) { return A <= B ? A : B; }
+    template <typename T> static constexpr T Max3(T A, T B, T C) { return Max(Max(A, B), C); }
+    template <typename T> static constexpr T Min3(T A, T B, T C) { return Min(Min(A, B), C); }
+    template <typename T> static constexpr T Clamp(T X, T Low, T High) { return X < Low ? Low : X < High ? X : High; }
+    template <typename T> static constexpr T Abs(T A) { return A >= T(0) ? A : -A; }
+    template <typename T> static constexpr T Square(T A) { return A * A; }
+    template <typename T> static constexpr T Sign(T A) { return A > T(0) ? T(1) : A < T(0) ? T(-1) : T(0); }
+    template <typename T, typename U> static T Lerp(const T& A, const T& B, const U& Alpha) { return (T)(A + Alpha * (B - A)); }
+    template <typename T> static void SwapValues(T& A, T& B) { std::swap(A, B); }
+
+    static int32 TruncToInt(float F) { return static_cast<int32>(F); }
+    static float TruncToFloat(float F) { return std::trunc(F); }
+    static int32 FloorToInt(float F) { return static_cast<int32>(std::floor(F)); }
+    static float FloorToFloat(float F) { return std::floor(F); }
+    static double FloorToDouble(double F) { return std::floor(F); }
+    static int32 CeilToInt(float F) { return static_cast<int32>(std::ceil(F)); }
+    static float CeilToFloat(float F) { return std::ceil(F); }
+    static double CeilToDouble(double F) { return std::ceil(F); }
+    static int32 RoundToInt(float F) { return FloorToInt(F + 0.5f); }
+    static float RoundToFloat(float F) { return FloorToFloat(F + 0.5f); }
+    static double RoundToDouble(double F) { return std::floor(F + 0.5); }
+    static float Frac(float F) { return F - FloorToFloat(F); }
+    static float Fmod(float X, float Y) { return std::fmod(X, Y); }
+
+    static float Sqrt(float F) { return std::sqrt(F); }
+    static double Sqrt(double F) { return std::sqrt(F); }
+    static float InvSqrt(float F) { return 1.f / std::sqrt(F); }
+    static float Pow(float A, float B) { return std::pow(A, B); }
+    static float Loge(float F) { return std::log(F); }
+    static float Exp(float F) { return std::exp(F); }
+    static float Sin(float F) { return std::sin(F); }
+    static float Cos(float F) { return std::cos(F); }
+    static float Tan(float F) { return std::tan(F); }
+    static float Acos(float F) { return std::acos(F); }
+    static float Atan2(float Y, float X) { return std::atan2(Y, X); }
+    static void SinCos(float* S, float* C, float F) { *S = std::sin(F); *C = std::cos(F); }
+
+    static bool IsNearlyEqual(float A, float B, float Tolerance = SMALL_NUMBER) { return Abs(A - B) <= Tolerance; }
+    static bool IsNearlyEqual(double A, double B, double Tolerance = SMALL_NUMBER) { return Abs(A - B) <= Tolerance; }
+    static bool IsNearlyZero(float A, float Tolerance = SMALL_NUMBER) { return Abs(A) <= Tolerance; }
+    static bool IsNaN(float A) { return std::isnan(A); }
+    static bool IsFinite(float A) { return std::isfinite(A); }
+    static bool IsPowerOfTwo(uint32 A) { return A != 0 && (A & (A - 1)) == 0; }
+    static uint32 RoundUpToPowerOfTwo(uint32 A) { uint32 P = 1; while (P < A) { P <<= 1; } return P; }
+    static uint32 FloorLog2(uint32 A) { uint32 L = 0; while (A >>= 1) { ++L; } return L; }
+    static uint32 CeilLogTwo(uint32 A) { return A <= 1 ? 0 : FloorLog2(A - 1) + 1; }
+    template <typename T> static constexpr T DivideAndRoundUp(T A, T B) { return (A + B - 1) / B; }
+    template <typename T> static constexpr T DivideAndRoundDown(T A, T B) { return A / B; }
+
+    // Defined with FVector in Math/Vector.h
+    static FVector ClosestPointOnTriangleToPoint(const FVector& Point, const FVector& A, const FVector& B, const FVector& C);
+};
+
+template <typename T> inline void Swap(T& A, T& B) { std::swap(A, B); }
+template <typename T> inline void Exchange(T& A, T& B) { std::swap(A, B); }
+template <typename T> inline std::remove_reference_t<T>&& MoveTemp(T&& Value) { return static_cast<std::remove_reference_t<T>&&>(Value); }
+template <typename T> inline T&& Forward(std::remove_reference_t<T>& Value) { return static_cast<T&&>(Value); }
+
+struct FMemory
+{
+    static void* Memcpy(void* Dest, const void* Src, SIZE_T Count) { return std::memcpy(Dest, Src, Count); }
+    static void* Memmove(void* Dest, const void* Src, SIZE_T Count) { return std::memmove(Dest, Src, Count); }
+    static int32 Memcmp(const void* A, const void* B, SIZE_T Count) { return std::memcmp(A, B, Count); }
+    static void* Memset(void* Dest, uint8 Value, SIZE_T Count) { return std::memset(Dest, Value, Count); }
+    static void* Memzero(void* Dest, SIZE_T Count) { return std::memset(Dest, 0, Count); }
+    template <typename T> static void Memzero(T& Value) { std::memset(&Value, 0, sizeof(T)); }
+    static void* Malloc(SIZE_T Count, uint32 Alignment = 16)
+    {
+        return Alignment <= 16 ? std::malloc(Count ? Count : 1) : std::aligned_alloc(Alignment, (Count + Alignment - 1) / Alignment * Alignment);
+    }
+    static void Free(void* Ptr) { std::free(Ptr); }
+};
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/Set.h"
+#include "Containers/UnrealString.h"
+#include "Math/Vector.h"
+#include "Math/Color.h"
+#include "Math/RandomStream.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/Function.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/Timespan.h"
+#include "PixelFormat.h"
+#include "Serialization/Archive.h"
@@ -0,0 +1,15 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PackedNormal.h"
+
+// The members of the engine's dynamic mesh vertex the plugin reads back
+struct FDynamicMeshVertex
+{
+    FVector Position;
+    FVector2D TextureCoordinate[8];
+    FPackedNormal TangentX;
+    FPackedNormal TangentZ;
+};
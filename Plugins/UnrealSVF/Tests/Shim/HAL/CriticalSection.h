@@ -0,0 +1,17 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Recursive like the engine's critical section
+class FCriticalSection
+{
+public:
+    void Lock() { Mutex.lock(); }
+    bool TryLock() { return Mutex.try_lock(); }
+    void Unlock() { Mutex.unlock(); }
+
+private:
+    std::recursive_mutex Mutex;
+};
@@ -0,0 +1,12 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FPlatformProcess
+{
+    static void Sleep(float Seconds) { std::this_thread::sleep_for(std::chrono::duration<float>(Seconds)); }
+    static void SleepNoStats(float Seconds) { Sleep(Seconds); }
+    static void YieldThread() { std::this_thread::yield(); }
+};
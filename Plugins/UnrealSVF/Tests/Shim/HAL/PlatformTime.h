@@ -0,0 +1,21 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FPlatformTime
+{
+    static double Seconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    static uint32 Cycles() { return static_cast<uint32>(Cycles64()); }
+    static uint64 Cycles64()
+    {
+        return static_cast<uint64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+    static double GetSecondsPerCycle() { return 1e-6; }
+    static double ToSeconds(uint32 Cycles) { return Cycles * GetSecondsPerCycle(); }
+    static double ToMilliseconds(uint32 Cycles) { return Cycles * GetSecondsPerCycle() * 1000.0; }
+};
@@ -0,0 +1,22 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Increment and Decrement return the new value, like the engine's
+class FThreadSafeCounter
+{
+public:
+    FThreadSafeCounter(int32 InValue = 0) : Counter(InValue) {}
+
+    int32 Increment() { return ++Counter; }
+    int32 Decrement() { return --Counter; }
+    int32 Add(int32 Amount) { return Counter.fetch_add(Amount); }
+    int32 Set(int32 Value) { return Counter.exchange(Value); }
+    int32 Reset() { return Counter.exchange(0); }
+    int32 GetValue() const { return Counter.load(); }
+
+private:
+    std::atomic<int32> Counter;
+};
@@ -0,0 +1,10 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+
+class UBlueprintFunctionLibrary : public UObject
+{
+};
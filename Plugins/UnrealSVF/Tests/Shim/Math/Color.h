@@ -0,0 +1,15 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+// Eight bit colour in the engine's BGRA memory order
+struct FColor
+{
+    uint8 B = 0;
+    uint8 G = 0;
+    uint8 R = 0;
+    uint8 A = 0;
+
+    FColor() = default;
+    FColor(uint8 InR, uint8 InG, uint8 InB, uint8 InA = 255) : B(InB), G(InG), R(InR), A(InA) {}
+};
@@ -0,0 +1,42 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// UE 4.26's linear congruential stream, the same sequence for the same seed
+struct FRandomStream
+{
+    FRandomStream() = default;
+    explicit FRandomStream(int32 InSeed) { Initialize(InSeed); }
+
+    void Initialize(int32 InSeed) { InitialSeed = Seed = InSeed; }
+    void Reset() const { Seed = InitialSeed; }
+    int32 GetInitialSeed() const { return InitialSeed; }
+
+    float GetFraction() const
+    {
+        MutateSeed();
+        const uint32 Bits = 0x3F800000U | (static_cast<uint32>(Seed) >> 9);
+        float Result;
+        FMemory::Memcpy(&Result, &Bits, sizeof(Result));
+        return Result - 1.f;
+    }
+
+    uint32 GetUnsignedInt() const
+    {
+        MutateSeed();
+        return static_cast<uint32>(Seed);
+    }
+
+    float FRand() const { return GetFraction(); }
+    int32 RandHelper(int32 A) const { return A > 0 ? FMath::Min(FMath::TruncToInt(GetFraction() * A), A - 1) : 0; }
+    int32 RandRange(int32 Min, int32 Max) const { return Min + RandHelper(Max - Min + 1); }
+    float FRandRange(float InMin, float InMax) const { return InMin + (InMax - InMin) * FRand(); }
+
+private:
+    void MutateSeed() const { Seed = static_cast<int32>(static_cast<uint32>(Seed) * 196314165U + 907633515U); }
+
+    int32 InitialSeed = 0;
+    mutable int32 Seed = 0;
+};
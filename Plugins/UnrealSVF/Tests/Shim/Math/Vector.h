@@ -0,0 +1,429 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum EForceInit
+{
+    ForceInit,
+    ForceInitToZero
+};
+
+struct FVector2D
+{
+    float X = 0.f;
+    float Y = 0.f;
+
+    FVector2D() = default;
+    constexpr FVector2D(float InX, float InY) : X(InX), Y(InY) {}
+    explicit FVector2D(EForceInit) {}
+
+    FVector2D operator+(const FVector2D& V) const { return FVector2D(X + V.X, Y + V.Y); }
+    FVector2D operator-(const FVector2D& V) const { return FVector2D(X - V.X, Y - V.Y); }
+    FVector2D operator*(float Scale) const { return FVector2D(X * Scale, Y * Scale); }
+    FVector2D operator/(float Scale) const { return FVector2D(X / Scale, Y / Scale); }
+    FVector2D& operator+=(const FVector2D& V) { X += V.X; Y += V.Y; return *this; }
+    bool operator==(const FVector2D& V) const { return X == V.X && Y == V.Y; }
+    bool operator!=(const FVector2D& V) const { return !(*this == V); }
+    float Size() const { return std::sqrt(X * X + Y * Y); }
+    float SizeSquared() const { return X * X + Y * Y; }
+    static float DotProduct(const FVector2D& A, const FVector2D& B) { return A.X * B.X + A.Y * B.Y; }
+
+    static const FVector2D ZeroVector;
+    static const FVector2D UnitVector;
+};
+inline const FVector2D FVector2D::ZeroVector(0.f, 0.f);
+inline const FVector2D FVector2D::UnitVector(1.f, 1.f);
+
+struct FVector
+{
+    float X = 0.f;
+    float Y = 0.f;
+    float Z = 0.f;
+
+    FVector() = default;
+    explicit constexpr FVector(float InF) : X(InF), Y(InF), Z(InF) {}
+    constexpr FVector(float InX, float InY, float InZ) : X(InX), Y(InY), Z(InZ) {}
+    explicit FVector(EForceInit) {}
+    FVector(const FVector2D& V, float InZ) : X(V.X), Y(V.Y), Z(InZ) {}
+    explicit FVector(const struct FIntVector& V);
+
+    FVector operator+(const FVector& V) const { return FVector(X + V.X, Y + V.Y, Z + V.Z); }
+    FVector operator-(const FVector& V) const { return FVector(X - V.X, Y - V.Y, Z - V.Z); }
+    FVector operator*(const FVector& V) const { return FVector(X * V.X, Y * V.Y, Z * V.Z); }
+    FVector operator/(const FVector& V) const { return FVector(X / V.X, Y / V.Y, Z / V.Z); }
+    FVector operator+(float Bias) const { return FVector(X + Bias, Y + Bias, Z + Bias); }
+    FVector operator-(float Bias) const { return FVector(X - Bias, Y - Bias, Z - Bias); }
+    FVector operator*(float Scale) const { return FVector(X * Scale, Y * Scale, Z * Scale); }
+    FVector operator/(float Scale) const { const float RScale = 1.f / Scale; return FVector(X * RScale, Y * RScale, Z * RScale); }
+    FVector operator-() const { return FVector(-X, -Y, -Z); }
+    // Cross product
+    FVector operator^(const FVector& V) const { return FVector(Y * V.Z - Z * V.Y, Z * V.X - X * V.Z, X * V.Y - Y * V.X); }
+    // Dot product
+    float operator|(const FVector& V) const { return X * V.X + Y * V.Y + Z * V.Z; }
+    FVector& operator+=(const FVector& V) { X += V.X; Y += V.Y; Z += V.Z; return *this; }
+    FVector& operator-=(const FVector& V) { X -= V.X; Y -= V.Y; Z -= V.Z; return *this; }
+    FVector& operator*=(const FVector& V) { X *= V.X; Y *= V.Y; Z *= V.Z; return *this; }
+    FVector& operator*=(float Scale) { X *= Scale; Y *= Scale; Z *= Scale; return *this; }
+    FVector& operator/=(float Scale) { const float RScale = 1.f / Scale; X *= RScale; Y *= RScale; Z *= RScale; return *this; }
+    bool operator==(const FVector& V) const { return X == V.X && Y == V.Y && Z == V.Z; }
+    bool operator!=(const FVector& V) const { return !(*this == V); }
+    float& operator[](int32 Index) { return (&X)[Index]; }
+    float operator[](int32 Index) const { return (&X)[Index]; }
+
+    float Size() const { return std::sqrt(X * X + Y * Y + Z * Z); }
+    float SizeSquared() const { return X * X + Y * Y + Z * Z; }
+    float Size2D() const { return std::sqrt(X * X + Y * Y); }
+    float GetMax() const { return FMath::Max3(X, Y, Z); }
+    float GetMin() const { return FMath::Min3(X, Y, Z); }
+    float GetAbsMax() const { return FMath::Max3(FMath::Abs(X), FMath::Abs(Y), FMath::Abs(Z)); }
+    FVector GetAbs() const { return FVector(FMath::Abs(X), FMath::Abs(Y), FMath::Abs(Z)); }
+    FVector ComponentMin(const FVector& V) const { return FVector(FMath::Min(X, V.X), FMath::Min(Y, V.Y), FMath::Min(Z, V.Z)); }
+    FVector ComponentMax(const FVector& V) const { return FVector(FMath::Max(X, V.X), FMath::Max(Y, V.Y), FMath::Max(Z, V.Z)); }
+    bool IsZero() const { return X == 0.f && Y == 0.f && Z == 0.f; }
+    bool IsNearlyZero(float Tolerance = KINDA_SMALL_NUMBER) const { return GetAbsMax() <= Tolerance; }
+    bool Equals(const FVector& V, float Tolerance = KINDA_SMALL_NUMBER) const { return (*this - V).GetAbsMax() <= Tolerance; }
+    bool ContainsNaN() const { return !std::isfinite(X) || !std::isfinite(Y) || !std::isfinite(Z); }
+
+    FVector GetSafeNormal(float Tolerance = SMALL_NUMBER) const
+    {
+        const float SquareSum = SizeSquared();
+        if (SquareSum == 1.f)
+        {
+            return *this;
+        }
+        if (SquareSum < Tolerance)
+        {
+            return FVector(0.f);
+        }
+        return *this * FMath::InvSqrt(SquareSum);
+    }
+    FVector GetUnsafeNormal() const { return *this * FMath::InvSqrt(SizeSquared()); }
+    bool Normalize(float Tolerance = SMALL_NUMBER)
+    {
+        const float SquareSum = SizeSquared();
+        if (SquareSum > Tolerance)
+        {
+            *this *= FMath::InvSqrt(SquareSum);
+            return true;
+        }
+        return false;
+    }
+
+    static float DotProduct(const FVector& A, const FVector& B) { return A | B; }
+    static FVector CrossProduct(const FVector& A, const FVector& B) { return A ^ B; }
+    static float Dist(const FVector& A, const FVector& B) { return (A - B).Size(); }
+    static float Distance(const FVector& A, const FVector& B) { return (A - B).Size(); }
+    static float DistSquared(const FVector& A, const FVector& B) { return (A - B).SizeSquared(); }
+    static FVector Min(const FVector& A, const FVector& B) { return A.ComponentMin(B); }
+    static FVector Max(const FVector& A, const FVector& B) { return A.ComponentMax(B); }
+
+    static const FVector ZeroVector;
+    static const FVector OneVector;
+    static const FVector UpVector;
+    static const FVector ForwardVector;
+    static const FVector RightVector;
+};
+inline const FVector FVector::ZeroVector(0.f, 0.f, 0.f);
+inline const FVector FVector::OneVector(1.f, 1.f, 1.f);
+inline const FVector FVector::UpVector(0.f, 0.f, 1.f);
+inline const FVector FVector::ForwardVector(1.f, 0.f, 0.f);
+inline const FVector FVector::RightVector(0.f, 1.f, 0.f);
+
+inline FVector operator*(float Scale, const FVector& V) { return V * Scale; }
+
+// Region test over the triangle's Voronoi regions (Ericson, Real-Time Collision Detection 5.1.5)
+inline FVector FMath::ClosestPointOnTriangleToPoint(const FVector& P, const FVector& A, const FVector& B, const FVector& C)
+{
+    const FVector AB = B - A;
+    const FVector AC = C - A;
+    const FVector AP = P - A;
+    const float D1 = AB | AP;
+    const float D2 = AC | AP;
+    if (D1 <= 0.f && D2 <= 0.f)
+    {
+        return A;
+    }
+    const FVector BP = P - B;
+    const float D3 = AB | BP;
+    const float D4 = AC | BP;
+    if (D3 >= 0.f && D4 <= D3)
+    {
+        return B;
+    }
+    const float VC = D1 * D4 - D3 * D2;
+    if (VC <= 0.f && D1 >= 0.f && D3 <= 0.f)
+    {
+        return A + AB * (D1 / (D1 - D3));
+    }
+    const FVector CP = P - C;
+    const float D5 = AB | CP;
+    const float D6 = AC | CP;
+    if (D6 >= 0.f && D5 <= D6)
+    {
+        return C;
+    }
+    const float VB = D5 * D2 - D1 * D6;
+    if (VB <= 0.f && D2 >= 0.f && D6 <= 0.f)
+    {
+        return A + AC * (D2 / (D2 - D6));
+    }
+    const float VA = D3 * D6 - D5 * D4;
+    if (VA <= 0.f && (D4 - D3) >= 0.f && (D5 - D6) >= 0.f)
+    {
+        return B + (C - B) * ((D4 - D3) / ((D4 - D3) + (D5 - D6)));
+    }
+    const float Denom = 1.f / (VA + VB + VC);
+    return A + AB * (VB * Denom) + AC * (VC * Denom);
+}
+
+struct FVector4
+{
+    float X = 0.f;
+    float Y = 0.f;
+    float Z = 0.f;
+    float W = 0.f;
+
+    FVector4() = default;
+    constexpr FVector4(float InX, float InY, float InZ, float InW = 1.f) : X(InX), Y(InY), Z(InZ), W(InW) {}
+    FVector4(const FVector& V, float InW = 1.f) : X(V.X), Y(V.Y), Z(V.Z), W(InW) {}
+    float& operator[](int32 Index) { return (&X)[Index]; }
+    float operator[](int32 Index) const { return (&X)[Index]; }
+};
+
+struct FIntVector
+{
+    int32 X = 0;
+    int32 Y = 0;
+    int32 Z = 0;
+
+    FIntVector() = default;
+    constexpr FIntVector(int32 InX, int32 InY, int32 InZ) : X(InX), Y(InY), Z(InZ) {}
+    explicit FIntVector(EForceInit) {}
+    int32& operator[](int32 Index) { return (&X)[Index]; }
+    int32 operator[](int32 Index) const { return (&X)[Index]; }
+    bool operator==(const FIntVector& V) const { return X == V.X && Y == V.Y && Z == V.Z; }
+    bool operator!=(const FIntVector& V) const { return !(*this == V); }
+    friend uint32 GetTypeHash(const FIntVector& V) { return HashCombine(HashCombine(V.X, V.Y), V.Z); }
+};
+
+inline FVector::FVector(const FIntVector& V) : X(static_cast<float>(V.X)), Y(static_cast<float>(V.Y)), Z(static_cast<float>(V.Z)) {}
+
+struct FPlane : public FVector
+{
+    float W = 0.f;
+
+    FPlane() = default;
+    constexpr FPlane(float InX, float InY, float InZ, float InW) : FVector(InX, InY, InZ), W(InW) {}
+    FPlane(const FVector& InNormal, float InW) : FVector(InNormal), W(InW) {}
+    // Plane through Point with the given normal
+    FPlane(const FVector& Point, const FVector& Normal) : FVector(Normal), W(Point | Normal) {}
+    float PlaneDot(const FVector& P) const { return X * P.X + Y * P.Y + Z * P.Z - W; }
+};
+
+// Row vector convention as in the engine: positions transform as P * M, the translation is the last row
+struct FMatrix
+{
+    float M[4][4];
+
+    FMatrix() = default;
+    explicit FMatrix(EForceInit) { std::memset(M, 0, sizeof(M)); }
+    FMatrix(const FVector& InX, const FVector& InY, const FVector& InZ, const FVector& InW)
+    {
+        const FVector* Rows[4] = { &InX, &InY, &InZ, &InW };
+        for (int32 Row = 0; Row < 4; ++Row)
+        {
+            M[Row][0] = Rows[Row]->X;
+            M[Row][1] = Rows[Row]->Y;
+            M[Row][2] = Rows[Row]->Z;
+            M[Row][3] = Row == 3 ? 1.f : 0.f;
+        }
+    }
+
+    FVector TransformPosition(const FVector& P) const { return TransformVector(P) + FVector(M[3][0], M[3][1], M[3][2]); }
+    FVector TransformVector(const FVector& V) const
+    {
+        return FVector(V.X * M[0][0] + V.Y * M[1][0] + V.Z * M[2][0], V.X * M[0][1] + V.Y * M[1][1] + V.Z * M[2][1],
+            V.X * M[0][2] + V.Y * M[1][2] + V.Z * M[2][2]);
+    }
+    FMatrix operator*(const FMatrix& Other) const
+    {
+        FMatrix Result(ForceInit);
+        for (int32 Row = 0; Row < 4; ++Row)
+        {
+            for (int32 Column = 0; Column < 4; ++Column)
+            {
+                for (int32 Index = 0; Index < 4; ++Index)
+                {
+                    Result.M[Row][Column] += M[Row][Index] * Other.M[Index][Column];
+                }
+            }
+        }
+        return Result;
+    }
+
+    static const FMatrix Identity;
+};
+inline const FMatrix FMatrix::Identity(FVector(1.f, 0.f, 0.f), FVector(0.f, 1.f, 0.f), FVector(0.f, 0.f, 1.f), FVector(0.f));
+
+struct FTranslationMatrix : public FMatrix
+{
+    explicit FTranslationMatrix(const FVector& Delta) : FMatrix(FVector(1.f, 0.f, 0.f), FVector(0.f, 1.f, 0.f), FVector(0.f, 0.f, 1.f), Delta) {}
+};
+
+struct FScaleMatrix : public FMatrix
+{
+    explicit FScaleMatrix(const FVector& Scale) : FMatrix(FVector(Scale.X, 0.f, 0.f), FVector(0.f, Scale.Y, 0.f), FVector(0.f, 0.f, Scale.Z), FVector(0.f)) {}
+};
+
+struct FBox
+{
+    FVector Min;
+    FVector Max;
+    uint8 IsValid = 0;
+
+    FBox() = default;
+    explicit FBox(EForceInit) {}
+    FBox(const FVector& InMin, const FVector& InMax) : Min(InMin), Max(InMax), IsValid(1) {}
+    FBox(const FVector* Points, int32 Count)
+    {
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            *this += Points[Index];
+        }
+    }
+
+    FBox& operator+=(const FVector& Point)
+    {
+        if (IsValid)
+        {
+            Min = Min.ComponentMin(Point);
+            Max = Max.ComponentMax(Point);
+        }
+        else
+        {
+            Min = Max = Point;
+            IsValid = 1;
+        }
+        return *this;
+    }
+    FBox& operator+=(const FBox& Other)
+    {
+        if (IsValid && Other.IsValid)
+        {
+            Min = Min.ComponentMin(Other.Min);
+            Max = Max.ComponentMax(Other.Max);
+        }
+        else if (Other.IsValid)
+        {
+            *this = Other;
+        }
+        return *this;
+    }
+    FBox operator+(const FBox& Other) const { return FBox(*this) += Other; }
+    bool operator==(const FBox& Other) const { return Min == Other.Min && Max == Other.Max; }
+
+    FVector GetCenter() const { return (Min + Max) * 0.5f; }
+    FVector GetExtent() const { return (Max - Min) * 0.5f; }
+    FVector GetSize() const { return Max - Min; }
+    float GetVolume() const { return (Max.X - Min.X) * (Max.Y - Min.Y) * (Max.Z - Min.Z); }
+    void GetCenterAndExtents(FVector& Center, FVector& Extents) const { Extents = GetExtent(); Center = Min + Extents; }
+    FBox ExpandBy(float W) const { return FBox(Min - FVector(W), Max + FVector(W)); }
+    FBox ShiftBy(const FVector& Offset) const { return FBox(Min + Offset, Max + Offset); }
+    bool IsInside(const FVector& P) const { return P.X > Min.X && P.X < Max.X && P.Y > Min.Y && P.Y < Max.Y && P.Z > Min.Z && P.Z < Max.Z; }
+    bool IsInsideOrOn(const FVector& P) const { return P.X >= Min.X && P.X <= Max.X && P.Y >= Min.Y && P.Y <= Max.Y && P.Z >= Min.Z && P.Z <= Max.Z; }
+    bool IsInside(const FBox& Other) const { return IsInside(Other.Min) && IsInside(Other.Max); }
+    bool Intersect(const FBox& Other) const
+    {
+        return !(Min.X > Other.Max.X || Other.Min.X > Max.X || Min.Y > Other.Max.Y || Other.Min.Y > Max.Y ||
+            Min.Z > Other.Max.Z || Other.Min.Z > Max.Z);
+    }
+    float ComputeSquaredDistanceToPoint(const FVector& P) const
+    {
+        const FVector Closest = P.ComponentMax(Min).ComponentMin(Max);
+        return (P - Closest).SizeSquared();
+    }
+    FVector GetClosestPointTo(const FVector& P) const { return P.ComponentMax(Min).ComponentMin(Max); }
+    void Init() { Min = Max = FVector::ZeroVector; IsValid = 0; }
+    static FBox BuildAABB(const FVector& Origin, const FVector& Extent) { return FBox(Origin - Extent, Origin + Extent); }
+    FBox TransformBy(const FMatrix& Matrix) const
+    {
+        FBox Result(ForceInit);
+        if (IsValid)
+        {
+            for (int32 Corner = 0; Corner < 8; ++Corner)
+            {
+                Result += Matrix.TransformPosition(FVector((Corner & 1) ? Max.X : Min.X, (Corner & 2) ? Max.Y : Min.Y, (Corner & 4) ? Max.Z : Min.Z));
+            }
+        }
+        return Result;
+    }
+};
+
+// Half float with the UE 4.26 conversion: normal values truncate, values below the half range round into
+// denormals and values above it clamp to the largest finite half
+class FFloat16
+{
+public:
+    uint16 Encoded = 0;
+
+    FFloat16() = default;
+    FFloat16(float Value) { Set(Value); }
+    FFloat16& operator=(float Value) { Set(Value); return *this; }
+    operator float() const { return GetFloat(); }
+
+    void Set(float Value)
+    {
+        uint32 Bits;
+        std::memcpy(&Bits, &Value, sizeof(Bits));
+        const uint32 Sign = Bits >> 31;
+        const uint32 Exponent = (Bits >> 23) & 0xff;
+        const uint32 Mantissa = Bits & 0x7fffff;
+
+        uint32 Result = 0;
+        if (Exponent <= 112)
+        {
+            const int32 NewExp = static_cast<int32>(Exponent) - 127 + 15;
+            if ((14 - NewExp) <= 24)
+            {
+                const uint32 FullMantissa = Mantissa | 0x800000;
+                Result = (FullMantissa >> (14 - NewExp)) & 0x3ff;
+                if ((FullMantissa >> (13 - NewExp)) & 1)
+                {
+                    ++Result;
+                }
+            }
+        }
+        else if (Exponent >= 143)
+        {
+            Result = (30u << 10) | 1023u;
+        }
+        else
+        {
+            Result = ((Exponent - 127 + 15) << 10) | (Mantissa >> 13);
+        }
+        Encoded = static_cast<uint16>(Result | (Sign << 15));
+    }
+
+    float GetFloat() const
+    {
+        const uint32 Sign = Encoded >> 15;
+        const uint32 Exponent = (Encoded >> 10) & 0x1f;
+        const uint32 Mantissa = Encoded & 0x3ff;
+        float Value;
+        if (Exponent == 0)
+        {
+            Value = std::ldexp(static_cast<float>(Mantissa), -24);
+        }
+        else if (Exponent == 31)
+        {
+            Value = 65504.f;
+        }
+        else
+        {
+            Value = std::ldexp(static_cast<float>(Mantissa | 0x400), static_cast<int32>(Exponent) - 25);
+        }
+        return Sign ? -Value : Value;
+    }
+};
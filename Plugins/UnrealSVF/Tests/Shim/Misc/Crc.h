@@ -0,0 +1,34 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// The engine's MemCrc32 is the standard reflected CRC-32
+struct FCrc
+{
+    static uint32 MemCrc32(const void* Data, int32 Length, uint32 CRC = 0)
+    {
+        static const std::vector<uint32> Table = []()
+        {
+            std::vector<uint32> Result(256);
+            for (uint32 Index = 0; Index < 256; ++Index)
+            {
+                uint32 Value = Index;
+                for (int32 Bit = 0; Bit < 8; ++Bit)
+                {
+                    Value = (Value & 1) ? (Value >> 1) ^ 0xedb88320u : Value >> 1;
+                }
+                Result[Index] = Value;
+            }
+            return Result;
+        }();
+        CRC = ~CRC;
+        const uint8* Bytes = static_cast<const uint8*>(Data);
+        for (int32 Index = 0; Index < Length; ++Index)
+        {
+            CRC = (CRC >> 8) ^ Table[(CRC ^ Bytes[Index]) & 0xff];
+        }
+        return ~CRC;
+    }
+};
@@ -0,0 +1,36 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <fstream>
+#include <iterator>
+
+enum EFileRead
+{
+    FILEREAD_None = 0x00,
+    FILEREAD_Silent = 0x02
+};
+
+struct FFileHelper
+{
+    static bool LoadFileToArray(TArray<uint8>& Result, const TCHAR* Filename, uint32 Flags = 0)
+    {
+        std::ifstream File(Filename, std::ios::binary);
+        if (!File)
+        {
+            return false;
+        }
+        const std::vector<char> Bytes((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+        Result.Reset();
+        Result.Append(reinterpret_cast<const uint8*>(Bytes.data()), static_cast<int32>(Bytes.size()));
+        return true;
+    }
+
+    static bool SaveArrayToFile(const TArray<uint8>& Array, const TCHAR* Filename)
+    {
+        std::ofstream File(Filename, std::ios::binary | std::ios::trunc);
+        File.write(reinterpret_cast<const char*>(Array.GetData()), Array.Num());
+        return static_cast<bool>(File);
+    }
+};
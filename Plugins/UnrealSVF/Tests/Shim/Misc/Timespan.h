@@ -0,0 +1,22 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Ticks of 100 nanoseconds
+struct FTimespan
+{
+    int64 Ticks = 0;
+
+    FTimespan() = default;
+    explicit FTimespan(int64 InTicks) : Ticks(InTicks) {}
+
+    int64 GetTicks() const { return Ticks; }
+    double GetTotalSeconds() const { return Ticks / 1.e7; }
+    static FTimespan FromSeconds(double Seconds) { return FTimespan(static_cast<int64>(Seconds * 1.e7 + (Seconds >= 0 ? 0.5 : -0.5))); }
+
+    bool operator==(const FTimespan& Other) const { return Ticks == Other.Ticks; }
+    bool operator!=(const FTimespan& Other) const { return Ticks != Other.Ticks; }
+    bool operator<(const FTimespan& Other) const { return Ticks < Other.Ticks; }
+};
@@ -0,0 +1,42 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Signed 8 bit normal as UE 4.26 packs it: each component rounded to the nearest 1/127 and saturated,
+// W set to 127 when packed from an FVector and packed like the others from an FVector4
+struct FPackedNormal
+{
+    union
+    {
+        struct
+        {
+            int8 X, Y, Z, W;
+        };
+        uint32 Packed;
+    } Vector;
+
+    FPackedNormal() { Vector.Packed = 0; }
+    FPackedNormal(const FVector& InVector) { *this = InVector; }
+    FPackedNormal(const FVector4& InVector) { *this = InVector; }
+    FPackedNormal(int8 InX, int8 InY, int8 InZ, int8 InW) { Vector.X = InX; Vector.Y = InY; Vector.Z = InZ; Vector.W = InW; }
+
+    void operator=(const FVector& InVector)
+    {
+        Vector.X = static_cast<int8>(FMath::Clamp<int32>(FMath::RoundToInt(InVector.X * 127.f), -128, 127));
+        Vector.Y = static_cast<int8>(FMath::Clamp<int32>(FMath::RoundToInt(InVector.Y * 127.f), -128, 127));
+        Vector.Z = static_cast<int8>(FMath::Clamp<int32>(FMath::RoundToInt(InVector.Z * 127.f), -128, 127));
+        Vector.W = 127;
+    }
+
+    void operator=(const FVector4& InVector)
+    {
+        *this = FVector(InVector.X, InVector.Y, InVector.Z);
+        Vector.W = static_cast<int8>(FMath::Clamp<int32>(FMath::RoundToInt(InVector.W * 127.f), -128, 127));
+    }
+
+    FVector ToFVector() const { return FVector(Vector.X / 127.f, Vector.Y / 127.f, Vector.Z / 127.f); }
+    bool operator==(const FPackedNormal& B) const { return Vector.Packed == B.Vector.Packed; }
+    bool operator!=(const FPackedNormal& B) const { return Vector.Packed != B.Vector.Packed; }
+};
@@ -0,0 +1,16 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+// The pixel formats the plugin names
+enum EPixelFormat
+{
+    PF_Unknown,
+    PF_B8G8R8A8,
+    PF_R8G8B8A8,
+    PF_R32_FLOAT,
+    PF_G16R16,
+    PF_G16R16F,
+    PF_G32R32F,
+    PF_NV12,
+};
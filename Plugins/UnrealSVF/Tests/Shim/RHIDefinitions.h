@@ -0,0 +1,32 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Vertex element types of the RHI, in the engine's order
+enum EVertexElementType
+{
+    VET_None,
+    VET_Float1,
+    VET_Float2,
+    VET_Float3,
+    VET_Float4,
+    VET_PackedNormal,
+    VET_UByte4,
+    VET_UByte4N,
+    VET_Color,
+    VET_Short2,
+    VET_Short4,
+    VET_Short2N,
+    VET_Half2,
+    VET_Half4,
+    VET_Short4N,
+    VET_UShort2,
+    VET_UShort4,
+    VET_UShort2N,
+    VET_UShort4N,
+    VET_URGB10A2N,
+    VET_UInt,
+    VET_MAX,
+};
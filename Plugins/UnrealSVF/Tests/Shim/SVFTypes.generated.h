@@ -0,0 +1,5 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+// Header tool output of SVFTypes.h; the reflection macros expand to nothing in the tests
@@ -0,0 +1,39 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Byte stream of the engine's archives: plain scalars and vectors in little endian, reads past the end
+// set the error flag and zero the value
+class FArchive
+{
+public:
+    virtual ~FArchive() = default;
+    virtual void Serialize(void* Value, int64 Length) = 0;
+    virtual int64 Tell() { return Offset; }
+
+    bool IsError() const { return bError; }
+    void SetError() { bError = true; }
+
+    friend FArchive& operator<<(FArchive& Ar, uint8& Value) { Ar.Serialize(&Value, sizeof(Value)); return Ar; }
+    friend FArchive& operator<<(FArchive& Ar, uint32& Value) { Ar.Serialize(&Value, sizeof(Value)); return Ar; }
+    friend FArchive& operator<<(FArchive& Ar, int32& Value) { Ar.Serialize(&Value, sizeof(Value)); return Ar; }
+    friend FArchive& operator<<(FArchive& Ar, int64& Value) { Ar.Serialize(&Value, sizeof(Value)); return Ar; }
+    friend FArchive& operator<<(FArchive& Ar, float& Value) { Ar.Serialize(&Value, sizeof(Value)); return Ar; }
+    friend FArchive& operator<<(FArchive& Ar, FVector& Value) { return Ar << Value.X << Value.Y << Value.Z; }
+    // Bools go as 32 bit, the way the engine writes them
+    friend FArchive& operator<<(FArchive& Ar, bool& Value)
+    {
+        uint32 Word = Value ? 1 : 0;
+        Ar << Word;
+        Value = Word != 0;
+        return Ar;
+    }
+    friend FArchive& operator<<(FArchive& Ar, FTimespan& Value) { return Ar << Value.Ticks; }
+    friend FArchive& operator<<(FArchive& Ar, FBox& Value) { return Ar << Value.Min << Value.Max << Value.IsValid; }
+
+protected:
+    int64 Offset = 0;
+    bool bError = false;
+};
@@ -0,0 +1,27 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+class FMemoryReader : public FArchive
+{
+public:
+    explicit FMemoryReader(const TArray<uint8>& InBytes) : Bytes(InBytes) {}
+
+    void Serialize(void* Value, int64 Length) override
+    {
+        if (bError || Offset + Length > Bytes.Num())
+        {
+            SetError();
+            FMemory::Memzero(Value, Length);
+            return;
+        }
+        FMemory::Memcpy(Value, Bytes.GetData() + Offset, Length);
+        Offset += Length;
+    }
+
+private:
+    const TArray<uint8>& Bytes;
+};
@@ -0,0 +1,27 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+// Appends to, or overwrites from the current offset of, a byte array
+class FMemoryWriter : public FArchive
+{
+public:
+    explicit FMemoryWriter(TArray<uint8>& InBytes) : Bytes(InBytes) {}
+
+    void Serialize(void* Value, int64 Length) override
+    {
+        const int64 End = Offset + Length;
+        if (End > Bytes.Num())
+        {
+            Bytes.AddUninitialized(static_cast<int32>(End - Bytes.Num()));
+        }
+        FMemory::Memcpy(Bytes.GetData() + Offset, Value, Length);
+        Offset = End;
+    }
+
+private:
+    TArray<uint8>& Bytes;
+};
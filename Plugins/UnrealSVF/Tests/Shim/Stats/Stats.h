@@ -0,0 +1,6 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+// Stats compile away, see CoreMinimal.h
+#include "CoreMinimal.h"
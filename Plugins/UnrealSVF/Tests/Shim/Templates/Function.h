@@ -0,0 +1,15 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+template <typename FunctionType>
+using TFunction = std::function<FunctionType>;
+
+// Owning here rather than a reference, which only costs the tests a copy
+template <typename FunctionType>
+using TFunctionRef = std::function<FunctionType>;
+
+template <typename FunctionType>
+using TUniqueFunction = std::function<FunctionType>;
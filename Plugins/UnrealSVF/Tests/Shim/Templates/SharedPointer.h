@@ -0,0 +1,69 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ESPMode
+{
+    NotThreadSafe,
+    Fast,
+    ThreadSafe
+};
+
+// Shared pointers are std::shared_ptr underneath, which is always thread safe
+template <typename T, ESPMode Mode = ESPMode::Fast>
+class TSharedPtr : public std::shared_ptr<T>
+{
+public:
+    TSharedPtr() = default;
+    TSharedPtr(std::nullptr_t) {}
+    TSharedPtr(std::shared_ptr<T>&& Other) : std::shared_ptr<T>(std::move(Other)) {}
+    template <typename OtherType, typename = std::enable_if_t<std::is_convertible<OtherType*, T*>::value>>
+    TSharedPtr(const TSharedPtr<OtherType, Mode>& Other) : std::shared_ptr<T>(Other) {}
+    template <typename OtherType, typename = std::enable_if_t<std::is_convertible<OtherType*, T*>::value>>
+    TSharedPtr(TSharedPtr<OtherType, Mode>&& Other) : std::shared_ptr<T>(std::move(Other)) {}
+
+    bool IsValid() const { return this->get() != nullptr; }
+    bool IsUnique() const { return this->use_count() == 1; }
+    int32 GetSharedReferenceCount() const { return static_cast<int32>(this->use_count()); }
+    T* Get() const { return this->get(); }
+    void Reset() { this->reset(); }
+    TSharedPtr<T, Mode> ToSharedRef() const { check(IsValid()); return *this; }
+};
+
+template <typename T, ESPMode Mode = ESPMode::Fast>
+using TSharedRef = TSharedPtr<T, Mode>;
+
+template <typename T, ESPMode Mode = ESPMode::Fast>
+class TWeakPtr : public std::weak_ptr<T>
+{
+public:
+    TWeakPtr() = default;
+    TWeakPtr(const TSharedPtr<T, Mode>& Shared) : std::weak_ptr<T>(Shared) {}
+    TSharedPtr<T, Mode> Pin() const { return TSharedPtr<T, Mode>(this->lock()); }
+    bool IsValid() const { return !this->expired(); }
+    void Reset() { this->reset(); }
+};
+
+template <typename T, ESPMode Mode = ESPMode::Fast, typename... ArgTypes>
+TSharedPtr<T, Mode> MakeShared(ArgTypes&&... Args)
+{
+    return TSharedPtr<T, Mode>(std::make_shared<T>(std::forward<ArgTypes>(Args)...));
+}
+
+template <typename T>
+class TUniquePtr : public std::unique_ptr<T>
+{
+public:
+    using std::unique_ptr<T>::unique_ptr;
+    bool IsValid() const { return this->get() != nullptr; }
+    T* Get() const { return this->get(); }
+    void Reset() { this->reset(); }
+};
+
+template <typename T, typename... ArgTypes>
+TUniquePtr<T> MakeUnique(ArgTypes&&... Args)
+{
+    return TUniquePtr<T>(new T(std::forward<ArgTypes>(Args)...));
+}
@@ -0,0 +1,18 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+inline uint32 HashCombine(uint32 A, uint32 B) { return A ^ (B + 0x9e3779b9u + (A << 6) + (A >> 2)); }
+inline uint32 GetTypeHash(int32 Value) { return static_cast<uint32>(Value); }
+inline uint32 GetTypeHash(uint32 Value) { return Value; }
+inline uint32 GetTypeHash(uint64 Value) { return static_cast<uint32>(Value) + static_cast<uint32>(Value >> 32) * 23; }
+inline uint32 GetTypeHash(int64 Value) { return GetTypeHash(static_cast<uint64>(Value)); }
+template <typename T> inline uint32 GetTypeHash(T* Value) { return GetTypeHash(static_cast<uint64>(reinterpret_cast<uintptr_t>(Value))); }
+
+// Hasher for the standard containers the shim's TMap and TSet are built on
+struct FShimKeyHash
+{
+    template <typename T> size_t operator()(const T& Value) const { return GetTypeHash(Value); }
+};
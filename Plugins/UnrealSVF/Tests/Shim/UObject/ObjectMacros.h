@@ -0,0 +1,23 @@
+// Copyright (C) Microsoft Corporation. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Reflection markup is only read by the header tool
+#define UENUM(...)
+#define USTRUCT(...)
+#define UCLASS(...)
+#define UINTERFACE(...)
+#define UPROPERTY(...)
+#define UFUNCTION(...)
+#define UMETA(...)
+#define GENERATED_BODY(...)
+#define GENERATED_UCLASS_BODY(...)
+#define GENERATED_USTRUCT_BODY(...)
+
+class UObject
+{
+public:
+    virtual ~UObject() = default;
+};